@@ -7,8 +7,10 @@
 #ifndef NDK_BASECOMPONENT_HPP
 #define NDK_BASECOMPONENT_HPP
 
+#include <NDK/ComponentPool.hpp>
 #include <NDK/EntityHandle.hpp>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -18,27 +20,30 @@ namespace Ndk
 	{
 		friend Entity;
 		friend class Sdk;
+		friend class World;
 
 		public:
 			using Factory = std::function<BaseComponent*()>;
+			using PoolFactory = std::function<BaseComponentPool*()>;
 
 			BaseComponent(ComponentIndex componentIndex);
-			BaseComponent(const BaseComponent&) = default;
+			inline BaseComponent(const BaseComponent& component);
 			BaseComponent(BaseComponent&&) = default;
 			virtual ~BaseComponent();
 
 			virtual BaseComponent* Clone() const = 0;
 
+			inline const EntityHandle& GetEntity() const;
 			ComponentIndex GetIndex() const;
 
-			BaseComponent& operator=(const BaseComponent&) = default;
+			inline BaseComponent& operator=(const BaseComponent& component);
 			BaseComponent& operator=(BaseComponent&&) = default;
 
 		protected:
 			ComponentIndex m_componentIndex;
 			EntityHandle m_entity;
 
-			static ComponentIndex RegisterComponent(ComponentId id, Factory factoryFunc);
+			static ComponentIndex RegisterComponent(ComponentId id, Factory factoryFunc, PoolFactory poolFactoryFunc);
 
 		private:
 			virtual void OnAttached();
@@ -48,6 +53,8 @@ namespace Ndk
 
 			void SetEntity(Entity* entity);
 
+			static inline std::unique_ptr<BaseComponentPool> CreatePool(ComponentIndex index);
+
 			static bool Initialize();
 			static void Uninitialize();
 
@@ -55,6 +62,7 @@ namespace Ndk
 			{
 				ComponentId id;
 				Factory factory;
+				PoolFactory poolFactory;
 			};
 
 			static std::vector<ComponentEntry> s_entries;
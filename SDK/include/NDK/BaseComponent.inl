@@ -12,12 +12,24 @@ namespace Ndk
 	{
 	}
 
+	inline BaseComponent::BaseComponent(const BaseComponent& component) :
+	m_componentIndex(component.m_componentIndex),
+	m_entity(nullptr)
+	{
+		///DOC: A copy is not attached to any entity, it doesn't reference the entity of the original component
+	}
+
+	inline const EntityHandle& BaseComponent::GetEntity() const
+	{
+		return m_entity;
+	}
+
 	inline ComponentIndex BaseComponent::GetIndex() const
 	{
 		return m_componentIndex;
 	}
 
-	inline ComponentIndex BaseComponent::RegisterComponent(ComponentId id, Factory factoryFunc)
+	inline ComponentIndex BaseComponent::RegisterComponent(ComponentId id, Factory factoryFunc, PoolFactory poolFactoryFunc)
 	{
 		// Nous allons rajouter notre composant à la fin
 		ComponentIndex index = s_entries.size();
@@ -27,6 +39,7 @@ namespace Ndk
 		ComponentEntry& entry = s_entries.back();
 		entry.factory = factoryFunc;
 		entry.id = id;
+		entry.poolFactory = poolFactoryFunc;
 
 		// Une petite assertion pour s'assurer que l'identifiant n'est pas déjà utilisé
 		NazaraAssert(s_idToIndex.find(id) == s_idToIndex.end(), "This id is already in use");
@@ -36,6 +49,13 @@ namespace Ndk
 		return index;
 	}
 
+	inline BaseComponent& BaseComponent::operator=(const BaseComponent& component)
+	{
+		m_componentIndex = component.m_componentIndex;
+
+		return *this;
+	}
+
 	inline void BaseComponent::SetEntity(Entity* entity)
 	{
 		if (m_entity != entity)
@@ -49,6 +69,13 @@ namespace Ndk
 		}
 	}
 
+	inline std::unique_ptr<BaseComponentPool> BaseComponent::CreatePool(ComponentIndex index)
+	{
+		NazaraAssert(index < s_entries.size(), "Component index out of range");
+
+		return std::unique_ptr<BaseComponentPool>(s_entries[index].poolFactory());
+	}
+
 	inline bool BaseComponent::Initialize()
 	{
 		// Rien à faire
@@ -8,6 +8,7 @@
 #define NDK_BASESYSTEM_HPP
 
 #include <Nazara/Core/Bitset.hpp>
+#include <NDK/EntityCommandBuffer.hpp>
 #include <NDK/EntityHandle.hpp>
 #include <vector>
 
@@ -29,13 +30,21 @@ namespace Ndk
 
 			virtual BaseSystem* Clone() const = 0;
 
+			inline bool ConflictsWith(const BaseSystem& system) const;
+
 			bool Filters(const Entity* entity) const;
 
+			template<typename F> void ForEachParallel(F&& func, std::size_t grainSize = 64);
+
 			inline const std::vector<EntityHandle>& GetEntities() const;
 			inline SystemIndex GetIndex() const;
+			inline Nz::UInt64 GetLastUpdateTime() const;
+			inline const Nz::Bitset<>& GetReadComponents() const;
 			inline float GetUpdateRate() const;
 			inline World& GetWorld() const;
+			inline const Nz::Bitset<>& GetWrittenComponents() const;
 
+			inline bool HasDeclaredAccesses() const;
 			inline bool HasEntity(const Entity* entity) const;
 
 			inline void SetUpdateRate(float updatePerSecond);
@@ -52,6 +61,10 @@ namespace Ndk
 
 			static SystemIndex GetNextIndex();
 
+			template<typename ComponentType> void Reads();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Reads();
+			inline void ReadsComponent(ComponentIndex index);
+
 			template<typename ComponentType> void Requires();
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Requires();
 			inline void RequiresComponent(ComponentIndex index);
@@ -60,32 +73,49 @@ namespace Ndk
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void RequiresAny();
 			inline void RequiresAnyComponent(ComponentIndex index);
 
+			template<typename ComponentType> void Writes();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Writes();
+			inline void WritesComponent(ComponentIndex index);
+
 			virtual void OnUpdate(float elapsedTime) = 0;
 
 		private:
 			inline void AddEntity(Entity* entity);
 
+			void ApplyCommands();
+
+			void InvalidateFilter();
+
 			virtual void OnEntityAdded(Entity* entity);
 			virtual void OnEntityRemoved(Entity* entity);
 			virtual void OnEntityValidation(Entity* entity, bool justAdded);
 
 			inline void RemoveEntity(Entity* entity);
+			void RemoveEntities(const Nz::Bitset<Nz::UInt64>& entities);
 
+			inline void SetDeferredCommands(bool deferredCommands);
 			inline void SetWorld(World& world);
 
 			inline void ValidateEntity(Entity* entity, bool justAdded);
 
+			inline bool WritesAnyAccessedBy(const BaseSystem& system) const;
+
 			static inline bool Initialize();
 			static inline void Uninitialize();
 
+			std::vector<EntityCommandBuffer> m_commandBuffers;
 			std::vector<EntityHandle> m_entities;
 			Nz::Bitset<Nz::UInt64> m_entityBits;
 			Nz::Bitset<> m_excludedComponents;
-			mutable Nz::Bitset<> m_filterResult;
+			Nz::Bitset<> m_readComponents;
 			Nz::Bitset<> m_requiredAnyComponents;
 			Nz::Bitset<> m_requiredComponents;
+			Nz::Bitset<> m_writtenComponents;
+			Nz::UInt64 m_lastUpdateTime;
 			SystemIndex m_systemIndex;
 			World* m_world;
+			bool m_accessesDeclared;
+			bool m_deferredCommands;
 			float m_updateCounter;
 			float m_updateRate;
 
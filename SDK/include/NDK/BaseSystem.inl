@@ -2,26 +2,77 @@
 // This file is part of the "Nazara Development Kit"
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Parallel.hpp>
+#include <algorithm>
 #include <type_traits>
 
 namespace Ndk
 {
 	inline BaseSystem::BaseSystem(SystemIndex systemId) :
-	m_systemIndex(systemId)
+	m_lastUpdateTime(0),
+	m_systemIndex(systemId),
+	m_world(nullptr),
+	m_accessesDeclared(false),
+	m_deferredCommands(false)
 	{
 		SetUpdateRate(30);
 	}
 
 	inline BaseSystem::BaseSystem(const BaseSystem& system) :
 	m_excludedComponents(system.m_excludedComponents),
+	m_readComponents(system.m_readComponents),
 	m_requiredComponents(system.m_requiredComponents),
+	m_writtenComponents(system.m_writtenComponents),
+	m_lastUpdateTime(0),
 	m_systemIndex(system.m_systemIndex),
+	m_world(nullptr),
+	m_accessesDeclared(system.m_accessesDeclared),
+	m_deferredCommands(false),
 	m_updateCounter(0.f),
 	m_updateRate(system.m_updateRate)
 	{
 	}
 
+	inline bool BaseSystem::ConflictsWith(const BaseSystem& system) const
+	{
+		///DOC: A system which did not declare its accesses may touch anything and conflicts with every system
+		if (!m_accessesDeclared || !system.m_accessesDeclared)
+			return true;
+
+		return WritesAnyAccessedBy(system) || system.WritesAnyAccessedBy(*this);
+	}
+
+	template<typename F>
+	void BaseSystem::ForEachParallel(F&& func, std::size_t grainSize)
+	{
+		///DOC: func must record entity and component changes into commands, which are applied in entity order once every chunk is done
+		NazaraAssert(grainSize > 0, "Grain size must be over zero");
+
+		std::size_t entityCount = m_entities.size();
+		std::size_t chunkCount = (entityCount + grainSize - 1) / grainSize;
+
+		// One command buffer per chunk, this way the commands order doesn't depend on the scheduling
+		if (m_commandBuffers.size() < chunkCount)
+			m_commandBuffers.resize(chunkCount);
+
+		Nz::ParallelFor(0, chunkCount, [this, &func, entityCount, grainSize] (std::size_t firstChunk, std::size_t lastChunk)
+		{
+			for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+			{
+				EntityCommandBuffer& commands = m_commandBuffers[chunk];
+
+				std::size_t lastEntity = std::min(entityCount, (chunk + 1) * grainSize);
+				for (std::size_t i = chunk * grainSize; i < lastEntity; ++i)
+					func(m_entities[i], commands);
+			}
+		});
+
+		if (!m_deferredCommands)
+			ApplyCommands();
+	}
+
 	inline const std::vector<EntityHandle>& BaseSystem::GetEntities() const
 	{
 		return m_entities;
@@ -32,6 +83,18 @@ namespace Ndk
 		return m_systemIndex;
 	}
 
+	inline Nz::UInt64 BaseSystem::GetLastUpdateTime() const
+	{
+		///DOC: Time spent (in microseconds) in the last OnUpdate call, zero if the last update was skipped because of the update rate
+		return m_lastUpdateTime;
+	}
+
+	inline const Nz::Bitset<>& BaseSystem::GetReadComponents() const
+	{
+		///DOC: Only holds the explicitly read components, components of the filter are read as well
+		return m_readComponents;
+	}
+
 	inline float BaseSystem::GetUpdateRate() const
 	{
 		return (m_updateRate > 0.f) ? 1.f / m_updateRate : 0.f;
@@ -42,6 +105,16 @@ namespace Ndk
 		return *m_world;
 	}
 
+	inline const Nz::Bitset<>& BaseSystem::GetWrittenComponents() const
+	{
+		return m_writtenComponents;
+	}
+
+	inline bool BaseSystem::HasDeclaredAccesses() const
+	{
+		return m_accessesDeclared;
+	}
+
 	inline bool BaseSystem::HasEntity(const Entity* entity) const
 	{
 		if (!entity)
@@ -62,12 +135,17 @@ namespace Ndk
 		{
 			m_updateCounter -= elapsedTime;
 			if (m_updateCounter >= 0.f)
+			{
+				m_lastUpdateTime = 0;
 				return;
+			}
 
 			m_updateCounter += m_updateRate;
 		}
 
+		Nz::UInt64 startTime = Nz::GetElapsedMicroseconds();
 		OnUpdate(elapsedTime);
+		m_lastUpdateTime = Nz::GetElapsedMicroseconds() - startTime;
 	}
 
 	template<typename ComponentType>
@@ -88,6 +166,7 @@ namespace Ndk
 	inline void BaseSystem::ExcludesComponent(ComponentIndex index)
 	{
 		m_excludedComponents.UnboundedSet(index);
+		InvalidateFilter();
 	}
 
 	inline SystemIndex BaseSystem::GetNextIndex()
@@ -95,6 +174,28 @@ namespace Ndk
 		return s_nextIndex++;
 	}
 
+	template<typename ComponentType>
+	void BaseSystem::Reads()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ReadsComponent(GetComponentIndex<ComponentType>());
+	}
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Reads()
+	{
+		Reads<ComponentType1>();
+		Reads<ComponentType2, Rest...>();
+	}
+
+	inline void BaseSystem::ReadsComponent(ComponentIndex index)
+	{
+		///DOC: A system declaring its accesses must declare every component it uses outside of its filter, and must not change entities during its update
+		m_readComponents.UnboundedSet(index);
+		m_accessesDeclared = true;
+	}
+
 	template<typename ComponentType>
 	void BaseSystem::Requires()
 	{
@@ -113,6 +214,7 @@ namespace Ndk
 	inline void BaseSystem::RequiresComponent(ComponentIndex index)
 	{
 		m_requiredComponents.UnboundedSet(index);
+		InvalidateFilter();
 	}
 
 	template<typename ComponentType>
@@ -133,6 +235,28 @@ namespace Ndk
 	inline void BaseSystem::RequiresAnyComponent(ComponentIndex index)
 	{
 		m_requiredAnyComponents.UnboundedSet(index);
+		InvalidateFilter();
+	}
+
+	template<typename ComponentType>
+	void BaseSystem::Writes()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		WritesComponent(GetComponentIndex<ComponentType>());
+	}
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Writes()
+	{
+		Writes<ComponentType1>();
+		Writes<ComponentType2, Rest...>();
+	}
+
+	inline void BaseSystem::WritesComponent(ComponentIndex index)
+	{
+		m_writtenComponents.UnboundedSet(index);
+		m_accessesDeclared = true;
 	}
 
 	inline void BaseSystem::AddEntity(Entity* entity)
@@ -172,11 +296,25 @@ namespace Ndk
 		OnEntityValidation(entity, justAdded);
 	}
 
+	inline void BaseSystem::SetDeferredCommands(bool deferredCommands)
+	{
+		m_deferredCommands = deferredCommands;
+	}
+
 	inline void BaseSystem::SetWorld(World& world)
 	{
 		m_world = &world;
 	}
 
+	inline bool BaseSystem::WritesAnyAccessedBy(const BaseSystem& system) const
+	{
+		// Components of the filter are read by the system
+		return m_writtenComponents.Intersects(system.m_writtenComponents) ||
+		       m_writtenComponents.Intersects(system.m_readComponents) ||
+		       m_writtenComponents.Intersects(system.m_requiredComponents) ||
+		       m_writtenComponents.Intersects(system.m_requiredAnyComponents);
+	}
+
 	inline bool BaseSystem::Initialize()
 	{
 		s_nextIndex = 0;
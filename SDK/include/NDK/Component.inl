@@ -37,7 +37,13 @@ namespace Ndk
 			return new ComponentType;
 		};
 
-		return BaseComponent::RegisterComponent(id, factory);
+		// Each world stores the components of this type in its own pool
+		auto poolFactory = []() -> BaseComponentPool*
+		{
+			return new ComponentPool<ComponentType>;
+		};
+
+		return BaseComponent::RegisterComponent(id, factory, poolFactory);
 	}
 
 	template<typename ComponentType>
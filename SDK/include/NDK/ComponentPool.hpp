@@ -0,0 +1,100 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_COMPONENTPOOL_HPP
+#define NDK_COMPONENTPOOL_HPP
+
+#include <Nazara/Core/Bitset.hpp>
+#include <NDK/Prerequesites.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Ndk
+{
+	class BaseComponent;
+
+	class NDK_API BaseComponentPool
+	{
+		public:
+			inline BaseComponentPool();
+			BaseComponentPool(const BaseComponentPool&) = delete;
+			BaseComponentPool(BaseComponentPool&&) = delete;
+			virtual ~BaseComponentPool();
+
+			virtual BaseComponent* Adopt(std::unique_ptr<BaseComponent>&& component) = 0;
+
+			inline void Bind(EntityId id, BaseComponent* component);
+
+			virtual void Clone(const BaseComponent& component, BaseComponent** clones, std::size_t count) = 0;
+
+			virtual void Delete(BaseComponent* component) = 0;
+
+			inline BaseComponent* Find(EntityId id) const;
+
+			inline std::size_t GetSize() const;
+
+			inline void Unbind(EntityId id, const BaseComponent* component);
+
+			BaseComponentPool& operator=(const BaseComponentPool&) = delete;
+			BaseComponentPool& operator=(BaseComponentPool&&) = delete;
+
+		protected:
+			std::vector<BaseComponent*> m_componentByEntity;
+			std::size_t m_size;
+	};
+
+	struct NDK_API ComponentDeleter
+	{
+		inline ComponentDeleter(BaseComponentPool* componentPool = nullptr);
+
+		void operator()(BaseComponent* component) const;
+
+		BaseComponentPool* pool;
+	};
+
+	using ComponentPtr = std::unique_ptr<BaseComponent, ComponentDeleter>;
+
+	template<typename ComponentType>
+	class ComponentPool : public BaseComponentPool
+	{
+		public:
+			ComponentPool() = default;
+			~ComponentPool();
+
+			BaseComponent* Adopt(std::unique_ptr<BaseComponent>&& component) override;
+
+			void Clone(const BaseComponent& component, BaseComponent** clones, std::size_t count) override;
+
+			void Delete(BaseComponent* component) override;
+
+			template<typename F> void ForEach(F&& func);
+
+			template<typename... Args> ComponentType* New(Args&&... args);
+
+			static constexpr std::size_t ChunkSize = 256;
+
+		private:
+			struct Slot
+			{
+				typename std::aligned_storage<sizeof(ComponentType), alignof(ComponentType)>::type storage;
+				std::size_t index;
+			};
+
+			Slot& AllocateSlot();
+			inline Slot& GetSlot(std::size_t index);
+			void ReleaseSlot(Slot& slot);
+
+			std::vector<std::unique_ptr<Slot[]>> m_chunks;
+			std::vector<std::size_t> m_freeSlots;
+			std::vector<ComponentType*> m_adoptedComponents; //< Allocated outside of the pool, owned by it
+			Nz::Bitset<Nz::UInt64> m_usedSlots;
+	};
+}
+
+#include <NDK/ComponentPool.inl>
+
+#endif // NDK_COMPONENTPOOL_HPP
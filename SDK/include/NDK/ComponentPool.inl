@@ -0,0 +1,188 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace Ndk
+{
+	inline BaseComponentPool::BaseComponentPool() :
+	m_size(0)
+	{
+	}
+
+	inline void BaseComponentPool::Bind(EntityId id, BaseComponent* component)
+	{
+		if (id >= m_componentByEntity.size())
+			m_componentByEntity.resize(id + 1, nullptr);
+
+		m_componentByEntity[id] = component;
+	}
+
+	inline BaseComponent* BaseComponentPool::Find(EntityId id) const
+	{
+		return (id < m_componentByEntity.size()) ? m_componentByEntity[id] : nullptr;
+	}
+
+	inline std::size_t BaseComponentPool::GetSize() const
+	{
+		return m_size;
+	}
+
+	inline void BaseComponentPool::Unbind(EntityId id, const BaseComponent* component)
+	{
+		if (Find(id) == component)
+			m_componentByEntity[id] = nullptr;
+	}
+
+	inline ComponentDeleter::ComponentDeleter(BaseComponentPool* componentPool) :
+	pool(componentPool)
+	{
+	}
+
+	template<typename ComponentType>
+	constexpr std::size_t ComponentPool<ComponentType>::ChunkSize;
+
+	template<typename ComponentType>
+	ComponentPool<ComponentType>::~ComponentPool()
+	{
+		m_usedSlots.ForEachSetBit([this] (std::size_t index)
+		{
+			reinterpret_cast<ComponentType*>(&GetSlot(index).storage)->~ComponentType();
+		});
+
+		for (ComponentType* component : m_adoptedComponents)
+			delete component;
+	}
+
+	template<typename ComponentType>
+	BaseComponent* ComponentPool<ComponentType>::Adopt(std::unique_ptr<BaseComponent>&& component)
+	{
+		NazaraAssert(component, "Invalid component");
+		NazaraAssert(dynamic_cast<ComponentType*>(component.get()), "Component is not of the pool type");
+
+		m_adoptedComponents.push_back(static_cast<ComponentType*>(component.get()));
+		m_size++;
+
+		return component.release();
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::Clone(const BaseComponent& component, BaseComponent** clones, std::size_t count)
+	{
+		NazaraAssert(dynamic_cast<const ComponentType*>(&component), "Component is not of the pool type");
+
+		const ComponentType& source = static_cast<const ComponentType&>(component);
+		for (std::size_t i = 0; i < count; ++i)
+			clones[i] = New(source);
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::Delete(BaseComponent* component)
+	{
+		NazaraAssert(component, "Invalid component");
+
+		ComponentType* typedComponent = static_cast<ComponentType*>(component);
+
+		// Adopted components are rare, there's no need for more than a linear search
+		if (!m_adoptedComponents.empty())
+		{
+			auto it = std::find(m_adoptedComponents.begin(), m_adoptedComponents.end(), typedComponent);
+			if (it != m_adoptedComponents.end())
+			{
+				*it = m_adoptedComponents.back();
+				m_adoptedComponents.pop_back();
+
+				delete typedComponent;
+				m_size--;
+				return;
+			}
+		}
+
+		Slot& slot = *reinterpret_cast<Slot*>(typedComponent);
+		NazaraAssert(m_usedSlots.Test(static_cast<unsigned int>(slot.index)), "Component is not part of this pool");
+
+		typedComponent->~ComponentType();
+		ReleaseSlot(slot);
+
+		m_size--;
+	}
+
+	template<typename ComponentType>
+	template<typename F>
+	void ComponentPool<ComponentType>::ForEach(F&& func)
+	{
+		///DOC: func must not add nor remove components of this type
+		m_usedSlots.ForEachSetBit([this, &func] (std::size_t index)
+		{
+			func(*reinterpret_cast<ComponentType*>(&GetSlot(index).storage));
+		});
+
+		for (ComponentType* component : m_adoptedComponents)
+			func(*component);
+	}
+
+	template<typename ComponentType>
+	template<typename... Args>
+	ComponentType* ComponentPool<ComponentType>::New(Args&&... args)
+	{
+		///DOC: Components are never moved once built, pointers to them stay valid until they are deleted
+		Slot& slot = AllocateSlot();
+
+		ComponentType* component;
+		try
+		{
+			component = Nz::PlacementNew<ComponentType>(&slot.storage, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			ReleaseSlot(slot);
+			throw;
+		}
+
+		m_size++;
+
+		return component;
+	}
+
+	template<typename ComponentType>
+	typename ComponentPool<ComponentType>::Slot& ComponentPool<ComponentType>::AllocateSlot()
+	{
+		if (m_freeSlots.empty())
+		{
+			// Slots are given by increasing index, so components created together are stored together
+			std::size_t firstIndex = m_chunks.size() * ChunkSize;
+			m_chunks.emplace_back(new Slot[ChunkSize]);
+			m_usedSlots.Resize(static_cast<unsigned int>(firstIndex + ChunkSize), false);
+
+			m_freeSlots.reserve(m_freeSlots.size() + ChunkSize);
+			for (std::size_t i = ChunkSize; i > 0; --i)
+				m_freeSlots.push_back(firstIndex + i - 1);
+		}
+
+		std::size_t index = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		Slot& slot = GetSlot(index);
+		slot.index = index;
+		m_usedSlots.Set(static_cast<unsigned int>(index), true);
+
+		return slot;
+	}
+
+	template<typename ComponentType>
+	inline typename ComponentPool<ComponentType>::Slot& ComponentPool<ComponentType>::GetSlot(std::size_t index)
+	{
+		return m_chunks[index / ChunkSize][index % ChunkSize];
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::ReleaseSlot(Slot& slot)
+	{
+		m_usedSlots.Set(static_cast<unsigned int>(slot.index), false);
+		m_freeSlots.push_back(slot.index);
+	}
+}
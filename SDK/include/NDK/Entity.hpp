@@ -9,6 +9,7 @@
 
 #include <Nazara/Core/Bitset.hpp>
 #include <NDK/Algorithm.hpp>
+#include <NDK/ComponentPool.hpp>
 #include <memory>
 #include <vector>
 
@@ -62,15 +63,19 @@ namespace Ndk
 		private:
 			Entity(World& world, EntityId id);
 
+			BaseComponent& AttachComponent(ComponentPtr&& component);
+
 			void Create();
 			void Destroy();
 
+			BaseComponentPool& GetComponentPool(ComponentIndex index) const;
+
 			inline void RegisterHandle(EntityHandle* handle);
 			inline void RegisterSystem(SystemIndex index);
 			inline void UnregisterHandle(EntityHandle* handle);
 			inline void UnregisterSystem(SystemIndex index);
 
-			std::vector<std::unique_ptr<BaseComponent>> m_components;
+			std::vector<ComponentPtr> m_components;
 			std::vector<EntityHandle*> m_handles;
 			Nz::Bitset<> m_componentBits;
 			Nz::Bitset<> m_systemBits;
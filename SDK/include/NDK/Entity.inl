@@ -14,9 +14,11 @@ namespace Ndk
 	{
 		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
 
-		// Allocation et affectation du component
-		std::unique_ptr<ComponentType> ptr(new ComponentType(std::forward<Args>(args)...));
-		return static_cast<ComponentType&>(AddComponent(std::move(ptr)));
+		// The component is built in place inside the world pool of its type
+		auto& pool = static_cast<ComponentPool<ComponentType>&>(GetComponentPool(GetComponentIndex<ComponentType>()));
+
+		ComponentPtr component(pool.New(std::forward<Args>(args)...), ComponentDeleter(&pool));
+		return static_cast<ComponentType&>(AttachComponent(std::move(component)));
 	}
 
 	inline void Entity::Enable(bool enable)
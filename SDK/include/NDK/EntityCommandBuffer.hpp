@@ -0,0 +1,72 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_ENTITYCOMMANDBUFFER_HPP
+#define NDK_ENTITYCOMMANDBUFFER_HPP
+
+#include <NDK/BaseComponent.hpp>
+#include <memory>
+#include <vector>
+
+namespace Ndk
+{
+	class World;
+
+	class NDK_API EntityCommandBuffer
+	{
+		public:
+			EntityCommandBuffer() = default;
+			EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+			EntityCommandBuffer(EntityCommandBuffer&&) = default;
+			~EntityCommandBuffer() = default;
+
+			void AddComponent(Entity* entity, std::unique_ptr<BaseComponent>&& component);
+			template<typename ComponentType, typename... Args> ComponentType& AddComponent(Entity* entity, Args&&... args);
+
+			void Apply();
+
+			inline void Clear();
+
+			void CreateEntity(World* world, std::vector<std::unique_ptr<BaseComponent>>&& components = {});
+
+			inline std::size_t GetCommandCount() const;
+
+			inline bool IsEmpty() const;
+
+			void Kill(Entity* entity);
+
+			void RemoveComponent(Entity* entity, ComponentIndex index);
+			template<typename ComponentType> void RemoveComponent(Entity* entity);
+
+			EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+			EntityCommandBuffer& operator=(EntityCommandBuffer&&) = default;
+
+		private:
+			enum CommandType
+			{
+				CommandType_AddComponent,
+				CommandType_CreateEntity,
+				CommandType_Kill,
+				CommandType_RemoveComponent
+			};
+
+			struct Command
+			{
+				std::unique_ptr<BaseComponent> component;
+				World* world;
+				ComponentIndex componentIndex;
+				CommandType type;
+				EntityId entityId;
+				bool createdEntity; //< Targets the entity created by the last CommandType_CreateEntity
+			};
+
+			std::vector<Command> m_commands;
+	};
+}
+
+#include <NDK/EntityCommandBuffer.inl>
+
+#endif // NDK_ENTITYCOMMANDBUFFER_HPP
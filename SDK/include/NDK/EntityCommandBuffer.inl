@@ -0,0 +1,45 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/Algorithm.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace Ndk
+{
+	template<typename ComponentType, typename... Args>
+	ComponentType& EntityCommandBuffer::AddComponent(Entity* entity, Args&&... args)
+	{
+		///DOC: The component is built right away and can be set up through the returned reference until the buffer is applied
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ComponentType* component = new ComponentType(std::forward<Args>(args)...);
+		AddComponent(entity, std::unique_ptr<BaseComponent>(component));
+
+		return *component;
+	}
+
+	inline void EntityCommandBuffer::Clear()
+	{
+		m_commands.clear();
+	}
+
+	inline std::size_t EntityCommandBuffer::GetCommandCount() const
+	{
+		return m_commands.size();
+	}
+
+	inline bool EntityCommandBuffer::IsEmpty() const
+	{
+		return m_commands.empty();
+	}
+
+	template<typename ComponentType>
+	void EntityCommandBuffer::RemoveComponent(Entity* entity)
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		RemoveComponent(entity, GetComponentIndex<ComponentType>());
+	}
+}
@@ -8,11 +8,15 @@
 #define NDK_WORLD_HPP
 
 #include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/TaskGraph.hpp>
+#include <NDK/BaseComponent.hpp>
+#include <NDK/ComponentPool.hpp>
 #include <NDK/Entity.hpp>
 #include <NDK/EntityHandle.hpp>
 #include <NDK/System.hpp>
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -20,9 +24,12 @@ namespace Ndk
 {
 	class NDK_API World
 	{
+		friend BaseSystem;
 		friend Entity;
 
 		public:
+			struct UpdateStats;
+
 			using EntityList = std::vector<EntityHandle>;
 
 			inline World(bool addDefaultSystems = true);
@@ -36,14 +43,22 @@ namespace Ndk
 			template<typename SystemType, typename... Args> SystemType& AddSystem(Args&&... args);
 
 			const EntityHandle& CreateEntity();
-			inline EntityList CreateEntities(unsigned int count);
+			EntityList CreateEntities(unsigned int count);
+			EntityList CreateEntities(unsigned int count, const Entity* prototype);
 
 			void Clear();
 
+			inline void EnableParallelUpdate(bool parallelUpdate);
+
+			template<typename ComponentType, typename... Rest, typename F> void ForEach(F&& func);
+
+			inline BaseComponentPool& GetComponentPool(ComponentIndex index);
+			template<typename ComponentType> ComponentPool<ComponentType>& GetComponentPool();
 			const EntityHandle& GetEntity(EntityId id);
 			inline const EntityList& GetEntities();
 			inline BaseSystem& GetSystem(SystemIndex index);
 			template<typename SystemType> SystemType& GetSystem();
+			inline const UpdateStats& GetUpdateStats() const;
 
 			inline bool HasSystem(SystemIndex index) const;
 			template<typename SystemType> bool HasSystem() const;
@@ -53,40 +68,81 @@ namespace Ndk
 
 			inline bool IsEntityValid(const Entity* entity) const;
 			inline bool IsEntityIdValid(EntityId id) const;
+			inline bool IsParallelUpdateEnabled() const;
 
 			inline void RemoveAllSystems();
 			inline void RemoveSystem(SystemIndex index);
 			template<typename SystemType> void RemoveSystem();
 
+			inline void Reserve(std::size_t entityCount);
+
 			void Update();
-			inline void Update(float elapsedTime);
+			void Update(float elapsedTime);
 
 			World& operator=(const World&) = delete;
 			World& operator=(World&&) = delete; ///TODO
 
+			struct UpdateStats
+			{
+				Nz::UInt64 systemTime;   //< Sum of the system update times (microseconds)
+				Nz::UInt64 updateTime;   //< Time spent updating the systems (microseconds)
+				float parallelism;       //< systemTime / updateTime, higher than one when systems ran concurrently
+				unsigned int filterEvaluations; //< System filters tested while updating the entities
+				unsigned int stageCount;
+			};
+
 		private:
+			void BuildFilterIndex();
+			void BuildUpdateStages();
+
 			inline void Invalidate();
 			inline void Invalidate(EntityId id);
+			inline void InvalidateComponent(EntityId id, ComponentIndex index);
+			inline void InvalidateSystemFilter();
+
+			template<typename ComponentType, typename... Rest, typename F, std::size_t... Indices> static void ForEachInPool(F& func, std::index_sequence<Indices...>, ComponentPool<ComponentType>& pool, BaseComponentPool* const* restPools);
 
 			struct EntityBlock
 			{
 				EntityBlock(Entity&& e) :
-				entity(std::move(e))
+				entity(std::move(e)),
+				validateAllSystems(false)
 				{
 				}
 
 				EntityBlock(EntityBlock&& block) = default;
 
 				Entity entity;
+				Nz::Bitset<> changedComponents;
 				unsigned int aliveIndex;
+				bool validateAllSystems;
+			};
+
+			struct UpdateStage
+			{
+				std::unique_ptr<Nz::TaskGraph> graph; //< Null if the stage holds a single system, run by the updating thread
+				std::vector<BaseSystem*> systems;
 			};
 
+			std::vector<std::unique_ptr<BaseComponentPool>> m_componentPools; //< Must outlive the entities
 			std::vector<std::unique_ptr<BaseSystem>> m_systems;
+			std::vector<Nz::Bitset<>> m_systemsByComponent; //< Systems whose filter depends on the component
 			std::vector<EntityBlock> m_entities;
 			std::vector<EntityId> m_freeIdList;
+			std::vector<UpdateStage> m_updateStages;
 			EntityList m_aliveEntities;
 			Nz::Bitset<Nz::UInt64> m_dirtyEntities;
 			Nz::Bitset<Nz::UInt64> m_killedEntities;
+			Nz::Bitset<> m_candidateSystems;
+			Nz::Bitset<> m_refilteredSystems;
+			Nz::Bitset<> m_registeredSystems;
+			Nz::Bitset<> m_unconditionalSystems; //< Systems requiring no component, refiltered for every entity update
+			UpdateStats m_updateStats;
+			bool m_filterIndexUpdated;
+			bool m_parallelUpdate;
+			bool m_updateStagesUpdated;
+			bool m_validateAllEntities;
+			float m_updateElapsedTime;
 	};
 }
 
@@ -7,7 +7,13 @@
 
 namespace Ndk
 {
-	inline World::World(bool addDefaultSystems)
+	inline World::World(bool addDefaultSystems) :
+	m_updateStats(),
+	m_filterIndexUpdated(false),
+	m_parallelUpdate(true),
+	m_updateStagesUpdated(false),
+	m_validateAllEntities(false),
+	m_updateElapsedTime(0.f)
 	{
 		if (addDefaultSystems)
 			AddDefaultSystems();
@@ -28,6 +34,8 @@ namespace Ndk
 		m_systems[index]->SetWorld(*this);
 
 		Invalidate(); // On force une mise à jour de toutes les entités
+		m_filterIndexUpdated = false;
+		m_updateStagesUpdated = false;
 
 		return *m_systems[index].get();
 	}
@@ -42,15 +50,48 @@ namespace Ndk
 		return static_cast<SystemType&>(AddSystem(std::move(ptr)));
 	}
 
-	inline World::EntityList World::CreateEntities(unsigned int count)
+	inline void World::EnableParallelUpdate(bool parallelUpdate)
 	{
-		EntityList list;
-		list.reserve(count);
+		///DOC: Only the systems which declared their accesses are updated concurrently, when they don't conflict
+		if (m_parallelUpdate != parallelUpdate)
+		{
+			m_parallelUpdate = parallelUpdate;
+			m_updateStagesUpdated = false;
+		}
+	}
+
+	template<typename ComponentType, typename... Rest, typename F>
+	void World::ForEach(F&& func)
+	{
+		///DOC: func(Entity&, ComponentType&, Rest&...) must not add nor remove components of the first type
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		// Other components are fetched from their pools by entity id rather than through the entities
+		BaseComponentPool* restPools[] = {nullptr, &GetComponentPool<Rest>()...};
+
+		ForEachInPool<ComponentType, Rest...>(func, std::index_sequence_for<Rest...>(), GetComponentPool<ComponentType>(), &restPools[1]);
+	}
+
+	inline BaseComponentPool& World::GetComponentPool(ComponentIndex index)
+	{
+		// Pools are created on first use, as worlds usually only use a few component types
+		if (index >= m_componentPools.size())
+			m_componentPools.resize(index + 1);
 
-		for (unsigned int i = 0; i < count; ++i)
-			list.emplace_back(CreateEntity());
+		std::unique_ptr<BaseComponentPool>& pool = m_componentPools[index];
+		if (!pool)
+			pool = BaseComponent::CreatePool(index);
 
-		return list;
+		return *pool;
+	}
+
+	template<typename ComponentType>
+	ComponentPool<ComponentType>& World::GetComponentPool()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ComponentIndex index = GetComponentIndex<ComponentType>();
+		return static_cast<ComponentPool<ComponentType>&>(GetComponentPool(index));
 	}
 
 	inline const World::EntityList& World::GetEntities()
@@ -79,6 +120,11 @@ namespace Ndk
 		return static_cast<SystemType&>(GetSystem(index));
 	}
 
+	inline const World::UpdateStats& World::GetUpdateStats() const
+	{
+		return m_updateStats;
+	}
+
 	inline bool World::HasSystem(SystemIndex index) const
 	{
 		return index < m_systems.size() && m_systems[index];
@@ -109,16 +155,27 @@ namespace Ndk
 		return id < m_entities.size() && m_entities[id].entity.IsValid();
 	}
 
+	inline bool World::IsParallelUpdateEnabled() const
+	{
+		return m_parallelUpdate;
+	}
+
 	inline void World::RemoveAllSystems()
 	{
 		m_systems.clear();
+		m_filterIndexUpdated = false;
+		m_updateStagesUpdated = false;
 	}
 
 	inline void World::RemoveSystem(SystemIndex index)
 	{
 		///DOC: N'a aucun effet si le système n'est pas présent
 		if (HasSystem(index))
+		{
 			m_systems[index].reset();
+			m_filterIndexUpdated = false;
+			m_updateStagesUpdated = false;
+		}
 	}
 
 	template<typename SystemType>
@@ -130,26 +187,66 @@ namespace Ndk
 		RemoveSystem(index);
 	}
 
-	inline void World::Update(float elapsedTime)
+	inline void World::Reserve(std::size_t entityCount)
 	{
-		Update(); //< Update entities
-
-		// And then update systems
-		for (auto& systemPtr : m_systems)
-		{
-			if (systemPtr)
-				systemPtr->Update(elapsedTime);
-		}
+		///DOC: Creating entities up to this count then doesn't move the existing ones
+		m_entities.reserve(entityCount);
+		m_aliveEntities.reserve(entityCount);
+		m_dirtyEntities.Reserve(static_cast<unsigned int>(entityCount));
+		m_killedEntities.Reserve(static_cast<unsigned int>(entityCount));
 	}
 
 	inline void World::Invalidate()
 	{
 		m_dirtyEntities.Resize(m_entities.size(), false);
 		m_dirtyEntities.Set(true); // Activation de tous les bits
+
+		m_validateAllEntities = true;
 	}
 
 	inline void World::Invalidate(EntityId id)
 	{
+		///DOC: Every system filter will be tested again for this entity
+		m_dirtyEntities.UnboundedSet(id, true);
+		m_entities[id].validateAllSystems = true;
+	}
+
+	inline void World::InvalidateComponent(EntityId id, ComponentIndex index)
+	{
+		///DOC: Only the filters of the systems depending on this component will be tested again for this entity
 		m_dirtyEntities.UnboundedSet(id, true);
+		m_entities[id].changedComponents.UnboundedSet(index, true);
+	}
+
+	inline void World::InvalidateSystemFilter()
+	{
+		// A system filter changed after it was added, the index and every entity membership are outdated
+		Invalidate();
+		m_filterIndexUpdated = false;
+		m_updateStagesUpdated = false;
+	}
+
+	template<typename ComponentType, typename... Rest, typename F, std::size_t... Indices>
+	void World::ForEachInPool(F& func, std::index_sequence<Indices...>, ComponentPool<ComponentType>& pool, BaseComponentPool* const* restPools)
+	{
+		pool.ForEach([&func, restPools] (ComponentType& component)
+		{
+			// Components of dead entities are released, so every pooled component has a valid owner
+			Entity* entity = component.GetEntity();
+			NazaraAssert(entity && entity->IsValid(), "Pooled component has no valid entity");
+
+			if (!entity->IsEnabled())
+				return;
+
+			EntityId id = entity->GetId();
+			BaseComponent* restComponents[] = {nullptr, restPools[Indices]->Find(id)...};
+			for (std::size_t i = 1; i < sizeof...(Rest) + 1; ++i)
+			{
+				if (!restComponents[i])
+					return;
+			}
+
+			func(*entity, component, static_cast<Rest&>(*restComponents[Indices + 1])...);
+		});
 	}
 }
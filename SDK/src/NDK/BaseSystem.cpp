@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/BaseSystem.hpp>
+#include <NDK/World.hpp>
 
 namespace Ndk
 {
@@ -19,13 +20,9 @@ namespace Ndk
 
 		const Nz::Bitset<>& components = entity->GetComponentBits();
 
-		m_filterResult.PerformsAND(m_requiredComponents, components);
-		if (m_filterResult !=  m_requiredComponents)
-			return false; // Au moins un component requis n'est pas présent
-
-		m_filterResult.PerformsAND(m_excludedComponents, components);
-		if (m_filterResult.TestAny())
-			return false; // Au moins un component exclu est présent
+		// Every required component must be present, and none of the excluded ones
+		if (!components.Matches(m_requiredComponents, m_excludedComponents))
+			return false;
 
 		// Si nous avons une liste de composants nécessaires
 		if (m_requiredAnyComponents.TestAny())
@@ -37,6 +34,22 @@ namespace Ndk
 		return true;
 	}
 
+	void BaseSystem::ApplyCommands()
+	{
+		for (EntityCommandBuffer& commands : m_commandBuffers)
+		{
+			if (!commands.IsEmpty())
+				commands.Apply();
+		}
+	}
+
+	void BaseSystem::InvalidateFilter()
+	{
+		// Filters are usually set by the constructor, before the system is added to a world
+		if (m_world)
+			m_world->InvalidateSystemFilter();
+	}
+
 	void BaseSystem::OnEntityAdded(Entity* entity)
 	{
 		NazaraUnused(entity);
@@ -53,5 +66,35 @@ namespace Ndk
 		NazaraUnused(justAdded);
 	}
 
+	void BaseSystem::RemoveEntities(const Nz::Bitset<Nz::UInt64>& entities)
+	{
+		if (!m_entityBits.Intersects(entities))
+			return;
+
+		std::vector<Entity*> removedEntities;
+		for (std::size_t i = m_entities.size(); i > 0; --i)
+		{
+			EntityHandle& handle = m_entities[i - 1];
+			if (!entities.UnboundedTest(handle->GetId()))
+				continue;
+
+			removedEntities.push_back(handle);
+
+			// Same swap and pop as RemoveEntity, going backward the swapped handle has already been tested
+			if (i < m_entities.size())
+				std::swap(handle, m_entities.back());
+
+			m_entities.pop_back();
+		}
+
+		for (Entity* entity : removedEntities)
+		{
+			m_entityBits.Reset(entity->GetId());
+			entity->UnregisterSystem(m_systemIndex);
+
+			OnEntityRemoved(entity);
+		}
+	}
+
 	SystemIndex BaseSystem::s_nextIndex;
 }
@@ -0,0 +1,19 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/ComponentPool.hpp>
+#include <NDK/BaseComponent.hpp>
+
+namespace Ndk
+{
+	BaseComponentPool::~BaseComponentPool() = default;
+
+	void ComponentDeleter::operator()(BaseComponent* component) const
+	{
+		if (pool)
+			pool->Delete(component);
+		else
+			delete component;
+	}
+}
@@ -38,29 +38,12 @@ namespace Ndk
 	{
 		NazaraAssert(componentPtr, "Component must be valid");
 
-		ComponentIndex index = componentPtr->GetIndex();
-
-		// Nous nous assurons que le vecteur de component est suffisamment grand pour contenir le nouveau component
-		if (index >= m_components.size())
-			m_components.resize(index + 1);
-
-		// Affectation et retour du component
-		m_components[index] = std::move(componentPtr);
-		m_componentBits.UnboundedSet(index);
-
-		Invalidate();
-
-		// On récupère le component et on informe les composants existants du nouvel arrivant
-		BaseComponent& component = *m_components[index].get();
-		component.SetEntity(this);
+		// The world pool of its type takes ownership of the component, which stays where it is
+		BaseComponentPool& pool = GetComponentPool(componentPtr->GetIndex());
 
-		for (unsigned int i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
-		{
-			if (i != index)
-				m_components[i]->OnComponentAttached(component);
-		}
+		ComponentPtr component(pool.Adopt(std::move(componentPtr)), ComponentDeleter(&pool));
 
-		return component;
+		return AttachComponent(std::move(component));
 	}
 
 	EntityHandle Entity::CreateHandle()
@@ -87,8 +70,6 @@ namespace Ndk
 		NazaraAssert(m_componentBits.TestNone(), "All components should be gone");
 
 		m_components.clear();
-
-		Invalidate();
 	}
 
 	void Entity::RemoveComponent(ComponentIndex index)
@@ -106,11 +87,41 @@ namespace Ndk
 
 			component.SetEntity(nullptr);
 
+			m_components[index].get_deleter().pool->Unbind(m_id, &component);
 			m_components[index].reset();
 			m_componentBits.Reset(index);
 
-			Invalidate();
+			m_world->InvalidateComponent(m_id, index);
+		}
+	}
+
+	BaseComponent& Entity::AttachComponent(ComponentPtr&& componentPtr)
+	{
+		ComponentIndex index = componentPtr->GetIndex();
+
+		// Nous nous assurons que le vecteur de component est suffisamment grand pour contenir le nouveau component
+		if (index >= m_components.size())
+			m_components.resize(index + 1);
+
+		// Affectation et retour du component
+		m_components[index] = std::move(componentPtr);
+		m_componentBits.UnboundedSet(index);
+
+		m_world->InvalidateComponent(m_id, index);
+
+		// On récupère le component et on informe les composants existants du nouvel arrivant
+		BaseComponent& component = *m_components[index].get();
+		component.SetEntity(this);
+
+		m_components[index].get_deleter().pool->Bind(m_id, &component);
+
+		for (unsigned int i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
+		{
+			if (i != index)
+				m_components[i]->OnComponentAttached(component);
 		}
+
+		return component;
 	}
 
 	void Entity::Create()
@@ -132,6 +143,18 @@ namespace Ndk
 		}
 		m_systemBits.Clear();
 
+		// Components go back to the world pools, a recycled id must not inherit them
+		for (ComponentPtr& component : m_components)
+		{
+			if (component)
+			{
+				component->SetEntity(nullptr);
+				component.get_deleter().pool->Unbind(m_id, component.get());
+			}
+		}
+		m_components.clear();
+		m_componentBits.Clear();
+
 		// On informe chaque handle de notre destruction pour éviter qu'il ne continue de pointer sur nous
 		for (EntityHandle* handle : m_handles)
 			handle->OnEntityDestroyed();
@@ -140,4 +163,9 @@ namespace Ndk
 
 		m_valid = false;
 	}
+
+	BaseComponentPool& Entity::GetComponentPool(ComponentIndex index) const
+	{
+		return m_world->GetComponentPool(index);
+	}
 }
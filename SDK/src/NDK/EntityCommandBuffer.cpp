@@ -0,0 +1,121 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/EntityCommandBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NDK/Entity.hpp>
+#include <NDK/World.hpp>
+
+namespace Ndk
+{
+	void EntityCommandBuffer::AddComponent(Entity* entity, std::unique_ptr<BaseComponent>&& component)
+	{
+		NazaraAssert(entity, "Invalid entity");
+		NazaraAssert(component, "Component must be valid");
+
+		m_commands.emplace_back();
+
+		Command& command = m_commands.back();
+		command.component = std::move(component);
+		command.createdEntity = false;
+		command.entityId = entity->GetId();
+		command.type = CommandType_AddComponent;
+		command.world = entity->GetWorld();
+	}
+
+	void EntityCommandBuffer::Apply()
+	{
+		///DOC: A buffer must be applied before the world updates its entities again
+		EntityHandle createdEntity;
+		for (Command& command : m_commands)
+		{
+			if (command.type == CommandType_CreateEntity)
+			{
+				createdEntity = command.world->CreateEntity();
+				continue;
+			}
+
+			// Entities are referenced by id, creating one may move the others
+			Entity* entity;
+			if (command.createdEntity)
+				entity = createdEntity;
+			else if (command.world->IsEntityIdValid(command.entityId))
+				entity = command.world->GetEntity(command.entityId);
+			else
+				continue;
+
+			switch (command.type)
+			{
+				case CommandType_AddComponent:
+					entity->AddComponent(std::move(command.component));
+					break;
+
+				case CommandType_CreateEntity:
+					break;
+
+				case CommandType_Kill:
+					entity->Kill();
+					break;
+
+				case CommandType_RemoveComponent:
+					entity->RemoveComponent(command.componentIndex);
+					break;
+			}
+		}
+
+		m_commands.clear();
+	}
+
+	void EntityCommandBuffer::CreateEntity(World* world, std::vector<std::unique_ptr<BaseComponent>>&& components)
+	{
+		///DOC: The entity is created with its components when the buffer is applied
+		NazaraAssert(world, "Invalid world");
+
+		m_commands.emplace_back();
+
+		Command& command = m_commands.back();
+		command.type = CommandType_CreateEntity;
+		command.world = world;
+
+		for (std::unique_ptr<BaseComponent>& component : components)
+		{
+			NazaraAssert(component, "Component must be valid");
+
+			m_commands.emplace_back();
+
+			Command& componentCommand = m_commands.back();
+			componentCommand.component = std::move(component);
+			componentCommand.createdEntity = true;
+			componentCommand.type = CommandType_AddComponent;
+			componentCommand.world = world;
+		}
+	}
+
+	void EntityCommandBuffer::Kill(Entity* entity)
+	{
+		NazaraAssert(entity, "Invalid entity");
+
+		m_commands.emplace_back();
+
+		Command& command = m_commands.back();
+		command.createdEntity = false;
+		command.entityId = entity->GetId();
+		command.type = CommandType_Kill;
+		command.world = entity->GetWorld();
+	}
+
+	void EntityCommandBuffer::RemoveComponent(Entity* entity, ComponentIndex index)
+	{
+		NazaraAssert(entity, "Invalid entity");
+
+		m_commands.emplace_back();
+
+		Command& command = m_commands.back();
+		command.componentIndex = index;
+		command.createdEntity = false;
+		command.entityId = entity->GetId();
+		command.type = CommandType_RemoveComponent;
+		command.world = entity->GetWorld();
+	}
+}
@@ -6,6 +6,7 @@
 #include <Nazara/Audio/Audio.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Lua/Lua.hpp>
 #include <Nazara/Noise/Noise.hpp>
@@ -55,6 +56,7 @@ namespace Ndk
 			#endif
 
 			// SDK Initialization
+			Nz::MemoryTagScope memoryTag(Nz::MemoryTag_SDK);
 
 			// Components
 			BaseComponent::Initialize();
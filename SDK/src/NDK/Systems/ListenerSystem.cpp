@@ -4,6 +4,7 @@
 
 #include <NDK/Systems/ListenerSystem.hpp>
 #include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <NDK/Components/ListenerComponent.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
@@ -13,10 +14,14 @@ namespace Ndk
 	ListenerSystem::ListenerSystem()
 	{
 		Requires<ListenerComponent, NodeComponent>();
+		Reads<VelocityComponent>();
+		Writes<NodeComponent>(); // Reading a node may update its cached transformations
 	}
 
 	void ListenerSystem::OnUpdate(float elapsedTime)
 	{
+		NazaraProfileZone("ListenerSystem::OnUpdate");
+
 		NazaraUnused(elapsedTime);
 
 		unsigned int activeListenerCount = 0;
@@ -4,6 +4,7 @@
 
 #include <NDK/Systems/PhysicsSystem.hpp>
 #include <Nazara/Physics/PhysObject.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <NDK/Components/CollisionComponent.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
@@ -14,6 +15,7 @@ namespace Ndk
 	{
 		Requires<NodeComponent>();
 		RequiresAny<CollisionComponent, PhysicsComponent>();
+		Writes<CollisionComponent, NodeComponent, PhysicsComponent>();
 	}
 
 	PhysicsSystem::PhysicsSystem(const PhysicsSystem& system) :
@@ -38,6 +40,8 @@ namespace Ndk
 
 	void PhysicsSystem::OnUpdate(float elapsedTime)
 	{
+		NazaraProfileZone("PhysicsSystem::OnUpdate");
+
 		m_world.Step(elapsedTime);
 
 		for (const Ndk::EntityHandle& entity : m_dynamicObjects)
@@ -4,6 +4,7 @@
 
 #include <NDK/Systems/RenderSystem.hpp>
 #include <Nazara/Graphics/ColorBackground.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <NDK/Components/CameraComponent.hpp>
 #include <NDK/Components/GraphicsComponent.hpp>
 #include <NDK/Components/LightComponent.hpp>
@@ -54,6 +55,8 @@ namespace Ndk
 
 	void RenderSystem::OnUpdate(float elapsedTime)
 	{
+		NazaraProfileZone("RenderSystem::OnUpdate");
+
 		NazaraUnused(elapsedTime);
 
 		// Invalidate every renderable if the coordinate system changed
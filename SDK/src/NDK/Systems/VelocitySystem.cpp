@@ -3,9 +3,11 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/Systems/VelocitySystem.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/World.hpp>
 
 namespace Ndk
 {
@@ -13,17 +15,21 @@ namespace Ndk
 	{
 		Requires<NodeComponent, VelocityComponent>();
 		Excludes<PhysicsComponent>();
+		Reads<VelocityComponent>();
+		Writes<NodeComponent>();
 	}
 
 	void VelocitySystem::OnUpdate(float elapsedTime)
 	{
-		for (const Ndk::EntityHandle& entity : GetEntities())
-		{
-			NodeComponent& node = entity->GetComponent<NodeComponent>();
-			const VelocityComponent& velocity = entity->GetComponent<VelocityComponent>();
+		NazaraProfileZone("VelocitySystem::OnUpdate");
 
-			node.Move(velocity.linearVelocity * elapsedTime);
-		}
+		// Walk the velocity components in storage order rather than chasing each entity components
+		GetWorld().ForEach<VelocityComponent, NodeComponent>([this, elapsedTime] (Entity& entity, const VelocityComponent& velocity, NodeComponent& node)
+		{
+			// Entities driven by physics are excluded from this system
+			if (HasEntity(&entity))
+				node.Move(velocity.linearVelocity * elapsedTime);
+		});
 	}
 
 	SystemIndex VelocitySystem::systemIndex;
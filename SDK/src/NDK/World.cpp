@@ -3,7 +3,10 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/World.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
 
@@ -59,6 +62,47 @@ namespace Ndk
 		return m_aliveEntities.back();
 	}
 
+	World::EntityList World::CreateEntities(unsigned int count)
+	{
+		std::size_t recycledCount = std::min<std::size_t>(count, m_freeIdList.size());
+		Reserve(m_entities.size() + count - recycledCount);
+
+		EntityList list;
+		list.reserve(count);
+
+		for (unsigned int i = 0; i < count; ++i)
+			list.emplace_back(CreateEntity());
+
+		return list;
+	}
+
+	World::EntityList World::CreateEntities(unsigned int count, const Entity* prototype)
+	{
+		///DOC: Creates entities having a copy of every component of prototype (which may belong to another world)
+		NazaraAssert(prototype, "Invalid prototype");
+
+		// Creating the entities may move the prototype (if it belongs to this world), but not its components which live in pools
+		std::vector<const BaseComponent*> prototypeComponents;
+
+		const Nz::Bitset<>& componentBits = prototype->GetComponentBits();
+		for (unsigned int index = componentBits.FindFirst(); index != componentBits.npos; index = componentBits.FindNext(index))
+			prototypeComponents.push_back(prototype->m_components[index].get());
+
+		EntityList list = CreateEntities(count);
+
+		std::vector<BaseComponent*> clones(count);
+		for (const BaseComponent* component : prototypeComponents)
+		{
+			BaseComponentPool& pool = GetComponentPool(component->GetIndex());
+			pool.Clone(*component, clones.data(), count);
+
+			for (unsigned int i = 0; i < count; ++i)
+				list[i]->AttachComponent(ComponentPtr(clones[i], ComponentDeleter(&pool)));
+		}
+
+		return list;
+	}
+
 	void World::Clear()
 	{
 		///DOC: Tous les handles sont correctement invalidés
@@ -93,7 +137,19 @@ namespace Ndk
 
 	void World::Update()
 	{
+		NazaraProfileZone("World::Update (entities)");
+
 		// Gestion des entités tuées depuis le dernier appel
+		if (m_killedEntities.TestAny())
+		{
+			// Each system drops its killed entities in a single pass, their destruction then has no system to notify
+			for (auto& system : m_systems)
+			{
+				if (system)
+					system->RemoveEntities(m_killedEntities);
+			}
+		}
+
 		for (unsigned int i = m_killedEntities.FindFirst(); i != m_killedEntities.npos; i = m_killedEntities.FindNext(i))
 		{
 			EntityBlock& block = m_entities[i];
@@ -127,42 +183,215 @@ namespace Ndk
 		m_killedEntities.Reset();
 
 		// Gestion des entités nécessitant une mise à jour de leurs systèmes
+		if (!m_filterIndexUpdated)
+			BuildFilterIndex();
+
+		m_updateStats.filterEvaluations = 0;
+
 		for (unsigned int i = m_dirtyEntities.FindFirst(); i != m_dirtyEntities.npos; i = m_dirtyEntities.FindNext(i))
 		{
 			NazaraAssert(i < m_entities.size(), "Entity index out of range");
 
-			Entity* entity = &m_entities[i].entity;
+			EntityBlock& block = m_entities[i];
+			Entity* entity = &block.entity;
 
 			// Check entity validity (as it could have been reported as dirty and killed during the same iteration)
-			if (!entity->IsValid())
+			if (entity->IsValid())
+			{
+				// Only the systems depending on a changed component may filter the entity differently
+				if (m_validateAllEntities || block.validateAllSystems)
+					m_refilteredSystems = m_registeredSystems;
+				else
+				{
+					m_refilteredSystems = m_unconditionalSystems;
+					for (unsigned int index = block.changedComponents.FindFirst(); index != block.changedComponents.npos; index = block.changedComponents.FindNext(index))
+					{
+						if (index < m_systemsByComponent.size())
+							m_refilteredSystems |= m_systemsByComponent[index];
+					}
+				}
+
+				// Systems already owning the entity are validated again even if their filter is unaffected
+				m_candidateSystems.PerformsOR(m_refilteredSystems, entity->GetSystemBits());
+
+				for (unsigned int index = m_candidateSystems.FindFirst(); index != m_candidateSystems.npos; index = m_candidateSystems.FindNext(index))
+				{
+					NazaraAssert(HasSystem(index), "Entity is part of a removed system");
+
+					BaseSystem* system = m_systems[index].get();
+
+					// Is our entity already part of this system?
+					bool partOfSystem = system->HasEntity(entity);
+
+					// Should it be part of it? (an unaffected filter keeps its result, enabling an entity validates all systems)
+					bool filtered = true;
+					if (m_refilteredSystems.Test(index))
+					{
+						filtered = entity->IsEnabled() && system->Filters(entity);
+						m_updateStats.filterEvaluations++;
+					}
+
+					if (filtered)
+					{
+						// Yes it should, add it to the system if not already done and validate it (again)
+						if (!partOfSystem)
+							system->AddEntity(entity);
+
+						system->ValidateEntity(entity, !partOfSystem);
+					}
+					else
+					{
+						// No, it shouldn't, remove it if it's part of the system
+						if (partOfSystem)
+							system->RemoveEntity(entity);
+					}
+				}
+			}
+
+			block.changedComponents.Reset();
+			block.validateAllSystems = false;
+		}
+		m_dirtyEntities.Reset();
+		m_validateAllEntities = false;
+	}
+
+	void World::Update(float elapsedTime)
+	{
+		NazaraProfileZone("World::Update");
+		Nz::MemoryTagScope memoryTag(Nz::MemoryTag_SDK);
+
+		Update(); //< Update entities
+
+		// And then update systems
+		if (!m_updateStagesUpdated)
+			BuildUpdateStages();
+
+		m_updateElapsedTime = elapsedTime;
+
+		Nz::UInt64 startTime = Nz::GetElapsedMicroseconds();
+		for (UpdateStage& stage : m_updateStages)
+		{
+			if (stage.graph)
+			{
+				stage.graph->Execute();
+
+				// Structural changes recorded by the systems of the stage are applied once they're all done
+				for (BaseSystem* system : stage.systems)
+					system->ApplyCommands();
+			}
+			else
+				stage.systems.front()->Update(elapsedTime);
+		}
+		m_updateStats.updateTime = Nz::GetElapsedMicroseconds() - startTime;
+
+		m_updateStats.systemTime = 0;
+		for (const UpdateStage& stage : m_updateStages)
+		{
+			for (BaseSystem* system : stage.systems)
+				m_updateStats.systemTime += system->GetLastUpdateTime();
+		}
+
+		m_updateStats.parallelism = (m_updateStats.updateTime > 0) ? static_cast<float>(m_updateStats.systemTime) / m_updateStats.updateTime : 1.f;
+		m_updateStats.stageCount = static_cast<unsigned int>(m_updateStages.size());
+	}
+
+	void World::BuildFilterIndex()
+	{
+		// Maps every component to the systems filtering on it, a component change then only concerns these systems
+		// Systems requiring no component may filter any entity (even one without components) and are always concerned
+		SystemIndex systemCount = static_cast<SystemIndex>(m_systems.size());
+
+		m_registeredSystems.Clear();
+		m_registeredSystems.Resize(systemCount, false);
+		m_systemsByComponent.clear();
+		m_unconditionalSystems.Clear();
+		m_unconditionalSystems.Resize(systemCount, false);
+
+		for (SystemIndex index = 0; index < systemCount; ++index)
+		{
+			BaseSystem* system = m_systems[index].get();
+			if (!system)
 				continue;
 
-			for (auto& system : m_systems)
+			m_registeredSystems.Set(index, true);
+
+			if (system->m_requiredComponents.TestNone() && system->m_requiredAnyComponents.TestNone())
+				m_unconditionalSystems.Set(index, true);
+
+			auto registerDependency = [this, index, systemCount] (unsigned int componentIndex)
+			{
+				if (componentIndex >= m_systemsByComponent.size())
+					m_systemsByComponent.resize(componentIndex + 1, Nz::Bitset<>(systemCount, false));
+
+				m_systemsByComponent[componentIndex].Set(index, true);
+			};
+
+			system->m_excludedComponents.ForEachSetBit(registerDependency);
+			system->m_requiredAnyComponents.ForEachSetBit(registerDependency);
+			system->m_requiredComponents.ForEachSetBit(registerDependency);
+		}
+
+		m_filterIndexUpdated = true;
+	}
+
+	void World::BuildUpdateStages()
+	{
+		// Consecutive systems having declared their accesses are gathered in a stage run as a task graph,
+		// other systems get a stage of their own and are updated by the calling thread (rendering needs it)
+		m_updateStages.clear();
+
+		bool parallelStageOpen = false;
+		for (auto& systemPtr : m_systems)
+		{
+			if (!systemPtr)
+				continue;
+
+			systemPtr->SetDeferredCommands(false);
+
+			bool parallelSystem = m_parallelUpdate && systemPtr->HasDeclaredAccesses();
+			if (!parallelSystem || !parallelStageOpen)
+				m_updateStages.emplace_back();
+
+			// Component pools are created on first use, which must not happen from concurrent systems
+			if (parallelSystem)
 			{
-				// Ignore non-existent systems
-				if (!system)
-					continue;
+				auto createPool = [this] (unsigned int index) { GetComponentPool(index); };
+				systemPtr->GetReadComponents().ForEachSetBit(createPool);
+				systemPtr->GetWrittenComponents().ForEachSetBit(createPool);
+				systemPtr->m_requiredComponents.ForEachSetBit(createPool);
+				systemPtr->m_requiredAnyComponents.ForEachSetBit(createPool);
+			}
+
+			m_updateStages.back().systems.push_back(systemPtr.get());
+			parallelStageOpen = parallelSystem;
+		}
 
-				// Is our entity already part of this system?
-				bool partOfSystem = system->HasEntity(entity);
+		for (UpdateStage& stage : m_updateStages)
+		{
+			if (stage.systems.size() < 2)
+				continue;
 
-				// Should it be part of it?
-				if (entity->IsEnabled() && system->Filters(entity))
+			stage.graph.reset(new Nz::TaskGraph);
+			for (std::size_t i = 0; i < stage.systems.size(); ++i)
+			{
+				BaseSystem* system = stage.systems[i];
+				system->SetDeferredCommands(true);
+
+				Nz::TaskGraph::TaskId task = stage.graph->AddTask([this, system]()
 				{
-					// Yes it should, add it to the system if not already done and validate it (again)
-					if (!partOfSystem)
-						system->AddEntity(entity);
+					Nz::MemoryTagScope memoryTag(Nz::MemoryTag_SDK);
+					system->Update(m_updateElapsedTime);
+				});
 
-					system->ValidateEntity(entity, !partOfSystem);
-				}
-				else
+				// A system waits for the previous systems it conflicts with, keeping the index order (task ids match stage indices)
+				for (std::size_t j = 0; j < i; ++j)
 				{
-					// No, it shouldn't, remove it if it's part of the system
-					if (partOfSystem)
-						system->RemoveEntity(entity);
+					if (system->ConflictsWith(*stage.systems[j]))
+						stage.graph->AddDependency(task, j);
 				}
 			}
 		}
-		m_dirtyEntities.Reset();
+
+		m_updateStagesUpdated = true;
 	}
 }
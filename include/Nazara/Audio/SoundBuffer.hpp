@@ -91,6 +91,7 @@ namespace Nz
 			static SoundBufferLoader::LoaderList s_loaders;
 			static SoundBufferManager::ManagerMap s_managerMap;
 			static SoundBufferManager::ManagerParams s_managerParameters;
+			static SoundBufferManager::ManagerState s_managerState;
 	};
 }
 
@@ -31,11 +31,16 @@
 
 #include <Nazara/Core/AbstractHash.hpp>
 #include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/AssetCache.hpp>
+#include <Nazara/Core/AsyncFileService.hpp>
+#include <Nazara/Core/AsyncLogger.hpp>
 #include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteChain.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Color.hpp>
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
 #include <Nazara/Core/ConditionVariable.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Core.hpp>
@@ -52,6 +57,7 @@
 #include <Nazara/Core/Initializer.hpp>
 #include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
 #include <Nazara/Core/MemoryHelper.hpp>
 #include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Core/MemoryPool.hpp>
@@ -60,10 +66,12 @@
 #include <Nazara/Core/ObjectLibrary.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/OffsetOf.hpp>
+#include <Nazara/Core/Parallel.hpp>
 #include <Nazara/Core/ParameterList.hpp>
 #include <Nazara/Core/PluginManager.hpp>
 #include <Nazara/Core/Primitive.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Core/RefCounted.hpp>
 #include <Nazara/Core/Resource.hpp>
 #include <Nazara/Core/ResourceLoader.hpp>
@@ -73,9 +81,12 @@
 #include <Nazara/Core/Serializer.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Core/SparsePtr.hpp>
+#include <Nazara/Core/StackArena.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Core/StringAtom.hpp>
 #include <Nazara/Core/StringStream.hpp>
+#include <Nazara/Core/TaskGraph.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Thread.hpp>
 #include <Nazara/Core/Unicode.hpp>
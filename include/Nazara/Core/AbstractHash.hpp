@@ -33,6 +33,7 @@ namespace Nz
 			AbstractHash& operator=(const AbstractHash&) = delete;
 			AbstractHash& operator=(AbstractHash&&) = default;
 
+			static void ComputeMany(HashType type, const UInt8* const* data, const std::size_t* sizes, std::size_t count, ByteArray* digests);
 			static std::unique_ptr<AbstractHash> Get(HashType hash);
 	};
 }
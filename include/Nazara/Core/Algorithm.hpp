@@ -41,10 +41,30 @@ namespace Nz
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Serialize(SerializationContext& context, T value);
 
+	inline bool SerializeBits(SerializationContext& context, UInt64 value, unsigned int bitCount);
+	template<typename T> bool SerializeDelta(SerializationContext& context, const T& value, const T& baseline);
+	inline bool SerializeQuantized(SerializationContext& context, float value, float min, float max, unsigned int bitCount);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, bool> SerializeVarInt(SerializationContext& context, T value);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool> SerializeZigZag(SerializationContext& context, T value);
+
 	inline bool Unserialize(UnserializationContext& context, bool* value);
 
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Unserialize(UnserializationContext& context, T* value);
+
+	inline bool UnserializeBits(UnserializationContext& context, UInt64* value, unsigned int bitCount);
+	template<typename T> bool UnserializeDelta(UnserializationContext& context, T* value, const T& baseline);
+	inline bool UnserializeQuantized(UnserializationContext& context, float* value, float min, float max, unsigned int bitCount);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, bool> UnserializeVarInt(UnserializationContext& context, T* value);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool> UnserializeZigZag(UnserializationContext& context, T* value);
 }
 
 #include <Nazara/Core/Algorithm.inl>
@@ -10,6 +10,9 @@
 #include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -28,6 +31,101 @@ namespace Nz
 		{
 			return (object .* std::forward<F>(fn))(std::get<S>(std::forward<Tuple>(t))...);
 		}
+
+		inline bool FlushBits(SerializationContext& context)
+		{
+			if (context.currentBitPos != 8)
+			{
+				context.currentBitPos = 8;
+
+				return Serialize<UInt8>(context, context.currentByte);
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		bool SerializeDelta(SerializationContext& context, const T& value, const T& baseline, std::true_type)
+		{
+			// Integers are sent as the (wrapping) difference with the baseline, small changes take a single byte
+			using Signed = std::make_signed_t<T>;
+
+			return SerializeZigZag(context, static_cast<Signed>(static_cast<T>(value - baseline)));
+		}
+
+		template<typename T>
+		bool SerializeDelta(SerializationContext& context, const T& value, const T& baseline, std::false_type)
+		{
+			// Other types are compared byte per byte: one bit if unchanged, else one bit per byte followed by the changed bytes
+			const UInt8* valueBytes = reinterpret_cast<const UInt8*>(&value);
+			const UInt8* baselineBytes = reinterpret_cast<const UInt8*>(&baseline);
+
+			bool changed = (std::memcmp(valueBytes, baselineBytes, sizeof(T)) != 0);
+			if (!Serialize(context, changed))
+				return false;
+
+			if (!changed)
+				return true;
+
+			for (std::size_t i = 0; i < sizeof(T); ++i)
+			{
+				bool byteChanged = (valueBytes[i] != baselineBytes[i]);
+				if (!Serialize(context, byteChanged))
+					return false;
+
+				if (byteChanged && !SerializeBits(context, valueBytes[i], 8))
+					return false;
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		bool UnserializeDelta(UnserializationContext& context, T* value, const T& baseline, std::true_type)
+		{
+			using Signed = std::make_signed_t<T>;
+
+			Signed delta;
+			if (!UnserializeZigZag(context, &delta))
+				return false;
+
+			*value = static_cast<T>(baseline + static_cast<T>(delta));
+			return true;
+		}
+
+		template<typename T>
+		bool UnserializeDelta(UnserializationContext& context, T* value, const T& baseline, std::false_type)
+		{
+			bool changed;
+			if (!Unserialize(context, &changed))
+				return false;
+
+			*value = baseline;
+			if (!changed)
+				return true;
+
+			UInt8* valueBytes = reinterpret_cast<UInt8*>(value);
+			for (std::size_t i = 0; i < sizeof(T); ++i)
+			{
+				bool byteChanged;
+				if (!Unserialize(context, &byteChanged))
+					return false;
+
+				if (byteChanged)
+				{
+					UInt64 byte;
+					if (!UnserializeBits(context, &byte, 8))
+						return false;
+
+					valueBytes[i] = static_cast<UInt8>(byte);
+				}
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		struct IsDeltaInteger : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value> {};
 	}
 
 	template<typename F, typename Tuple>
@@ -131,6 +229,90 @@ namespace Nz
 		return context.stream->Write(&value, sizeof(T)) == sizeof(T);
 	}
 
+	inline bool SerializeBits(SerializationContext& context, UInt64 value, unsigned int bitCount)
+	{
+		///DOC: The bits share the stream of the booleans, least significant bit first
+		NazaraAssert(bitCount <= 64, "Bit count must be between 0 and 64");
+
+		while (bitCount > 0)
+		{
+			if (context.currentBitPos == 8)
+			{
+				context.currentBitPos = 0;
+				context.currentByte = 0;
+			}
+
+			unsigned int count = std::min(bitCount, 8U - context.currentBitPos);
+			context.currentByte |= static_cast<UInt8>((value & ((1U << count) - 1U)) << context.currentBitPos);
+
+			value >>= count;
+			bitCount -= count;
+			context.currentBitPos += static_cast<UInt8>(count);
+
+			if (context.currentBitPos == 8 && !Serialize<UInt8>(context, context.currentByte))
+				return false;
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	bool SerializeDelta(SerializationContext& context, const T& value, const T& baseline)
+	{
+		///DOC: Non-integer types are compared bitwise, padding bytes should be zeroed to avoid sending them
+		static_assert(std::is_trivially_copyable<T>::value, "Delta encoding requires a trivially copyable type");
+
+		return Detail::SerializeDelta(context, value, baseline, Detail::IsDeltaInteger<T>());
+	}
+
+	inline bool SerializeQuantized(SerializationContext& context, float value, float min, float max, unsigned int bitCount)
+	{
+		///DOC: Maps value from [min, max] (clamped) to a bitCount bits integer, the precision being (max - min) / (2^bitCount - 1)
+		NazaraAssert(min < max, "Invalid range");
+		NazaraAssert(bitCount > 0 && bitCount <= 32, "Bit count must be between 1 and 32");
+
+		if (value > max)
+			value = max;
+		else if (!(value >= min)) //< Handles NaN as well
+			value = min;
+
+		UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+		double normalized = (static_cast<double>(value) - min) / (static_cast<double>(max) - min);
+
+		return SerializeBits(context, static_cast<UInt64>(std::round(normalized * maxValue)), bitCount);
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, bool> SerializeVarInt(SerializationContext& context, T value)
+	{
+		UInt8 buffer[(sizeof(T) * 8 + 6) / 7];
+		std::size_t size = 0;
+		do
+		{
+			UInt8 byte = static_cast<UInt8>(value & 0x7F);
+			value = static_cast<T>(value >> 7);
+			if (value != 0)
+				byte |= 0x80;
+
+			buffer[size++] = byte;
+		}
+		while (value != 0);
+
+		if (!Detail::FlushBits(context))
+			return false;
+
+		return context.stream->Write(buffer, size) == size;
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool> SerializeZigZag(SerializationContext& context, T value)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+
+		Unsigned sign = static_cast<Unsigned>(value >> (sizeof(T) * 8 - 1));
+		return SerializeVarInt(context, static_cast<Unsigned>(static_cast<Unsigned>(static_cast<Unsigned>(value) << 1) ^ sign));
+	}
+
 	inline bool Unserialize(UnserializationContext& context, bool* value)
 	{
 		NazaraAssert(value, "Invalid data pointer");
@@ -169,6 +351,111 @@ namespace Nz
 		else
 			return false;
 	}
+
+	inline bool UnserializeBits(UnserializationContext& context, UInt64* value, unsigned int bitCount)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+		NazaraAssert(bitCount <= 64, "Bit count must be between 0 and 64");
+
+		UInt64 result = 0;
+		unsigned int shift = 0;
+		while (shift < bitCount)
+		{
+			if (context.currentBitPos == 8)
+			{
+				if (!Unserialize(context, &context.currentByte))
+					return false;
+
+				context.currentBitPos = 0;
+			}
+
+			unsigned int count = std::min(bitCount - shift, 8U - context.currentBitPos);
+			UInt64 bits = (context.currentByte >> context.currentBitPos) & ((1U << count) - 1U);
+			result |= bits << shift;
+
+			shift += count;
+			context.currentBitPos += static_cast<UInt8>(count);
+		}
+
+		*value = result;
+		return true;
+	}
+
+	template<typename T>
+	bool UnserializeDelta(UnserializationContext& context, T* value, const T& baseline)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+		static_assert(std::is_trivially_copyable<T>::value, "Delta encoding requires a trivially copyable type");
+
+		return Detail::UnserializeDelta(context, value, baseline, Detail::IsDeltaInteger<T>());
+	}
+
+	inline bool UnserializeQuantized(UnserializationContext& context, float* value, float min, float max, unsigned int bitCount)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+		NazaraAssert(min < max, "Invalid range");
+		NazaraAssert(bitCount > 0 && bitCount <= 32, "Bit count must be between 1 and 32");
+
+		UInt64 quantized;
+		if (!UnserializeBits(context, &quantized, bitCount))
+			return false;
+
+		UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+		*value = static_cast<float>(min + (static_cast<double>(max) - min) * quantized / maxValue);
+
+		return true;
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, bool> UnserializeVarInt(UnserializationContext& context, T* value)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+
+		// Reset bit position
+		context.currentBitPos = 8;
+
+		constexpr unsigned int bitCount = sizeof(T) * 8;
+
+		T result = 0;
+		unsigned int shift = 0;
+		for (;;)
+		{
+			UInt8 byte;
+			if (context.stream->Read(&byte, 1) != 1)
+				return false;
+
+			// Reject encodings overflowing T
+			UInt8 bits = byte & 0x7F;
+			if (shift >= bitCount || (shift + 7 > bitCount && (bits >> (bitCount - shift)) != 0))
+				return false;
+
+			result |= static_cast<T>(static_cast<T>(bits) << shift);
+			shift += 7;
+
+			if ((byte & 0x80) == 0)
+				break;
+		}
+
+		*value = result;
+		return true;
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool> UnserializeZigZag(UnserializationContext& context, T* value)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+
+		using Unsigned = std::make_unsigned_t<T>;
+
+		Unsigned encoded;
+		if (!UnserializeVarInt(context, &encoded))
+			return false;
+
+		Unsigned sign = static_cast<Unsigned>(0U - (encoded & 1U));
+		*value = static_cast<T>(static_cast<Unsigned>(encoded >> 1) ^ sign);
+
+		return true;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,42 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASSETCACHE_HPP
+#define NAZARA_ASSETCACHE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <cstddef>
+
+namespace Nz
+{
+	class MappedFileView;
+
+	class NAZARA_CORE_API AssetCache
+	{
+		public:
+			AssetCache() = delete;
+			~AssetCache() = delete;
+
+			static bool Clear();
+
+			static String GetDirectory();
+			static String GetEntryPath(const String& sourcePath, const String& assetType, const void* variant, std::size_t variantSize);
+			static unsigned int GetHitCount();
+			static unsigned int GetMissCount();
+
+			static bool Invalidate(const String& sourcePath);
+			static bool IsEnabled();
+
+			static bool OpenEntry(const String& entryPath, UInt32 formatVersion, MappedFileView* view);
+
+			static void SetDirectory(const String& directoryPath);
+
+			static bool WriteEntry(const String& entryPath, UInt32 formatVersion, const void* payload, std::size_t size);
+	};
+}
+
+#endif // NAZARA_ASSETCACHE_HPP
@@ -0,0 +1,59 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASYNCFILESERVICE_HPP
+#define NAZARA_ASYNCFILESERVICE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/String.hpp>
+#include <cstddef>
+#include <functional>
+
+namespace Nz
+{
+	class NAZARA_CORE_API AsyncFileService
+	{
+		public:
+			struct ReadRequest;
+			struct ReadResult;
+
+			using ReadCallback = std::function<void(ReadResult& result)>;
+
+			AsyncFileService() = delete;
+			~AsyncFileService() = delete;
+
+			static unsigned int DispatchCompletions();
+			static unsigned int GetPendingRequestCount();
+			static unsigned int GetWorkerCount();
+			static bool Initialize();
+			static bool IsInitialized();
+			static void Read(const String& filePath, ReadCallback callback, CompletionMode completionMode = CompletionMode_Deferred);
+			static void Read(const ReadRequest* requests, std::size_t count, CompletionMode completionMode = CompletionMode_Deferred);
+			static void SetWorkerCount(unsigned int workerCount);
+			static void Uninitialize();
+			static void WaitForRequests();
+	};
+
+	struct AsyncFileService::ReadRequest
+	{
+		ReadCallback callback;
+		String filePath;
+		UInt64 offset = 0;
+		UInt64 size = 0; // Zero reads up to the end of the file
+	};
+
+	struct AsyncFileService::ReadResult
+	{
+		ByteArray data;
+		String filePath;
+		UInt64 offset;
+		bool success;
+	};
+}
+
+#endif // NAZARA_ASYNCFILESERVICE_HPP
@@ -0,0 +1,89 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASYNCLOGGER_HPP
+#define NAZARA_ASYNCLOGGER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Nz
+{
+	class NAZARA_CORE_API AsyncLogger : public AbstractLogger
+	{
+		public:
+			AsyncLogger(std::unique_ptr<AbstractLogger> logger, std::size_t queueSize = 4096, LogOverflowPolicy overflowPolicy = LogOverflowPolicy_Block);
+			AsyncLogger(const AsyncLogger&) = delete;
+			AsyncLogger(AsyncLogger&&) = delete;
+			~AsyncLogger();
+
+			void EnableStdReplication(bool enable) override;
+
+			void Flush();
+
+			UInt64 GetDroppedCount() const;
+			AbstractLogger* GetLogger() const;
+			LogOverflowPolicy GetOverflowPolicy() const;
+			std::size_t GetQueueSize() const;
+
+			bool IsStdReplicationEnabled() override;
+
+			void SetOverflowPolicy(LogOverflowPolicy overflowPolicy);
+
+			void Write(const String& string) override;
+			void WriteError(ErrorType type, const String& error, unsigned int line = 0, const char* file = nullptr, const char* function = nullptr) override;
+
+			AsyncLogger& operator=(const AsyncLogger&) = delete;
+			AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+		private:
+			struct Entry
+			{
+				String message;
+				ErrorType errorType;
+				const char* file;
+				const char* function;
+				unsigned int line;
+				bool isError;
+			};
+
+			struct Slot
+			{
+				std::atomic_size_t sequence;
+				Entry entry;
+			};
+
+			bool Pop(Entry* entry);
+			void Push(Entry&& entry);
+			void WakeWorker();
+			void WorkerProc();
+
+			std::unique_ptr<AbstractLogger> m_logger;
+			std::unique_ptr<Slot[]> m_slots;
+			std::atomic_size_t m_enqueuePos;
+			std::atomic_size_t m_writtenCount;
+			std::atomic<UInt64> m_droppedCount;
+			std::atomic<LogOverflowPolicy> m_overflowPolicy;
+			std::atomic_bool m_workerWaiting;
+			std::size_t m_dequeuePos;
+			std::size_t m_mask;
+			ConditionVariable m_flushCondition;
+			ConditionVariable m_workerCondition;
+			Mutex m_loggerMutex;
+			Mutex m_mutex;
+			Thread m_worker;
+			bool m_shouldStop;
+	};
+}
+
+#endif // NAZARA_ASYNCLOGGER_HPP
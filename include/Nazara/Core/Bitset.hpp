@@ -41,6 +41,8 @@ namespace Nz
 			unsigned int FindFirst() const;
 			unsigned int FindNext(unsigned int bit) const;
 
+			template<typename F> void ForEachSetBit(F&& func) const;
+
 			Block GetBlock(unsigned int i) const;
 			unsigned int GetBlockCount() const;
 			unsigned int GetCapacity() const;
@@ -53,6 +55,8 @@ namespace Nz
 
 			bool Intersects(const Bitset& bitset) const;
 
+			bool Matches(const Bitset& required, const Bitset& excluded) const;
+
 			void Reserve(unsigned int bitCount);
 			void Resize(unsigned int bitCount, bool defaultVal = false);
 
@@ -6,6 +6,13 @@
 #include <Nazara/Math/Algorithm.hpp>
 #include <limits>
 #include <utility>
+
+// SSE2 is part of every x86-64 processor
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NAZARA_BITSET_SSE2
+	#include <emmintrin.h>
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 #ifdef NAZARA_COMPILER_MSVC
@@ -16,6 +23,55 @@
 
 namespace Nz
 {
+	namespace Detail
+	{
+		struct BitsetAnd
+		{
+			template<typename T> T operator()(T lhs, T rhs) const { return static_cast<T>(lhs & rhs); }
+
+			#ifdef NAZARA_BITSET_SSE2
+			__m128i operator()(__m128i lhs, __m128i rhs) const { return _mm_and_si128(lhs, rhs); }
+			#endif
+		};
+
+		struct BitsetOr
+		{
+			template<typename T> T operator()(T lhs, T rhs) const { return static_cast<T>(lhs | rhs); }
+
+			#ifdef NAZARA_BITSET_SSE2
+			__m128i operator()(__m128i lhs, __m128i rhs) const { return _mm_or_si128(lhs, rhs); }
+			#endif
+		};
+
+		struct BitsetXor
+		{
+			template<typename T> T operator()(T lhs, T rhs) const { return static_cast<T>(lhs ^ rhs); }
+
+			#ifdef NAZARA_BITSET_SSE2
+			__m128i operator()(__m128i lhs, __m128i rhs) const { return _mm_xor_si128(lhs, rhs); }
+			#endif
+		};
+
+		// result may be the same array as lhs or rhs, each block is read before being written
+		template<typename Block, typename Op>
+		void BitsetTransform(Block* result, const Block* lhs, const Block* rhs, std::size_t blockCount, Op op)
+		{
+			std::size_t i = 0;
+
+			#ifdef NAZARA_BITSET_SSE2
+			constexpr std::size_t blocksPerVector = sizeof(__m128i) / sizeof(Block);
+			for (; i + blocksPerVector <= blockCount; i += blocksPerVector)
+			{
+				__m128i value = op(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&lhs[i])), _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rhs[i])));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&result[i]), value);
+			}
+			#endif
+
+			for (; i < blockCount; ++i)
+				result[i] = op(lhs[i], rhs[i]);
+		}
+	}
+
 	template<typename Block, class Allocator>
 	Bitset<Block, Allocator>::Bitset() :
 	m_bitCount(0)
@@ -79,9 +135,10 @@ namespace Nz
 		if (m_blocks.empty())
 			return 0;
 
+		// CountBits uses the popcnt instruction when available
 		unsigned int count = 0;
-		for (unsigned int i = 0; i < m_blocks.size(); ++i)
-			count += CountBits(m_blocks[i]);
+		for (Block block : m_blocks)
+			count += static_cast<unsigned int>(CountBits(block));
 
 		return count;
 	}
@@ -126,6 +183,22 @@ namespace Nz
 			return FindFirstFrom(blockIndex + 1);
 	}
 
+	template<typename Block, class Allocator>
+	template<typename F>
+	void Bitset<Block, Allocator>::ForEachSetBit(F&& func) const
+	{
+		///DOC: Blocks are read one at a time, bits changed in the current block by func are not seen
+		for (unsigned int i = 0; i < m_blocks.size(); ++i)
+		{
+			Block block = m_blocks[i];
+			while (block)
+			{
+				func(i * bitsPerBlock + IntegralLog2Pot(static_cast<Block>(block & -block)));
+				block &= block - 1; // Reset the lowest set bit
+			}
+		}
+	}
+
 	template<typename Block, class Allocator>
 	Block Bitset<Block, Allocator>::GetBlock(unsigned int i) const
 	{
@@ -155,16 +228,18 @@ namespace Nz
 	template<typename Block, class Allocator>
 	void Bitset<Block, Allocator>::PerformsAND(const Bitset& a, const Bitset& b)
 	{
-		std::pair<unsigned int, unsigned int> minmax = std::minmax(a.GetBlockCount(), b.GetBlockCount());
+		// a or b may be this bitset, the blocks are combined in place before resizing
+		unsigned int minBlockCount = std::min(a.GetBlockCount(), b.GetBlockCount());
+		unsigned int maxBlockCount = std::max(a.GetBlockCount(), b.GetBlockCount());
+		unsigned int bitCount = std::max(a.GetSize(), b.GetSize());
 
-		// On réinitialise nos blocs à zéro
-		m_blocks.clear();
-		m_blocks.resize(minmax.second, 0U);
-		m_bitCount = std::max(a.GetSize(), b.GetSize());
+		m_blocks.resize(std::max<std::size_t>(m_blocks.size(), minBlockCount));
+		Detail::BitsetTransform(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount, Detail::BitsetAnd());
 
 		// Dans le cas du AND, nous pouvons nous arrêter à la plus petite taille (car x & 0 = 0)
-		for (unsigned int i = 0; i < minmax.first; ++i)
-			m_blocks[i] = a.GetBlock(i) & b.GetBlock(i);
+		m_blocks.resize(minBlockCount);
+		m_blocks.resize(maxBlockCount, 0U);
+		m_bitCount = bitCount;
 
 		ResetExtraBits();
 	}
@@ -175,8 +250,24 @@ namespace Nz
 		m_blocks.resize(a.GetBlockCount());
 		m_bitCount = a.GetSize();
 
-		for (unsigned int i = 0; i < m_blocks.size(); ++i)
-			m_blocks[i] = ~a.GetBlock(i);
+		Block* blocks = m_blocks.data();
+		const Block* source = a.m_blocks.data();
+		std::size_t blockCount = m_blocks.size();
+
+		std::size_t i = 0;
+
+		#ifdef NAZARA_BITSET_SSE2
+		constexpr std::size_t blocksPerVector = sizeof(__m128i) / sizeof(Block);
+		const __m128i fullMask = _mm_set1_epi32(-1);
+		for (; i + blocksPerVector <= blockCount; i += blocksPerVector)
+		{
+			__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&blocks[i]), _mm_xor_si128(value, fullMask));
+		}
+		#endif
+
+		for (; i < blockCount; ++i)
+			blocks[i] = static_cast<Block>(~source[i]);
 
 		ResetExtraBits();
 	}
@@ -189,14 +280,16 @@ namespace Nz
 
 		unsigned int maxBlockCount = greater.GetBlockCount();
 		unsigned int minBlockCount = lesser.GetBlockCount();
+		unsigned int bitCount = std::max(a.GetSize(), b.GetSize());
+
+		// Growing the vector keeps the blocks of a or b if they belong to this bitset
 		m_blocks.resize(maxBlockCount);
-		m_bitCount = greater.GetSize();
+		Detail::BitsetTransform(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount, Detail::BitsetOr());
 
-		for (unsigned int i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) | b.GetBlock(i);
+		if (&greater != this)
+			std::copy(greater.m_blocks.begin() + minBlockCount, greater.m_blocks.end(), m_blocks.begin() + minBlockCount); // (x | 0 = x)
 
-		for (unsigned int i = minBlockCount; i < maxBlockCount; ++i)
-			m_blocks[i] = greater.GetBlock(i); // (x | 0 = x)
+		m_bitCount = bitCount;
 
 		ResetExtraBits();
 	}
@@ -209,14 +302,15 @@ namespace Nz
 
 		unsigned int maxBlockCount = greater.GetBlockCount();
 		unsigned int minBlockCount = lesser.GetBlockCount();
+		unsigned int bitCount = std::max(a.GetSize(), b.GetSize());
+
 		m_blocks.resize(maxBlockCount);
-		m_bitCount = greater.GetSize();
+		Detail::BitsetTransform(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount, Detail::BitsetXor());
 
-		for (unsigned int i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) ^ b.GetBlock(i);
+		if (&greater != this)
+			std::copy(greater.m_blocks.begin() + minBlockCount, greater.m_blocks.end(), m_blocks.begin() + minBlockCount); // (x ^ 0 = x)
 
-		for (unsigned int i = minBlockCount; i < maxBlockCount; ++i)
-			m_blocks[i] = greater.GetBlock(i); // (x ^ 0 = x)
+		m_bitCount = bitCount;
 
 		ResetExtraBits();
 	}
@@ -237,6 +331,28 @@ namespace Nz
 		return false;
 	}
 
+	template<typename Block, class Allocator>
+	bool Bitset<Block, Allocator>::Matches(const Bitset& required, const Bitset& excluded) const
+	{
+		///DOC: Tests in a single pass that every bit of required is set and that no bit of excluded is
+		std::size_t blockCount = m_blocks.size();
+		std::size_t requiredCount = required.m_blocks.size();
+		std::size_t excludedCount = excluded.m_blocks.size();
+
+		std::size_t maxCount = std::max(requiredCount, excludedCount);
+		for (std::size_t i = 0; i < maxCount; ++i)
+		{
+			Block block = (i < blockCount) ? m_blocks[i] : Block(0U);
+			Block requiredBlock = (i < requiredCount) ? required.m_blocks[i] : Block(0U);
+			Block excludedBlock = (i < excludedCount) ? excluded.m_blocks[i] : Block(0U);
+
+			if ((requiredBlock & ~block) | (excludedBlock & block))
+				return false;
+		}
+
+		return true;
+	}
+
 	template<typename Block, class Allocator>
 	void Bitset<Block, Allocator>::Reserve(unsigned int bitCount)
 	{
@@ -325,8 +441,9 @@ namespace Nz
 
 		for (unsigned int i = 0; i < m_blocks.size(); ++i)
 		{
-			Block mask = (i == m_blocks.size() - 1) ? lastBlockMask : fullBitMask;
-			if (m_blocks[i] == mask) // Les extra bits sont à zéro, on peut donc tester sans procéder à un masquage
+			// A null mask means the last block is full
+			Block mask = (i == m_blocks.size() - 1 && lastBlockMask) ? lastBlockMask : fullBitMask;
+			if (m_blocks[i] != mask) // Les extra bits sont à zéro, on peut donc tester sans procéder à un masquage
 				return false;
 		}
 
@@ -755,6 +872,8 @@ namespace std
 	}
 }
 
+#undef NAZARA_BITSET_SSE2
+
 #ifdef NAZARA_COMPILER_MSVC
 	// Reenable those warnings
 	#pragma warning(default: 4146)
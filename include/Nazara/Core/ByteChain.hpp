@@ -0,0 +1,112 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_BYTECHAIN_HPP
+#define NAZARA_BYTECHAIN_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <deque>
+#include <memory>
+
+namespace Nz
+{
+	class AbstractHash;
+
+	class NAZARA_CORE_API ByteChain
+	{
+		public:
+			struct Segment
+			{
+				const UInt8* data;
+				std::size_t size;
+			};
+
+			inline ByteChain();
+			explicit ByteChain(ByteArray array);
+			ByteChain(const ByteChain&) = default;
+			ByteChain(ByteChain&& chain);
+			~ByteChain() = default;
+
+			void Append(const void* buffer, std::size_t size);
+			void Append(ByteArray array);
+			void Append(const ByteChain& chain);
+
+			void Clear();
+
+			std::size_t CopyTo(void* buffer, std::size_t size, std::size_t offset = 0) const;
+
+			void Discard(std::size_t size);
+
+			std::size_t ExportSegments(Segment* segments, std::size_t maxCount, std::size_t firstSegment = 0) const;
+
+			inline std::size_t GetSegmentCount() const;
+			inline std::size_t GetSize() const;
+
+			inline bool IsEmpty() const;
+
+			void Prepend(const void* buffer, std::size_t size);
+			void Prepend(ByteArray array);
+			void Prepend(const ByteChain& chain);
+
+			ByteChain SubChain(std::size_t offset, std::size_t size) const;
+
+			ByteArray ToByteArray() const;
+
+			ByteChain& operator=(const ByteChain&) = default;
+			ByteChain& operator=(ByteChain&& chain);
+
+			static constexpr std::size_t BlockSize = 4096;
+
+		private:
+			struct Slice
+			{
+				std::shared_ptr<ByteArray> block;
+				std::size_t offset;
+				std::size_t size;
+			};
+
+			std::deque<Slice> m_slices;
+			std::size_t m_size;
+	};
+
+	class NAZARA_CORE_API ByteChainStream : public Stream
+	{
+		public:
+			inline ByteChainStream();
+			inline ByteChainStream(ByteChain chain);
+			ByteChainStream(const ByteChainStream&) = default;
+			ByteChainStream(ByteChainStream&&) = default;
+			~ByteChainStream() = default;
+
+			bool EndOfStream() const override;
+
+			inline ByteChain& GetChain();
+			inline const ByteChain& GetChain() const;
+			UInt64 GetCursorPos() const override;
+			UInt64 GetSize() const override;
+
+			bool SetCursorPos(UInt64 offset) override;
+
+			ByteChainStream& operator=(const ByteChainStream&) = default;
+			ByteChainStream& operator=(ByteChainStream&&) = default;
+
+		private:
+			void FlushStream() override;
+			std::size_t ReadBlock(void* buffer, std::size_t size) override;
+			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+
+			ByteChain m_chain;
+			UInt64 m_pos;
+	};
+
+	NAZARA_CORE_API bool HashAppend(AbstractHash* hash, const ByteChain& chain);
+}
+
+#include <Nazara/Core/ByteChain.inl>
+
+#endif // NAZARA_BYTECHAIN_HPP
@@ -0,0 +1,52 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline ByteChain::ByteChain() :
+	m_size(0)
+	{
+	}
+
+	inline std::size_t ByteChain::GetSegmentCount() const
+	{
+		return m_slices.size();
+	}
+
+	inline std::size_t ByteChain::GetSize() const
+	{
+		return m_size;
+	}
+
+	inline bool ByteChain::IsEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	inline ByteChainStream::ByteChainStream() :
+	Stream(StreamOption_None, OpenMode_ReadWrite | OpenMode_Append),
+	m_pos(0)
+	{
+	}
+
+	inline ByteChainStream::ByteChainStream(ByteChain chain) :
+	ByteChainStream()
+	{
+		m_chain = std::move(chain);
+	}
+
+	inline ByteChain& ByteChainStream::GetChain()
+	{
+		return m_chain;
+	}
+
+	inline const ByteChain& ByteChainStream::GetChain() const
+	{
+		return m_chain;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
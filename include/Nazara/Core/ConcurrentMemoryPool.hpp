@@ -0,0 +1,70 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CONCURRENTMEMORYPOOL_HPP
+#define NAZARA_CONCURRENTMEMORYPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API ConcurrentMemoryPool
+	{
+		public:
+			ConcurrentMemoryPool(std::size_t blockSize, std::size_t chunkSize = 1024, std::size_t magazineSize = 32);
+			ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool(ConcurrentMemoryPool&&) = delete;
+			~ConcurrentMemoryPool();
+
+			void* Allocate();
+			template<typename T> void Delete(T* ptr);
+			void Flush();
+			void Free(void* ptr);
+			void Free(void* const* blocks, std::size_t count);
+
+			std::size_t GetBlockCount() const;
+			std::size_t GetBlockSize() const;
+
+			template<typename T, typename... Args> T* New(Args&&... args);
+
+			ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool& operator=(ConcurrentMemoryPool&&) = delete;
+
+		private:
+			struct Magazine;
+			struct Registry;
+			struct ThreadSlot;
+
+			void* AllocateBlock();
+			void FlushMagazine(Magazine& magazine, std::size_t count);
+			Magazine* GetMagazine();
+			void RefillMagazine(Magazine& magazine);
+			void ReleaseMagazine(unsigned int slot);
+
+			static Registry& GetRegistry();
+			static unsigned int GetThreadSlot();
+
+			std::unique_ptr<std::unique_ptr<Magazine>[]> m_magazines;
+			std::atomic_size_t m_blockCount;
+			std::size_t m_blockSize;
+			std::size_t m_chunkSize;
+			std::size_t m_magazineSize;
+			std::vector<UInt8*> m_chunks;
+			std::vector<void*> m_depot;
+			Mutex m_mutex;
+			UInt8* m_chunkCursor;
+			UInt8* m_chunkEnd;
+	};
+}
+
+#include <Nazara/Core/ConcurrentMemoryPool.inl>
+
+#endif // NAZARA_CONCURRENTMEMORYPOOL_HPP
@@ -0,0 +1,31 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	void ConcurrentMemoryPool::Delete(T* ptr)
+	{
+		if (ptr)
+		{
+			ptr->~T();
+			Free(ptr);
+		}
+	}
+
+	template<typename T, typename... Args>
+	T* ConcurrentMemoryPool::New(Args&&... args)
+	{
+		NazaraAssert(sizeof(T) <= m_blockSize, "Object is too big for the pool blocks");
+
+		return PlacementNew<T>(Allocate(), std::forward<Args>(args)...);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -50,6 +50,9 @@
 // Utilise le MemoryManager pour gérer les allocations dynamiques (détecte les leaks au prix d'allocations/libérations dynamiques plus lentes)
 #define NAZARA_CORE_MANAGE_MEMORY 0
 
+// Active les zones de profilage (NazaraProfileZone) du moteur, sans coût si désactivé
+#define NAZARA_CORE_PROFILER 0
+
 // Active les tests de sécurité basés sur le code (Conseillé pour le développement)
 #define NAZARA_CORE_SAFE 1
 
@@ -9,6 +9,23 @@
 
 namespace Nz
 {
+	enum AccessPattern
+	{
+		AccessPattern_Normal,     // No particular access pattern
+		AccessPattern_Random,     // Data is accessed in random order, read-ahead is useless
+		AccessPattern_Sequential, // Data is accessed from the beginning to the end, read-ahead is aggressive
+
+		AccessPattern_Max = AccessPattern_Sequential
+	};
+
+	enum CompletionMode
+	{
+		CompletionMode_Deferred,      // The callback is queued until AsyncFileService::DispatchCompletions is called (usually by the main thread)
+		CompletionMode_TaskScheduler, // The callback is submitted to the TaskScheduler workers as soon as the operation completes
+
+		CompletionMode_Max = CompletionMode_TaskScheduler
+	};
+
 	enum CoordSys
 	{
 		CoordSys_Global,
@@ -69,8 +86,37 @@ namespace Nz
 		HashType_SHA384,
 		HashType_SHA512,
 		HashType_Whirlpool,
+		HashType_XXHash64,
+		HashType_CRC32C,
 
-		HashType_Max = HashType_Whirlpool
+		HashType_Max = HashType_CRC32C
+	};
+
+	enum LogOverflowPolicy
+	{
+		LogOverflowPolicy_Block, // The writing thread waits for the logging thread to make room (no message is lost)
+		LogOverflowPolicy_Drop,  // The message is discarded and counted, the writing thread never waits
+
+		LogOverflowPolicy_Max = LogOverflowPolicy_Drop
+	};
+
+	enum MemoryTag
+	{
+		MemoryTag_Unknown, // Allocations made outside of any MemoryTagScope
+
+		MemoryTag_Audio,
+		MemoryTag_Core,
+		MemoryTag_Graphics,
+		MemoryTag_Lua,
+		MemoryTag_Network,
+		MemoryTag_Noise,
+		MemoryTag_Physics,
+		MemoryTag_Renderer,
+		MemoryTag_SDK,
+		MemoryTag_User,
+		MemoryTag_Utility,
+
+		MemoryTag_Max = MemoryTag_Utility
 	};
 
 	enum OpenModeFlags
@@ -122,6 +168,7 @@ namespace Nz
 	{
 		ProcessorCap_x64,
 		ProcessorCap_AVX,
+		ProcessorCap_AVX2,
 		ProcessorCap_FMA3,
 		ProcessorCap_FMA4,
 		ProcessorCap_MMX,
@@ -133,8 +180,9 @@ namespace Nz
 		ProcessorCap_SSE41,
 		ProcessorCap_SSE42,
 		ProcessorCap_SSE4a,
+		ProcessorCap_SHA,
 
-		ProcessorCap_Max = ProcessorCap_SSE4a
+		ProcessorCap_Max = ProcessorCap_SHA
 	};
 
 	enum ProcessorVendor
@@ -161,6 +209,16 @@ namespace Nz
 		ProcessorVendor_Max = ProcessorVendor_XenHVM
 	};
 
+	enum ResourceState
+	{
+		ResourceState_Queued,  // Waiting for ResourceManager::Update to start loading it
+		ResourceState_Loading, // The file is being read
+		ResourceState_Loaded,
+		ResourceState_Failed,
+
+		ResourceState_Max = ResourceState_Failed
+	};
+
 	enum SphereType
 	{
 		SphereType_Cubic,
@@ -18,7 +18,7 @@ namespace Nz
 	class NAZARA_CORE_API HashCRC32 : public AbstractHash
 	{
 		public:
-			HashCRC32(UInt32 polynomial = 0x04c11db7);
+			HashCRC32(UInt32 polynomial = 0x04c11db7); // 0x1edc6f41 for CRC32C, which is hardware accelerated
 			virtual ~HashCRC32();
 
 			void Append(const UInt8* data, std::size_t len) override;
@@ -30,6 +30,7 @@ namespace Nz
 
 		private:
 			HashCRC32_state* m_state;
+			UInt32 m_polynomial;
 	};
 }
 
@@ -0,0 +1,36 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_HASH_XXHASH64_HPP
+#define NAZARA_HASH_XXHASH64_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+
+namespace Nz
+{
+	struct HashXXHash64_state;
+
+	class NAZARA_CORE_API HashXXHash64 : public AbstractHash
+	{
+		public:
+			HashXXHash64(UInt64 seed = 0);
+			virtual ~HashXXHash64();
+
+			void Append(const UInt8* data, std::size_t len) override;
+			void Begin() override;
+			ByteArray End() override;
+
+			std::size_t GetDigestLength() const override;
+			const char* GetHashName() const override;
+
+		private:
+			HashXXHash64_state* m_state;
+	};
+}
+
+#endif // NAZARA_HASH_XXHASH64_HPP
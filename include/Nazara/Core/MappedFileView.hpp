@@ -0,0 +1,62 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MAPPEDFILEVIEW_HPP
+#define NAZARA_MAPPEDFILEVIEW_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/String.hpp>
+
+namespace Nz
+{
+	class NAZARA_CORE_API MappedFileView : public Stream
+	{
+		public:
+			MappedFileView();
+			MappedFileView(const String& filePath, UInt32 openMode = OpenMode_ReadOnly);
+			MappedFileView(const MappedFileView&) = delete;
+			MappedFileView(MappedFileView&& view) noexcept;
+			~MappedFileView();
+
+			void Close();
+
+			bool EndOfStream() const override;
+
+			UInt64 GetCursorPos() const override;
+			inline const UInt8* GetConstData() const;
+			inline UInt8* GetData();
+			String GetDirectory() const override;
+			const void* GetMemoryPointer() const override;
+			String GetPath() const override;
+			UInt64 GetSize() const override;
+
+			inline bool IsOpen() const;
+
+			bool Open(const String& filePath, UInt32 openMode = OpenMode_ReadOnly);
+
+			bool SetAccessPattern(AccessPattern pattern);
+			bool SetCursorPos(UInt64 offset) override;
+
+			MappedFileView& operator=(const MappedFileView&) = delete;
+			MappedFileView& operator=(MappedFileView&& view) noexcept;
+
+		private:
+			void FlushStream() override;
+			std::size_t ReadBlock(void* buffer, std::size_t size) override;
+			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+
+			String m_filePath;
+			UInt8* m_data;
+			UInt64 m_pos;
+			UInt64 m_size;
+	};
+}
+
+#include <Nazara/Core/MappedFileView.inl>
+
+#endif // NAZARA_MAPPEDFILEVIEW_HPP
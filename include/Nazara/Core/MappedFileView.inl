@@ -0,0 +1,28 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline const UInt8* MappedFileView::GetConstData() const
+	{
+		return m_data;
+	}
+
+	inline UInt8* MappedFileView::GetData()
+	{
+		NazaraAssert(IsWritable(), "File is not mapped for writing");
+
+		return m_data;
+	}
+
+	inline bool MappedFileView::IsOpen() const
+	{
+		return m_openMode != OpenMode_NotOpen;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
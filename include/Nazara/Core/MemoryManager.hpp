@@ -8,6 +8,7 @@
 #define NAZARA_MEMORYMANAGER_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <cstdio>
 #include <cstring>
 
@@ -16,22 +17,69 @@ namespace Nz
 	class NAZARA_CORE_API MemoryManager
 	{
 		public:
+			struct CallStackSample;
+			struct Snapshot;
+			struct TagStats;
+
 			static void* Allocate(std::size_t size, bool multi = false, const char* file = nullptr, unsigned int line = 0);
 
+			static void ClearCallStackSamples();
+
+			static Snapshot Diff(const Snapshot& previous, const Snapshot& current);
+
 			static void EnableAllocationFilling(bool allocationFilling);
 			static void EnableAllocationLogging(bool logAllocations);
+			static void EnableLeakTracking(bool leakTracking);
 
 			static void Free(void* pointer, bool multi = false);
 
 			static unsigned int GetAllocatedBlockCount();
 			static std::size_t GetAllocatedSize();
 			static unsigned int GetAllocationCount();
+			static unsigned int GetCallStackSamplingRate();
+			static std::size_t GetCallStackSamples(CallStackSample* samples, std::size_t maxCount);
+			static MemoryTag GetCurrentTag();
+			static const char* GetTagName(MemoryTag tag);
 
 			static bool IsAllocationFillingEnabled();
 			static bool IsAllocationLoggingEnabled();
+			static bool IsLeakTrackingEnabled();
+
+			static void LogCallStackSamples();
 
 			static void NextFree(const char* file, unsigned int line);
 
+			static void SetCallStackSamplingRate(unsigned int rate);
+			static void SetCurrentTag(MemoryTag tag);
+
+			static Snapshot TakeSnapshot();
+
+			static constexpr std::size_t MaxCallStackDepth = 16;
+
+			struct CallStackSample
+			{
+				void* frames[MaxCallStackDepth];
+				const char* file;
+				std::size_t frameCount;
+				std::size_t sampledSize;
+				MemoryTag tag;
+				unsigned int line;
+				unsigned int sampleCount;
+			};
+
+			struct TagStats
+			{
+				UInt64 allocationCount;
+				UInt64 allocatedSize;
+				UInt64 freeCount;
+				UInt64 freedSize;
+			};
+
+			struct Snapshot
+			{
+				TagStats tags[MemoryTag_Max + 1];
+			};
+
 		private:
 			MemoryManager();
 			~MemoryManager();
@@ -40,6 +88,21 @@ namespace Nz
 			static void TimeInfo(char buffer[23]);
 			static void Uninitialize();
 	};
+
+	class NAZARA_CORE_API MemoryTagScope
+	{
+		public:
+			MemoryTagScope(MemoryTag tag);
+			MemoryTagScope(const MemoryTagScope&) = delete;
+			MemoryTagScope(MemoryTagScope&&) = delete;
+			~MemoryTagScope();
+
+			MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+			MemoryTagScope& operator=(MemoryTagScope&&) = delete;
+
+		private:
+			MemoryTag m_previousTag;
+	};
 }
 
 #endif // NAZARA_MEMORYMANAGER_HPP
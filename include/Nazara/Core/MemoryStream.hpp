@@ -30,6 +30,7 @@ namespace Nz
 			const ByteArray& GetBuffer() const;
 			const UInt8* GetData() const;
 			UInt64 GetCursorPos() const override;
+			const void* GetMemoryPointer() const override;
 			UInt64 GetSize() const override;
 
 			bool SetCursorPos(UInt64 offset) override;
@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/String.hpp>
 
 namespace Nz
 {
@@ -16,6 +17,7 @@ namespace Nz
 	{
 		public:
 			MemoryView(const void* ptr, UInt64 size);
+			MemoryView(const void* ptr, UInt64 size, const String& filePath);
 			MemoryView(const MemoryView&) = delete;
 			MemoryView(MemoryView&&) = delete; ///TODO
 			~MemoryView() = default;
@@ -23,6 +25,9 @@ namespace Nz
 			bool EndOfStream() const override;
 
 			UInt64 GetCursorPos() const override;
+			String GetDirectory() const override;
+			const void* GetMemoryPointer() const override;
+			String GetPath() const override;
 			UInt64 GetSize() const override;
 
 			bool SetCursorPos(UInt64 offset) override;
@@ -35,6 +40,7 @@ namespace Nz
 			std::size_t ReadBlock(void* buffer, std::size_t size) override;
 			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
 
+			String m_filePath;
 			const UInt8* m_ptr;
 			UInt64 m_pos;
 			UInt64 m_size;
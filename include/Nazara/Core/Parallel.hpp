@@ -0,0 +1,21 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PARALLEL_HPP
+#define NAZARA_PARALLEL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <cstddef>
+
+namespace Nz
+{
+	template<typename F> void ParallelFor(std::size_t begin, std::size_t end, F function, std::size_t grainSize = 1);
+	template<typename T, typename F, typename R> T ParallelReduce(std::size_t begin, std::size_t end, const T& identity, F function, R reduce, std::size_t grainSize = 1);
+}
+
+#include <Nazara/Core/Parallel.inl>
+
+#endif // NAZARA_PARALLEL_HPP
@@ -0,0 +1,197 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		class ParallelRange
+		{
+			public:
+				ParallelRange(std::size_t begin, std::size_t end, std::size_t grainSize, unsigned int participantCount) :
+				m_next(begin),
+				m_end(end),
+				m_grainSize(grainSize),
+				m_participantCount(participantCount)
+				{
+				}
+
+				bool FetchChunk(std::size_t* first, std::size_t* last)
+				{
+					// Guided scheduling: chunks shrink as the range gets consumed, large chunks keep the atomic
+					// traffic low at the beginning and small ones balance the load between participants at the end
+					std::size_t current = m_next.load(std::memory_order_relaxed);
+					for (;;)
+					{
+						if (current >= m_end)
+							return false;
+
+						std::size_t remaining = m_end - current;
+						std::size_t chunkSize = std::min(remaining, std::max(m_grainSize, remaining / (2 * m_participantCount)));
+						if (m_next.compare_exchange_weak(current, current + chunkSize, std::memory_order_relaxed))
+						{
+							*first = current;
+							*last = current + chunkSize;
+							return true;
+						}
+					}
+				}
+
+			private:
+				std::atomic<std::size_t> m_next;
+				std::size_t m_end;
+				std::size_t m_grainSize;
+				unsigned int m_participantCount;
+		};
+
+		template<typename F>
+		class ParallelForJob : public Functor
+		{
+			public:
+				ParallelForJob(std::size_t begin, std::size_t end, std::size_t grainSize, unsigned int participantCount, F& function) :
+				m_range(begin, end, grainSize, participantCount),
+				m_function(function)
+				{
+				}
+
+				void Run() override
+				{
+					std::size_t first, last;
+					while (m_range.FetchChunk(&first, &last))
+						m_function(first, last);
+				}
+
+			private:
+				ParallelRange m_range;
+				F& m_function;
+		};
+
+		template<typename T, typename F>
+		class ParallelReduceJob : public Functor
+		{
+			public:
+				ParallelReduceJob(std::size_t begin, std::size_t end, std::size_t grainSize, unsigned int participantCount, const T& identity, F& function) :
+				m_range(begin, end, grainSize, participantCount),
+				m_partialCount(0),
+				m_function(function),
+				m_identity(identity)
+				{
+					m_partialValues.reserve(participantCount);
+					for (unsigned int i = 0; i < participantCount; ++i)
+						m_partialValues.emplace_back(identity);
+				}
+
+				std::size_t GetPartialCount() const
+				{
+					return m_partialCount.load(std::memory_order_relaxed);
+				}
+
+				const T& GetPartialValue(std::size_t index) const
+				{
+					return m_partialValues[index];
+				}
+
+				void Run() override
+				{
+					std::size_t first, last;
+					if (!m_range.FetchChunk(&first, &last))
+						return;
+
+					// Each participant accumulates in its own value, they are only reduced together at the end
+					T value = m_identity;
+					do
+					{
+						m_function(first, last, value);
+					}
+					while (m_range.FetchChunk(&first, &last));
+
+					m_partialValues[m_partialCount.fetch_add(1, std::memory_order_relaxed)] = std::move(value);
+				}
+
+			private:
+				ParallelRange m_range;
+				std::atomic<std::size_t> m_partialCount;
+				std::vector<T> m_partialValues;
+				F& m_function;
+				const T& m_identity;
+		};
+	}
+
+	template<typename F>
+	void ParallelFor(std::size_t begin, std::size_t end, F function, std::size_t grainSize)
+	{
+		///DOC: Subranges contain at least grainSize indices (except the last one), the range is processed inline when it's too small to be split
+		if (begin >= end)
+			return;
+
+		if (grainSize == 0)
+			grainSize = 1;
+
+		std::size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+		unsigned int workerCount = TaskScheduler::GetWorkerCount();
+		if (chunkCount < 2 || workerCount < 2 || !TaskScheduler::Initialize())
+		{
+			function(begin, end);
+			return;
+		}
+
+		unsigned int helperCount = static_cast<unsigned int>(std::min<std::size_t>(workerCount, chunkCount - 1));
+
+		Detail::ParallelForJob<F> job(begin, end, grainSize, helperCount + 1, function);
+
+		TaskScheduler::Counter counter;
+		TaskScheduler::Dispatch(&job, helperCount, counter);
+
+		job.Run();
+
+		TaskScheduler::WaitForTasks(counter);
+	}
+
+	template<typename T, typename F, typename R>
+	T ParallelReduce(std::size_t begin, std::size_t end, const T& identity, F function, R reduce, std::size_t grainSize)
+	{
+		///DOC: Partial results are then combined with reduce(lhs, rhs), in no particular order
+		if (begin >= end)
+			return identity;
+
+		if (grainSize == 0)
+			grainSize = 1;
+
+		std::size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+		unsigned int workerCount = TaskScheduler::GetWorkerCount();
+		if (chunkCount < 2 || workerCount < 2 || !TaskScheduler::Initialize())
+		{
+			T value = identity;
+			function(begin, end, value);
+
+			return value;
+		}
+
+		unsigned int helperCount = static_cast<unsigned int>(std::min<std::size_t>(workerCount, chunkCount - 1));
+
+		Detail::ParallelReduceJob<T, F> job(begin, end, grainSize, helperCount + 1, identity, function);
+
+		TaskScheduler::Counter counter;
+		TaskScheduler::Dispatch(&job, helperCount, counter);
+
+		job.Run();
+
+		TaskScheduler::WaitForTasks(counter);
+
+		T value = identity;
+		for (std::size_t i = 0; i < job.GetPartialCount(); ++i)
+			value = reduce(value, job.GetPartialValue(i));
+
+		return value;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
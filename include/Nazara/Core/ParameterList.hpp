@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Core/StringAtom.hpp>
 #include <atomic>
 #include <unordered_map>
 
@@ -27,16 +28,25 @@ namespace Nz
 			void Clear();
 
 			bool GetBooleanParameter(const String& name, bool* value) const;
+			bool GetBooleanParameter(const StringAtom& name, bool* value) const;
 			bool GetFloatParameter(const String& name, float* value) const;
+			bool GetFloatParameter(const StringAtom& name, float* value) const;
 			bool GetIntegerParameter(const String& name, int* value) const;
+			bool GetIntegerParameter(const StringAtom& name, int* value) const;
 			bool GetParameterType(const String& name, ParameterType* type) const;
+			bool GetParameterType(const StringAtom& name, ParameterType* type) const;
 			bool GetPointerParameter(const String& name, void** value) const;
+			bool GetPointerParameter(const StringAtom& name, void** value) const;
 			bool GetStringParameter(const String& name, String* value) const;
+			bool GetStringParameter(const StringAtom& name, String* value) const;
 			bool GetUserdataParameter(const String& name, void** value) const;
+			bool GetUserdataParameter(const StringAtom& name, void** value) const;
 
 			bool HasParameter(const String& name) const;
+			bool HasParameter(const StringAtom& name) const;
 
 			void RemoveParameter(const String& name);
+			void RemoveParameter(const StringAtom& name);
 
 			void SetParameter(const String& name);
 			void SetParameter(const String& name, const String& value);
@@ -46,6 +56,14 @@ namespace Nz
 			void SetParameter(const String& name, bool value);
 			void SetParameter(const String& name, float value);
 			void SetParameter(const String& name, int value);
+			void SetParameter(const StringAtom& name);
+			void SetParameter(const StringAtom& name, const String& value);
+			void SetParameter(const StringAtom& name, const char* value);
+			void SetParameter(const StringAtom& name, void* value);
+			void SetParameter(const StringAtom& name, void* value, Destructor destructor);
+			void SetParameter(const StringAtom& name, bool value);
+			void SetParameter(const StringAtom& name, float value);
+			void SetParameter(const StringAtom& name, int value);
 
 			ParameterList& operator=(const ParameterList& list);
 			ParameterList& operator=(ParameterList&&) = default;
@@ -86,7 +104,7 @@ namespace Nz
 				Value value;
 			};
 
-			using ParameterMap = std::unordered_map<String, Parameter>;
+			using ParameterMap = std::unordered_map<StringAtom, Parameter>;
 
 			void DestroyValue(Parameter& parameter);
 
@@ -0,0 +1,87 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PROFILER_HPP
+#define NAZARA_PROFILER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <vector>
+
+#if NAZARA_CORE_PROFILER
+	#define NazaraProfileZone(name) Nz::ProfilerZone NazaraSuffixMacro(nazaraProfilerZone, __LINE__)(name)
+#else
+	#define NazaraProfileZone(name)
+#endif
+
+namespace Nz
+{
+	class Stream;
+	class String;
+
+	class NAZARA_CORE_API Profiler
+	{
+		public:
+			struct FrameStats;
+			struct ZoneStats;
+
+			Profiler() = delete;
+			~Profiler() = delete;
+
+			static void BeginZone(const char* name);
+
+			static void Enable(bool enable = true);
+			static void EndFrame();
+			static void EndZone();
+
+			static bool ExportChromeTrace(Stream& stream);
+			static bool ExportChromeTrace(const String& filePath);
+
+			static const FrameStats& GetLastFrameStats();
+
+			static bool IsCapturing();
+			static bool IsEnabled();
+
+			static void StartCapture();
+			static void StopCapture();
+
+			struct ZoneStats
+			{
+				const char* name;
+				UInt64 callCount;
+				UInt64 maxTime;
+				UInt64 selfTime;
+				UInt64 totalTime;
+			};
+
+			struct FrameStats
+			{
+				std::vector<ZoneStats> zones;
+				UInt64 beginTime;
+				UInt64 duration;
+				UInt64 droppedEvents;
+			};
+
+			static constexpr std::size_t MaxZoneDepth = 64;
+			static constexpr std::size_t ThreadEventCount = 16384;
+	};
+
+	class ProfilerZone
+	{
+		public:
+			inline ProfilerZone(const char* name);
+			ProfilerZone(const ProfilerZone&) = delete;
+			ProfilerZone(ProfilerZone&&) = delete;
+			inline ~ProfilerZone();
+
+			ProfilerZone& operator=(const ProfilerZone&) = delete;
+			ProfilerZone& operator=(ProfilerZone&&) = delete;
+	};
+}
+
+#include <Nazara/Core/Profiler.inl>
+
+#endif // NAZARA_PROFILER_HPP
@@ -0,0 +1,20 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline ProfilerZone::ProfilerZone(const char* name)
+	{
+		Profiler::BeginZone(name);
+	}
+
+	inline ProfilerZone::~ProfilerZone()
+	{
+		Profiler::EndZone();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -10,6 +10,7 @@
 #include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/Resource.hpp>
 #include <Nazara/Core/String.hpp>
+#include <functional>
 #include <list>
 #include <tuple>
 #include <type_traits>
@@ -24,6 +25,7 @@ namespace Nz
 		friend Type;
 
 		public:
+			using AsyncCallback = std::function<void(Type* resource, bool loaded)>;
 			using ExtensionGetter = bool (*)(const String& extension);
 			using FileLoader = bool (*)(Type* resource, const String& filePath, const Parameters& parameters);
 			using MemoryLoader = bool (*)(Type* resource, const void* data, std::size_t size, const Parameters& parameters);
@@ -36,6 +38,7 @@ namespace Nz
 			static bool IsExtensionSupported(const String& extension);
 
 			static bool LoadFromFile(Type* resource, const String& filePath, const Parameters& parameters = Parameters());
+			static bool LoadFromFileAsync(Type* resource, const String& filePath, AsyncCallback callback, const Parameters& parameters = Parameters(), CompletionMode completionMode = CompletionMode_Deferred);
 			static bool LoadFromMemory(Type* resource, const void* data, unsigned int size, const Parameters& parameters = Parameters());
 			static bool LoadFromStream(Type* resource, Stream& stream, const Parameters& parameters = Parameters());
 
@@ -45,6 +48,9 @@ namespace Nz
 		private:
 			using Loader = std::tuple<ExtensionGetter, StreamChecker, StreamLoader, FileLoader, MemoryLoader>;
 			using LoaderList = std::list<Loader>;
+
+			static bool GetFileExtension(const String& filePath, String* path, String* extension);
+			template<typename F> static bool LoadFromFileStream(Type* resource, const String& filePath, const String& extension, F openStream, const Parameters& parameters);
 	};
 }
 
@@ -2,9 +2,11 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/AsyncFileService.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Core/Debug.hpp>
@@ -28,6 +30,7 @@ namespace Nz
 	template<typename Type, typename Parameters>
 	bool ResourceLoader<Type, Parameters>::LoadFromFile(Type* resource, const String& filePath, const Parameters& parameters)
 	{
+		///DOC: The file is mapped and must not be truncated during the load (SIGBUS on POSIX systems), use LoadFromStream otherwise
 		#if NAZARA_CORE_SAFE
 		if (!parameters.IsValid())
 		{
@@ -36,90 +39,69 @@ namespace Nz
 		}
 		#endif
 
-		String path = File::NormalizePath(filePath);
-		String ext = path.SubStringFrom('.', -1, true).ToLower();
-		if (ext.IsEmpty())
-		{
-			NazaraError("Failed to get file extension from \"" + filePath + '"');
+		String path;
+		String ext;
+		if (!GetFileExtension(filePath, &path, &ext))
 			return false;
-		}
 
-		File file(path); // Ouvert seulement en cas de besoin
+		// Loaders parse the file directly from the mapped pages, it is only mapped when needed
+		MappedFileView mappedFile;
+		File file;
+		Stream* stream = nullptr;
 
-		bool found = false;
-		for (Loader& loader : Type::s_loaders)
+		return LoadFromFileStream(resource, filePath, ext, [&]() -> Stream*
 		{
-			ExtensionGetter isExtensionSupported = std::get<0>(loader);
-			if (!isExtensionSupported || !isExtensionSupported(ext))
-				continue;
+			if (stream)
+				return stream;
 
-			StreamChecker checkFunc = std::get<1>(loader);
-			StreamLoader streamLoader = std::get<2>(loader);
-			FileLoader fileLoader = std::get<3>(loader);
-
-			if (checkFunc && !file.IsOpen())
+			if (mappedFile.Open(path, OpenMode_ReadOnly))
 			{
-				if (!file.Open(OpenMode_ReadOnly))
-				{
-					NazaraError("Failed to load file: unable to open \"" + filePath + '"');
-					return false;
-				}
-			}
-
-			Ternary recognized = Ternary_Unknown;
-			if (fileLoader)
-			{
-				if (checkFunc)
-				{
-					file.SetCursorPos(0);
-
-					recognized = checkFunc(file, parameters);
-					if (recognized == Ternary_False)
-						continue;
-					else
-						found = true;
-				}
-				else
-				{
-					recognized = Ternary_Unknown;
-					found = true;
-				}
-
-				if (fileLoader(resource, filePath, parameters))
-				{
-					resource->SetFilePath(filePath);
-					return true;
-				}
+				mappedFile.SetAccessPattern(AccessPattern_Sequential);
+				stream = &mappedFile;
 			}
+			else if (file.Open(path, OpenMode_ReadOnly)) // Some files cannot be mapped (pipes, some file systems)
+				stream = &file;
 			else
-			{
-				file.SetCursorPos(0);
+				NazaraError("Failed to load file: unable to open \"" + filePath + '"');
 
-				recognized = checkFunc(file, parameters);
-				if (recognized == Ternary_False)
-					continue;
-				else if (recognized == Ternary_True)
-					found = true;
+			return stream;
+		}, parameters);
+	}
 
-				file.SetCursorPos(0);
+	template<typename Type, typename Parameters>
+	bool ResourceLoader<Type, Parameters>::LoadFromFileAsync(Type* resource, const String& filePath, AsyncCallback callback, const Parameters& parameters, CompletionMode completionMode)
+	{
+		///DOC: The resource must outlive the callback, and loaders using the GPU or the error system need CompletionMode_Deferred
+		#if NAZARA_CORE_SAFE
+		if (!parameters.IsValid())
+		{
+			NazaraError("Invalid parameters");
+			return false;
+		}
+		#endif
 
-				if (streamLoader(resource, file, parameters))
-				{
-					resource->SetFilePath(filePath);
-					return true;
-				}
-			}
+		String path;
+		String ext;
+		if (!GetFileExtension(filePath, &path, &ext))
+			return false;
 
-			if (recognized == Ternary_True)
-				NazaraWarning("Loader failed");
-		}
+		AsyncFileService::Read(path, [resource, filePath, path, ext, callback, parameters](AsyncFileService::ReadResult& result)
+		{
+			bool loaded = false;
+			if (result.success)
+			{
+				// The view carries the file path, loaders resolving files relative to their input (materials, textures) still find them
+				MemoryView stream(result.data.GetConstBuffer(), result.data.GetSize(), path);
+				loaded = LoadFromFileStream(resource, filePath, ext, [&stream]() -> Stream* { return &stream; }, parameters);
+			}
+			else
+				NazaraError("Failed to load file: unable to read \"" + filePath + '"');
 
-		if (found)
-			NazaraError("Failed to load file: all loaders failed");
-		else
-			NazaraError("Failed to load file: no loader found for extension \"" + ext + '"');
+			if (callback)
+				callback(resource, loaded);
+		}, completionMode);
 
-		return false;
+		return true;
 	}
 
 	template<typename Type, typename Parameters>
@@ -277,6 +259,101 @@ namespace Nz
 	{
 		Type::s_loaders.remove(std::make_tuple(extensionGetter, checkFunc, streamLoader, fileLoader, memoryLoader));
 	}
+
+	template<typename Type, typename Parameters>
+	bool ResourceLoader<Type, Parameters>::GetFileExtension(const String& filePath, String* path, String* extension)
+	{
+		*path = File::NormalizePath(filePath);
+		*extension = path->SubStringFrom('.', -1, true).ToLower();
+		if (extension->IsEmpty())
+		{
+			NazaraError("Failed to get file extension from \"" + filePath + '"');
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename Type, typename Parameters>
+	template<typename F>
+	bool ResourceLoader<Type, Parameters>::LoadFromFileStream(Type* resource, const String& filePath, const String& extension, F openStream, const Parameters& parameters)
+	{
+		// openStream is only called if a loader needs the stream
+		Stream* stream = nullptr;
+
+		bool found = false;
+		for (Loader& loader : Type::s_loaders)
+		{
+			ExtensionGetter isExtensionSupported = std::get<0>(loader);
+			if (!isExtensionSupported || !isExtensionSupported(extension))
+				continue;
+
+			StreamChecker checkFunc = std::get<1>(loader);
+			StreamLoader streamLoader = std::get<2>(loader);
+			FileLoader fileLoader = std::get<3>(loader);
+
+			if (checkFunc)
+			{
+				stream = openStream();
+				if (!stream)
+					return false;
+			}
+
+			Ternary recognized = Ternary_Unknown;
+			if (fileLoader)
+			{
+				if (checkFunc)
+				{
+					stream->SetCursorPos(0);
+
+					recognized = checkFunc(*stream, parameters);
+					if (recognized == Ternary_False)
+						continue;
+					else
+						found = true;
+				}
+				else
+				{
+					recognized = Ternary_Unknown;
+					found = true;
+				}
+
+				if (fileLoader(resource, filePath, parameters))
+				{
+					resource->SetFilePath(filePath);
+					return true;
+				}
+			}
+			else
+			{
+				stream->SetCursorPos(0);
+
+				recognized = checkFunc(*stream, parameters);
+				if (recognized == Ternary_False)
+					continue;
+				else if (recognized == Ternary_True)
+					found = true;
+
+				stream->SetCursorPos(0);
+
+				if (streamLoader(resource, *stream, parameters))
+				{
+					resource->SetFilePath(filePath);
+					return true;
+				}
+			}
+
+			if (recognized == Ternary_True)
+				NazaraWarning("Loader failed");
+		}
+
+		if (found)
+			NazaraError("Failed to load file: all loaders failed");
+		else
+			NazaraError("Failed to load file: no loader found for extension \"" + extension + '"');
+
+		return false;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -7,9 +7,12 @@
 #ifndef NAZARA_RESOURCEMANAGER_HPP
 #define NAZARA_RESOURCEMANAGER_HPP
 
+#include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Core/StringAtom.hpp>
 #include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
@@ -19,25 +22,81 @@ namespace Nz
 		friend Type;
 
 		public:
+			struct ResourceInfo;
+
 			ResourceManager() = delete;
 			~ResourceManager() = delete;
 
+			static bool Cancel(const String& filePath);
 			static void Clear();
 
-			static ObjectRef<Type> Get(const String& filePath);
+			static void EnableStreaming(bool streaming);
+
+			static ObjectRef<Type> Get(const String& filePath, int priority = 0);
 			static const Parameters& GetDefaultParameters();
+			static bool GetInfo(const String& filePath, ResourceInfo* info);
+			static unsigned int GetMaxConcurrentLoads();
+			static UInt64 GetMemoryBudget();
+			static UInt64 GetResidentSize();
+
+			static bool IsStreamingEnabled();
 
 			static void Purge();
 			static void Register(const String& filePath, ObjectRef<Type> resource);
 			static void SetDefaultParameters(const Parameters& params);
+			static void SetMaxConcurrentLoads(unsigned int maxConcurrentLoads);
+			static void SetMemoryBudget(UInt64 budget);
+			static bool SetPriority(const String& filePath, int priority);
 			static void Unregister(const String& filePath);
+			static void Update();
 
 		private:
+			struct Entry;
+			struct StreamingState;
+
+			static void Evict(UInt64 budget);
 			static bool Initialize();
+			static void OnLoadFinished(const StringAtom& filePath, Type* resource, UInt64 generation, const void* data, std::size_t size);
+			static void StartLoad(const StringAtom& filePath, Entry& entry);
 			static void Uninitialize();
 
-			using ManagerMap = std::unordered_map<String, ObjectRef<Type>>;
+			using ManagerMap = std::unordered_map<StringAtom, Entry>;
 			using ManagerParams = Parameters;
+			using ManagerState = StreamingState;
+	};
+
+	template<typename Type, typename Parameters>
+	struct ResourceManager<Type, Parameters>::ResourceInfo
+	{
+		UInt64 loadLatency;  // Microseconds between the request and the end of the loading
+		UInt64 residentSize; // Bytes used by the resource (its file size if the type can't tell)
+		int priority;
+		ResourceState state;
+	};
+
+	template<typename Type, typename Parameters>
+	struct ResourceManager<Type, Parameters>::Entry
+	{
+		ObjectRef<Type> resource;
+		UInt64 lastUse;
+		UInt64 loadLatency;
+		UInt64 requestTime;
+		UInt64 residentSize;
+		int priority;
+		ResourceState state;
+	};
+
+	template<typename Type, typename Parameters>
+	struct ResourceManager<Type, Parameters>::StreamingState
+	{
+		std::vector<StringAtom> queue;
+		UInt64 generation = 0;
+		UInt64 memoryBudget = 0;
+		UInt64 residentSize = 0;
+		UInt64 useCounter = 0;
+		unsigned int loadingCount = 0;
+		unsigned int maxConcurrentLoads = 4;
+		bool streaming = false;
 	};
 }
 
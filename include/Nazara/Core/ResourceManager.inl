@@ -2,33 +2,134 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/AsyncFileService.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <algorithm>
+#include <utility>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	namespace Detail
+	{
+		// Resources able to tell their memory usage (like images) report it, the file size is used otherwise
+		template<typename T>
+		auto GetResourceSize(const T& resource, UInt64 fileSize, int) -> decltype(static_cast<UInt64>(resource.GetMemoryUsage()))
+		{
+			NazaraUnused(fileSize);
+
+			return resource.GetMemoryUsage();
+		}
+
+		template<typename T>
+		UInt64 GetResourceSize(const T& resource, UInt64 fileSize, long)
+		{
+			NazaraUnused(resource);
+
+			return fileSize;
+		}
+	}
+
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::Cancel(const String& filePath)
+	{
+		///DOC: If its file is being read, the read finishes but the resource is not parsed
+		StringAtom absolutePath;
+		if (!StringAtom::Find(File::AbsolutePath(filePath), &absolutePath))
+			return false;
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it == Type::s_managerMap.end())
+			return false;
+
+		Entry& entry = it->second;
+		if (entry.state != ResourceState_Queued && entry.state != ResourceState_Loading)
+			return false;
+
+		if (entry.state == ResourceState_Queued)
+		{
+			std::vector<StringAtom>& queue = Type::s_managerState.queue;
+			queue.erase(std::find(queue.begin(), queue.end(), absolutePath));
+		}
+
+		Type::s_managerMap.erase(it);
+		return true;
+	}
+
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Clear()
 	{
+		StreamingState& state = Type::s_managerState;
+
+		// Loads in progress will be ignored when they complete
+		state.generation++;
+		state.loadingCount = 0;
+		state.queue.clear();
+		state.residentSize = 0;
+
 		Type::s_managerMap.clear();
 	}
 
 	template<typename Type, typename Parameters>
-	ObjectRef<Type> ResourceManager<Type, Parameters>::Get(const String& filePath)
+	void ResourceManager<Type, Parameters>::EnableStreaming(bool streaming)
 	{
+		///DOC: When streaming, Get returns an empty resource right away and Update loads it in the background
+		Type::s_managerState.streaming = streaming;
+	}
+
+	template<typename Type, typename Parameters>
+	ObjectRef<Type> ResourceManager<Type, Parameters>::Get(const String& filePath, int priority)
+	{
+		///DOC: The priority is only used when streaming, resources with a higher priority are loaded first
+		StreamingState& state = Type::s_managerState;
+
 		String absolutePath = File::AbsolutePath(filePath);
-		auto it = Type::s_managerMap.find(absolutePath);
-		if (it == Type::s_managerMap.end())
+
+		// The path is only interned once the resource is known, a failed load shouldn't leave an atom behind
+		StringAtom pathAtom;
+		if (StringAtom::Find(absolutePath, &pathAtom))
 		{
-			ObjectRef<Type> resource = Type::New();
-			if (!resource)
+			auto it = Type::s_managerMap.find(pathAtom);
+			if (it != Type::s_managerMap.end())
 			{
-				NazaraError("Failed to create resource");
-				return ObjectRef<Type>();
+				Entry& entry = it->second;
+				entry.lastUse = ++state.useCounter;
+
+				if (entry.state == ResourceState_Queued)
+					entry.priority = std::max(entry.priority, priority);
+
+				return entry.resource;
 			}
+		}
 
+		ObjectRef<Type> resource = Type::New();
+		if (!resource)
+		{
+			NazaraError("Failed to create resource");
+			return ObjectRef<Type>();
+		}
+
+		Entry entry;
+		entry.resource = resource;
+		entry.lastUse = ++state.useCounter;
+		entry.loadLatency = 0;
+		entry.priority = priority;
+		entry.requestTime = GetElapsedMicroseconds();
+		entry.residentSize = 0;
+
+		if (state.streaming)
+		{
+			pathAtom = StringAtom(absolutePath);
+
+			entry.state = ResourceState_Queued;
+			state.queue.push_back(pathAtom);
+		}
+		else
+		{
 			if (!resource->LoadFromFile(absolutePath, GetDefaultParameters()))
 			{
 				NazaraError("Failed to load resource from file: " + absolutePath);
@@ -37,10 +138,18 @@ namespace Nz
 
 			NazaraDebug("Loaded resource from file " + absolutePath);
 
-			it = Type::s_managerMap.insert(std::make_pair(absolutePath, resource)).first;
+			pathAtom = StringAtom(absolutePath);
+
+			entry.loadLatency = GetElapsedMicroseconds() - entry.requestTime;
+			entry.residentSize = Detail::GetResourceSize(*resource, File::GetSize(absolutePath), 0);
+			entry.state = ResourceState_Loaded;
+
+			state.residentSize += entry.residentSize;
 		}
 
-		return it->second;
+		Type::s_managerMap.insert(std::make_pair(pathAtom, std::move(entry)));
+
+		return resource;
 	}
 
 	template<typename Type, typename Parameters>
@@ -49,16 +158,68 @@ namespace Nz
 		return Type::s_managerParameters;
 	}
 
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::GetInfo(const String& filePath, ResourceInfo* info)
+	{
+		NazaraAssert(info, "Invalid info");
+
+		StringAtom absolutePath;
+		if (!StringAtom::Find(File::AbsolutePath(filePath), &absolutePath))
+			return false;
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it == Type::s_managerMap.end())
+			return false;
+
+		const Entry& entry = it->second;
+		info->loadLatency = entry.loadLatency;
+		info->priority = entry.priority;
+		info->residentSize = entry.residentSize;
+		info->state = entry.state;
+
+		return true;
+	}
+
+	template<typename Type, typename Parameters>
+	unsigned int ResourceManager<Type, Parameters>::GetMaxConcurrentLoads()
+	{
+		return Type::s_managerState.maxConcurrentLoads;
+	}
+
+	template<typename Type, typename Parameters>
+	UInt64 ResourceManager<Type, Parameters>::GetMemoryBudget()
+	{
+		return Type::s_managerState.memoryBudget;
+	}
+
+	template<typename Type, typename Parameters>
+	UInt64 ResourceManager<Type, Parameters>::GetResidentSize()
+	{
+		return Type::s_managerState.residentSize;
+	}
+
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::IsStreamingEnabled()
+	{
+		return Type::s_managerState.streaming;
+	}
+
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Purge()
 	{
 		auto it = Type::s_managerMap.begin();
 		while (it != Type::s_managerMap.end())
 		{
-			const ObjectRef<Type>& ref = it->second;
-			if (ref.GetReferenceCount() == 1) // Sommes-nous les seuls à détenir la ressource ?
+			const Entry& entry = it->second;
+			const ObjectRef<Type>& ref = entry.resource;
+
+			// Resources waiting to be loaded are kept, use Cancel to forget them
+			bool pending = (entry.state == ResourceState_Queued || entry.state == ResourceState_Loading);
+			if (!pending && (!ref || ref->GetReferenceCount() == 1)) // Sommes-nous les seuls à détenir la ressource ?
 			{
-				NazaraDebug("Purging resource from file " + ref->GetFilePath());
+				NazaraDebug("Purging resource from file " + it->first.GetString());
+
+				Type::s_managerState.residentSize -= entry.residentSize;
 				Type::s_managerMap.erase(it++); // Alors on la supprime
 			}
 			else
@@ -71,7 +232,19 @@ namespace Nz
 	{
 		String absolutePath = File::AbsolutePath(filePath);
 
-		Type::s_managerMap[absolutePath] = resource;
+		Unregister(absolutePath);
+
+		Entry entry;
+		entry.lastUse = ++Type::s_managerState.useCounter;
+		entry.loadLatency = 0;
+		entry.priority = 0;
+		entry.requestTime = 0;
+		entry.residentSize = (resource) ? Detail::GetResourceSize(*resource, 0, 0) : 0;
+		entry.resource = std::move(resource);
+		entry.state = ResourceState_Loaded;
+
+		Type::s_managerState.residentSize += entry.residentSize;
+		Type::s_managerMap.insert(std::make_pair(StringAtom(absolutePath), std::move(entry)));
 	}
 
 	template<typename Type, typename Parameters>
@@ -80,12 +253,110 @@ namespace Nz
 		Type::s_managerParameters = params;
 	}
 
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::SetMaxConcurrentLoads(unsigned int maxConcurrentLoads)
+	{
+		NazaraAssert(maxConcurrentLoads > 0, "At least one load must be allowed");
+
+		Type::s_managerState.maxConcurrentLoads = maxConcurrentLoads;
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::SetMemoryBudget(UInt64 budget)
+	{
+		///DOC: A budget of zero means no limit
+		Type::s_managerState.memoryBudget = budget;
+	}
+
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::SetPriority(const String& filePath, int priority)
+	{
+		StringAtom absolutePath;
+		if (!StringAtom::Find(File::AbsolutePath(filePath), &absolutePath))
+			return false;
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it == Type::s_managerMap.end())
+			return false;
+
+		it->second.priority = priority;
+		return true;
+	}
+
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Unregister(const String& filePath)
 	{
-		String absolutePath = File::AbsolutePath(filePath);
+		StringAtom absolutePath;
+		if (!StringAtom::Find(File::AbsolutePath(filePath), &absolutePath))
+			return;
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it == Type::s_managerMap.end())
+			return;
+
+		if (it->second.state == ResourceState_Queued)
+		{
+			std::vector<StringAtom>& queue = Type::s_managerState.queue;
+			queue.erase(std::find(queue.begin(), queue.end(), absolutePath));
+		}
 
-		Type::s_managerMap.erase(absolutePath);
+		Type::s_managerState.residentSize -= it->second.residentSize;
+		Type::s_managerMap.erase(it);
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::Update()
+	{
+		///DOC: This should be called once per frame
+		StreamingState& state = Type::s_managerState;
+
+		if (!state.queue.empty() && state.loadingCount < state.maxConcurrentLoads)
+		{
+			// Highest priority first, in request order for a same priority
+			std::stable_sort(state.queue.begin(), state.queue.end(), [](const StringAtom& lhs, const StringAtom& rhs)
+			{
+				return Type::s_managerMap.find(lhs)->second.priority > Type::s_managerMap.find(rhs)->second.priority;
+			});
+
+			std::size_t startCount = std::min<std::size_t>(state.queue.size(), state.maxConcurrentLoads - state.loadingCount);
+			for (std::size_t i = 0; i < startCount; ++i)
+				StartLoad(state.queue[i], Type::s_managerMap.find(state.queue[i])->second);
+
+			state.queue.erase(state.queue.begin(), state.queue.begin() + startCount);
+		}
+
+		if (state.memoryBudget > 0 && state.residentSize > state.memoryBudget)
+			Evict(state.memoryBudget);
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::Evict(UInt64 budget)
+	{
+		std::vector<std::pair<UInt64, StringAtom>> candidates;
+		for (auto& pair : Type::s_managerMap)
+		{
+			const Entry& entry = pair.second;
+			if (entry.state == ResourceState_Loaded && entry.resource && entry.resource->GetReferenceCount() == 1)
+				candidates.emplace_back(entry.lastUse, pair.first);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const std::pair<UInt64, StringAtom>& lhs, const std::pair<UInt64, StringAtom>& rhs)
+		{
+			return lhs.first < rhs.first;
+		});
+
+		StreamingState& state = Type::s_managerState;
+		for (const auto& candidate : candidates)
+		{
+			if (state.residentSize <= budget)
+				break;
+
+			NazaraDebug("Evicting resource from file " + candidate.second.GetString());
+
+			auto it = Type::s_managerMap.find(candidate.second);
+			state.residentSize -= it->second.residentSize;
+			Type::s_managerMap.erase(it);
+		}
 	}
 
 	template<typename Type, typename Parameters>
@@ -94,6 +365,68 @@ namespace Nz
 		return true;
 	}
 
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::OnLoadFinished(const StringAtom& filePath, Type* resource, UInt64 generation, const void* data, std::size_t size)
+	{
+		StreamingState& state = Type::s_managerState;
+		if (generation != state.generation)
+			return; // The manager has been cleared since
+
+		state.loadingCount--;
+
+		auto it = Type::s_managerMap.find(filePath);
+		if (it == Type::s_managerMap.end() || it->second.resource.Get() != resource)
+			return; // Cancelled
+
+		bool loaded = false;
+		if (data)
+		{
+			// The view carries the file path, loaders resolving files relative to their input (materials, textures) still find them
+			MemoryView stream(data, size, filePath.GetString());
+			loaded = resource->LoadFromStream(stream, GetDefaultParameters());
+		}
+
+		Entry& entry = it->second;
+		entry.loadLatency = GetElapsedMicroseconds() - entry.requestTime;
+
+		if (!loaded)
+		{
+			NazaraError("Failed to load resource from file: " + filePath.GetString());
+
+			entry.state = ResourceState_Failed;
+			return;
+		}
+
+		NazaraDebug("Loaded resource from file " + filePath.GetString());
+
+		resource->SetFilePath(filePath.GetString());
+
+		entry.residentSize = Detail::GetResourceSize(*resource, size, 0);
+		entry.state = ResourceState_Loaded;
+
+		state.residentSize += entry.residentSize;
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::StartLoad(const StringAtom& filePath, Entry& entry)
+	{
+		StreamingState& state = Type::s_managerState;
+		state.loadingCount++;
+
+		entry.state = ResourceState_Loading;
+
+		// The callback holds a reference so the resource survives until the end of the load
+		ObjectRef<Type> resource = entry.resource;
+		UInt64 generation = state.generation;
+		AsyncFileService::Read(filePath.GetString(), [filePath, generation, resource](AsyncFileService::ReadResult& result)
+		{
+			if (result.success)
+				OnLoadFinished(filePath, resource, generation, result.data.GetConstBuffer(), result.data.GetSize());
+			else
+				OnLoadFinished(filePath, resource, generation, nullptr, 0);
+		});
+	}
+
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Uninitialize()
 	{
@@ -22,6 +22,7 @@ namespace Nz
 			Serializer(Serializer&&) = default;
 			~Serializer();
 
+			inline SerializationContext& GetContext();
 			inline Endianness GetDataEndianness() const;
 			inline Stream& GetStream() const;
 
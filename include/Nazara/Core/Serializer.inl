@@ -20,6 +20,11 @@ namespace Nz
 			NazaraWarning("Failed to flush bits at serializer destruction");
 	}
 
+	inline SerializationContext& Serializer::GetContext()
+	{
+		return m_serializationContext;
+	}
+
 	inline Endianness Serializer::GetDataEndianness() const
 	{
 		return m_serializationContext.endianness;
@@ -7,8 +7,11 @@
 #ifndef NAZARA_SIGNAL_HPP
 #define NAZARA_SIGNAL_HPP
 
+#include <Nazara/Prerequesites.hpp>
+#include <atomic>
+#include <deque>
 #include <functional>
-#include <memory>
+#include <type_traits>
 #include <vector>
 
 #define NazaraDetailSignal(Keyword, SignalName, ...) using SignalName ## Type = Nz::Signal<__VA_ARGS__>; \
@@ -33,8 +36,8 @@ namespace Nz
 
 			Signal();
 			Signal(const Signal&) = delete;
-			Signal(Signal&& signal);
-			~Signal() = default;
+			Signal(Signal&& signal) noexcept;
+			~Signal();
 
 			void Clear();
 
@@ -48,31 +51,69 @@ namespace Nz
 			void operator()(Args... args) const;
 
 			Signal& operator=(const Signal&) = delete;
-			Signal& operator=(Signal&& signal);
+			Signal& operator=(Signal&& signal) noexcept;
 
 		private:
 			struct Slot;
+			struct SlotTable;
 
-			using SlotPtr = std::shared_ptr<Slot>;
-			using SlotList = std::vector<SlotPtr>;
-			using SlotListIndex = typename SlotList::size_type;
+			using SlotIndex = UInt32;
+
+			template<typename F> Connection ConnectCallable(F&& func);
+
+			static void Disconnect(SlotTable* table, SlotIndex handleIndex);
+			static void DisconnectAll(SlotTable* table);
+			template<typename F> static void InvokeHeap(Slot& slot, Args... args);
+			template<typename F> static void InvokeInline(Slot& slot, Args... args);
+			template<typename F> static void ManageHeap(Slot* destination, Slot& source);
+			template<typename F> static void ManageInline(Slot* destination, Slot& source);
+			static void ReleaseTable(SlotTable* table);
+			static void RemoveDisconnectedSlots(SlotTable* table);
+			template<typename F> static void StoreCallable(Slot& slot, F&& func, std::false_type /*fitsInline*/);
+			template<typename F> static void StoreCallable(Slot& slot, F&& func, std::true_type /*fitsInline*/);
+
+			static constexpr SlotIndex InvalidIndex = 0xFFFFFFFF;
+
+			// Connections refer to their slot through a handle, which stays valid when slots are moved around
+			struct Handle
+			{
+				SlotIndex slotIndex; //< Next free handle when not in use
+				UInt32 generation;
+			};
 
 			struct Slot
 			{
-				Slot(Signal* me) :
-				signal(me)
-				{
-				}
-
-				Callback callback;
-				Signal* signal;
-				SlotListIndex index;
+				using InvokeFunction = void(*)(Slot& slot, Args... args);
+				using ManageFunction = void(*)(Slot* destination, Slot& source);
+
+				Slot() = default;
+				Slot(const Slot&) = delete;
+				Slot(Slot&& slot) noexcept;
+				~Slot();
+
+				Slot& operator=(const Slot&) = delete;
+				Slot& operator=(Slot&& slot) noexcept;
+
+				typename std::aligned_storage<sizeof(Callback), alignof(Callback)>::type storage; //< Callable, or pointer to it if too big
+				InvokeFunction invoke = nullptr; //< Null once disconnected
+				ManageFunction manage = nullptr;
+				SlotIndex handleIndex = InvalidIndex;
 			};
 
-			void Disconnect(const SlotPtr& slot);
+			// Allocated with the first connection and shared with the connections, which may outlive the signal
+			// Only its lifetime is thread-safe: connections may be released from another thread, but emitting and connecting are not
+			struct SlotTable
+			{
+				std::vector<Handle> handles;
+				std::deque<Slot> pendingSlots; //< Connected during an emission, added to the slots once it's over (a deque keeps them in place while growing)
+				std::vector<Slot> slots;
+				SlotIndex firstFreeHandle = InvalidIndex;
+				unsigned int emissionDepth = 0;
+				std::atomic<unsigned int> referenceCount{1};
+				bool hasDisconnectedSlots = false;
+			};
 
-			SlotList m_slots;
-			mutable SlotListIndex m_slotIterator;
+			SlotTable* m_slotTable;
 	};
 
 	template<typename... Args>
@@ -82,10 +123,10 @@ namespace Nz
 		friend BaseClass;
 
 		public:
-			Connection() = default;
-			Connection(const Connection& connection) = default;
-			Connection(Connection&& connection) = default;
-			~Connection() = default;
+			Connection();
+			Connection(const Connection& connection);
+			Connection(Connection&& connection) noexcept;
+			~Connection();
 
 			template<typename... ConnectArgs>
 			void Connect(BaseClass& signal, ConnectArgs&&... args);
@@ -93,13 +134,15 @@ namespace Nz
 
 			bool IsConnected() const;
 
-			Connection& operator=(const Connection& connection) = default;
-			Connection& operator=(Connection&& connection) = default;
+			Connection& operator=(const Connection& connection);
+			Connection& operator=(Connection&& connection) noexcept;
 
 		private:
-			Connection(const SlotPtr& slot);
+			Connection(SlotTable* table, SlotIndex handleIndex, UInt32 generation);
 
-			std::weak_ptr<Slot> m_ptr;
+			SlotTable* m_slotTable;
+			SlotIndex m_handleIndex;
+			UInt32 m_generation;
 	};
 
 	template<typename... Args>
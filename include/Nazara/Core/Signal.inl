@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
 #include <utility>
 #include <Nazara/Core/Debug.hpp>
 
@@ -10,21 +11,33 @@ namespace Nz
 {
 	template<typename... Args>
 	Signal<Args...>::Signal() :
-	m_slotIterator(0)
+	m_slotTable(nullptr)
 	{
 	}
 
 	template<typename... Args>
-	Signal<Args...>::Signal(Signal&& signal)
+	Signal<Args...>::Signal(Signal&& signal) noexcept :
+	m_slotTable(signal.m_slotTable)
 	{
-		operator=(std::move(signal));
+		signal.m_slotTable = nullptr;
+	}
+
+	template<typename... Args>
+	Signal<Args...>::~Signal()
+	{
+		///DOC: Connections to a destroyed signal are disconnected, even if it's destroyed during its emission
+		if (m_slotTable)
+		{
+			DisconnectAll(m_slotTable);
+			ReleaseTable(m_slotTable);
+		}
 	}
 
 	template<typename... Args>
 	void Signal<Args...>::Clear()
 	{
-		m_slots.clear();
-		m_slotIterator = 0;
+		if (m_slotTable)
+			DisconnectAll(m_slotTable);
 	}
 
 	template<typename... Args>
@@ -38,27 +51,14 @@ namespace Nz
 	{
 		NazaraAssert(func, "Invalid function");
 
-		// Since we're incrementing the slot vector size, we need to replace our iterator at the end
-		// (Except when we are iterating on the signal)
-		bool resetIt = (m_slotIterator >= m_slots.size());
-
-		auto tempPtr = std::make_shared<Slot>(this);
-		tempPtr->callback = std::move(func);
-		tempPtr->index = m_slots.size();
-
-		m_slots.emplace_back(std::move(tempPtr));
-
-		if (resetIt)
-			m_slotIterator = m_slots.size(); //< Replace the iterator to the end
-
-		return Connection(m_slots.back());
+		return ConnectCallable(std::move(func));
 	}
 
 	template<typename... Args>
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(O& object, void (O::*method) (Args...))
 	{
-		return Connect([&object, method] (Args&&... args)
+		return ConnectCallable([&object, method] (Args&&... args)
 		{
 			return (object .* method) (std::forward<Args>(args)...);
 		});
@@ -68,7 +68,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(O* object, void (O::*method)(Args...))
 	{
-		return Connect([object, method] (Args&&... args)
+		return ConnectCallable([object, method] (Args&&... args)
 		{
 			return (object ->* method) (std::forward<Args>(args)...);
 		});
@@ -78,7 +78,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(const O& object, void (O::*method) (Args...) const)
 	{
-		return Connect([&object, method] (Args&&... args)
+		return ConnectCallable([&object, method] (Args&&... args)
 		{
 			return (object .* method) (std::forward<Args>(args)...);
 		});
@@ -88,7 +88,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(const O* object, void (O::*method)(Args...) const)
 	{
-		return Connect([object, method] (Args&&... args)
+		return ConnectCallable([object, method] (Args&&... args)
 		{
 			return (object ->* method) (std::forward<Args>(args)...);
 		});
@@ -97,64 +97,372 @@ namespace Nz
 	template<typename... Args>
 	void Signal<Args...>::operator()(Args... args) const
 	{
-		for (m_slotIterator = 0; m_slotIterator < m_slots.size(); ++m_slotIterator)
-			m_slots[m_slotIterator]->callback(args...);
+		///DOC: Slots disconnected during the emission are not called anymore, slots connected during it are called last
+		SlotTable* table = m_slotTable;
+		if (!table)
+			return;
+
+		// Ends the emission even if a slot throws
+		struct EmissionGuard
+		{
+			EmissionGuard(SlotTable* slotTable) :
+			table(slotTable)
+			{
+				table->emissionDepth++;
+				table->referenceCount++;
+			}
+
+			~EmissionGuard()
+			{
+				if (--table->emissionDepth == 0 && (table->hasDisconnectedSlots || !table->pendingSlots.empty()))
+					RemoveDisconnectedSlots(table);
+
+				ReleaseTable(table);
+			}
+
+			SlotTable* table;
+		};
+
+		// Slots are not moved nor destroyed during an emission, the table itself is kept alive even if the signal is destroyed
+		EmissionGuard guard(table);
+
+		std::size_t slotCount = table->slots.size();
+		for (std::size_t i = 0; i < slotCount; ++i)
+		{
+			Slot& slot = table->slots[i];
+			if (slot.invoke)
+				slot.invoke(slot, args...);
+		}
+
+		// Pending slots don't move when more are connected, the size has to be read again at each iteration
+		for (std::size_t i = 0; i < table->pendingSlots.size(); ++i)
+		{
+			Slot& slot = table->pendingSlots[i];
+			if (slot.invoke)
+				slot.invoke(slot, args...);
+		}
 	}
 
 	template<typename... Args>
-	Signal<Args...>& Signal<Args...>::operator=(Signal&& signal)
+	Signal<Args...>& Signal<Args...>::operator=(Signal&& signal) noexcept
 	{
-		m_slots = std::move(signal.m_slots);
-		m_slotIterator = signal.m_slotIterator;
-
-		// We need to update the signal pointer inside of each slot
-		for (SlotPtr& slot : m_slots)
-			slot->signal = this;
+		if (this != &signal)
+		{
+			if (m_slotTable)
+			{
+				DisconnectAll(m_slotTable);
+				ReleaseTable(m_slotTable);
+			}
+
+			m_slotTable = signal.m_slotTable;
+			signal.m_slotTable = nullptr;
+		}
 
 		return *this;
 	}
 
 	template<typename... Args>
-	void Signal<Args...>::Disconnect(const SlotPtr& slot)
+	template<typename F>
+	typename Signal<Args...>::Connection Signal<Args...>::ConnectCallable(F&& func)
 	{
-		NazaraAssert(slot, "Invalid slot pointer");
-		NazaraAssert(slot->index < m_slots.size(), "Invalid slot index");
+		using Functor = typename std::decay<F>::type;
 
-		// "Swap this slot with the last one and pop" idiom
-		// This will preserve slot indexes
+		if (!m_slotTable)
+			m_slotTable = new SlotTable;
 
-		// Can we safely "remove" this slot?
-		if (m_slotIterator >= m_slots.size()-1 || slot->index > m_slotIterator)
+		SlotTable* table = m_slotTable;
+
+		SlotIndex handleIndex;
+		if (table->firstFreeHandle != InvalidIndex)
 		{
-			// Yes we can
-			SlotPtr& newSlot = m_slots[slot->index];
-			newSlot = std::move(m_slots.back());
-			newSlot->index = slot->index; //< Update the moved slot index before resizing (in case it's the last one)
+			handleIndex = table->firstFreeHandle;
+			table->firstFreeHandle = table->handles[handleIndex].slotIndex;
 		}
 		else
 		{
-			// Nope, let's be tricky
-			SlotPtr& current = m_slots[m_slotIterator];
-			SlotPtr& newSlot = m_slots[slot->index];
+			handleIndex = static_cast<SlotIndex>(table->handles.size());
+			table->handles.push_back(Handle{InvalidIndex, 0});
+		}
+
+		Slot slot;
+		slot.handleIndex = handleIndex;
+		StoreCallable(slot, std::forward<F>(func), std::integral_constant<bool, sizeof(Functor) <= sizeof(slot.storage) && alignof(Functor) <= alignof(decltype(slot.storage))>());
+
+		Handle& handle = table->handles[handleIndex];
+		if (table->emissionDepth > 0)
+		{
+			// Adding a slot could move the slot being called
+			handle.slotIndex = static_cast<SlotIndex>(table->slots.size() + table->pendingSlots.size());
+			table->pendingSlots.emplace_back(std::move(slot));
+		}
+		else
+		{
+			handle.slotIndex = static_cast<SlotIndex>(table->slots.size());
+			table->slots.emplace_back(std::move(slot));
+		}
+
+		return Connection(table, handleIndex, handle.generation);
+	}
+
+	template<typename... Args>
+	void Signal<Args...>::Disconnect(SlotTable* table, SlotIndex handleIndex)
+	{
+		NazaraAssert(handleIndex < table->handles.size(), "Invalid handle index");
+
+		Handle& handle = table->handles[handleIndex];
+		SlotIndex slotIndex = handle.slotIndex;
+
+		// Any connection still referring to this handle is now invalid
+		handle.generation++;
+		handle.slotIndex = table->firstFreeHandle;
+		table->firstFreeHandle = handleIndex;
+
+		if (table->emissionDepth > 0)
+		{
+			// The slot may be running, it's only released once the emission is over
+			Slot& slot = (slotIndex < table->slots.size()) ? table->slots[slotIndex] : table->pendingSlots[slotIndex - table->slots.size()];
+			slot.handleIndex = InvalidIndex;
+			slot.invoke = nullptr;
+
+			table->hasDisconnectedSlots = true;
+		}
+		else
+		{
+			// "Swap this slot with the last one and pop" idiom
+			NazaraAssert(slotIndex < table->slots.size(), "Invalid slot index");
+
+			if (slotIndex != table->slots.size() - 1)
+			{
+				Slot& slot = table->slots[slotIndex];
+				slot = std::move(table->slots.back());
+				table->handles[slot.handleIndex].slotIndex = slotIndex;
+			}
+
+			table->slots.pop_back();
+		}
+	}
+
+	template<typename... Args>
+	void Signal<Args...>::DisconnectAll(SlotTable* table)
+	{
+		auto ReleaseHandles = [table](auto& slots)
+		{
+			for (Slot& slot : slots)
+			{
+				if (slot.handleIndex == InvalidIndex)
+					continue;
+
+				Handle& handle = table->handles[slot.handleIndex];
+				handle.generation++;
+				handle.slotIndex = table->firstFreeHandle;
+				table->firstFreeHandle = slot.handleIndex;
+
+				slot.handleIndex = InvalidIndex;
+				slot.invoke = nullptr;
+			}
+		};
+
+		ReleaseHandles(table->slots);
+		ReleaseHandles(table->pendingSlots);
+
+		if (table->emissionDepth > 0)
+			table->hasDisconnectedSlots = true;
+		else
+			table->slots.clear();
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::InvokeHeap(Slot& slot, Args... args)
+	{
+		F* functor = *reinterpret_cast<F**>(&slot.storage);
+		(*functor)(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::InvokeInline(Slot& slot, Args... args)
+	{
+		F& functor = *reinterpret_cast<F*>(&slot.storage);
+		functor(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::ManageHeap(Slot* destination, Slot& source)
+	{
+		// Moves the callable to the destination, or destroys it if there's none
+		F* functor = *reinterpret_cast<F**>(&source.storage);
+		if (destination)
+			*reinterpret_cast<F**>(&destination->storage) = functor;
+		else
+			delete functor;
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::ManageInline(Slot* destination, Slot& source)
+	{
+		// Moves the callable to the destination, or destroys it if there's none
+		F& functor = *reinterpret_cast<F*>(&source.storage);
+		if (destination)
+			PlacementNew<F>(&destination->storage, std::move(functor));
+
+		functor.~F();
+	}
+
+	template<typename... Args>
+	void Signal<Args...>::ReleaseTable(SlotTable* table)
+	{
+		if (--table->referenceCount == 0)
+			delete table;
+	}
+
+	template<typename... Args>
+	void Signal<Args...>::RemoveDisconnectedSlots(SlotTable* table)
+	{
+		// Called once the emission is over, the order of the remaining slots is kept
+		std::size_t slotCount = 0;
+		for (std::size_t i = 0; i < table->slots.size(); ++i)
+		{
+			Slot& slot = table->slots[i];
+			if (!slot.invoke)
+				continue;
+
+			if (i != slotCount)
+			{
+				table->slots[slotCount] = std::move(slot);
+				table->handles[table->slots[slotCount].handleIndex].slotIndex = static_cast<SlotIndex>(slotCount);
+			}
 
-			newSlot = std::move(current);
-			newSlot->index = slot->index; //< Update the moved slot index
+			slotCount++;
+		}
 
-			current = std::move(m_slots.back());
-			current->index = m_slotIterator; //< Update the moved slot index
+		table->slots.erase(table->slots.begin() + slotCount, table->slots.end());
+
+		for (Slot& slot : table->pendingSlots)
+		{
+			if (!slot.invoke)
+				continue;
 
-			--m_slotIterator;
+			table->handles[slot.handleIndex].slotIndex = static_cast<SlotIndex>(table->slots.size());
+			table->slots.emplace_back(std::move(slot));
 		}
 
-		// Pop the last entry (from where we moved our slot)
-		m_slots.pop_back();
+		table->pendingSlots.clear();
+		table->hasDisconnectedSlots = false;
 	}
 
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::StoreCallable(Slot& slot, F&& func, std::false_type)
+	{
+		using Functor = typename std::decay<F>::type;
+
+		*reinterpret_cast<Functor**>(&slot.storage) = new Functor(std::forward<F>(func));
+		slot.invoke = &InvokeHeap<Functor>;
+		slot.manage = &ManageHeap<Functor>;
+	}
 
 	template<typename... Args>
-	Signal<Args...>::Connection::Connection(const SlotPtr& slot) :
-	m_ptr(slot)
+	template<typename F>
+	void Signal<Args...>::StoreCallable(Slot& slot, F&& func, std::true_type)
 	{
+		using Functor = typename std::decay<F>::type;
+
+		PlacementNew<Functor>(&slot.storage, std::forward<F>(func));
+		slot.invoke = &InvokeInline<Functor>;
+		slot.manage = &ManageInline<Functor>;
+	}
+
+	template<typename... Args>
+	constexpr typename Signal<Args...>::SlotIndex Signal<Args...>::InvalidIndex;
+
+
+	template<typename... Args>
+	Signal<Args...>::Slot::Slot(Slot&& slot) noexcept :
+	invoke(slot.invoke),
+	manage(slot.manage),
+	handleIndex(slot.handleIndex)
+	{
+		if (manage)
+			manage(this, slot);
+
+		slot.invoke = nullptr;
+		slot.manage = nullptr;
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Slot::~Slot()
+	{
+		if (manage)
+			manage(nullptr, *this);
+	}
+
+	template<typename... Args>
+	typename Signal<Args...>::Slot& Signal<Args...>::Slot::operator=(Slot&& slot) noexcept
+	{
+		if (this != &slot)
+		{
+			if (manage)
+				manage(nullptr, *this);
+
+			invoke = slot.invoke;
+			manage = slot.manage;
+			handleIndex = slot.handleIndex;
+
+			if (manage)
+				manage(this, slot);
+
+			slot.invoke = nullptr;
+			slot.manage = nullptr;
+		}
+
+		return *this;
+	}
+
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection() :
+	m_slotTable(nullptr),
+	m_handleIndex(InvalidIndex),
+	m_generation(0)
+	{
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection(const Connection& connection) :
+	m_slotTable(connection.m_slotTable),
+	m_handleIndex(connection.m_handleIndex),
+	m_generation(connection.m_generation)
+	{
+		if (m_slotTable)
+			m_slotTable->referenceCount++;
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection(Connection&& connection) noexcept :
+	m_slotTable(connection.m_slotTable),
+	m_handleIndex(connection.m_handleIndex),
+	m_generation(connection.m_generation)
+	{
+		connection.m_slotTable = nullptr;
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection(SlotTable* table, SlotIndex handleIndex, UInt32 generation) :
+	m_slotTable(table),
+	m_handleIndex(handleIndex),
+	m_generation(generation)
+	{
+		m_slotTable->referenceCount++;
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Connection::~Connection()
+	{
+		if (m_slotTable)
+			ReleaseTable(m_slotTable);
 	}
 
 	template<typename... Args>
@@ -167,14 +475,48 @@ namespace Nz
 	template<typename... Args>
 	void Signal<Args...>::Connection::Disconnect()
 	{
-		if (SlotPtr ptr = m_ptr.lock())
-			ptr->signal->Disconnect(ptr);
+		if (IsConnected())
+			BaseClass::Disconnect(m_slotTable, m_handleIndex);
 	}
 
 	template<typename... Args>
 	bool Signal<Args...>::Connection::IsConnected() const
 	{
-		return !m_ptr.expired();
+		return m_slotTable && m_slotTable->handles[m_handleIndex].generation == m_generation;
+	}
+
+	template<typename... Args>
+	typename Signal<Args...>::Connection& Signal<Args...>::Connection::operator=(const Connection& connection)
+	{
+		if (connection.m_slotTable)
+			connection.m_slotTable->referenceCount++;
+
+		if (m_slotTable)
+			ReleaseTable(m_slotTable);
+
+		m_slotTable = connection.m_slotTable;
+		m_handleIndex = connection.m_handleIndex;
+		m_generation = connection.m_generation;
+
+		return *this;
+	}
+
+	template<typename... Args>
+	typename Signal<Args...>::Connection& Signal<Args...>::Connection::operator=(Connection&& connection) noexcept
+	{
+		if (this != &connection)
+		{
+			if (m_slotTable)
+				ReleaseTable(m_slotTable);
+
+			m_slotTable = connection.m_slotTable;
+			m_handleIndex = connection.m_handleIndex;
+			m_generation = connection.m_generation;
+
+			connection.m_slotTable = nullptr;
+		}
+
+		return *this;
 	}
 
 
@@ -0,0 +1,111 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STACKARENA_HPP
+#define NAZARA_STACKARENA_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API StackArena
+	{
+		public:
+			struct Marker;
+			class ScopedMarker;
+
+			StackArena(std::size_t blockSize = 64 * 1024);
+			StackArena(const StackArena&) = delete;
+			StackArena(StackArena&&) = default;
+			~StackArena() = default;
+
+			inline void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+			template<typename T> T* AllocateArray(std::size_t count);
+
+			inline std::size_t GetAllocatedBytes() const;
+			std::size_t GetCapacity() const;
+			inline Marker GetMarker() const;
+			inline unsigned int GetOverflowCount() const;
+			inline std::size_t GetPeakBytes() const;
+
+			void Reset();
+			void ResetStats();
+			inline void Rewind(const Marker& marker);
+
+			StackArena& operator=(const StackArena&) = delete;
+			StackArena& operator=(StackArena&&) = default;
+
+			struct Marker
+			{
+				std::size_t allocatedBytes;
+				std::size_t blockIndex;
+				std::size_t offset;
+			};
+
+			class ScopedMarker
+			{
+				public:
+					inline ScopedMarker(StackArena& arena);
+					ScopedMarker(const ScopedMarker&) = delete;
+					ScopedMarker(ScopedMarker&&) = delete;
+					inline ~ScopedMarker();
+
+					ScopedMarker& operator=(const ScopedMarker&) = delete;
+					ScopedMarker& operator=(ScopedMarker&&) = delete;
+
+				private:
+					StackArena& m_arena;
+					Marker m_marker;
+			};
+
+		private:
+			struct Block
+			{
+				std::unique_ptr<UInt8[]> memory;
+				std::size_t size;
+			};
+
+			void* AllocateFromNextBlock(std::size_t size, std::size_t alignment);
+
+			std::vector<Block> m_blocks;
+			std::size_t m_allocatedBytes;
+			std::size_t m_blockIndex;
+			std::size_t m_blockSize;
+			std::size_t m_offset;
+			std::size_t m_peakBytes;
+			unsigned int m_overflowCount;
+	};
+
+	template<typename T>
+	class StackAllocator
+	{
+		public:
+			using value_type = T;
+
+			inline StackAllocator(StackArena& arena);
+			template<typename U> StackAllocator(const StackAllocator<U>& allocator);
+
+			inline T* allocate(std::size_t count);
+			inline void deallocate(T* ptr, std::size_t count);
+
+			inline StackArena& GetArena() const;
+
+			template<typename U> struct rebind { using other = StackAllocator<U>; };
+
+		private:
+			StackArena* m_arena;
+	};
+
+	template<typename T, typename U> bool operator==(const StackAllocator<T>& lhs, const StackAllocator<U>& rhs);
+	template<typename T, typename U> bool operator!=(const StackAllocator<T>& lhs, const StackAllocator<U>& rhs);
+}
+
+#include <Nazara/Core/StackArena.inl>
+
+#endif // NAZARA_STACKARENA_HPP
@@ -0,0 +1,133 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline void* StackArena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		if (m_blockIndex < m_blocks.size())
+		{
+			Block& block = m_blocks[m_blockIndex];
+
+			std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+			std::size_t alignedOffset = ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+			if (alignedOffset + size <= block.size)
+			{
+				m_allocatedBytes += alignedOffset + size - m_offset;
+				m_offset = alignedOffset + size;
+				m_peakBytes = std::max(m_peakBytes, m_allocatedBytes);
+
+				return &block.memory[alignedOffset];
+			}
+		}
+
+		return AllocateFromNextBlock(size, alignment);
+	}
+
+	template<typename T>
+	T* StackArena::AllocateArray(std::size_t count)
+	{
+		///DOC: The memory is uninitialized, and no destructor will ever be called on it
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	inline std::size_t StackArena::GetAllocatedBytes() const
+	{
+		return m_allocatedBytes;
+	}
+
+	inline StackArena::Marker StackArena::GetMarker() const
+	{
+		///DOC: Rewinding to a marker frees everything allocated after it was taken
+		Marker marker;
+		marker.allocatedBytes = m_allocatedBytes;
+		marker.blockIndex = m_blockIndex;
+		marker.offset = m_offset;
+
+		return marker;
+	}
+
+	inline unsigned int StackArena::GetOverflowCount() const
+	{
+		return m_overflowCount;
+	}
+
+	inline std::size_t StackArena::GetPeakBytes() const
+	{
+		return m_peakBytes;
+	}
+
+	inline void StackArena::Rewind(const Marker& marker)
+	{
+		NazaraAssert(marker.blockIndex < m_blockIndex || (marker.blockIndex == m_blockIndex && marker.offset <= m_offset), "Marker is ahead of the arena");
+
+		m_allocatedBytes = marker.allocatedBytes;
+		m_blockIndex = marker.blockIndex;
+		m_offset = marker.offset;
+	}
+
+	inline StackArena::ScopedMarker::ScopedMarker(StackArena& arena) :
+	m_arena(arena),
+	m_marker(arena.GetMarker())
+	{
+	}
+
+	inline StackArena::ScopedMarker::~ScopedMarker()
+	{
+		m_arena.Rewind(m_marker);
+	}
+
+	template<typename T>
+	StackAllocator<T>::StackAllocator(StackArena& arena) :
+	m_arena(&arena)
+	{
+		///DOC: The containers must be destroyed (or emptied with shrink_to_fit) before the arena is reset
+	}
+
+	template<typename T>
+	template<typename U>
+	StackAllocator<T>::StackAllocator(const StackAllocator<U>& allocator) :
+	m_arena(&allocator.GetArena())
+	{
+	}
+
+	template<typename T>
+	T* StackAllocator<T>::allocate(std::size_t count)
+	{
+		return m_arena->AllocateArray<T>(count);
+	}
+
+	template<typename T>
+	void StackAllocator<T>::deallocate(T* /*ptr*/, std::size_t /*count*/)
+	{
+		// The memory is reclaimed when the arena is reset
+	}
+
+	template<typename T>
+	StackArena& StackAllocator<T>::GetArena() const
+	{
+		return *m_arena;
+	}
+
+	template<typename T, typename U>
+	bool operator==(const StackAllocator<T>& lhs, const StackAllocator<U>& rhs)
+	{
+		return &lhs.GetArena() == &rhs.GetArena();
+	}
+
+	template<typename T, typename U>
+	bool operator!=(const StackAllocator<T>& lhs, const StackAllocator<U>& rhs)
+	{
+		return !operator==(lhs, rhs);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
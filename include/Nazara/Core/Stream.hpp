@@ -31,6 +31,7 @@ namespace Nz
 
 			virtual UInt64 GetCursorPos() const = 0;
 			virtual String GetDirectory() const;
+			virtual const void* GetMemoryPointer() const;
 			virtual String GetPath() const;
 			inline UInt32 GetOpenMode() const;
 			inline UInt32 GetStreamOptions() const;
@@ -39,9 +39,9 @@ namespace Nz
 			String(const char* string);
 			String(const char* string, std::size_t length);
 			String(const std::string& string);
-			String(const String& string) = default;
-			String(String&& string) noexcept = default;
-			~String() = default;
+			String(const String& string);
+			String(String&& string) noexcept;
+			inline ~String();
 
 			String& Append(char character);
 			String& Append(const char* string);
@@ -301,23 +301,35 @@ namespace Nz
 		private:
 			struct SharedString;
 
-			String(std::shared_ptr<SharedString>&& sharedString);
-
+			void Allocate(std::size_t size, std::size_t capacity = 0);
 			void EnsureOwnership(bool discardContent = false);
+			inline char* GetStringData();
+			inline const char* GetStringData() const;
+			inline bool HasSharedString() const;
 			inline void ReleaseString();
+			inline void SetSharedString(SharedString* sharedString);
+
+			static inline void ReleaseSharedString(SharedString* sharedString);
 
-			static const std::shared_ptr<SharedString>& GetEmptyString();
+			// Strings up to this size are stored inline, without any allocation
+			// The inline buffer overlaps the shared string pointer, its last byte tells which one is used
+			static constexpr std::size_t SmallStringCapacity = 2 * sizeof(void*) - 2;
+			static constexpr std::size_t SharedStringTag = SmallStringCapacity + 1;
 
-			std::shared_ptr<SharedString> m_sharedString;
+			// Keeps String as small as two pointers and a size, strings are often passed and stored by value
+			union
+			{
+				SharedString* m_sharedString;
+				char m_smallString[SmallStringCapacity + 2] = {};
+			};
+			std::size_t m_size;
 
 			struct SharedString
 			{
-				inline SharedString();
-				inline SharedString(std::size_t strSize);
-				inline SharedString(std::size_t strSize, std::size_t strCapacity);
+				inline SharedString(std::size_t strCapacity);
 
+				std::atomic_uint refCount;
 				std::size_t capacity;
-				std::size_t size;
 				std::unique_ptr<char[]> string;
 			};
 	};
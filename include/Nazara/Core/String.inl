@@ -7,36 +7,62 @@
 
 namespace Nz
 {
-	inline String::String(std::shared_ptr<SharedString>&& sharedString) :
-	m_sharedString(std::move(sharedString))
+	inline String::~String()
 	{
+		if (HasSharedString())
+			ReleaseSharedString(m_sharedString);
+	}
+
+	inline char* String::GetStringData()
+	{
+		return (HasSharedString()) ? m_sharedString->string.get() : m_smallString;
+	}
+
+	inline const char* String::GetStringData() const
+	{
+		return (HasSharedString()) ? m_sharedString->string.get() : m_smallString;
+	}
+
+	inline bool String::HasSharedString() const
+	{
+		return m_smallString[SharedStringTag] != 0;
 	}
 
 	inline void String::ReleaseString()
 	{
-		m_sharedString = std::move(GetEmptyString());
+		SetSharedString(nullptr);
+		m_size = 0;
 	}
 
-	inline String::SharedString::SharedString() : // Special case: empty string
-	capacity(0),
-	size(0)
+	inline void String::SetSharedString(SharedString* sharedString)
 	{
+		// Takes a reference already counted for this string, a null pointer makes the string inline (and empty)
+		if (HasSharedString())
+			ReleaseSharedString(m_sharedString);
+
+		if (sharedString)
+		{
+			m_sharedString = sharedString;
+			m_smallString[SharedStringTag] = 1;
+		}
+		else
+		{
+			m_smallString[0] = '\0';
+			m_smallString[SharedStringTag] = 0;
+		}
 	}
 
-	inline String::SharedString::SharedString(std::size_t strSize) :
-	capacity(strSize), 
-	size(strSize),
-	string(new char[strSize + 1])
+	inline void String::ReleaseSharedString(SharedString* sharedString)
 	{
-		string[strSize] = '\0';
+		if (sharedString->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete sharedString;
 	}
 
-	inline String::SharedString::SharedString(std::size_t strSize, std::size_t strCapacity) :
+	inline String::SharedString::SharedString(std::size_t strCapacity) :
+	refCount(1),
 	capacity(strCapacity),
-	size(strSize),
 	string(new char[strCapacity + 1])
 	{
-		string[strSize] = '\0';
 	}
 
 	inline bool HashAppend(AbstractHash* hash, const String& string)
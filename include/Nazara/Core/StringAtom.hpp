@@ -0,0 +1,68 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STRINGATOM_HPP
+#define NAZARA_STRINGATOM_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <functional>
+#include <string>
+
+namespace Nz
+{
+	class NAZARA_CORE_API StringAtom
+	{
+		public:
+			inline StringAtom();
+			explicit StringAtom(const char* string);
+			explicit StringAtom(const std::string& string);
+			explicit StringAtom(const String& string);
+			StringAtom(const StringAtom&) = default;
+			~StringAtom() = default;
+
+			inline std::size_t GetHash() const;
+			inline const String& GetString() const;
+
+			inline bool IsEmpty() const;
+
+			StringAtom& operator=(const StringAtom&) = default;
+
+			static bool Find(const String& string, StringAtom* atom);
+
+			inline bool operator==(const StringAtom& atom) const;
+			inline bool operator!=(const StringAtom& atom) const;
+
+		private:
+			struct Entry
+			{
+				String string;
+				std::size_t hash;
+			};
+
+			static const Entry* Intern(const String& string, bool insert);
+
+			const Entry* m_entry;
+
+			static const Entry s_emptyEntry;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<Nz::StringAtom>
+	{
+		size_t operator()(const Nz::StringAtom& atom) const
+		{
+			return atom.GetHash();
+		}
+	};
+}
+
+#include <Nazara/Core/StringAtom.inl>
+
+#endif // NAZARA_STRINGATOM_HPP
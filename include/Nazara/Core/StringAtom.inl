@@ -0,0 +1,40 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline StringAtom::StringAtom() :
+	m_entry(&s_emptyEntry)
+	{
+	}
+
+	inline std::size_t StringAtom::GetHash() const
+	{
+		return m_entry->hash;
+	}
+
+	inline const String& StringAtom::GetString() const
+	{
+		return m_entry->string;
+	}
+
+	inline bool StringAtom::IsEmpty() const
+	{
+		return m_entry == &s_emptyEntry;
+	}
+
+	inline bool StringAtom::operator==(const StringAtom& atom) const
+	{
+		return m_entry == atom.m_entry;
+	}
+
+	inline bool StringAtom::operator!=(const StringAtom& atom) const
+	{
+		return !operator==(atom);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,75 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKGRAPH_HPP
+#define NAZARA_TASKGRAPH_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API TaskGraph
+	{
+		public:
+			using TaskId = std::size_t;
+
+			TaskGraph() = default;
+			TaskGraph(const TaskGraph&) = delete;
+			TaskGraph(TaskGraph&&) = delete;
+			~TaskGraph() = default;
+
+			template<typename F> TaskId AddContinuation(TaskId task, F function);
+			void AddDependency(TaskId task, TaskId dependency);
+			template<typename F> TaskId AddTask(F function);
+			template<typename F, typename... Args> TaskId AddTask(F function, Args&&... args);
+
+			void Clear();
+
+			bool Execute();
+
+			const std::vector<TaskId>& GetCriticalPath() const;
+			UInt64 GetCriticalPathTime() const;
+			UInt64 GetExecutionTime() const;
+			std::size_t GetTaskCount() const;
+			UInt64 GetTaskTime(TaskId task) const;
+
+			TaskGraph& operator=(const TaskGraph&) = delete;
+			TaskGraph& operator=(TaskGraph&&) = delete;
+
+		private:
+			struct Node
+			{
+				std::atomic_uint remainingDependencies;
+				std::unique_ptr<Functor> functor;
+				std::vector<TaskId> dependencies;
+				std::vector<TaskId> successors;
+				UInt64 endTime;
+				UInt64 startTime;
+			};
+
+			TaskId AddNode(Functor* functor);
+			bool BuildExecutionOrder();
+			void ComputeCriticalPath();
+			void RunNode(TaskId task);
+
+			std::vector<std::unique_ptr<Node>> m_nodes;
+			std::vector<TaskId> m_criticalPath;
+			std::vector<TaskId> m_executionOrder;
+			TaskScheduler::Counter m_counter;
+			UInt64 m_criticalPathTime = 0;
+			UInt64 m_executionTime = 0;
+			bool m_executionOrderUpdated = false;
+	};
+}
+
+#include <Nazara/Core/TaskGraph.inl>
+
+#endif // NAZARA_TASKGRAPH_HPP
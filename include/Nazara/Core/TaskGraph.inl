@@ -0,0 +1,32 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename F>
+	TaskGraph::TaskId TaskGraph::AddContinuation(TaskId task, F function)
+	{
+		TaskId continuation = AddTask(function);
+		AddDependency(continuation, task);
+
+		return continuation;
+	}
+
+	template<typename F>
+	TaskGraph::TaskId TaskGraph::AddTask(F function)
+	{
+		return AddNode(new FunctorWithoutArgs<F>(function));
+	}
+
+	template<typename F, typename... Args>
+	TaskGraph::TaskId TaskGraph::AddTask(F function, Args&&... args)
+	{
+		return AddNode(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -9,27 +9,85 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
 
 namespace Nz
 {
 	class NAZARA_CORE_API TaskScheduler
 	{
+		friend class TaskSchedulerImpl;
+
 		public:
+			class Counter;
+
 			TaskScheduler() = delete;
 			~TaskScheduler() = delete;
 
 			template<typename F> static void AddTask(F function);
 			template<typename F, typename... Args> static void AddTask(F function, Args&&... args);
 			template<typename C> static void AddTask(void (C::*function)(), C* object);
+			static void Dispatch(Functor* functor, unsigned int count, Counter& counter);
 			static unsigned int GetWorkerCount();
 			static bool Initialize();
 			static void Run();
+			static void Run(Counter& counter);
 			static void SetWorkerCount(unsigned int workerCount);
+			template<typename F> static void Submit(Counter& counter, F function);
 			static void Uninitialize();
 			static void WaitForTasks();
+			static void WaitForTasks(const Counter& counter);
+
+		private:
+			struct Task;
+
+			static void AddPendingTask(Task* task);
+			static Task* AllocateTask(std::size_t functorSize, void** functorStorage);
+			template<typename T, typename... Args> static Task* CreateTask(Args&&... args);
+			static void SubmitTask(Task* task, Counter& counter);
+	};
+
+	struct TaskScheduler::Task
+	{
+		// Functors up to this size are stored in the task itself
+		static constexpr std::size_t InlineStorageSize = 80;
+
+		enum FunctorLocation : UInt8
+		{
+			FunctorLocation_External,
+			FunctorLocation_Heap,
+			FunctorLocation_Inline,
+			FunctorLocation_Pool
+		};
+
+		std::aligned_storage<InlineStorageSize>::type inlineStorage;
+		Functor* functor;
+		Counter* counter;
+		Task* next;
+		void* functorBlock;
+		FunctorLocation functorLocation;
+	};
+
+	class TaskScheduler::Counter
+	{
+		friend class TaskSchedulerImpl;
+
+		public:
+			inline Counter();
+			Counter(const Counter&) = delete;
+			Counter(Counter&&) = delete;
+			~Counter() = default;
+
+			inline unsigned int GetPendingTaskCount() const;
+
+			inline bool IsDone() const;
+
+			Counter& operator=(const Counter&) = delete;
+			Counter& operator=(Counter&&) = delete;
 
 		private:
-			static void AddTaskFunctor(Functor* taskFunctor);
+			std::atomic_uint m_pendingTasks;
 	};
 }
 
@@ -2,6 +2,8 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <utility>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -9,19 +11,54 @@ namespace Nz
 	template<typename F>
 	void TaskScheduler::AddTask(F function)
 	{
-		AddTaskFunctor(new FunctorWithoutArgs<F>(function));
+		AddPendingTask(CreateTask<FunctorWithoutArgs<F>>(function));
 	}
 
 	template<typename F, typename... Args>
 	void TaskScheduler::AddTask(F function, Args&&... args)
 	{
-		AddTaskFunctor(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+		AddPendingTask(CreateTask<FunctorWithArgs<F, Args...>>(function, std::forward<Args>(args)...));
 	}
 
 	template<typename C>
 	void TaskScheduler::AddTask(void (C::*function)(), C* object)
 	{
-		AddTaskFunctor(new MemberWithoutArgs<C>(function, object));
+		AddPendingTask(CreateTask<MemberWithoutArgs<C>>(function, object));
+	}
+
+	template<typename F>
+	void TaskScheduler::Submit(Counter& counter, F function)
+	{
+		///DOC: Unlike AddTask, the task is started right away without waiting for Run
+		SubmitTask(CreateTask<FunctorWithoutArgs<F>>(function), counter);
+	}
+
+	template<typename T, typename... Args>
+	TaskScheduler::Task* TaskScheduler::CreateTask(Args&&... args)
+	{
+		static_assert(std::alignment_of<T>::value <= std::alignment_of<std::max_align_t>::value, "Over-aligned functors are not supported");
+
+		void* functorStorage;
+		Task* task = AllocateTask(sizeof(T), &functorStorage);
+		task->functor = PlacementNew<T>(functorStorage, std::forward<Args>(args)...);
+
+		return task;
+	}
+
+	inline TaskScheduler::Counter::Counter() :
+	m_pendingTasks(0)
+	{
+		///DOC: A counter must outlive every task attached to it through TaskScheduler::Run(Counter&)
+	}
+
+	inline unsigned int TaskScheduler::Counter::GetPendingTaskCount() const
+	{
+		return m_pendingTasks.load(std::memory_order_acquire);
+	}
+
+	inline bool TaskScheduler::Counter::IsDone() const
+	{
+		return GetPendingTaskCount() == 0;
 	}
 }
 
@@ -22,6 +22,7 @@ namespace Nz
 			Unserializer(Unserializer&&) = default;
 			~Unserializer() = default;
 
+			inline UnserializationContext& GetContext();
 			inline Endianness GetDataEndianness() const;
 			inline Stream& GetStream() const;
 
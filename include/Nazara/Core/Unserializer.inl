@@ -13,6 +13,11 @@ namespace Nz
 		m_unserializationContext.stream = &stream;
 	}
 
+	inline UnserializationContext& Unserializer::GetContext()
+	{
+		return m_unserializationContext;
+	}
+
 	inline Endianness Unserializer::GetDataEndianness() const
 	{
 		return m_unserializationContext.endianness;
@@ -187,6 +187,7 @@ namespace Nz
 			static MaterialLoader::LoaderList s_loaders;
 			static MaterialManager::ManagerMap s_managerMap;
 			static MaterialManager::ManagerParams s_managerParameters;
+			static MaterialManager::ManagerState s_managerState;
 			static MaterialRef s_defaultMaterial;
 	};
 }
@@ -145,15 +145,27 @@ namespace Nz
 	//TODO: Mark as constexpr when supported by all major compilers
 	/*constexpr*/ inline T CountBits(T value)
 	{
+		// Negative values of narrow signed types must not be sign-extended while being widened
+		using UnsignedT = std::make_unsigned_t<T>;
+		UnsignedT bits = static_cast<UnsignedT>(value);
+
+		#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+		// Compiled to popcnt when the target supports it
+		if (sizeof(T) <= sizeof(unsigned int))
+			return static_cast<T>(__builtin_popcount(static_cast<unsigned int>(bits)));
+		else
+			return static_cast<T>(__builtin_popcountll(static_cast<unsigned long long>(bits)));
+		#else
 		// https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetKernighan
 		unsigned int count = 0;
-		while (value)
+		while (bits)
 		{
-			value &= value - 1;
+			bits &= bits - 1;
 			count++;
 		}
 
-		return count;
+		return static_cast<T>(count);
+		#endif
 	}
 
 	/*!
@@ -404,7 +416,18 @@ namespace Nz
 	//TODO: Mark as constexpr when supported by all major compilers
 	/*constexpr*/ inline unsigned int IntegralLog2Pot(T pot)
 	{
+		#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+		// Counting trailing zeros is a single instruction (bsf/tzcnt)
+		if (pot == 0)
+			return 0;
+
+		if (sizeof(T) <= sizeof(unsigned int))
+			return static_cast<unsigned int>(__builtin_ctz(static_cast<unsigned int>(pot)));
+		else
+			return static_cast<unsigned int>(__builtin_ctzll(static_cast<unsigned long long>(pot)));
+		#else
 		return Detail::IntegralLog2Pot<T>(pot);
+		#endif
 	}
 
 	/*!
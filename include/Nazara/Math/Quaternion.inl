@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Mathematics module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/StringStream.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Math/Config.hpp>
@@ -830,6 +831,88 @@ namespace Nz
 
 		return quaternion;
 	}
+
+	/*!
+	* \brief Serializes a normalized quaternion with the "smallest three" method
+	* \return true if successful
+	*
+	* \param context Serialization context
+	* \param quat Normalized quaternion to serialize
+	* \param bitCount Number of bits used for each of the three smallest components
+	*
+	* \remark The largest component is not sent but rebuilt from the others, this takes 2 + 3 * bitCount bits
+	*/
+
+	template<typename T>
+	bool SerializeQuantized(SerializationContext& context, const Quaternion<T>& quat, unsigned int bitCount)
+	{
+		// The three smallest components of a normalized quaternion are within [-1/sqrt(2), 1/sqrt(2)]
+		constexpr float range = 0.707106781f;
+
+		T components[4] = {quat.w, quat.x, quat.y, quat.z};
+
+		unsigned int largest = 0;
+		for (unsigned int i = 1; i < 4; ++i)
+		{
+			if (std::abs(components[i]) > std::abs(components[largest]))
+				largest = i;
+		}
+
+		// q and -q represent the same rotation, we make the largest component positive so its sign doesn't have to be sent
+		T sign = (components[largest] < F(0.0)) ? F(-1.0) : F(1.0);
+
+		if (!SerializeBits(context, largest, 2))
+			return false;
+
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			if (i != largest && !SerializeQuantized(context, static_cast<float>(sign * components[i]), -range, range, bitCount))
+				return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Unserializes a quaternion serialized with the "smallest three" method
+	* \return true if successful
+	*
+	* \param context Unserialization context
+	* \param quat Output quaternion
+	* \param bitCount Number of bits used for each of the three smallest components
+	*/
+
+	template<typename T>
+	bool UnserializeQuantized(UnserializationContext& context, Quaternion<T>* quat, unsigned int bitCount)
+	{
+		NazaraAssert(quat, "Invalid quaternion");
+
+		constexpr float range = 0.707106781f;
+
+		UInt64 largest;
+		if (!UnserializeBits(context, &largest, 2))
+			return false;
+
+		T components[4];
+		T squaredSum = F(0.0);
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+				continue;
+
+			float component;
+			if (!UnserializeQuantized(context, &component, -range, range, bitCount))
+				return false;
+
+			components[i] = static_cast<T>(component);
+			squaredSum += components[i] * components[i];
+		}
+
+		components[largest] = std::sqrt(std::max(F(0.0), F(1.0) - squaredSum));
+
+		quat->Set(components[0], components[1], components[2], components[3]);
+		return true;
+	}
 }
 
 /*!
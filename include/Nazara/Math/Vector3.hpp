@@ -7,6 +7,7 @@
 #ifndef NAZARA_VECTOR3_HPP
 #define NAZARA_VECTOR3_HPP
 
+#include <Nazara/Core/Serialization.hpp>
 #include <Nazara/Core/String.hpp>
 
 namespace Nz
@@ -125,6 +126,9 @@ namespace Nz
 	typedef Vector3<unsigned int> Vector3ui;
 	typedef Vector3<Int32> Vector3i32;
 	typedef Vector3<UInt32> Vector3ui32;
+
+	template<typename T> bool SerializeQuantized(SerializationContext& context, const Vector3<T>& vector, T min, T max, unsigned int bitCount);
+	template<typename T> bool UnserializeQuantized(UnserializationContext& context, Vector3<T>* vector, T min, T max, unsigned int bitCount);
 }
 
 template<typename T> std::ostream& operator<<(std::ostream& out, const Nz::Vector3<T>& vec);
@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Mathematics module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/StringStream.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <cstring>
@@ -1275,6 +1276,58 @@ namespace Nz
 
 		return vector;
 	}
+
+	/*!
+	* \brief Serializes a vector with quantized components
+	* \return true if successful
+	*
+	* \param context Serialization context
+	* \param vector Vector to serialize, components are clamped to [min, max]
+	* \param min Minimum value of a component
+	* \param max Maximum value of a component
+	* \param bitCount Number of bits used for each component
+	*/
+
+	template<typename T>
+	bool SerializeQuantized(SerializationContext& context, const Vector3<T>& vector, T min, T max, unsigned int bitCount)
+	{
+		float fMin = static_cast<float>(min);
+		float fMax = static_cast<float>(max);
+
+		return SerializeQuantized(context, static_cast<float>(vector.x), fMin, fMax, bitCount) &&
+		       SerializeQuantized(context, static_cast<float>(vector.y), fMin, fMax, bitCount) &&
+		       SerializeQuantized(context, static_cast<float>(vector.z), fMin, fMax, bitCount);
+	}
+
+	/*!
+	* \brief Unserializes a vector serialized with quantized components
+	* \return true if successful
+	*
+	* \param context Unserialization context
+	* \param vector Output vector
+	* \param min Minimum value of a component
+	* \param max Maximum value of a component
+	* \param bitCount Number of bits used for each component
+	*/
+
+	template<typename T>
+	bool UnserializeQuantized(UnserializationContext& context, Vector3<T>* vector, T min, T max, unsigned int bitCount)
+	{
+		NazaraAssert(vector, "Invalid vector");
+
+		float fMin = static_cast<float>(min);
+		float fMax = static_cast<float>(max);
+
+		float components[3];
+		for (float& component : components)
+		{
+			if (!UnserializeQuantized(context, &component, fMin, fMax, bitCount))
+				return false;
+		}
+
+		vector->Set(static_cast<T>(components[0]), static_cast<T>(components[1]), static_cast<T>(components[2]));
+		return true;
+	}
 }
 
 /*!
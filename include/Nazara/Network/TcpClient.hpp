@@ -8,10 +8,12 @@
 #define NAZARA_TCPCLIENT_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteChain.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Network/AbstractSocket.hpp>
 #include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/NetBuffer.hpp>
 
 namespace Nz
 {
@@ -45,6 +47,8 @@ namespace Nz
 			bool Receive(void* buffer, std::size_t size, std::size_t* received);
 
 			bool Send(const void* buffer, std::size_t size, std::size_t* sent);
+			bool Send(const ByteChain& chain, std::size_t* sent);
+			bool SendMultiple(const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent);
 
 			bool SetCursorPos(UInt64 offset) override;
 
@@ -129,6 +129,7 @@ namespace Nz
 			static TextureLibrary::LibraryMap s_library;
 			static TextureManager::ManagerMap s_managerMap;
 			static TextureManager::ManagerParams s_managerParameters;
+			static TextureManager::ManagerState s_managerState;
 	};
 }
 
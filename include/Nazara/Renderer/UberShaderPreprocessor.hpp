@@ -10,6 +10,7 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Renderer/Enums.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
+#include <Nazara/Core/StringAtom.hpp>
 #include <Nazara/Renderer/Shader.hpp>
 #include <Nazara/Renderer/ShaderStage.hpp>
 #include <Nazara/Renderer/UberShader.hpp>
@@ -44,14 +45,14 @@ namespace Nz
 			struct CachedShader
 			{
 				mutable std::unordered_map<UInt32, ShaderStage> cache;
-				std::unordered_map<String, UInt32> flags;
+				std::unordered_map<StringAtom, UInt32> flags;
 				UInt32 requiredFlags;
 				String source;
 				bool present = false;
 			};
 
 			mutable std::unordered_map<UInt32, UberShaderInstancePreprocessor> m_cache;
-			std::unordered_map<String, UInt32> m_flags;
+			std::unordered_map<StringAtom, UInt32> m_flags;
 			CachedShader m_shaders[ShaderStageType_Max+1];
 	};
 }
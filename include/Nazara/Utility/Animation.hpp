@@ -104,6 +104,7 @@ namespace Nz
 			static AnimationLoader::LoaderList s_loaders;
 			static AnimationManager::ManagerMap s_managerMap;
 			static AnimationManager::ManagerParams s_managerParameters;
+			static AnimationManager::ManagerState s_managerState;
 	};
 }
 
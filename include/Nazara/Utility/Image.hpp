@@ -165,6 +165,7 @@ namespace Nz
 			static ImageLoader::LoaderList s_loaders;
 			static ImageManager::ManagerMap s_managerMap;
 			static ImageManager::ManagerParams s_managerParameters;
+			static ImageManager::ManagerState s_managerState;
 		};
 }
 
@@ -135,6 +135,9 @@ namespace Nz
 			NazaraSignal(OnMeshRelease, const Mesh* /*mesh*/);
 
 		private:
+			bool LoadFromCache(const String& entryPath, const String& sourceDirectory, const MeshParams& params);
+			void SaveToCache(const String& entryPath, const String& sourceDirectory) const;
+
 			MeshImpl* m_impl = nullptr;
 
 			static bool Initialize();
@@ -144,6 +147,7 @@ namespace Nz
 			static MeshLoader::LoaderList s_loaders;
 			static MeshManager::ManagerMap s_managerMap;
 			static MeshManager::ManagerParams s_managerParameters;
+			static MeshManager::ManagerState s_managerState;
 	};
 }
 
@@ -3,7 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Parallel.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -62,7 +64,29 @@ namespace Nz
 			return false;
 		}
 
-		if (!func(reinterpret_cast<const UInt8*>(start), reinterpret_cast<const UInt8*>(end), reinterpret_cast<UInt8*>(dst)))
+		const UInt8* srcPtr = reinterpret_cast<const UInt8*>(start);
+		UInt8* dstPtr = reinterpret_cast<UInt8*>(dst);
+
+		bool succeeded;
+		if (!IsCompressed(srcFormat) && !IsCompressed(dstFormat))
+		{
+			// Uncompressed pixels are converted independently, large images can be split between the task scheduler workers
+			UInt8 srcBpp = GetBytesPerPixel(srcFormat);
+			UInt8 dstBpp = GetBytesPerPixel(dstFormat);
+
+			std::atomic_bool failed(false);
+			ParallelFor(0, (reinterpret_cast<const UInt8*>(end) - srcPtr) / srcBpp, [&](std::size_t first, std::size_t last)
+			{
+				if (!func(srcPtr + first*srcBpp, srcPtr + last*srcBpp, dstPtr + first*dstBpp))
+					failed = true;
+			}, 16384);
+
+			succeeded = !failed;
+		}
+		else
+			succeeded = (func(srcPtr, reinterpret_cast<const UInt8*>(end), dstPtr) != nullptr);
+
+		if (!succeeded)
 		{
 			NazaraError("Pixel format conversion from " + ToString(srcFormat) + " to " + ToString(dstFormat) + " failed");
 			return false;
@@ -77,6 +77,6 @@ namespace Nz
 	};
 }
 
-#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <Nazara/Utility/VertexDeclaration.inl>
 
 #endif // NAZARA_VERTEXDECLARATION_HPP
@@ -256,4 +256,5 @@ namespace Nz
 	SoundBufferLoader::LoaderList SoundBuffer::s_loaders;
 	SoundBufferManager::ManagerMap SoundBuffer::s_managerMap;
 	SoundBufferManager::ManagerParams SoundBuffer::s_managerParameters;
+	SoundBufferManager::ManagerState SoundBuffer::s_managerState;
 }
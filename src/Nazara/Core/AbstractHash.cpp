@@ -3,7 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Parallel.hpp>
 #include <Nazara/Core/Hash/CRC32.hpp>
 #include <Nazara/Core/Hash/Fletcher16.hpp>
 #include <Nazara/Core/Hash/MD5.hpp>
@@ -13,12 +15,34 @@
 #include <Nazara/Core/Hash/SHA384.hpp>
 #include <Nazara/Core/Hash/SHA512.hpp>
 #include <Nazara/Core/Hash/Whirlpool.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
 	AbstractHash::~AbstractHash() = default;
 
+	void AbstractHash::ComputeMany(HashType type, const UInt8* const* data, const std::size_t* sizes, std::size_t count, ByteArray* digests)
+	{
+		///DOC: Hashes count independent inputs, the digest of data[i] is stored in digests[i]
+		NazaraAssert(type <= HashType_Max, "Hash type value out of enum");
+		NazaraAssert((data && sizes && digests) || count == 0, "Invalid inputs");
+
+		// Small inputs are hashed in a few hundreds of cycles, a chunk must hold enough of them to amortize the task
+		constexpr std::size_t GrainSize = 64;
+
+		ParallelFor(0, count, [=](std::size_t first, std::size_t last)
+		{
+			std::unique_ptr<AbstractHash> hash = Get(type);
+			for (std::size_t i = first; i < last; ++i)
+			{
+				hash->Begin();
+				hash->Append(data[i], sizes[i]);
+				digests[i] = hash->End();
+			}
+		}, GrainSize);
+	}
+
 	std::unique_ptr<AbstractHash> AbstractHash::Get(HashType type)
 	{
 		NazaraAssert(type <= HashType_Max, "Hash type value out of enum");
@@ -31,6 +55,9 @@ namespace Nz
 			case HashType_CRC32:
 				return std::unique_ptr<AbstractHash>(new HashCRC32);
 
+			case HashType_CRC32C:
+				return std::unique_ptr<AbstractHash>(new HashCRC32(0x1edc6f41));
+
 			case HashType_MD5:
 				return std::unique_ptr<AbstractHash>(new HashMD5);
 
@@ -51,6 +78,9 @@ namespace Nz
 
 			case HashType_Whirlpool:
 				return std::unique_ptr<AbstractHash>(new HashWhirlpool);
+
+			case HashType_XXHash64:
+				return std::unique_ptr<AbstractHash>(new HashXXHash64);
 		}
 
 		NazaraInternalError("Hash type not handled (0x" + String::Number(type, 16) + ')');
@@ -0,0 +1,237 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AssetCache.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Entries are written in native endianness, a foreign entry fails the magic check and is rebuilt
+		struct EntryHeader
+		{
+			UInt32 magic;
+			UInt32 cacheVersion;
+			UInt32 formatVersion;
+			UInt32 reserved;
+			UInt64 payloadSize;
+			UInt64 padding; // Keeps the payload 16 bytes aligned in the mapping
+		};
+
+		static_assert(sizeof(EntryHeader) == 32, "EntryHeader must be 32 bytes long");
+
+		constexpr UInt32 CacheVersion = 1;
+		constexpr UInt32 EntryMagic = 0x43415A4E; // "NZAC" once stored in little-endian
+
+		const char* EntryExtension = ".nzcache";
+
+		String s_directory;
+		std::atomic_uint s_hitCount(0);
+		std::atomic_uint s_missCount(0);
+
+		String GetContentHash(const String& sourcePath)
+		{
+			if (!File::Exists(sourcePath))
+				return String();
+
+			return File::ComputeHash(HashType_MD5, sourcePath).ToHex();
+		}
+
+		bool RemoveEntries(const String& pattern)
+		{
+			if (!Directory::Exists(s_directory))
+				return true;
+
+			std::vector<String> entries;
+			{
+				Directory directory(s_directory);
+				directory.SetPattern(pattern);
+				if (!directory.Open())
+				{
+					NazaraError("Failed to open cache directory \"" + s_directory + '"');
+					return false;
+				}
+
+				while (directory.NextResult())
+				{
+					if (!directory.IsResultDirectory())
+						entries.push_back(directory.GetResultPath());
+				}
+			}
+
+			bool success = true;
+			for (const String& entryPath : entries)
+				success &= File::Delete(entryPath);
+
+			return success;
+		}
+	}
+
+	bool AssetCache::Clear()
+	{
+		if (!IsEnabled())
+			return true;
+
+		return RemoveEntries(String('*') + EntryExtension);
+	}
+
+	String AssetCache::GetDirectory()
+	{
+		return s_directory;
+	}
+
+	String AssetCache::GetEntryPath(const String& sourcePath, const String& assetType, const void* variant, std::size_t variantSize)
+	{
+		///DOC: Returns an empty string if the cache is disabled or the source file doesn't exist
+		NazaraAssert(variant || variantSize == 0, "Invalid variant");
+
+		if (!IsEnabled())
+			return String();
+
+		String contentHash = GetContentHash(sourcePath);
+		if (contentHash.IsEmpty())
+			return String();
+
+		std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_CRC32);
+		hash->Begin();
+		hash->Append(reinterpret_cast<const UInt8*>(assetType.GetConstBuffer()), assetType.GetSize());
+		if (variantSize > 0)
+			hash->Append(static_cast<const UInt8*>(variant), variantSize);
+
+		return s_directory + NAZARA_DIRECTORY_SEPARATOR + contentHash + '-' + hash->End().ToHex() + EntryExtension;
+	}
+
+	unsigned int AssetCache::GetHitCount()
+	{
+		return s_hitCount;
+	}
+
+	unsigned int AssetCache::GetMissCount()
+	{
+		return s_missCount;
+	}
+
+	bool AssetCache::Invalidate(const String& sourcePath)
+	{
+		///DOC: Entries built from a previous content of the file are only removed by Clear()
+		if (!IsEnabled())
+			return true;
+
+		String contentHash = GetContentHash(sourcePath);
+		if (contentHash.IsEmpty())
+			return true;
+
+		return RemoveEntries(contentHash + "-*" + EntryExtension);
+	}
+
+	bool AssetCache::IsEnabled()
+	{
+		return !s_directory.IsEmpty();
+	}
+
+	bool AssetCache::OpenEntry(const String& entryPath, UInt32 formatVersion, MappedFileView* view)
+	{
+		///DOC: The cursor is moved to the payload, which is 16 bytes aligned in memory
+		NazaraAssert(view, "Invalid view");
+
+		if (entryPath.IsEmpty() || !File::Exists(entryPath) || !view->Open(entryPath, OpenMode_ReadOnly))
+		{
+			s_missCount++;
+			return false;
+		}
+
+		const UInt8* data = view->GetConstData();
+		UInt64 size = view->GetSize();
+
+		bool valid = false;
+		if (size >= sizeof(EntryHeader))
+		{
+			const EntryHeader* header = reinterpret_cast<const EntryHeader*>(data);
+			valid = header->magic == EntryMagic && header->cacheVersion == CacheVersion && header->formatVersion == formatVersion &&
+			        header->payloadSize == size - sizeof(EntryHeader);
+		}
+
+		if (!valid)
+		{
+			view->Close();
+			File::Delete(entryPath);
+
+			s_missCount++;
+			return false;
+		}
+
+		view->SetCursorPos(sizeof(EntryHeader));
+
+		s_hitCount++;
+		return true;
+	}
+
+	void AssetCache::SetDirectory(const String& directoryPath)
+	{
+		///DOC: An empty path disables the cache (the default), the directory is created on the first write
+		s_directory = (directoryPath.IsEmpty()) ? String() : File::NormalizePath(directoryPath);
+	}
+
+	bool AssetCache::WriteEntry(const String& entryPath, UInt32 formatVersion, const void* payload, std::size_t size)
+	{
+		NazaraAssert(payload || size == 0, "Invalid payload");
+
+		if (entryPath.IsEmpty())
+			return false;
+
+		if (!Directory::Exists(s_directory) && !Directory::Create(s_directory, true))
+		{
+			NazaraError("Failed to create cache directory \"" + s_directory + '"');
+			return false;
+		}
+
+		EntryHeader header;
+		header.magic = EntryMagic;
+		header.cacheVersion = CacheVersion;
+		header.formatVersion = formatVersion;
+		header.reserved = 0;
+		header.payloadSize = size;
+		header.padding = 0;
+
+		// Written aside then renamed, so a reader never maps a partially written entry
+		String tempPath = entryPath + ".tmp";
+		{
+			File file(tempPath, OpenMode_WriteOnly | OpenMode_Truncate);
+			if (!file.IsOpen())
+			{
+				NazaraError("Failed to open \"" + tempPath + '"');
+				return false;
+			}
+
+			if (file.Write(&header, sizeof(EntryHeader)) != sizeof(EntryHeader) || file.Write(payload, size) != size)
+			{
+				NazaraError("Failed to write cache entry");
+
+				file.Close();
+				File::Delete(tempPath);
+				return false;
+			}
+		}
+
+		if (File::Exists(entryPath))
+			File::Delete(entryPath);
+
+		if (!File::Rename(tempPath, entryPath))
+		{
+			File::Delete(tempPath);
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,335 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncFileService.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+	#include <Nazara/Core/Win32/FileImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+	#include <Nazara/Core/Posix/FileImpl.hpp>
+#else
+	#error OS not handled
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct Completion
+		{
+			AsyncFileService::ReadCallback callback;
+			AsyncFileService::ReadResult result;
+		};
+
+		struct PendingRead
+		{
+			AsyncFileService::ReadRequest request;
+			CompletionMode completionMode;
+		};
+
+		// Reads are I/O bound, a few workers are enough to keep the disk busy
+		constexpr unsigned int DefaultWorkerCount = 2;
+		constexpr std::size_t MaxBatchSize = 32;
+
+		std::deque<PendingRead> s_requests;
+		std::vector<Completion> s_completions;
+		std::vector<Thread> s_workers;
+		ConditionVariable s_idleCondition;
+		ConditionVariable s_requestCondition;
+		Mutex s_completionMutex;
+		Mutex s_requestMutex;
+		TaskScheduler::Counter s_completionCounter;
+		unsigned int s_activeWorkerCount = 0;
+		unsigned int s_pendingRequests = 0;
+		unsigned int s_workerCount = 0;
+		bool s_shouldFinish = false;
+
+		void Complete(PendingRead& pending, AsyncFileService::ReadResult& result)
+		{
+			if (!pending.request.callback)
+				return;
+
+			switch (pending.completionMode)
+			{
+				case CompletionMode_Deferred:
+				{
+					LockGuard lock(s_completionMutex);
+					s_completions.push_back(Completion{std::move(pending.request.callback), std::move(result)});
+					break;
+				}
+
+				case CompletionMode_TaskScheduler:
+				{
+					// Task functors are copied, the completion is moved to the heap to avoid copying the data
+					Completion* completion = new Completion{std::move(pending.request.callback), std::move(result)};
+					TaskScheduler::Submit(s_completionCounter, [completion]()
+					{
+						completion->callback(completion->result);
+						delete completion;
+					});
+					break;
+				}
+			}
+		}
+
+		void ProcessBatch(std::vector<PendingRead>& batch)
+		{
+			// Sorting by file and offset lets us open each file once and read it front to back
+			std::stable_sort(batch.begin(), batch.end(), [](const PendingRead& lhs, const PendingRead& rhs)
+			{
+				int comparison = String::Compare(lhs.request.filePath, rhs.request.filePath);
+				if (comparison != 0)
+					return comparison < 0;
+
+				return lhs.request.offset < rhs.request.offset;
+			});
+
+			// FileImpl is used directly as File reports errors through the (thread-unsafe) error system
+			std::unique_ptr<FileImpl> file;
+			String filePath;
+			UInt64 fileSize = 0;
+
+			for (PendingRead& pending : batch)
+			{
+				const AsyncFileService::ReadRequest& request = pending.request;
+				if (filePath.IsEmpty() || filePath != request.filePath)
+				{
+					if (file)
+					{
+						file->Close();
+						file.reset();
+					}
+
+					filePath = request.filePath;
+
+					file.reset(new FileImpl(nullptr));
+					if (file->Open(filePath, OpenMode_ReadOnly))
+						fileSize = FileImpl::GetSize(filePath);
+					else
+						file.reset();
+				}
+
+				AsyncFileService::ReadResult result;
+				result.filePath = request.filePath;
+				result.offset = request.offset;
+				result.success = false;
+
+				if (file && request.offset <= fileSize)
+				{
+					UInt64 size = (request.size != 0) ? request.size : fileSize - request.offset;
+					if (size <= fileSize - request.offset && file->SetCursorPos(CursorPosition_AtBegin, request.offset))
+					{
+						result.data.Resize(static_cast<std::size_t>(size));
+
+						std::size_t readSize = 0;
+						while (readSize < size)
+						{
+							std::size_t read = file->Read(result.data.GetBuffer() + readSize, static_cast<std::size_t>(size - readSize));
+							if (read == 0)
+								break;
+
+							readSize += read;
+						}
+
+						result.data.Resize(readSize);
+						result.success = (readSize == size);
+					}
+				}
+
+				Complete(pending, result);
+			}
+
+			if (file)
+				file->Close();
+		}
+
+		void WorkerProc()
+		{
+			std::vector<PendingRead> batch;
+			for (;;)
+			{
+				{
+					LockGuard lock(s_requestMutex);
+					while (s_requests.empty() && !s_shouldFinish)
+						s_requestCondition.Wait(&s_requestMutex);
+
+					// Remaining requests are still processed when finishing
+					if (s_requests.empty())
+						return;
+
+					// Leave some work to the other workers
+					std::size_t batchSize = std::min(MaxBatchSize, std::max<std::size_t>(s_requests.size() / s_activeWorkerCount, 1));
+					auto batchEnd = s_requests.begin() + batchSize;
+
+					batch.assign(std::make_move_iterator(s_requests.begin()), std::make_move_iterator(batchEnd));
+					s_requests.erase(s_requests.begin(), batchEnd);
+				}
+
+				ProcessBatch(batch);
+
+				{
+					LockGuard lock(s_requestMutex);
+					s_pendingRequests -= static_cast<unsigned int>(batch.size());
+					if (s_pendingRequests == 0)
+						s_idleCondition.SignalAll();
+				}
+
+				batch.clear();
+			}
+		}
+	}
+
+	unsigned int AsyncFileService::DispatchCompletions()
+	{
+		///DOC: Runs the callbacks of the completed CompletionMode_Deferred reads on the calling thread
+		std::vector<Completion> completions;
+		{
+			LockGuard lock(s_completionMutex);
+			completions.swap(s_completions);
+		}
+
+		for (Completion& completion : completions)
+			completion.callback(completion.result);
+
+		return static_cast<unsigned int>(completions.size());
+	}
+
+	unsigned int AsyncFileService::GetPendingRequestCount()
+	{
+		LockGuard lock(s_requestMutex);
+		return s_pendingRequests;
+	}
+
+	unsigned int AsyncFileService::GetWorkerCount()
+	{
+		return (s_workerCount > 0) ? s_workerCount : DefaultWorkerCount;
+	}
+
+	bool AsyncFileService::Initialize()
+	{
+		// Read() initializes lazily, two threads may get here at the same time
+		LockGuard lock(s_requestMutex);
+		if (!s_workers.empty())
+			return true;
+
+		s_activeWorkerCount = GetWorkerCount();
+		s_shouldFinish = false;
+
+		s_workers.reserve(s_activeWorkerCount);
+		for (unsigned int i = 0; i < s_activeWorkerCount; ++i)
+			s_workers.emplace_back(WorkerProc);
+
+		return true;
+	}
+
+	bool AsyncFileService::IsInitialized()
+	{
+		LockGuard lock(s_requestMutex);
+		return !s_workers.empty();
+	}
+
+	void AsyncFileService::Read(const String& filePath, ReadCallback callback, CompletionMode completionMode)
+	{
+		ReadRequest request;
+		request.callback = std::move(callback);
+		request.filePath = filePath;
+
+		Read(&request, 1, completionMode);
+	}
+
+	void AsyncFileService::Read(const ReadRequest* requests, std::size_t count, CompletionMode completionMode)
+	{
+		///DOC: Callbacks are always called, with ReadResult::success set to false on failure, in no particular order
+		NazaraAssert(requests || count == 0, "Invalid requests");
+
+		if (count == 0)
+			return;
+
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize async file service");
+			return;
+		}
+
+		// Initialize the scheduler now rather than from an I/O worker
+		if (completionMode == CompletionMode_TaskScheduler && !TaskScheduler::Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		{
+			LockGuard lock(s_requestMutex);
+			for (std::size_t i = 0; i < count; ++i)
+				s_requests.push_back(PendingRead{requests[i], completionMode});
+
+			s_pendingRequests += static_cast<unsigned int>(count);
+		}
+
+		if (count > 1)
+			s_requestCondition.SignalAll();
+		else
+			s_requestCondition.Signal();
+	}
+
+	void AsyncFileService::SetWorkerCount(unsigned int workerCount)
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (IsInitialized())
+		{
+			NazaraError("Worker count cannot be set while initialized");
+			return;
+		}
+		#endif
+
+		s_workerCount = workerCount;
+	}
+
+	void AsyncFileService::Uninitialize()
+	{
+		///DOC: Deferred completions not dispatched yet are dropped
+		{
+			LockGuard lock(s_requestMutex);
+			if (s_workers.empty())
+				return;
+
+			s_shouldFinish = true;
+		}
+		s_requestCondition.SignalAll();
+
+		// Workers need the lock to finish, it can't be held while joining them
+		for (Thread& worker : s_workers)
+			worker.Join();
+
+		{
+			LockGuard lock(s_requestMutex);
+			s_workers.clear();
+		}
+
+		if (!s_completionCounter.IsDone())
+			TaskScheduler::WaitForTasks(s_completionCounter);
+
+		LockGuard lock(s_completionMutex);
+		s_completions.clear();
+	}
+
+	void AsyncFileService::WaitForRequests()
+	{
+		LockGuard lock(s_requestMutex);
+		while (s_pendingRequests > 0)
+			s_idleCondition.Wait(&s_requestMutex);
+	}
+}
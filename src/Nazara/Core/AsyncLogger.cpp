@@ -0,0 +1,244 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <thread>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Set on the logging threads, so messages logged by the wrapped logger itself don't wait on the queue
+		thread_local AsyncLogger* s_currentLogger = nullptr;
+
+		// Maximum wait of the logging thread when idle, in case a wake up was missed
+		constexpr UInt32 IdleTimeout = 10;
+	}
+
+	AsyncLogger::AsyncLogger(std::unique_ptr<AbstractLogger> logger, std::size_t queueSize, LogOverflowPolicy overflowPolicy) :
+	m_logger(std::move(logger)),
+	m_enqueuePos(0),
+	m_writtenCount(0),
+	m_droppedCount(0),
+	m_overflowPolicy(overflowPolicy),
+	m_workerWaiting(false),
+	m_dequeuePos(0),
+	m_shouldStop(false)
+	{
+		///DOC: The queue size is rounded up to a power of two
+		NazaraAssert(m_logger, "Invalid logger");
+		NazaraAssert(queueSize > 0, "Queue size must be over zero");
+
+		std::size_t slotCount = 1;
+		while (slotCount < queueSize)
+			slotCount <<= 1;
+
+		m_mask = slotCount - 1;
+		m_slots.reset(new Slot[slotCount]);
+		for (std::size_t i = 0; i < slotCount; ++i)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+
+		m_worker = Thread(&AsyncLogger::WorkerProc, this);
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		{
+			LockGuard lock(m_mutex);
+			m_shouldStop = true;
+		}
+		m_workerCondition.Signal();
+
+		m_worker.Join();
+	}
+
+	void AsyncLogger::EnableStdReplication(bool enable)
+	{
+		LockGuard lock(m_loggerMutex);
+		m_logger->EnableStdReplication(enable);
+	}
+
+	void AsyncLogger::Flush()
+	{
+		std::size_t queuedCount = m_enqueuePos.load();
+		if (s_currentLogger == this)
+			return; // Messages of the logging thread are written directly
+
+		LockGuard lock(m_mutex);
+		while (m_writtenCount.load() < queuedCount)
+		{
+			m_workerCondition.Signal();
+			m_flushCondition.Wait(&m_mutex, IdleTimeout);
+		}
+	}
+
+	UInt64 AsyncLogger::GetDroppedCount() const
+	{
+		return m_droppedCount.load(std::memory_order_relaxed);
+	}
+
+	AbstractLogger* AsyncLogger::GetLogger() const
+	{
+		///DOC: The wrapped logger is used by the logging thread, it should not be used directly
+		return m_logger.get();
+	}
+
+	LogOverflowPolicy AsyncLogger::GetOverflowPolicy() const
+	{
+		return m_overflowPolicy.load(std::memory_order_relaxed);
+	}
+
+	std::size_t AsyncLogger::GetQueueSize() const
+	{
+		return m_mask + 1;
+	}
+
+	bool AsyncLogger::IsStdReplicationEnabled()
+	{
+		LockGuard lock(m_loggerMutex);
+		return m_logger->IsStdReplicationEnabled();
+	}
+
+	void AsyncLogger::SetOverflowPolicy(LogOverflowPolicy overflowPolicy)
+	{
+		m_overflowPolicy.store(overflowPolicy, std::memory_order_relaxed);
+	}
+
+	void AsyncLogger::Write(const String& string)
+	{
+		if (s_currentLogger == this)
+		{
+			m_logger->Write(string);
+			return;
+		}
+
+		Push(Entry{string, ErrorType_Normal, nullptr, nullptr, 0, false});
+	}
+
+	void AsyncLogger::WriteError(ErrorType type, const String& error, unsigned int line, const char* file, const char* function)
+	{
+		///DOC: file and function are expected to be string literals (as given by the error macros), they are not copied
+		if (s_currentLogger == this)
+		{
+			m_logger->WriteError(type, error, line, file, function);
+			return;
+		}
+
+		Push(Entry{error, type, file, function, line, true});
+	}
+
+	bool AsyncLogger::Pop(Entry* entry)
+	{
+		// Single consumer: only the logging thread reads from the queue
+		Slot& slot = m_slots[m_dequeuePos & m_mask];
+		if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+			return false;
+
+		*entry = std::move(slot.entry);
+		slot.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+		m_dequeuePos++;
+
+		return true;
+	}
+
+	void AsyncLogger::Push(Entry&& entry)
+	{
+		// Bounded multi-producer queue from Dmitry Vyukov, each slot sequence tells if it is free for the position
+		// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+		std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Slot& slot = m_slots[pos & m_mask];
+			std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+			if (difference == 0)
+			{
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					slot.entry = std::move(entry);
+					slot.sequence.store(pos + 1, std::memory_order_release);
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The queue is full
+				if (m_overflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy_Drop)
+				{
+					m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				WakeWorker();
+				std::this_thread::yield();
+
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+			else
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		// The mutex is only taken when the logging thread is sleeping, which should not happen under load
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_workerWaiting.load(std::memory_order_relaxed))
+			WakeWorker();
+	}
+
+	void AsyncLogger::WakeWorker()
+	{
+		LockGuard lock(m_mutex);
+		m_workerCondition.Signal();
+	}
+
+	void AsyncLogger::WorkerProc()
+	{
+		s_currentLogger = this;
+
+		Entry entry;
+		for (;;)
+		{
+			std::size_t writtenCount = 0;
+			{
+				LockGuard lock(m_loggerMutex);
+				while (Pop(&entry))
+				{
+					if (entry.isError)
+						m_logger->WriteError(entry.errorType, entry.message, entry.line, entry.file, entry.function);
+					else
+						m_logger->Write(entry.message);
+
+					writtenCount++;
+				}
+			}
+
+			// Release the last message memory now rather than when the next one is popped
+			entry.message.Clear();
+
+			LockGuard lock(m_mutex);
+			if (writtenCount > 0)
+			{
+				m_writtenCount.fetch_add(writtenCount);
+				m_flushCondition.SignalAll();
+				continue;
+			}
+
+			if (m_shouldStop)
+				break;
+
+			m_workerWaiting.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			// A message may have been pushed between the last Pop and the waiting flag
+			if (m_slots[m_dequeuePos & m_mask].sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+				m_workerCondition.Wait(&m_mutex, IdleTimeout);
+
+			m_workerWaiting.store(false, std::memory_order_relaxed);
+		}
+
+		s_currentLogger = nullptr;
+	}
+}
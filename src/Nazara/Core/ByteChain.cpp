@@ -0,0 +1,303 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ByteChain.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	constexpr std::size_t ByteChain::BlockSize;
+
+	ByteChain::ByteChain(ByteArray array) :
+	ByteChain()
+	{
+		Append(std::move(array));
+	}
+
+	ByteChain::ByteChain(ByteChain&& chain) :
+	m_slices(std::move(chain.m_slices)),
+	m_size(chain.m_size)
+	{
+		chain.m_slices.clear();
+		chain.m_size = 0;
+	}
+
+	void ByteChain::Append(const void* buffer, std::size_t size)
+	{
+		NazaraAssert(buffer || size == 0, "Invalid buffer");
+
+		const UInt8* ptr = static_cast<const UInt8*>(buffer);
+		if (!m_slices.empty())
+		{
+			// Only the chain whose last slice ends the block may grow it, copies sharing the block allocate a new one
+			Slice& last = m_slices.back();
+			ByteArray& block = *last.block;
+			if (last.offset + last.size == block.GetSize())
+			{
+				std::size_t copySize = std::min(size, block.GetCapacity() - block.GetSize());
+				if (copySize > 0)
+				{
+					block.Append(ptr, copySize);
+					last.size += copySize;
+					m_size += copySize;
+
+					ptr += copySize;
+					size -= copySize;
+				}
+			}
+		}
+
+		if (size > 0)
+		{
+			std::shared_ptr<ByteArray> block = std::make_shared<ByteArray>();
+			block->Reserve(std::max(size, BlockSize));
+			block->Append(ptr, size);
+
+			m_slices.push_back(Slice{std::move(block), 0, size});
+			m_size += size;
+		}
+	}
+
+	void ByteChain::Append(ByteArray array)
+	{
+		std::size_t size = array.GetSize();
+		if (size == 0)
+			return;
+
+		m_slices.push_back(Slice{std::make_shared<ByteArray>(std::move(array)), 0, size});
+		m_size += size;
+	}
+
+	void ByteChain::Append(const ByteChain& chain)
+	{
+		if (&chain == this)
+		{
+			ByteChain copy(chain);
+			Append(copy);
+			return;
+		}
+
+		m_slices.insert(m_slices.end(), chain.m_slices.begin(), chain.m_slices.end());
+		m_size += chain.m_size;
+	}
+
+	void ByteChain::Clear()
+	{
+		m_slices.clear();
+		m_size = 0;
+	}
+
+	std::size_t ByteChain::CopyTo(void* buffer, std::size_t size, std::size_t offset) const
+	{
+		NazaraAssert(buffer || size == 0, "Invalid buffer");
+
+		UInt8* ptr = static_cast<UInt8*>(buffer);
+		std::size_t copied = 0;
+		for (const Slice& slice : m_slices)
+		{
+			if (copied == size)
+				break;
+
+			if (offset >= slice.size)
+			{
+				offset -= slice.size;
+				continue;
+			}
+
+			std::size_t copySize = std::min(slice.size - offset, size - copied);
+			std::memcpy(ptr + copied, slice.block->GetConstBuffer() + slice.offset + offset, copySize);
+
+			copied += copySize;
+			offset = 0;
+		}
+
+		return copied;
+	}
+
+	void ByteChain::Discard(std::size_t size)
+	{
+		NazaraAssert(size <= m_size, "Cannot discard more bytes than the chain holds");
+
+		while (size > 0 && !m_slices.empty())
+		{
+			Slice& front = m_slices.front();
+			if (front.size <= size)
+			{
+				size -= front.size;
+				m_size -= front.size;
+				m_slices.pop_front();
+			}
+			else
+			{
+				front.offset += size;
+				front.size -= size;
+				m_size -= size;
+				size = 0;
+			}
+		}
+	}
+
+	std::size_t ByteChain::ExportSegments(Segment* segments, std::size_t maxCount, std::size_t firstSegment) const
+	{
+		///DOC: The pointers are invalidated by any modification of the chain
+		NazaraAssert(segments || maxCount == 0, "Invalid segments");
+
+		if (firstSegment >= m_slices.size())
+			return 0;
+
+		std::size_t count = std::min(maxCount, m_slices.size() - firstSegment);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const Slice& slice = m_slices[firstSegment + i];
+			segments[i].data = slice.block->GetConstBuffer() + slice.offset;
+			segments[i].size = slice.size;
+		}
+
+		return count;
+	}
+
+	void ByteChain::Prepend(const void* buffer, std::size_t size)
+	{
+		NazaraAssert(buffer || size == 0, "Invalid buffer");
+
+		if (size == 0)
+			return;
+
+		Prepend(ByteArray(buffer, size));
+	}
+
+	void ByteChain::Prepend(ByteArray array)
+	{
+		std::size_t size = array.GetSize();
+		if (size == 0)
+			return;
+
+		m_slices.push_front(Slice{std::make_shared<ByteArray>(std::move(array)), 0, size});
+		m_size += size;
+	}
+
+	void ByteChain::Prepend(const ByteChain& chain)
+	{
+		if (&chain == this)
+		{
+			ByteChain copy(chain);
+			Prepend(copy);
+			return;
+		}
+
+		m_slices.insert(m_slices.begin(), chain.m_slices.begin(), chain.m_slices.end());
+		m_size += chain.m_size;
+	}
+
+	ByteChain ByteChain::SubChain(std::size_t offset, std::size_t size) const
+	{
+		NazaraAssert(offset <= m_size && size <= m_size - offset, "Range out of chain");
+
+		ByteChain subChain;
+		for (const Slice& slice : m_slices)
+		{
+			if (subChain.m_size == size)
+				break;
+
+			if (offset >= slice.size)
+			{
+				offset -= slice.size;
+				continue;
+			}
+
+			std::size_t sliceSize = std::min(slice.size - offset, size - subChain.m_size);
+			subChain.m_slices.push_back(Slice{slice.block, slice.offset + offset, sliceSize});
+			subChain.m_size += sliceSize;
+
+			offset = 0;
+		}
+
+		return subChain;
+	}
+
+	ByteArray ByteChain::ToByteArray() const
+	{
+		ByteArray array;
+		array.Resize(m_size);
+		CopyTo(array.GetBuffer(), m_size);
+
+		return array;
+	}
+
+	ByteChain& ByteChain::operator=(ByteChain&& chain)
+	{
+		m_slices = std::move(chain.m_slices);
+		m_size = chain.m_size;
+
+		chain.m_slices.clear();
+		chain.m_size = 0;
+
+		return *this;
+	}
+
+	bool ByteChainStream::EndOfStream() const
+	{
+		return m_pos >= m_chain.GetSize();
+	}
+
+	UInt64 ByteChainStream::GetCursorPos() const
+	{
+		return m_pos;
+	}
+
+	UInt64 ByteChainStream::GetSize() const
+	{
+		return m_chain.GetSize();
+	}
+
+	bool ByteChainStream::SetCursorPos(UInt64 offset)
+	{
+		///DOC: Only the read position is affected, writes are always appended to the chain
+		m_pos = std::min<UInt64>(offset, m_chain.GetSize());
+
+		return true;
+	}
+
+	void ByteChainStream::FlushStream()
+	{
+		// Nothing to flush
+	}
+
+	std::size_t ByteChainStream::ReadBlock(void* buffer, std::size_t size)
+	{
+		std::size_t readSize;
+		if (buffer)
+			readSize = m_chain.CopyTo(buffer, size, static_cast<std::size_t>(m_pos));
+		else
+			readSize = std::min<std::size_t>(size, static_cast<std::size_t>(m_chain.GetSize() - m_pos));
+
+		m_pos += readSize;
+		return readSize;
+	}
+
+	std::size_t ByteChainStream::WriteBlock(const void* buffer, std::size_t size)
+	{
+		m_chain.Append(buffer, size);
+		return size;
+	}
+
+	bool HashAppend(AbstractHash* hash, const ByteChain& chain)
+	{
+		ByteChain::Segment segments[16];
+
+		std::size_t segmentCount = chain.GetSegmentCount();
+		for (std::size_t i = 0; i < segmentCount; i += 16)
+		{
+			std::size_t count = chain.ExportSegments(segments, 16, i);
+			for (std::size_t j = 0; j < count; ++j)
+				hash->Append(segments[j].data, segments[j].size);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,274 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Threads past this count don't get a magazine and use the depot directly
+		constexpr unsigned int s_maxThreadSlots = 64;
+		constexpr unsigned int s_invalidThreadSlot = s_maxThreadSlots;
+	}
+
+	// Per-thread cache of free blocks, only ever accessed by the thread owning the slot
+	struct ConcurrentMemoryPool::Magazine
+	{
+		std::unique_ptr<void*[]> blocks;
+		std::size_t count = 0;
+	};
+
+	// Keeps track of the live pools so that an exiting thread can give its magazines back
+	struct ConcurrentMemoryPool::Registry
+	{
+		Mutex mutex;
+		std::vector<ConcurrentMemoryPool*> pools;
+		std::vector<unsigned int> freeSlots;
+		unsigned int nextSlot = 0;
+	};
+
+	struct ConcurrentMemoryPool::ThreadSlot
+	{
+		ThreadSlot()
+		{
+			Registry& registry = GetRegistry();
+			LockGuard lock(registry.mutex);
+
+			if (!registry.freeSlots.empty())
+			{
+				id = registry.freeSlots.back();
+				registry.freeSlots.pop_back();
+			}
+			else if (registry.nextSlot < s_maxThreadSlots)
+				id = registry.nextSlot++;
+			else
+				id = s_invalidThreadSlot;
+		}
+
+		~ThreadSlot()
+		{
+			if (id == s_invalidThreadSlot)
+				return;
+
+			Registry& registry = GetRegistry();
+			LockGuard lock(registry.mutex);
+
+			for (ConcurrentMemoryPool* pool : registry.pools)
+				pool->ReleaseMagazine(id);
+
+			registry.freeSlots.push_back(id);
+		}
+
+		unsigned int id;
+	};
+
+	ConcurrentMemoryPool::ConcurrentMemoryPool(std::size_t blockSize, std::size_t chunkSize, std::size_t magazineSize) :
+	m_magazines(new std::unique_ptr<Magazine>[s_maxThreadSlots]),
+	m_blockCount(0),
+	m_chunkSize(std::max<std::size_t>(chunkSize, 1)),
+	m_magazineSize(std::max<std::size_t>(magazineSize, 1)),
+	m_chunkCursor(nullptr),
+	m_chunkEnd(nullptr)
+	{
+		///DOC: The chunk size is the number of blocks allocated at once when the pool runs out of blocks
+		std::size_t alignment = alignof(std::max_align_t);
+		while (alignment > 1 && alignment > blockSize)
+			alignment /= 2;
+
+		m_blockSize = std::max<std::size_t>((blockSize + alignment - 1) / alignment * alignment, 1);
+
+		Registry& registry = GetRegistry();
+		LockGuard lock(registry.mutex);
+
+		registry.pools.push_back(this);
+	}
+
+	ConcurrentMemoryPool::~ConcurrentMemoryPool()
+	{
+		///DOC: Every block is released with the pool, no thread may still be using it
+		{
+			Registry& registry = GetRegistry();
+			LockGuard lock(registry.mutex);
+
+			registry.pools.erase(std::find(registry.pools.begin(), registry.pools.end(), this));
+		}
+
+		for (UInt8* chunk : m_chunks)
+			OperatorDelete(chunk);
+	}
+
+	void* ConcurrentMemoryPool::Allocate()
+	{
+		Magazine* magazine = GetMagazine();
+		if (!magazine)
+		{
+			LockGuard lock(m_mutex);
+			return AllocateBlock();
+		}
+
+		if (magazine->count == 0)
+		{
+			LockGuard lock(m_mutex);
+			RefillMagazine(*magazine);
+		}
+
+		return magazine->blocks[--magazine->count];
+	}
+
+	void ConcurrentMemoryPool::Flush()
+	{
+		///DOC: This is done automatically when a thread exits
+		Magazine* magazine = GetMagazine();
+		if (magazine)
+			FlushMagazine(*magazine, magazine->count);
+	}
+
+	void ConcurrentMemoryPool::Free(void* ptr)
+	{
+		///DOC: The block can be freed by any thread, not only the one which allocated it
+		if (!ptr)
+			return;
+
+		Magazine* magazine = GetMagazine();
+		if (!magazine)
+		{
+			LockGuard lock(m_mutex);
+			m_depot.push_back(ptr);
+
+			return;
+		}
+
+		// Keeps a full magazine for the thread so that alternating allocations and frees don't hit the depot
+		if (magazine->count == 2 * m_magazineSize)
+			FlushMagazine(*magazine, m_magazineSize);
+
+		magazine->blocks[magazine->count++] = ptr;
+	}
+
+	void ConcurrentMemoryPool::Free(void* const* blocks, std::size_t count)
+	{
+		Magazine* magazine = GetMagazine();
+		if (!magazine)
+		{
+			LockGuard lock(m_mutex);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (blocks[i])
+					m_depot.push_back(blocks[i]);
+			}
+
+			return;
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (!blocks[i])
+				continue;
+
+			if (magazine->count == 2 * m_magazineSize)
+				FlushMagazine(*magazine, m_magazineSize);
+
+			magazine->blocks[magazine->count++] = blocks[i];
+		}
+	}
+
+	std::size_t ConcurrentMemoryPool::GetBlockCount() const
+	{
+		return m_blockCount.load(std::memory_order_relaxed);
+	}
+
+	std::size_t ConcurrentMemoryPool::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	void* ConcurrentMemoryPool::AllocateBlock()
+	{
+		// The pool mutex must be locked
+		if (!m_depot.empty())
+		{
+			void* block = m_depot.back();
+			m_depot.pop_back();
+
+			return block;
+		}
+
+		if (m_chunkCursor == m_chunkEnd)
+		{
+			m_chunks.push_back(static_cast<UInt8*>(OperatorNew(m_blockSize * m_chunkSize)));
+			m_chunkCursor = m_chunks.back();
+			m_chunkEnd = m_chunkCursor + m_blockSize * m_chunkSize;
+
+			m_blockCount.fetch_add(m_chunkSize, std::memory_order_relaxed);
+		}
+
+		void* block = m_chunkCursor;
+		m_chunkCursor += m_blockSize;
+
+		return block;
+	}
+
+	void ConcurrentMemoryPool::FlushMagazine(Magazine& magazine, std::size_t count)
+	{
+		if (count == 0)
+			return;
+
+		// The oldest blocks go to the depot, the most recently freed (and most likely in cache) stay in the magazine
+		{
+			LockGuard lock(m_mutex);
+			m_depot.insert(m_depot.end(), &magazine.blocks[0], &magazine.blocks[count]);
+		}
+
+		magazine.count -= count;
+		std::memmove(&magazine.blocks[0], &magazine.blocks[count], magazine.count * sizeof(void*));
+	}
+
+	ConcurrentMemoryPool::Magazine* ConcurrentMemoryPool::GetMagazine()
+	{
+		unsigned int slot = GetThreadSlot();
+		if (slot == s_invalidThreadSlot)
+			return nullptr;
+
+		std::unique_ptr<Magazine>& magazine = m_magazines[slot];
+		if (!magazine)
+		{
+			magazine.reset(new Magazine);
+			magazine->blocks.reset(new void*[2 * m_magazineSize]);
+		}
+
+		return magazine.get();
+	}
+
+	void ConcurrentMemoryPool::RefillMagazine(Magazine& magazine)
+	{
+		// The pool mutex must be locked
+		while (magazine.count < m_magazineSize)
+			magazine.blocks[magazine.count++] = AllocateBlock();
+	}
+
+	void ConcurrentMemoryPool::ReleaseMagazine(unsigned int slot)
+	{
+		// Called by an exiting thread, the next thread using this slot will start with an empty magazine
+		std::unique_ptr<Magazine>& magazine = m_magazines[slot];
+		if (magazine)
+			FlushMagazine(*magazine, magazine->count);
+	}
+
+	ConcurrentMemoryPool::Registry& ConcurrentMemoryPool::GetRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	unsigned int ConcurrentMemoryPool::GetThreadSlot()
+	{
+		thread_local ThreadSlot threadSlot;
+		return threadSlot.id;
+	}
+}
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/AsyncFileService.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
@@ -48,6 +49,7 @@ namespace Nz
 		// Libération du module
 		s_moduleReferenceCounter = 0;
 
+		AsyncFileService::Uninitialize();
 		HardwareInfo::Uninitialize();
 		Log::Uninitialize();
 		PluginManager::Uninitialize();
@@ -176,13 +176,17 @@ namespace Nz
 			}
 		}
 
-		if (eax >= 1)
+		UInt32 maxSupportedFunction = eax;
+		if (maxSupportedFunction >= 1)
 		{
 			// Récupération de certaines capacités du processeur (ECX et EDX, fonction 1)
 			HardwareInfoImpl::Cpuid(1, 0, registers);
 
-			s_capabilities[ProcessorCap_AVX]   = (ecx & (1U << 28)) != 0;
-			s_capabilities[ProcessorCap_FMA3]  = (ecx & (1U << 12)) != 0;
+			// AVX instructions fault unless the OS saves the YMM registers: OSXSAVE must be set and XCR0 must enable SSE and AVX states
+			bool avxStateEnabled = (ecx & (1U << 27)) != 0 && (HardwareInfoImpl::Xgetbv(0) & 0x6) == 0x6;
+
+			s_capabilities[ProcessorCap_AVX]   = avxStateEnabled && (ecx & (1U << 28)) != 0;
+			s_capabilities[ProcessorCap_FMA3]  = avxStateEnabled && (ecx & (1U << 12)) != 0;
 			s_capabilities[ProcessorCap_MMX]   = (edx & (1U << 23)) != 0;
 			s_capabilities[ProcessorCap_SSE]   = (edx & (1U << 25)) != 0;
 			s_capabilities[ProcessorCap_SSE2]  = (edx & (1U << 26)) != 0;
@@ -192,6 +196,15 @@ namespace Nz
 			s_capabilities[ProcessorCap_SSE42] = (ecx & (1U << 20)) != 0;
 		}
 
+		if (maxSupportedFunction >= 7)
+		{
+			// Extended features (EBX, function 7, sub-function 0)
+			HardwareInfoImpl::Cpuid(7, 0, registers);
+
+			s_capabilities[ProcessorCap_AVX2]  = s_capabilities[ProcessorCap_AVX] && (ebx & (1U << 5)) != 0;
+			s_capabilities[ProcessorCap_SHA]   = (ebx & (1U << 29)) != 0;
+		}
+
 		// Récupération de la plus grande fonction étendue supportée (EAX, fonction 0x80000000)
 		HardwareInfoImpl::Cpuid(0x80000000, 0, registers);
 
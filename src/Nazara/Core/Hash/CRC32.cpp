@@ -4,6 +4,22 @@
 
 #include <Nazara/Core/Hash/CRC32.hpp>
 #include <Nazara/Core/Endianness.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <cstring>
+
+// SSE4.2 has an instruction computing CRC32C (Castagnoli polynomial), it is only used if the processor supports it
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NAZARA_HASH_CRC32_SSE42
+
+	#include <nmmintrin.h>
+
+	#if defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG)
+		#define NAZARA_HASH_CRC32_SSE42_TARGET __attribute__((target("sse4.2")))
+	#else
+		#define NAZARA_HASH_CRC32_SSE42_TARGET
+	#endif
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -12,10 +28,45 @@ namespace Nz
 	{
 		UInt32 crc;
 		const UInt32* table;
+		bool hardware;
 	};
 
 	namespace
 	{
+		constexpr UInt32 CastagnoliPolynomial = 0x1edc6f41;
+
+		#ifdef NAZARA_HASH_CRC32_SSE42
+		NAZARA_HASH_CRC32_SSE42_TARGET UInt32 crc32c_sse42(UInt32 crc, const UInt8* data, std::size_t len)
+		{
+			UInt64 crc64 = crc;
+			while (len >= 8)
+			{
+				UInt64 value;
+				std::memcpy(&value, data, sizeof(UInt64));
+
+				crc64 = _mm_crc32_u64(crc64, value);
+				data += 8;
+				len -= 8;
+			}
+
+			crc = static_cast<UInt32>(crc64);
+			while (len--)
+				crc = _mm_crc32_u8(crc, *data++);
+
+			return crc;
+		}
+		#endif
+
+		bool IsCRC32CHardwareSupported()
+		{
+			#ifdef NAZARA_HASH_CRC32_SSE42
+			static bool supported = HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_SSE42);
+			return supported;
+			#else
+			return false;
+			#endif
+		}
+
 		UInt32 crc32_reflect(UInt32 ref, unsigned int j)
 		{
 			UInt32 value = 0;
@@ -67,9 +118,11 @@ namespace Nz
 		};
 	}
 
-	HashCRC32::HashCRC32(UInt32 polynomial)
+	HashCRC32::HashCRC32(UInt32 polynomial) :
+	m_polynomial(polynomial)
 	{
 		m_state = new HashCRC32_state;
+		m_state->hardware = (polynomial == CastagnoliPolynomial && IsCRC32CHardwareSupported());
 
 		if (polynomial == 0x04c11db7)
 			m_state->table = crc32_table; // Table précalculée (Bien plus rapide)
@@ -81,7 +134,7 @@ namespace Nz
 			{
 				table[i] = crc32_reflect(i, 8) << 24;
 				for (unsigned int j = 0; j < 8; ++j)
-					table[i] = (table[i] << 1) ^ (table[i] & ((1 << 31) ? polynomial : 0));
+					table[i] = (table[i] << 1) ^ ((table[i] & (1U << 31)) ? polynomial : 0);
 
 				table[i] = crc32_reflect(table[i], 32);
 			}
@@ -100,6 +153,14 @@ namespace Nz
 
 	void HashCRC32::Append(const UInt8* data, std::size_t len)
 	{
+		#ifdef NAZARA_HASH_CRC32_SSE42
+		if (m_state->hardware)
+		{
+			m_state->crc = crc32c_sse42(m_state->crc, data, len);
+			return;
+		}
+		#endif
+
 		while (len--)
 			m_state->crc = m_state->table[(m_state->crc ^ *data++) & 0xFF] ^ (m_state->crc >> 8);
 	}
@@ -127,6 +188,6 @@ namespace Nz
 
 	const char* HashCRC32::GetHashName() const
 	{
-		return "CRC32";
+		return (m_polynomial == CastagnoliPolynomial) ? "CRC32C" : "CRC32";
 	}
 }
@@ -39,7 +39,22 @@
 
 #include <Nazara/Core/Hash/SHA/Internal.hpp>
 #include <Nazara/Core/Endianness.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 #include <cstring>
+
+// SHA extensions (SHA-NI) compute SHA-1 and SHA-256 rounds, they are only used if the processor supports them
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NAZARA_HASH_SHA_NI
+
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG)
+		#define NAZARA_HASH_SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+	#else
+		#define NAZARA_HASH_SHA_NI_TARGET
+	#endif
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -267,6 +282,126 @@ namespace Nz
 	};
 
 
+	/*** SHA EXTENSIONS ***************************************************/
+	#ifdef NAZARA_HASH_SHA_NI
+	/*
+	 * Both kernels process one 64 bytes block read as big-endian words, like the portable transforms.
+	 * SHA-1 works on ABCD and E registers, SHA-256 on ABEF and CDGH registers (see Intel's
+	 * "New Instructions Supporting the Secure Hash Algorithm on Intel Architecture Processors").
+	 */
+
+	/* Four SHA-1 rounds, i being the index of the group of rounds [0, 20): */
+	#define ROUND1_NI(i) \
+		{ \
+			__m128i& Ecur = ((i) % 2 == 0) ? E0 : E1; \
+			__m128i& Enext = ((i) % 2 == 0) ? E1 : E0; \
+			if ((i) == 0) \
+				Ecur = _mm_add_epi32(Ecur, MSG[0]); \
+			else \
+				Ecur = _mm_sha1nexte_epu32(Ecur, MSG[(i) % 4]); \
+			Enext = ABCD; \
+			if ((i) >= 3 && (i) <= 18) \
+				MSG[((i) + 1) % 4] = _mm_sha1msg2_epu32(MSG[((i) + 1) % 4], MSG[(i) % 4]); \
+			ABCD = _mm_sha1rnds4_epu32(ABCD, Ecur, (i) / 5); \
+			if ((i) >= 1 && (i) <= 16) \
+				MSG[((i) + 3) % 4] = _mm_sha1msg1_epu32(MSG[((i) + 3) % 4], MSG[(i) % 4]); \
+			if ((i) >= 2 && (i) <= 17) \
+				MSG[((i) + 2) % 4] = _mm_xor_si128(MSG[((i) + 2) % 4], MSG[(i) % 4]); \
+		}
+
+	namespace
+	{
+		NAZARA_HASH_SHA_NI_TARGET void SHA1_Internal_TransformNI(UInt32* state, const UInt8* data)
+		{
+			const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+			__m128i ABCD = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+			__m128i E0 = _mm_set_epi32(state[4], 0, 0, 0);
+			__m128i E1;
+
+			__m128i ABCD_SAVE = ABCD;
+			__m128i E0_SAVE = E0;
+
+			__m128i MSG[4];
+			for (unsigned int i = 0; i < 4; ++i)
+				MSG[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), MASK);
+
+			ROUND1_NI(0);  ROUND1_NI(1);  ROUND1_NI(2);  ROUND1_NI(3);
+			ROUND1_NI(4);  ROUND1_NI(5);  ROUND1_NI(6);  ROUND1_NI(7);
+			ROUND1_NI(8);  ROUND1_NI(9);  ROUND1_NI(10); ROUND1_NI(11);
+			ROUND1_NI(12); ROUND1_NI(13); ROUND1_NI(14); ROUND1_NI(15);
+			ROUND1_NI(16); ROUND1_NI(17); ROUND1_NI(18); ROUND1_NI(19);
+
+			E0 = _mm_sha1nexte_epu32(E0, E0_SAVE);
+			ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(ABCD, 0x1B));
+			state[4] = _mm_extract_epi32(E0, 3);
+		}
+
+		NAZARA_HASH_SHA_NI_TARGET void SHA256_Internal_TransformNI(UInt32* state, const UInt8* data)
+		{
+			const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+			__m128i TMP = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1); /* CDAB */
+			__m128i STATE1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B); /* EFGH */
+			__m128i STATE0 = _mm_alignr_epi8(TMP, STATE1, 8); /* ABEF */
+			STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0); /* CDGH */
+
+			__m128i ABEF_SAVE = STATE0;
+			__m128i CDGH_SAVE = STATE1;
+
+			__m128i MSG[4];
+			for (unsigned int i = 0; i < 4; ++i)
+				MSG[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), MASK);
+
+			/* Four rounds per iteration, the message schedule runs ahead of the rounds: */
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				__m128i& current = MSG[i % 4];
+
+				__m128i W = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K256[4*i])));
+				STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, W);
+
+				if (i >= 3 && i <= 14)
+				{
+					__m128i& next = MSG[(i + 1) % 4];
+					next = _mm_add_epi32(next, _mm_alignr_epi8(current, MSG[(i + 3) % 4], 4));
+					next = _mm_sha256msg2_epu32(next, current);
+				}
+
+				W = _mm_shuffle_epi32(W, 0x0E);
+				STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, W);
+
+				if (i >= 1 && i <= 12)
+					MSG[(i + 3) % 4] = _mm_sha256msg1_epu32(MSG[(i + 3) % 4], current);
+			}
+
+			STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+			STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+
+			TMP = _mm_shuffle_epi32(STATE0, 0x1B); /* FEBA */
+			STATE1 = _mm_shuffle_epi32(STATE1, 0xB1); /* DCHG */
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(TMP, STATE1, 0xF0)); /* DCBA */
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(STATE1, TMP, 8)); /* HGFE */
+		}
+	}
+	#endif
+
+	namespace
+	{
+		bool UseSHAExtensions()
+		{
+			#ifdef NAZARA_HASH_SHA_NI
+			static bool supported = HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_SHA) && HardwareInfo::HasCapability(ProcessorCap_SSE41);
+			return supported;
+			#else
+			return false;
+			#endif
+		}
+	}
+
 	/*** SHA-1: ***********************************************************/
 	void SHA1_Init(SHA_CTX* context)
 	{
@@ -321,7 +456,7 @@ namespace Nz
 
 	namespace
 	{
-		void SHA1_Internal_Transform(SHA_CTX* context, const UInt32* data)
+		void SHA1_Internal_TransformScalar(SHA_CTX* context, const UInt32* data)
 		{
 			UInt32 a, b, c, d, e;
 			UInt32 T1, *W1;
@@ -435,6 +570,19 @@ namespace Nz
 			context->s1.state[3] += d;
 			context->s1.state[4] += e;
 		}
+
+		void SHA1_Internal_Transform(SHA_CTX* context, const UInt32* data)
+		{
+			#ifdef NAZARA_HASH_SHA_NI
+			if (UseSHAExtensions())
+			{
+				SHA1_Internal_TransformNI(context->s1.state, reinterpret_cast<const UInt8*>(data));
+				return;
+			}
+			#endif
+
+			SHA1_Internal_TransformScalar(context, data);
+		}
 	}
 
 	void SHA1_Update(SHA_CTX* context, const UInt8* data, std::size_t len)
@@ -589,64 +737,80 @@ namespace Nz
 		(h) = T1 + Sigma0_256(a) + Maj((a), (b), (c)); \
 		j++
 
-	void SHA256_Internal_Transform(SHA_CTX* context, const UInt32* data)
+	namespace
 	{
-		UInt32 a, b, c, d, e, f, g, h;
-		UInt32 T1, *W256;
-		int	j;
+		void SHA256_Internal_TransformScalar(SHA_CTX* context, const UInt32* data)
+		{
+			UInt32 a, b, c, d, e, f, g, h;
+			UInt32 T1, *W256;
+			int	j;
 
-		W256 = reinterpret_cast<UInt32*>(context->s256.buffer);
+			W256 = reinterpret_cast<UInt32*>(context->s256.buffer);
 
-		/* Initialize registers with the prev. intermediate value */
-		a = context->s256.state[0];
-		b = context->s256.state[1];
-		c = context->s256.state[2];
-		d = context->s256.state[3];
-		e = context->s256.state[4];
-		f = context->s256.state[5];
-		g = context->s256.state[6];
-		h = context->s256.state[7];
+			/* Initialize registers with the prev. intermediate value */
+			a = context->s256.state[0];
+			b = context->s256.state[1];
+			c = context->s256.state[2];
+			d = context->s256.state[3];
+			e = context->s256.state[4];
+			f = context->s256.state[5];
+			g = context->s256.state[6];
+			h = context->s256.state[7];
 
-		j = 0;
-		do
-		{
-			/* Rounds 0 to 15 (unrolled): */
-			ROUND256_0_TO_15(a,b,c,d,e,f,g,h);
-			ROUND256_0_TO_15(h,a,b,c,d,e,f,g);
-			ROUND256_0_TO_15(g,h,a,b,c,d,e,f);
-			ROUND256_0_TO_15(f,g,h,a,b,c,d,e);
-			ROUND256_0_TO_15(e,f,g,h,a,b,c,d);
-			ROUND256_0_TO_15(d,e,f,g,h,a,b,c);
-			ROUND256_0_TO_15(c,d,e,f,g,h,a,b);
-			ROUND256_0_TO_15(b,c,d,e,f,g,h,a);
+			j = 0;
+			do
+			{
+				/* Rounds 0 to 15 (unrolled): */
+				ROUND256_0_TO_15(a,b,c,d,e,f,g,h);
+				ROUND256_0_TO_15(h,a,b,c,d,e,f,g);
+				ROUND256_0_TO_15(g,h,a,b,c,d,e,f);
+				ROUND256_0_TO_15(f,g,h,a,b,c,d,e);
+				ROUND256_0_TO_15(e,f,g,h,a,b,c,d);
+				ROUND256_0_TO_15(d,e,f,g,h,a,b,c);
+				ROUND256_0_TO_15(c,d,e,f,g,h,a,b);
+				ROUND256_0_TO_15(b,c,d,e,f,g,h,a);
+			}
+			while (j < 16);
+
+			/* Now for the remaining rounds to 64: */
+			do
+			{
+				UInt32 s0, s1;
+
+				ROUND256(a,b,c,d,e,f,g,h);
+				ROUND256(h,a,b,c,d,e,f,g);
+				ROUND256(g,h,a,b,c,d,e,f);
+				ROUND256(f,g,h,a,b,c,d,e);
+				ROUND256(e,f,g,h,a,b,c,d);
+				ROUND256(d,e,f,g,h,a,b,c);
+				ROUND256(c,d,e,f,g,h,a,b);
+				ROUND256(b,c,d,e,f,g,h,a);
+			}
+			while (j < 64);
+
+			/* Compute the current intermediate hash value */
+			context->s256.state[0] += a;
+			context->s256.state[1] += b;
+			context->s256.state[2] += c;
+			context->s256.state[3] += d;
+			context->s256.state[4] += e;
+			context->s256.state[5] += f;
+			context->s256.state[6] += g;
+			context->s256.state[7] += h;
 		}
-		while (j < 16);
+	}
 
-		/* Now for the remaining rounds to 64: */
-		do
+	void SHA256_Internal_Transform(SHA_CTX* context, const UInt32* data)
+	{
+		#ifdef NAZARA_HASH_SHA_NI
+		if (UseSHAExtensions())
 		{
-			UInt32 s0, s1;
-
-			ROUND256(a,b,c,d,e,f,g,h);
-			ROUND256(h,a,b,c,d,e,f,g);
-			ROUND256(g,h,a,b,c,d,e,f);
-			ROUND256(f,g,h,a,b,c,d,e);
-			ROUND256(e,f,g,h,a,b,c,d);
-			ROUND256(d,e,f,g,h,a,b,c);
-			ROUND256(c,d,e,f,g,h,a,b);
-			ROUND256(b,c,d,e,f,g,h,a);
+			SHA256_Internal_TransformNI(context->s256.state, reinterpret_cast<const UInt8*>(data));
+			return;
 		}
-		while (j < 64);
+		#endif
 
-		/* Compute the current intermediate hash value */
-		context->s256.state[0] += a;
-		context->s256.state[1] += b;
-		context->s256.state[2] += c;
-		context->s256.state[3] += d;
-		context->s256.state[4] += e;
-		context->s256.state[5] += f;
-		context->s256.state[6] += g;
-		context->s256.state[7] += h;
+		SHA256_Internal_TransformScalar(context, data);
 	}
 
 	void SHA256_Update(SHA_CTX* context, const UInt8 *data, std::size_t len)
@@ -0,0 +1,199 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Implementation of the xxHash64 algorithm designed by Yann Collet (BSD licensed, https://github.com/Cyan4973/xxHash)
+
+#include <Nazara/Core/Hash/XXHash64.hpp>
+#include <Nazara/Core/Endianness.hpp>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct HashXXHash64_state
+	{
+		UInt64 accumulators[4];
+		UInt64 seed;
+		UInt64 totalLength;
+		UInt8 buffer[32];
+		std::size_t bufferSize;
+	};
+
+	namespace
+	{
+		constexpr UInt64 Prime1 = 11400714785074694791ULL;
+		constexpr UInt64 Prime2 = 14029467366897019727ULL;
+		constexpr UInt64 Prime3 = 1609587929392839161ULL;
+		constexpr UInt64 Prime4 = 9650029242287828579ULL;
+		constexpr UInt64 Prime5 = 2870177450012600261ULL;
+
+		inline UInt64 RotateLeft(UInt64 value, unsigned int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		// The algorithm reads little-endian values
+		inline UInt32 Read32(const UInt8* data)
+		{
+			UInt32 value;
+			std::memcpy(&value, data, sizeof(UInt32));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt32));
+			#endif
+
+			return value;
+		}
+
+		inline UInt64 Read64(const UInt8* data)
+		{
+			UInt64 value;
+			std::memcpy(&value, data, sizeof(UInt64));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt64));
+			#endif
+
+			return value;
+		}
+
+		inline UInt64 Round(UInt64 accumulator, UInt64 input)
+		{
+			accumulator += input * Prime2;
+			accumulator = RotateLeft(accumulator, 31);
+			return accumulator * Prime1;
+		}
+
+		inline UInt64 MergeRound(UInt64 accumulator, UInt64 value)
+		{
+			accumulator ^= Round(0, value);
+			return accumulator * Prime1 + Prime4;
+		}
+
+		inline void ProcessStripe(UInt64 accumulators[4], const UInt8* data)
+		{
+			accumulators[0] = Round(accumulators[0], Read64(data));
+			accumulators[1] = Round(accumulators[1], Read64(data + 8));
+			accumulators[2] = Round(accumulators[2], Read64(data + 16));
+			accumulators[3] = Round(accumulators[3], Read64(data + 24));
+		}
+	}
+
+	HashXXHash64::HashXXHash64(UInt64 seed)
+	{
+		m_state = new HashXXHash64_state;
+		m_state->seed = seed;
+	}
+
+	HashXXHash64::~HashXXHash64()
+	{
+		delete m_state;
+	}
+
+	void HashXXHash64::Append(const UInt8* data, std::size_t len)
+	{
+		m_state->totalLength += len;
+
+		// Input is processed by stripes of 32 bytes, the rest is kept until the next call
+		if (m_state->bufferSize + len < 32)
+		{
+			std::memcpy(&m_state->buffer[m_state->bufferSize], data, len);
+			m_state->bufferSize += len;
+			return;
+		}
+
+		if (m_state->bufferSize > 0)
+		{
+			std::size_t fillSize = 32 - m_state->bufferSize;
+			std::memcpy(&m_state->buffer[m_state->bufferSize], data, fillSize);
+			ProcessStripe(m_state->accumulators, m_state->buffer);
+
+			data += fillSize;
+			len -= fillSize;
+			m_state->bufferSize = 0;
+		}
+
+		while (len >= 32)
+		{
+			ProcessStripe(m_state->accumulators, data);
+
+			data += 32;
+			len -= 32;
+		}
+
+		std::memcpy(m_state->buffer, data, len);
+		m_state->bufferSize = len;
+	}
+
+	void HashXXHash64::Begin()
+	{
+		m_state->accumulators[0] = m_state->seed + Prime1 + Prime2;
+		m_state->accumulators[1] = m_state->seed + Prime2;
+		m_state->accumulators[2] = m_state->seed;
+		m_state->accumulators[3] = m_state->seed - Prime1;
+		m_state->bufferSize = 0;
+		m_state->totalLength = 0;
+	}
+
+	ByteArray HashXXHash64::End()
+	{
+		const UInt64* accumulators = m_state->accumulators;
+
+		UInt64 hash;
+		if (m_state->totalLength >= 32)
+		{
+			hash = RotateLeft(accumulators[0], 1) + RotateLeft(accumulators[1], 7) + RotateLeft(accumulators[2], 12) + RotateLeft(accumulators[3], 18);
+			for (unsigned int i = 0; i < 4; ++i)
+				hash = MergeRound(hash, accumulators[i]);
+		}
+		else
+			hash = m_state->seed + Prime5;
+
+		hash += m_state->totalLength;
+
+		const UInt8* data = m_state->buffer;
+		const UInt8* end = data + m_state->bufferSize;
+		for (; data + 8 <= end; data += 8)
+		{
+			hash ^= Round(0, Read64(data));
+			hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+		}
+
+		if (data + 4 <= end)
+		{
+			hash ^= Read32(data) * Prime1;
+			hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+			data += 4;
+		}
+
+		for (; data < end; ++data)
+		{
+			hash ^= *data * Prime5;
+			hash = RotateLeft(hash, 11) * Prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+
+		// Canonical representation is big-endian, like the other hashes
+		#ifdef NAZARA_LITTLE_ENDIAN
+		SwapBytes(&hash, sizeof(UInt64));
+		#endif
+
+		return ByteArray(reinterpret_cast<UInt8*>(&hash), 8);
+	}
+
+	std::size_t HashXXHash64::GetDigestLength() const
+	{
+		return 8;
+	}
+
+	const char* HashXXHash64::GetHashName() const
+	{
+		return "XXHash64";
+	}
+}
@@ -0,0 +1,189 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MappedFileView.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+	#include <Nazara/Core/Win32/MappedFileViewImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+	#include <Nazara/Core/Posix/MappedFileViewImpl.hpp>
+#else
+	#error OS not handled
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	MappedFileView::MappedFileView() :
+	m_data(nullptr),
+	m_pos(0),
+	m_size(0)
+	{
+	}
+
+	MappedFileView::MappedFileView(const String& filePath, UInt32 openMode) :
+	MappedFileView()
+	{
+		Open(filePath, openMode);
+	}
+
+	MappedFileView::MappedFileView(MappedFileView&& view) noexcept :
+	Stream(std::move(view)),
+	m_filePath(std::move(view.m_filePath)),
+	m_data(view.m_data),
+	m_pos(view.m_pos),
+	m_size(view.m_size)
+	{
+		view.m_data = nullptr;
+		view.m_openMode = OpenMode_NotOpen;
+		view.m_size = 0;
+	}
+
+	MappedFileView::~MappedFileView()
+	{
+		Close();
+	}
+
+	void MappedFileView::Close()
+	{
+		if (!IsOpen())
+			return;
+
+		if (m_data)
+			MappedFileViewImpl::Unmap(m_data, m_size);
+
+		m_data = nullptr;
+		m_filePath.Clear();
+		m_openMode = OpenMode_NotOpen;
+		m_pos = 0;
+		m_size = 0;
+	}
+
+	bool MappedFileView::EndOfStream() const
+	{
+		return m_pos >= m_size;
+	}
+
+	UInt64 MappedFileView::GetCursorPos() const
+	{
+		return m_pos;
+	}
+
+	String MappedFileView::GetDirectory() const
+	{
+		return m_filePath.SubStringTo(NAZARA_DIRECTORY_SEPARATOR, -1, true, true);
+	}
+
+	const void* MappedFileView::GetMemoryPointer() const
+	{
+		return m_data;
+	}
+
+	String MappedFileView::GetPath() const
+	{
+		return m_filePath;
+	}
+
+	UInt64 MappedFileView::GetSize() const
+	{
+		return m_size;
+	}
+
+	bool MappedFileView::Open(const String& filePath, UInt32 openMode)
+	{
+		///DOC: The file must exist, and its size cannot change through the view
+		Close();
+
+		if ((openMode & OpenMode_ReadWrite) == 0)
+		{
+			NazaraError("Open mode must allow reading or writing");
+			return false;
+		}
+
+		String absolutePath = File::AbsolutePath(filePath);
+
+		if (!MappedFileViewImpl::Map(absolutePath, openMode, &m_data, &m_size))
+		{
+			ErrorFlags flags(ErrorFlag_Silent); // Silent by default, like File
+			NazaraError("Failed to map \"" + absolutePath + "\": " + Error::GetLastSystemError());
+			return false;
+		}
+
+		m_filePath = std::move(absolutePath);
+		m_openMode = openMode;
+		m_pos = 0;
+
+		if (m_openMode & OpenMode_Text)
+			m_streamOptions |= StreamOption_Text;
+		else
+			m_streamOptions &= ~StreamOption_Text;
+
+		return true;
+	}
+
+	bool MappedFileView::SetAccessPattern(AccessPattern pattern)
+	{
+		///DOC: Only a hint, which is not supported on every platform
+		NazaraAssert(IsOpen(), "File is not mapped");
+
+		if (!m_data)
+			return true;
+
+		return MappedFileViewImpl::SetAccessPattern(m_data, m_size, pattern);
+	}
+
+	bool MappedFileView::SetCursorPos(UInt64 offset)
+	{
+		m_pos = std::min(offset, m_size);
+
+		return true;
+	}
+
+	MappedFileView& MappedFileView::operator=(MappedFileView&& view) noexcept
+	{
+		std::swap(m_data, view.m_data);
+		std::swap(m_filePath, view.m_filePath);
+		std::swap(m_openMode, view.m_openMode);
+		std::swap(m_pos, view.m_pos);
+		std::swap(m_size, view.m_size);
+		std::swap(m_streamOptions, view.m_streamOptions);
+
+		return *this;
+	}
+
+	void MappedFileView::FlushStream()
+	{
+		if (m_data && !MappedFileViewImpl::Flush(m_data, m_size))
+			NazaraError("Unable to flush mapped file: " + Error::GetLastSystemError());
+	}
+
+	std::size_t MappedFileView::ReadBlock(void* buffer, std::size_t size)
+	{
+		std::size_t readSize = std::min<std::size_t>(size, static_cast<std::size_t>(m_size - m_pos));
+
+		if (buffer && readSize > 0)
+			std::memcpy(buffer, &m_data[m_pos], readSize);
+
+		m_pos += readSize;
+		return readSize;
+	}
+
+	std::size_t MappedFileView::WriteBlock(const void* buffer, std::size_t size)
+	{
+		std::size_t writeSize = std::min<std::size_t>(size, static_cast<std::size_t>(m_size - m_pos));
+
+		if (writeSize > 0)
+			std::memcpy(&m_data[m_pos], buffer, writeSize);
+
+		m_pos += writeSize;
+		return writeSize;
+	}
+}
@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/MemoryManager.hpp>
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
@@ -13,6 +15,10 @@
 	#include <windows.h>
 #elif defined(NAZARA_PLATFORM_POSIX)
 	#include <pthread.h>
+	#if defined(__GLIBC__)
+		#include <execinfo.h>
+		#define NAZARA_CORE_MEMORY_BACKTRACE
+	#endif
 #endif
 
 // Le seul fichier n'ayant pas à inclure Debug.hpp
@@ -23,6 +29,7 @@ namespace Nz
 	{
 		constexpr unsigned int s_allocatedId = 0xDEADB33FUL;
 		constexpr unsigned int s_freedId = 0x4B1DUL;
+		constexpr std::size_t s_maxSamples = 1024;
 
 		struct Block
 		{
@@ -31,16 +38,51 @@ namespace Nz
 			Block* prev;
 			Block* next;
 			bool array;
+			bool tracked;
+			UInt8 tag;
 			unsigned int line;
 			unsigned int magic;
 		};
 
+		// Counters of a thread, only written by it (without atomic read-modify-write) and summed by snapshots
+		// Nodes are never released, so counters of exited threads stay in the totals
+		struct ThreadStats
+		{
+			std::atomic<UInt64> allocationCount[MemoryTag_Max + 1];
+			std::atomic<UInt64> allocatedSize[MemoryTag_Max + 1];
+			std::atomic<UInt64> freeCount[MemoryTag_Max + 1];
+			std::atomic<UInt64> freedSize[MemoryTag_Max + 1];
+			ThreadStats* next;
+			unsigned int sampleCountdown;
+			unsigned int samplingGeneration;
+		};
+
+		const char* s_tagNames[] = {
+			"Unknown",  // MemoryTag_Unknown
+			"Audio",    // MemoryTag_Audio
+			"Core",     // MemoryTag_Core
+			"Graphics", // MemoryTag_Graphics
+			"Lua",      // MemoryTag_Lua
+			"Network",  // MemoryTag_Network
+			"Noise",    // MemoryTag_Noise
+			"Physics",  // MemoryTag_Physics
+			"Renderer", // MemoryTag_Renderer
+			"SDK",      // MemoryTag_SDK
+			"User",     // MemoryTag_User
+			"Utility"   // MemoryTag_Utility
+		};
+
+		static_assert(sizeof(s_tagNames) / sizeof(const char*) == MemoryTag_Max + 1, "Memory tag name array is incomplete");
+
 		bool s_allocationFilling = true;
 		bool s_allocationLogging = false;
 		bool s_initialized = false;
+		bool s_leakTracking = true;
 		const char* s_logFileName = "NazaraMemory.log";
 		thread_local const char* s_nextFreeFile = "(Internal error)";
 		thread_local unsigned int s_nextFreeLine = 0;
+		thread_local MemoryTag s_currentTag = MemoryTag_Unknown;
+		thread_local ThreadStats* s_currentThreadStats = nullptr;
 
 		Block s_list =
 		{
@@ -49,11 +91,16 @@ namespace Nz
 			&s_list,
 			&s_list,
 			false,
+			false,
+			0,
 			0,
 			0
 		};
 
-		unsigned int s_allocationCount = 0;
+		std::atomic<ThreadStats*> s_threadStats(nullptr);
+		std::atomic_uint s_samplingGeneration(0); // Incremented on every rate change, threads compare it to restart their countdown
+		std::atomic_uint s_samplingRate(0);
+		MemoryManager::CallStackSample s_samples[s_maxSamples];
 		unsigned int s_allocatedBlock = 0;
 		std::size_t s_allocatedSize = 0;
 
@@ -62,8 +109,114 @@ namespace Nz
 		#elif defined(NAZARA_PLATFORM_POSIX)
 		pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
 		#endif
+
+		void LockMutex()
+		{
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			EnterCriticalSection(&s_mutex);
+			#elif defined(NAZARA_PLATFORM_POSIX)
+			pthread_mutex_lock(&s_mutex);
+			#endif
+		}
+
+		void UnlockMutex()
+		{
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			LeaveCriticalSection(&s_mutex);
+			#elif defined(NAZARA_PLATFORM_POSIX)
+			pthread_mutex_unlock(&s_mutex);
+			#endif
+		}
+
+		void AddToCounter(std::atomic<UInt64>& counter, UInt64 value)
+		{
+			// Only the owning thread writes the counter, a load and a store are enough
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		ThreadStats& GetThreadStats()
+		{
+			if (s_currentThreadStats)
+				return *s_currentThreadStats;
+
+			// Cannot use new here, it would come back to the memory manager
+			ThreadStats* stats = static_cast<ThreadStats*>(std::malloc(sizeof(ThreadStats)));
+			if (!stats)
+				throw std::bad_alloc();
+
+			for (unsigned int i = 0; i <= MemoryTag_Max; ++i)
+			{
+				new (&stats->allocationCount[i]) std::atomic<UInt64>(0);
+				new (&stats->allocatedSize[i]) std::atomic<UInt64>(0);
+				new (&stats->freeCount[i]) std::atomic<UInt64>(0);
+				new (&stats->freedSize[i]) std::atomic<UInt64>(0);
+			}
+			stats->samplingGeneration = s_samplingGeneration.load(std::memory_order_acquire);
+			stats->sampleCountdown = s_samplingRate.load(std::memory_order_relaxed);
+
+			ThreadStats* head = s_threadStats.load(std::memory_order_relaxed);
+			do
+				stats->next = head;
+			while (!s_threadStats.compare_exchange_weak(head, stats, std::memory_order_release, std::memory_order_relaxed));
+
+			s_currentThreadStats = stats;
+			return *stats;
+		}
+
+		std::size_t CaptureCallStack(void** frames, std::size_t maxCount)
+		{
+			// The first frames are the memory manager ones (depending on inlining)
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			return CaptureStackBackTrace(0, static_cast<DWORD>(maxCount), frames, nullptr);
+			#elif defined(NAZARA_CORE_MEMORY_BACKTRACE)
+			return static_cast<std::size_t>(backtrace(frames, static_cast<int>(maxCount)));
+			#else
+			NazaraUnused(frames);
+			NazaraUnused(maxCount);
+			return 0;
+			#endif
+		}
+
+		void RecordSample(std::size_t size, MemoryTag tag, const char* file, unsigned int line)
+		{
+			void* frames[MemoryManager::MaxCallStackDepth];
+			std::size_t frameCount = CaptureCallStack(frames, MemoryManager::MaxCallStackDepth);
+
+			std::size_t hash = reinterpret_cast<std::uintptr_t>(file) ^ line;
+			for (std::size_t i = 0; i < frameCount; ++i)
+				hash = hash * 31 + reinterpret_cast<std::uintptr_t>(frames[i]);
+
+			// Samples are stored in a fixed open addressing table, to not allocate while allocating
+			LockMutex();
+			for (std::size_t i = 0; i < s_maxSamples; ++i)
+			{
+				MemoryManager::CallStackSample& sample = s_samples[(hash + i) % s_maxSamples];
+				if (sample.sampleCount == 0)
+				{
+					std::memcpy(sample.frames, frames, frameCount * sizeof(void*));
+					sample.file = file;
+					sample.frameCount = frameCount;
+					sample.line = line;
+					sample.sampleCount = 1;
+					sample.sampledSize = size;
+					sample.tag = tag;
+					break;
+				}
+
+				if (sample.file == file && sample.line == line && sample.tag == tag && sample.frameCount == frameCount &&
+				    std::memcmp(sample.frames, frames, frameCount * sizeof(void*)) == 0)
+				{
+					sample.sampleCount++;
+					sample.sampledSize += size;
+					break;
+				}
+			}
+			UnlockMutex();
+		}
 	}
 
+	constexpr std::size_t MemoryManager::MaxCallStackDepth;
+
 	MemoryManager::MemoryManager()
 	{
 	}
@@ -78,18 +231,14 @@ namespace Nz
 		if (!s_initialized)
 			Initialize();
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		EnterCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_lock(&s_mutex);
-		#endif
-
 		Block* ptr = reinterpret_cast<Block*>(std::malloc(size+sizeof(Block)));
 		if (!ptr)
 		{
 			char timeStr[23];
 			TimeInfo(timeStr);
 
+			LockMutex();
+
 			FILE* log = std::fopen(s_logFileName, "a");
 
 			if (file)
@@ -99,23 +248,37 @@ namespace Nz
 
 			std::fclose(log);
 
+			UnlockMutex();
+
 			throw std::bad_alloc();
 		}
 
+		MemoryTag tag = s_currentTag;
+
 		ptr->array = multi;
 		ptr->file = file;
 		ptr->line = line;
 		ptr->size = size;
 		ptr->magic = s_allocatedId;
+		ptr->tag = static_cast<UInt8>(tag);
+		ptr->tracked = s_leakTracking;
 
-		ptr->prev = s_list.prev;
-		ptr->next = &s_list;
-		s_list.prev->next = ptr;
-		s_list.prev = ptr;
+		ThreadStats& stats = GetThreadStats();
+		AddToCounter(stats.allocationCount[tag], 1);
+		AddToCounter(stats.allocatedSize[tag], size);
 
-		s_allocatedBlock++;
-		s_allocatedSize += size;
-		s_allocationCount++;
+		unsigned int samplingGeneration = s_samplingGeneration.load(std::memory_order_acquire);
+		if (stats.samplingGeneration != samplingGeneration)
+		{
+			stats.samplingGeneration = samplingGeneration;
+			stats.sampleCountdown = s_samplingRate.load(std::memory_order_relaxed);
+		}
+
+		if (stats.sampleCountdown > 0 && --stats.sampleCountdown == 0)
+		{
+			stats.sampleCountdown = s_samplingRate.load(std::memory_order_relaxed);
+			RecordSample(size, tag, file, line);
+		}
 
 		if (s_allocationFilling)
 		{
@@ -123,6 +286,23 @@ namespace Nz
 			std::memset(data, 0xFF, size);
 		}
 
+		// Without leak tracking (and logging), no lock is taken
+		if (!ptr->tracked && !s_allocationLogging)
+			return reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
+
+		LockMutex();
+
+		if (ptr->tracked)
+		{
+			ptr->prev = s_list.prev;
+			ptr->next = &s_list;
+			s_list.prev->next = ptr;
+			s_list.prev = ptr;
+
+			s_allocatedBlock++;
+			s_allocatedSize += size;
+		}
+
 		if (s_allocationLogging)
 		{
 			char timeStr[23];
@@ -138,15 +318,32 @@ namespace Nz
 			std::fclose(log);
 		}
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		LeaveCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_unlock(&s_mutex);
-		#endif
+		UnlockMutex();
 
 		return reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
 	}
 
+	void MemoryManager::ClearCallStackSamples()
+	{
+		LockMutex();
+		std::memset(s_samples, 0, sizeof(s_samples));
+		UnlockMutex();
+	}
+
+	MemoryManager::Snapshot MemoryManager::Diff(const Snapshot& previous, const Snapshot& current)
+	{
+		Snapshot diff;
+		for (unsigned int i = 0; i <= MemoryTag_Max; ++i)
+		{
+			diff.tags[i].allocationCount = current.tags[i].allocationCount - previous.tags[i].allocationCount;
+			diff.tags[i].allocatedSize = current.tags[i].allocatedSize - previous.tags[i].allocatedSize;
+			diff.tags[i].freeCount = current.tags[i].freeCount - previous.tags[i].freeCount;
+			diff.tags[i].freedSize = current.tags[i].freedSize - previous.tags[i].freedSize;
+		}
+
+		return diff;
+	}
+
 	void MemoryManager::EnableAllocationFilling(bool allocationFilling)
 	{
 		s_allocationFilling = allocationFilling;
@@ -157,6 +354,12 @@ namespace Nz
 		s_allocationLogging = logAllocations;
 	}
 
+	void MemoryManager::EnableLeakTracking(bool leakTracking)
+	{
+		///DOC: Only affects the blocks allocated after the call
+		s_leakTracking = leakTracking;
+	}
+
 	void MemoryManager::Free(void* pointer, bool multi)
 	{
 		if (!pointer)
@@ -180,17 +383,13 @@ namespace Nz
 			return;
 		}
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		EnterCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_lock(&s_mutex);
-		#endif
-
 		if (ptr->array != multi)
 		{
 			char timeStr[23];
 			TimeInfo(timeStr);
 
+			LockMutex();
+
 			FILE* log = std::fopen(s_logFileName, "a");
 
 			const char* error = (multi) ? "delete[] after new" : "delete after new[]";
@@ -200,14 +399,28 @@ namespace Nz
 				std::fprintf(log, "%s Warning: %s at unknown position\n", timeStr, error);
 
 			std::fclose(log);
+
+			UnlockMutex();
 		}
 
 		ptr->magic = s_freedId;
-		ptr->prev->next = ptr->next;
-		ptr->next->prev = ptr->prev;
 
-		s_allocatedBlock--;
-		s_allocatedSize -= ptr->size;
+		if (ptr->tracked)
+		{
+			LockMutex();
+
+			ptr->prev->next = ptr->next;
+			ptr->next->prev = ptr->prev;
+
+			s_allocatedBlock--;
+			s_allocatedSize -= ptr->size;
+
+			UnlockMutex();
+		}
+
+		ThreadStats& stats = GetThreadStats();
+		AddToCounter(stats.freeCount[ptr->tag], 1);
+		AddToCounter(stats.freedSize[ptr->tag], ptr->size);
 
 		if (s_allocationFilling)
 		{
@@ -219,27 +432,69 @@ namespace Nz
 
 		s_nextFreeFile = nullptr;
 		s_nextFreeLine = 0;
-
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		LeaveCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_unlock(&s_mutex);
-		#endif
 	}
 
 	unsigned int MemoryManager::GetAllocatedBlockCount()
 	{
-		return s_allocatedBlock;
+		Snapshot snapshot = TakeSnapshot();
+
+		UInt64 blockCount = 0;
+		for (const TagStats& stats : snapshot.tags)
+			blockCount += stats.allocationCount - stats.freeCount;
+
+		return static_cast<unsigned int>(blockCount);
 	}
 
 	std::size_t MemoryManager::GetAllocatedSize()
 	{
-		return s_allocatedSize;
+		Snapshot snapshot = TakeSnapshot();
+
+		UInt64 allocatedSize = 0;
+		for (const TagStats& stats : snapshot.tags)
+			allocatedSize += stats.allocatedSize - stats.freedSize;
+
+		return static_cast<std::size_t>(allocatedSize);
 	}
 
 	unsigned int MemoryManager::GetAllocationCount()
 	{
-		return s_allocationCount;
+		Snapshot snapshot = TakeSnapshot();
+
+		UInt64 allocationCount = 0;
+		for (const TagStats& stats : snapshot.tags)
+			allocationCount += stats.allocationCount;
+
+		return static_cast<unsigned int>(allocationCount);
+	}
+
+	unsigned int MemoryManager::GetCallStackSamplingRate()
+	{
+		return s_samplingRate.load(std::memory_order_relaxed);
+	}
+
+	std::size_t MemoryManager::GetCallStackSamples(CallStackSample* samples, std::size_t maxCount)
+	{
+		std::size_t count = 0;
+
+		LockMutex();
+		for (std::size_t i = 0; i < s_maxSamples && count < maxCount; ++i)
+		{
+			if (s_samples[i].sampleCount > 0)
+				samples[count++] = s_samples[i];
+		}
+		UnlockMutex();
+
+		return count;
+	}
+
+	MemoryTag MemoryManager::GetCurrentTag()
+	{
+		return s_currentTag;
+	}
+
+	const char* MemoryManager::GetTagName(MemoryTag tag)
+	{
+		return s_tagNames[tag];
 	}
 
 	bool MemoryManager::IsAllocationFillingEnabled()
@@ -252,12 +507,84 @@ namespace Nz
 		return s_allocationLogging;
 	}
 
+	bool MemoryManager::IsLeakTrackingEnabled()
+	{
+		return s_leakTracking;
+	}
+
+	void MemoryManager::LogCallStackSamples()
+	{
+		char timeStr[23];
+		TimeInfo(timeStr);
+
+		LockMutex();
+
+		FILE* log = std::fopen(s_logFileName, "a");
+		std::fprintf(log, "%s Sampled allocations (one every %u allocations per thread):\n", timeStr, s_samplingRate.load(std::memory_order_relaxed));
+
+		for (const CallStackSample& sample : s_samples)
+		{
+			if (sample.sampleCount == 0)
+				continue;
+
+			if (sample.file)
+				std::fprintf(log, "- [%s] %u samples (%zu bytes) at %s:%u\n", s_tagNames[sample.tag], sample.sampleCount, sample.sampledSize, sample.file, sample.line);
+			else
+				std::fprintf(log, "- [%s] %u samples (%zu bytes) at unknown position\n", s_tagNames[sample.tag], sample.sampleCount, sample.sampledSize);
+
+			#ifdef NAZARA_CORE_MEMORY_BACKTRACE
+			std::fflush(log);
+			backtrace_symbols_fd(sample.frames, static_cast<int>(sample.frameCount), fileno(log));
+			#else
+			for (std::size_t i = 0; i < sample.frameCount; ++i)
+				std::fprintf(log, "    0x%p\n", sample.frames[i]);
+			#endif
+		}
+
+		std::fclose(log);
+
+		UnlockMutex();
+	}
+
 	void MemoryManager::NextFree(const char* file, unsigned int line)
 	{
 		s_nextFreeFile = file;
 		s_nextFreeLine = line;
 	}
 
+	void MemoryManager::SetCallStackSamplingRate(unsigned int rate)
+	{
+		///DOC: Records the call stack of one allocation every rate allocations (per thread), 0 disables sampling
+		s_samplingRate.store(rate, std::memory_order_relaxed);
+		s_samplingGeneration.fetch_add(1, std::memory_order_release);
+	}
+
+	void MemoryManager::SetCurrentTag(MemoryTag tag)
+	{
+		///DOC: The tag is per thread, MemoryTagScope should be preferred
+		s_currentTag = tag;
+	}
+
+	MemoryManager::Snapshot MemoryManager::TakeSnapshot()
+	{
+		///DOC: Counters of other threads may be a few allocations behind
+		Snapshot snapshot;
+		std::memset(&snapshot, 0, sizeof(Snapshot));
+
+		for (ThreadStats* stats = s_threadStats.load(std::memory_order_acquire); stats; stats = stats->next)
+		{
+			for (unsigned int i = 0; i <= MemoryTag_Max; ++i)
+			{
+				snapshot.tags[i].allocationCount += stats->allocationCount[i].load(std::memory_order_relaxed);
+				snapshot.tags[i].allocatedSize += stats->allocatedSize[i].load(std::memory_order_relaxed);
+				snapshot.tags[i].freeCount += stats->freeCount[i].load(std::memory_order_relaxed);
+				snapshot.tags[i].freedSize += stats->freedSize[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		return snapshot;
+	}
+
 	void MemoryManager::Initialize()
 	{
 		char timeStr[23];
@@ -303,6 +630,17 @@ namespace Nz
 
 		std::fprintf(log, "%s Application finished, checking leaks...\n", timeStr);
 
+		// Counters also include the blocks allocated without leak tracking
+		Snapshot snapshot = TakeSnapshot();
+		for (unsigned int i = 0; i <= MemoryTag_Max; ++i)
+		{
+			const TagStats& stats = snapshot.tags[i];
+			if (stats.allocationCount > 0)
+				std::fprintf(log, "%s [%s] %llu allocations (%llu bytes), %llu still allocated (%llu bytes)\n", timeStr, s_tagNames[i],
+				             static_cast<unsigned long long>(stats.allocationCount), static_cast<unsigned long long>(stats.allocatedSize),
+				             static_cast<unsigned long long>(stats.allocationCount - stats.freeCount), static_cast<unsigned long long>(stats.allocatedSize - stats.freedSize));
+		}
+
 		if (s_allocatedBlock == 0)
 		{
 			std::fprintf(log, "%s ==============================\n", timeStr);
@@ -334,5 +672,16 @@ namespace Nz
 		}
 
 		std::fclose(log);
-}
+	}
+
+	MemoryTagScope::MemoryTagScope(MemoryTag tag) :
+	m_previousTag(s_currentTag)
+	{
+		s_currentTag = tag;
+	}
+
+	MemoryTagScope::~MemoryTagScope()
+	{
+		s_currentTag = m_previousTag;
+	}
 }
@@ -48,6 +48,12 @@ namespace Nz
 		return m_buffer.GetConstBuffer();
 	}
 
+	const void* MemoryStream::GetMemoryPointer() const
+	{
+		///DOC: The pointer is invalidated by the next write
+		return m_buffer.GetConstBuffer();
+	}
+
 	UInt64 MemoryStream::GetSize() const
 	{
 		return m_buffer.size();
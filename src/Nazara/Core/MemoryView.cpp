@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/Directory.hpp>
 #include <algorithm>
 #include <cstring>
 #include <Nazara/Core/Debug.hpp>
@@ -17,6 +18,15 @@ namespace Nz
 	{
 	}
 
+	MemoryView::MemoryView(const void* ptr, UInt64 size, const String& filePath) :
+	Stream(StreamOption_None, OpenMode_ReadOnly),
+	m_filePath(filePath),
+	m_ptr(reinterpret_cast<const UInt8*>(ptr)),
+	m_pos(0),
+	m_size(size)
+	{
+	}
+
 	bool MemoryView::EndOfStream() const
 	{
 		return m_pos >= m_size;
@@ -27,6 +37,21 @@ namespace Nz
 		return m_pos;
 	}
 
+	String MemoryView::GetDirectory() const
+	{
+		return m_filePath.SubStringTo(NAZARA_DIRECTORY_SEPARATOR, -1, true, true);
+	}
+
+	const void* MemoryView::GetMemoryPointer() const
+	{
+		return m_ptr;
+	}
+
+	String MemoryView::GetPath() const
+	{
+		return m_filePath;
+	}
+
 	UInt64 MemoryView::GetSize() const
 	{
 		return m_size;
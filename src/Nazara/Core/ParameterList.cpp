@@ -31,11 +31,24 @@ namespace Nz
 	}
 
 	bool ParameterList::GetBooleanParameter(const String& name, bool* value) const
+	{
+		// Looking a name up must not intern it, an atom which was never created can't be a key
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetBooleanParameter(atom, value);
+	}
+
+	bool ParameterList::GetBooleanParameter(const StringAtom& name, bool* value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -73,11 +86,23 @@ namespace Nz
 	}
 
 	bool ParameterList::GetFloatParameter(const String& name, float* value) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetFloatParameter(atom, value);
+	}
+
+	bool ParameterList::GetFloatParameter(const StringAtom& name, float* value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -115,11 +140,23 @@ namespace Nz
 	}
 
 	bool ParameterList::GetIntegerParameter(const String& name, int* value) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetIntegerParameter(atom, value);
+	}
+
+	bool ParameterList::GetIntegerParameter(const StringAtom& name, int* value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -162,6 +199,15 @@ namespace Nz
 	}
 
 	bool ParameterList::GetParameterType(const String& name, ParameterType* type) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+			return false;
+
+		return GetParameterType(atom, type);
+	}
+
+	bool ParameterList::GetParameterType(const StringAtom& name, ParameterType* type) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
@@ -173,11 +219,23 @@ namespace Nz
 	}
 
 	bool ParameterList::GetPointerParameter(const String& name, void** value) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetPointerParameter(atom, value);
+	}
+
+	bool ParameterList::GetPointerParameter(const StringAtom& name, void** value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -204,11 +262,23 @@ namespace Nz
 	}
 
 	bool ParameterList::GetStringParameter(const String& name, String* value) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetStringParameter(atom, value);
+	}
+
+	bool ParameterList::GetStringParameter(const StringAtom& name, String* value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -248,11 +318,23 @@ namespace Nz
 	}
 
 	bool ParameterList::GetUserdataParameter(const String& name, void** value) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+		{
+			NazaraError("Parameter \"" + name + "\" is not present");
+			return false;
+		}
+
+		return GetUserdataParameter(atom, value);
+	}
+
+	bool ParameterList::GetUserdataParameter(const StringAtom& name, void** value) const
 	{
 		auto it = m_parameters.find(name);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + name.GetString() + "\" is not present");
 			return false;
 		}
 
@@ -269,11 +351,27 @@ namespace Nz
 	}
 
 	bool ParameterList::HasParameter(const String& name) const
+	{
+		StringAtom atom;
+		if (!StringAtom::Find(name, &atom))
+			return false;
+
+		return HasParameter(atom);
+	}
+
+	bool ParameterList::HasParameter(const StringAtom& name) const
 	{
 		return m_parameters.find(name) != m_parameters.end();
 	}
 
 	void ParameterList::RemoveParameter(const String& name)
+	{
+		StringAtom atom;
+		if (StringAtom::Find(name, &atom))
+			RemoveParameter(atom);
+	}
+
+	void ParameterList::RemoveParameter(const StringAtom& name)
 	{
 		auto it = m_parameters.find(name);
 		if (it != m_parameters.end())
@@ -284,6 +382,46 @@ namespace Nz
 	}
 
 	void ParameterList::SetParameter(const String& name)
+	{
+		SetParameter(StringAtom(name));
+	}
+
+	void ParameterList::SetParameter(const String& name, const String& value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, const char* value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, void* value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, void* value, Destructor destructor)
+	{
+		SetParameter(StringAtom(name), value, destructor);
+	}
+
+	void ParameterList::SetParameter(const String& name, bool value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, float value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, int value)
+	{
+		SetParameter(StringAtom(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringAtom& name)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -294,7 +432,7 @@ namespace Nz
 		parameter.type = ParameterType_None;
 	}
 
-	void ParameterList::SetParameter(const String& name, const String& value)
+	void ParameterList::SetParameter(const StringAtom& name, const String& value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -307,7 +445,7 @@ namespace Nz
 		PlacementNew<String>(&parameter.value.stringVal, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, const char* value)
+	void ParameterList::SetParameter(const StringAtom& name, const char* value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -320,7 +458,7 @@ namespace Nz
 		PlacementNew<String>(&parameter.value.stringVal, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, void* value)
+	void ParameterList::SetParameter(const StringAtom& name, void* value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -332,7 +470,7 @@ namespace Nz
 		parameter.value.ptrVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, void* value, Destructor destructor)
+	void ParameterList::SetParameter(const StringAtom& name, void* value, Destructor destructor)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -344,7 +482,7 @@ namespace Nz
 		parameter.value.userdataVal = new Parameter::UserdataValue(destructor, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, bool value)
+	void ParameterList::SetParameter(const StringAtom& name, bool value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -356,7 +494,7 @@ namespace Nz
 		parameter.value.boolVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, float value)
+	void ParameterList::SetParameter(const StringAtom& name, float value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -368,7 +506,7 @@ namespace Nz
 		parameter.value.floatVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, int value)
+	void ParameterList::SetParameter(const StringAtom& name, int value)
 	{
 		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
 		Parameter& parameter = pair.first->second;
@@ -54,7 +54,7 @@ namespace Nz
 		int flags;
 		mode_t permissions = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
 
-		if (mode & OpenMode_ReadWrite)
+		if ((mode & OpenMode_ReadWrite) == OpenMode_ReadWrite)
 			flags = O_CREAT | O_RDWR;
 		else if (mode & OpenMode_ReadOnly)
 			flags = O_RDONLY;
@@ -63,4 +63,20 @@ namespace Nz
 		#endif
 	#endif
 	}
+
+	UInt64 HardwareInfoImpl::Xgetbv(UInt32 registerId)
+	{
+	#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_INTEL)
+		// Encoded by hand, the mnemonic needs the assembler to know about XSAVE
+		UInt32 eax, edx;
+		asm volatile (".byte 0x0f, 0x01, 0xd0" // xgetbv
+					  : "=a" (eax), "=d" (edx) // output
+					  : "c" (registerId));     // input
+
+		return (static_cast<UInt64>(edx) << 32) | eax;
+	#else
+		NazaraInternalError("Xgetbv has been called although it is not supported");
+		return 0;
+	#endif
+	}
 }
@@ -19,6 +19,7 @@ namespace Nz
 			static unsigned int GetProcessorCount();
 			static UInt64 GetTotalMemory();
 			static bool IsCpuidSupported();
+			static UInt64 Xgetbv(UInt32 registerId);
 	};
 }
 
@@ -0,0 +1,86 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Posix/MappedFileViewImpl.hpp>
+#include <Nazara/Core/String.hpp>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	bool MappedFileViewImpl::Flush(UInt8* data, UInt64 size)
+	{
+		return msync(data, static_cast<std::size_t>(size), MS_SYNC) == 0;
+	}
+
+	bool MappedFileViewImpl::Map(const String& filePath, UInt32 openMode, UInt8** data, UInt64* size)
+	{
+		bool writable = (openMode & OpenMode_WriteOnly) != 0;
+
+		int fileDescriptor = open64(filePath.GetConstBuffer(), (writable) ? O_RDWR : O_RDONLY);
+		if (fileDescriptor == -1)
+			return false;
+
+		struct stat64 fileInfo;
+		if (fstat64(fileDescriptor, &fileInfo) == -1 || static_cast<UInt64>(fileInfo.st_size) > std::numeric_limits<std::size_t>::max())
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		// An empty file cannot be mapped, but it is still a valid (empty) view
+		void* mapping = nullptr;
+		if (fileInfo.st_size > 0)
+		{
+			mapping = mmap(nullptr, static_cast<std::size_t>(fileInfo.st_size), (writable) ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fileDescriptor, 0);
+			if (mapping == MAP_FAILED)
+			{
+				close(fileDescriptor);
+				return false;
+			}
+		}
+
+		// The mapping stays valid once the descriptor is closed
+		close(fileDescriptor);
+
+		*data = static_cast<UInt8*>(mapping);
+		*size = static_cast<UInt64>(fileInfo.st_size);
+
+		return true;
+	}
+
+	bool MappedFileViewImpl::SetAccessPattern(UInt8* data, UInt64 size, AccessPattern pattern)
+	{
+		int advice;
+		switch (pattern)
+		{
+			case AccessPattern_Normal:
+				advice = POSIX_MADV_NORMAL;
+				break;
+
+			case AccessPattern_Random:
+				advice = POSIX_MADV_RANDOM;
+				break;
+
+			case AccessPattern_Sequential:
+				advice = POSIX_MADV_SEQUENTIAL;
+				break;
+
+			default:
+				return false;
+		}
+
+		return posix_madvise(data, static_cast<std::size_t>(size), advice) == 0;
+	}
+
+	void MappedFileViewImpl::Unmap(UInt8* data, UInt64 size)
+	{
+		munmap(data, static_cast<std::size_t>(size));
+	}
+}
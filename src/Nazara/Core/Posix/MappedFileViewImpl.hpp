@@ -0,0 +1,34 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MAPPEDFILEVIEWIMPL_HPP
+#define NAZARA_MAPPEDFILEVIEWIMPL_HPP
+
+#ifndef _LARGEFILE64_SOURCE
+#define _LARGEFILE64_SOURCE
+#endif
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
+
+namespace Nz
+{
+	class String;
+
+	class MappedFileViewImpl
+	{
+		public:
+			MappedFileViewImpl() = delete;
+			~MappedFileViewImpl() = delete;
+
+			static bool Flush(UInt8* data, UInt64 size);
+			static bool Map(const String& filePath, UInt32 openMode, UInt8** data, UInt64* size);
+			static bool SetAccessPattern(UInt8* data, UInt64 size, AccessPattern pattern);
+			static void Unmap(UInt8* data, UInt64 size);
+	};
+}
+
+#endif // NAZARA_MAPPEDFILEVIEWIMPL_HPP
@@ -0,0 +1,383 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/StringStream.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct Event
+		{
+			const char* name;
+			UInt64 begin;
+			UInt64 duration;
+			UInt64 selfTime;
+		};
+
+		struct OpenZone
+		{
+			const char* name;
+			UInt64 begin;
+			UInt64 childTime;
+			bool recorded;
+		};
+
+		struct ThreadBuffer
+		{
+			// Written by the owning thread only, read by the thread calling EndFrame
+			std::unique_ptr<Event[]> events;
+			std::array<OpenZone, Profiler::MaxZoneDepth> zones;
+			std::atomic<UInt64> writeCount;
+			std::atomic_bool inUse;
+			std::size_t depth;
+			UInt64 readCount;
+			unsigned int index;
+		};
+
+		struct ThreadBufferOwner
+		{
+			~ThreadBufferOwner()
+			{
+				// Let another thread reuse the buffer, its pending events are still collected
+				if (buffer)
+					buffer->inUse.store(false, std::memory_order_release);
+			}
+
+			ThreadBuffer* buffer = nullptr;
+		};
+
+		struct CapturedEvent
+		{
+			Event event;
+			unsigned int threadIndex;
+		};
+
+		std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+		std::vector<CapturedEvent> s_capture;
+		std::vector<Event> s_collectedEvents;
+		std::atomic_bool s_capturing(false);
+		std::atomic_bool s_enabled(true);
+		Mutex s_bufferMutex;
+		Mutex s_captureMutex;
+		Profiler::FrameStats s_lastFrame = {{}, 0, 0, 0};
+		UInt64 s_frameBegin = 0;
+		thread_local ThreadBufferOwner s_threadBuffer;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			if (s_threadBuffer.buffer)
+				return *s_threadBuffer.buffer;
+
+			LockGuard lock(s_bufferMutex);
+			for (auto& buffer : s_buffers)
+			{
+				bool inUse = false;
+				if (buffer->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+				{
+					buffer->depth = 0;
+					s_threadBuffer.buffer = buffer.get();
+					return *buffer;
+				}
+			}
+
+			std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer);
+			buffer->events.reset(new Event[Profiler::ThreadEventCount]);
+			buffer->writeCount.store(0, std::memory_order_relaxed);
+			buffer->inUse.store(true, std::memory_order_relaxed);
+			buffer->depth = 0;
+			buffer->readCount = 0;
+			buffer->index = static_cast<unsigned int>(s_buffers.size());
+
+			s_threadBuffer.buffer = buffer.get();
+			s_buffers.push_back(std::move(buffer));
+
+			return *s_threadBuffer.buffer;
+		}
+
+		void WriteJsonString(StringStream& stream, const char* string)
+		{
+			stream << '"';
+			for (; *string; ++string)
+			{
+				char character = *string;
+				if (character == '"' || character == '\\')
+					stream << '\\' << character;
+				else if (static_cast<unsigned char>(character) >= 0x20)
+					stream << character;
+			}
+			stream << '"';
+		}
+	}
+
+	constexpr std::size_t Profiler::MaxZoneDepth;
+	constexpr std::size_t Profiler::ThreadEventCount;
+
+	/*!
+	* \class Nz::Profiler
+	* \brief Core class measuring the time spent in named zones, per thread and per frame
+	*
+	* Zones are usually opened with the NazaraProfileZone macro, which compiles to nothing unless NAZARA_CORE_PROFILER is enabled
+	*/
+
+	/*!
+	* \brief Opens a zone on the calling thread
+	*
+	* \param name Name of the zone, must stay valid as long as the profiler data is used (typically a string literal)
+	*
+	* \remark Every call must be matched by a call to EndZone on the same thread
+	*/
+	void Profiler::BeginZone(const char* name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		// Zones are still counted when the profiler is disabled, so EndZone stays balanced if it gets enabled meanwhile
+		std::size_t depth = buffer.depth++;
+		if (depth >= MaxZoneDepth)
+			return;
+
+		OpenZone& zone = buffer.zones[depth];
+		zone.recorded = s_enabled.load(std::memory_order_relaxed);
+		if (zone.recorded)
+		{
+			zone.name = name;
+			zone.childTime = 0;
+			zone.begin = GetElapsedMicroseconds();
+		}
+	}
+
+	/*!
+	* \brief Enables or disables the recording of zones at runtime
+	*
+	* \param enable Should the zones be recorded
+	*/
+	void Profiler::Enable(bool enable)
+	{
+		s_enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Collects the zones of every thread closed since the last call and computes the frame statistics
+	*
+	* \remark Should be called once per frame, from a single thread
+	*/
+	void Profiler::EndFrame()
+	{
+		UInt64 now = GetElapsedMicroseconds();
+
+		s_lastFrame.zones.clear();
+		s_lastFrame.beginTime = s_frameBegin;
+		s_lastFrame.duration = now - s_frameBegin;
+		s_lastFrame.droppedEvents = 0;
+		s_frameBegin = now;
+
+		bool capturing = s_capturing.load(std::memory_order_relaxed);
+
+		LockGuard lock(s_bufferMutex);
+		for (auto& buffer : s_buffers)
+		{
+			UInt64 writeCount = buffer->writeCount.load(std::memory_order_acquire);
+			UInt64 readCount = buffer->readCount;
+			if (writeCount - readCount > ThreadEventCount)
+			{
+				s_lastFrame.droppedEvents += writeCount - readCount - ThreadEventCount;
+				readCount = writeCount - ThreadEventCount;
+			}
+
+			s_collectedEvents.clear();
+			for (UInt64 i = readCount; i < writeCount; ++i)
+				s_collectedEvents.push_back(buffer->events[i % ThreadEventCount]);
+
+			// Events overwritten while we were copying them are unreliable
+			std::atomic_thread_fence(std::memory_order_acquire);
+			UInt64 firstValid = buffer->writeCount.load(std::memory_order_acquire);
+			firstValid = (firstValid > ThreadEventCount) ? firstValid - ThreadEventCount : 0;
+			std::size_t skipCount = static_cast<std::size_t>(std::min(std::max(firstValid, readCount) - readCount, writeCount - readCount));
+			s_lastFrame.droppedEvents += skipCount;
+
+			buffer->readCount = writeCount;
+
+			for (auto it = s_collectedEvents.begin() + skipCount; it != s_collectedEvents.end(); ++it)
+			{
+				const Event& event = *it;
+
+				auto statsIt = std::find_if(s_lastFrame.zones.begin(), s_lastFrame.zones.end(), [&event] (const ZoneStats& stats)
+				{
+					return stats.name == event.name || std::strcmp(stats.name, event.name) == 0;
+				});
+
+				if (statsIt == s_lastFrame.zones.end())
+				{
+					s_lastFrame.zones.push_back(ZoneStats{event.name, 0, 0, 0, 0});
+					statsIt = s_lastFrame.zones.end() - 1;
+				}
+
+				statsIt->callCount++;
+				statsIt->maxTime = std::max(statsIt->maxTime, event.duration);
+				statsIt->selfTime += event.selfTime;
+				statsIt->totalTime += event.duration;
+			}
+
+			if (capturing)
+			{
+				LockGuard captureLock(s_captureMutex);
+				for (auto it = s_collectedEvents.begin() + skipCount; it != s_collectedEvents.end(); ++it)
+					s_capture.push_back(CapturedEvent{*it, buffer->index});
+			}
+		}
+
+		std::sort(s_lastFrame.zones.begin(), s_lastFrame.zones.end(), [] (const ZoneStats& lhs, const ZoneStats& rhs)
+		{
+			return lhs.totalTime > rhs.totalTime;
+		});
+	}
+
+	/*!
+	* \brief Closes the last zone opened on the calling thread
+	*/
+	void Profiler::EndZone()
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		NazaraAssert(buffer.depth > 0, "No zone to end");
+
+		std::size_t depth = --buffer.depth;
+		if (depth >= MaxZoneDepth)
+			return;
+
+		OpenZone& zone = buffer.zones[depth];
+		if (!zone.recorded)
+			return;
+
+		UInt64 duration = GetElapsedMicroseconds() - zone.begin;
+		if (depth > 0)
+			buffer.zones[depth - 1].childTime += duration;
+
+		// Only the owning thread writes, the collector only reads up to the published count
+		UInt64 writeCount = buffer.writeCount.load(std::memory_order_relaxed);
+		Event& event = buffer.events[writeCount % ThreadEventCount];
+		event.name = zone.name;
+		event.begin = zone.begin;
+		event.duration = duration;
+		event.selfTime = duration - std::min(zone.childTime, duration);
+
+		buffer.writeCount.store(writeCount + 1, std::memory_order_release);
+	}
+
+	/*!
+	* \brief Writes the captured zones in the Chrome trace event format (readable by chrome://tracing)
+	* \return true if successful
+	*
+	* \param stream Stream to write the JSON to
+	*/
+	bool Profiler::ExportChromeTrace(Stream& stream)
+	{
+		StringStream json;
+		json << "{\"traceEvents\":[";
+		{
+			LockGuard lock(s_captureMutex);
+
+			bool first = true;
+			for (const CapturedEvent& captured : s_capture)
+			{
+				if (!first)
+					json << ',';
+
+				json << "\n{\"name\":";
+				WriteJsonString(json, captured.event.name);
+				json << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << captured.threadIndex;
+				json << ",\"ts\":" << captured.event.begin << ",\"dur\":" << captured.event.duration << '}';
+
+				first = false;
+			}
+		}
+		json << "\n]}\n";
+
+		if (!stream.Write(json.ToString()))
+		{
+			NazaraError("Failed to write trace");
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Writes the captured zones in the Chrome trace event format to a file
+	* \return true if successful
+	*
+	* \param filePath Path of the file, truncated if it exists
+	*/
+	bool Profiler::ExportChromeTrace(const String& filePath)
+	{
+		File file(filePath, OpenMode_WriteOnly | OpenMode_Truncate);
+		if (!file.IsOpen())
+		{
+			NazaraError("Failed to open \"" + filePath + '"');
+			return false;
+		}
+
+		return ExportChromeTrace(file);
+	}
+
+	/*!
+	* \brief Gets the statistics computed by the last call to EndFrame, sorted by decreasing total time
+	* \return Statistics of the last frame, valid until the next call to EndFrame
+	*/
+	const Profiler::FrameStats& Profiler::GetLastFrameStats()
+	{
+		return s_lastFrame;
+	}
+
+	/*!
+	* \brief Checks whether the collected zones are kept for a trace export
+	* \return true if a capture is running
+	*/
+	bool Profiler::IsCapturing()
+	{
+		return s_capturing.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Checks whether the zones are recorded
+	* \return true if the profiler is enabled
+	*/
+	bool Profiler::IsEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Starts keeping the zones collected by EndFrame, discarding the previous capture
+	*
+	* \remark The capture grows until StopCapture is called
+	*/
+	void Profiler::StartCapture()
+	{
+		LockGuard lock(s_captureMutex);
+		s_capture.clear();
+
+		s_capturing.store(true, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Stops the capture, captured zones are kept until the next StartCapture
+	*/
+	void Profiler::StopCapture()
+	{
+		s_capturing.store(false, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,82 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/StackArena.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	StackArena::StackArena(std::size_t blockSize) :
+	m_allocatedBytes(0),
+	m_blockIndex(0),
+	m_blockSize(blockSize),
+	m_offset(0),
+	m_peakBytes(0),
+	m_overflowCount(0)
+	{
+		///DOC: An arena is not thread-safe, use one per thread (or per job)
+	}
+
+	std::size_t StackArena::GetCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (const Block& block : m_blocks)
+			capacity += block.size;
+
+		return capacity;
+	}
+
+	void StackArena::Reset()
+	{
+		///DOC: Blocks are merged after an overflow, so the next frame fits in a single block
+		if (m_blocks.size() > 1)
+		{
+			Block block;
+			block.size = GetCapacity();
+			block.memory.reset(new UInt8[block.size]);
+
+			m_blocks.clear();
+			m_blocks.emplace_back(std::move(block));
+		}
+
+		m_allocatedBytes = 0;
+		m_blockIndex = 0;
+		m_offset = 0;
+	}
+
+	void StackArena::ResetStats()
+	{
+		m_overflowCount = 0;
+		m_peakBytes = m_allocatedBytes;
+	}
+
+	void* StackArena::AllocateFromNextBlock(std::size_t size, std::size_t alignment)
+	{
+		// What's left of the current block is lost until the next rewind
+		if (m_blockIndex < m_blocks.size())
+			m_allocatedBytes += m_blocks[m_blockIndex].size - m_offset;
+
+		// Blocks too small for this allocation are skipped, and lost as well
+		std::size_t blockIndex = (m_blocks.empty()) ? 0 : m_blockIndex + 1;
+		while (blockIndex < m_blocks.size() && m_blocks[blockIndex].size < size + alignment - 1)
+			m_allocatedBytes += m_blocks[blockIndex++].size;
+
+		if (blockIndex == m_blocks.size())
+		{
+			if (!m_blocks.empty())
+				m_overflowCount++;
+
+			Block block;
+			block.size = std::max(m_blockSize, size + alignment - 1);
+			block.memory.reset(new UInt8[block.size]);
+
+			m_blocks.emplace_back(std::move(block));
+		}
+
+		m_blockIndex = blockIndex;
+		m_offset = 0;
+
+		return Allocate(size, alignment);
+	}
+}
@@ -18,6 +18,12 @@ namespace Nz
 		return String();
 	}
 
+	const void* Stream::GetMemoryPointer() const
+	{
+		///DOC: Streams whose whole content lives in memory return a pointer to it, or nullptr
+		return nullptr;
+	}
+
 	String Stream::GetPath() const
 	{
 		return String();
@@ -26,7 +32,28 @@ namespace Nz
 	String Stream::ReadLine(unsigned int lineSize)
 	{
 		String line;
-		if (lineSize == 0) // Taille maximale indéterminée
+
+		const char* data = static_cast<const char*>(GetMemoryPointer());
+		if (data && lineSize == 0)
+		{
+			// The content is already in memory, look for the end of the line in place
+			const char* begin = &data[GetCursorPos()];
+			const char* end = &data[GetSize()];
+
+			const char* lineEnd = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+			if (!lineEnd)
+				lineEnd = end;
+
+			std::size_t length = lineEnd - begin;
+			if (m_streamOptions & StreamOption_Text && length > 0 && begin[length - 1] == '\r')
+				length--;
+
+			line.Set(begin, length);
+
+			if (!SetCursorPos((lineEnd != end) ? lineEnd - data + 1 : end - data))
+				NazaraWarning("Failed to reset cursos pos");
+		}
+		else if (lineSize == 0) // Taille maximale indéterminée
 		{
 			const unsigned int bufferSize = 64;
 
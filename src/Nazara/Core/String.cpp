@@ -8,6 +8,7 @@
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/StringImpl.hpp>
 #include <Nazara/Core/Unicode.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <algorithm>
@@ -23,6 +24,21 @@ namespace Nz
 {
 	namespace Detail
 	{
+		// Counts overlapping occurrences
+		inline unsigned int CountString(const char* begin, const char* end, const char* string, bool caseInsensitive)
+		{
+			std::size_t length = std::strlen(string);
+
+			unsigned int count = 0;
+			while ((begin = StringImpl::FindString(begin, end, string, length, caseInsensitive)) != end)
+			{
+				count++;
+				begin++;
+			}
+
+			return count;
+		}
+
 		// Cet algorithme est inspiré de la documentation de Qt
 		inline std::size_t GetNewSize(std::size_t newSize)
 		{
@@ -77,32 +93,28 @@ namespace Nz
 	}
 
 	String::String() :
-	m_sharedString(GetEmptyString())
+	m_size(0)
 	{
+		m_smallString[0] = '\0';
 	}
 
 	String::String(char character)
 	{
 		if (character != '\0')
 		{
-			m_sharedString = std::make_shared<SharedString>(1);
-			m_sharedString->string[0] = character;
+			Allocate(1);
+			GetStringData()[0] = character;
 		}
 		else
-			m_sharedString = GetEmptyString();
+			ReleaseString();
 	}
 
 	String::String(std::size_t rep, char character)
 	{
-		if (rep > 0)
-		{
-			m_sharedString = std::make_shared<SharedString>(rep);
+		Allocate(rep);
 
-			if (character != '\0')
-				std::memset(m_sharedString->string.get(), character, rep);
-		}
-		else
-			m_sharedString = GetEmptyString();
+		if (rep > 0 && character != '\0')
+			std::memset(GetStringData(), character, rep);
 	}
 
 	String::String(std::size_t rep, const char* string) :
@@ -114,15 +126,11 @@ namespace Nz
 	{
 		std::size_t totalSize = rep*length;
 
-		if (totalSize > 0)
-		{
-			m_sharedString = std::make_shared<SharedString>(totalSize);
+		Allocate(totalSize);
 
-			for (std::size_t i = 0; i < rep; ++i)
-				std::memcpy(&m_sharedString->string[i*length], string, length);
-		}
-		else
-			m_sharedString = GetEmptyString();
+		char* ptr = GetStringData();
+		for (std::size_t i = 0; i < rep; ++i)
+			std::memcpy(&ptr[i*length], string, length);
 	}
 
 	String::String(std::size_t rep, const String& string) :
@@ -137,13 +145,33 @@ namespace Nz
 
 	String::String(const char* string, std::size_t length)
 	{
+		Allocate(length);
+
 		if (length > 0)
+			std::memcpy(GetStringData(), string, length);
+	}
+
+	String::String(const String& string) :
+	m_size(string.m_size)
+	{
+		if (string.HasSharedString())
 		{
-			m_sharedString = std::make_shared<SharedString>(length);
-			std::memcpy(m_sharedString->string.get(), string, length);
+			string.m_sharedString->refCount.fetch_add(1, std::memory_order_relaxed);
+			SetSharedString(string.m_sharedString);
 		}
 		else
-			m_sharedString = GetEmptyString();
+			std::memcpy(m_smallString, string.m_smallString, m_size + 1);
+	}
+
+	String::String(String&& string) noexcept :
+	m_size(string.m_size)
+	{
+		// Copies the shared string pointer and its tag as well, the source is left empty
+		std::memcpy(m_smallString, string.m_smallString, sizeof(m_smallString));
+
+		string.m_size = 0;
+		string.m_smallString[0] = '\0';
+		string.m_smallString[SharedStringTag] = 0;
 	}
 
 	String::String(const std::string& string) :
@@ -153,22 +181,22 @@ namespace Nz
 
 	String& String::Append(char character)
 	{
-		return Insert(m_sharedString->size, character);
+		return Insert(m_size, character);
 	}
 
 	String& String::Append(const char* string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	String& String::Append(const char* string, std::size_t length)
 	{
-		return Insert(m_sharedString->size, string, length);
+		return Insert(m_size, string, length);
 	}
 
 	String& String::Append(const String& string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	void String::Clear(bool keepBuffer)
@@ -176,7 +204,8 @@ namespace Nz
 		if (keepBuffer)
 		{
 			EnsureOwnership(true);
-			m_sharedString->size = 0;
+			m_size = 0;
+			GetStringData()[0] = '\0';
 		}
 		else
 			ReleaseString();
@@ -199,54 +228,37 @@ namespace Nz
 
 	unsigned int String::Count(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
-		unsigned int count = 0;
+		const char* str = &GetStringData()[pos];
+		const char* end = &GetStringData()[m_size];
 		if (flags & CaseInsensitive)
-		{
-			char character_lower = Detail::ToLower(character);
-			char character_upper = Detail::ToUpper(character);
-			do
-			{
-				if (*str == character_lower || *str == character_upper)
-					count++;
-			}
-			while (*++str);
-		}
+			return static_cast<unsigned int>(StringImpl::CountCharacters(str, end, Detail::ToLower(character), Detail::ToUpper(character)));
 		else
-		{
-			while ((str = std::strchr(str, character)) != nullptr)
-			{
-				count++;
-				str++;
-			}
-		}
-
-		return count;
+			return static_cast<unsigned int>(StringImpl::CountCharacters(str, end, character, character));
 	}
 
 	unsigned int String::Count(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
+		const char* str = &GetStringData()[pos];
 		unsigned int count = 0;
 		if (flags & CaseInsensitive)
 		{
@@ -288,45 +300,10 @@ namespace Nz
 				while (*++it);
 			}
 			else
-			{
-				char c = Detail::ToLower(string[0]);
-				do
-				{
-					if (Detail::ToLower(*str) == c)
-					{
-						str++;
-
-						const char* ptr = &string[1];
-						for (;;)
-						{
-							if (*ptr == '\0')
-							{
-								count++;
-								break;
-							}
-
-							if (*str == '\0')
-								return count;
-
-							if (Detail::ToLower(*str) != Detail::ToLower(*ptr))
-								break;
-
-							ptr++;
-							str++;
-						}
-					}
-				}
-				while (*++str);
-			}
+				count = Detail::CountString(str, &GetStringData()[m_size], string, true);
 		}
 		else
-		{
-			while ((str = std::strstr(str, string)) != nullptr)
-			{
-				count++;
-				str++;
-			}
-		}
+			count = Detail::CountString(str, &GetStringData()[m_size], string, false);
 
 		return count;
 	}
@@ -338,17 +315,17 @@ namespace Nz
 
 	unsigned int String::CountAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
+		const char* str = &GetStringData()[pos];
 		unsigned int count = 0;
 		if (flags & HandleUtf8)
 		{
@@ -431,13 +408,13 @@ namespace Nz
 
 	bool String::EndsWith(char character, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 
 		if (flags & CaseInsensitive)
-			return Detail::ToLower(m_sharedString->string[m_sharedString->size-1]) == Detail::ToLower(character);
+			return Detail::ToLower(GetStringData()[m_size-1]) == Detail::ToLower(character);
 		else
-			return m_sharedString->string[m_sharedString->size-1] == character; // character == '\0' sera toujours faux
+			return GetStringData()[m_size-1] == character; // character == '\0' sera toujours faux
 	}
 
 	bool String::EndsWith(const char* string, UInt32 flags) const
@@ -447,73 +424,61 @@ namespace Nz
 
 	bool String::EndsWith(const char* string, std::size_t length, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0 || length > m_sharedString->size)
+		if (!string || !string[0] || m_size == 0 || length > m_size)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
-				return Detail::Unicodecasecmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+				return Detail::Unicodecasecmp(&GetStringData()[m_size - length], string) == 0;
 			else
-				return Detail::Strcasecmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+				return Detail::Strcasecmp(&GetStringData()[m_size - length], string) == 0;
 		}
 		else
-			return std::strcmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+			return std::strcmp(&GetStringData()[m_size - length], string) == 0;
 	}
 
 	bool String::EndsWith(const String& string, UInt32 flags) const
 	{
-		return EndsWith(string.GetConstBuffer(), string.m_sharedString->size, flags);
+		return EndsWith(string.GetConstBuffer(), string.m_size, flags);
 	}
 
 	std::size_t String::Find(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		if (flags & CaseInsensitive)
-		{
-			char ch = Detail::ToLower(character);
-			const char* str = m_sharedString->string.get();
-			do
-			{
-				if (Detail::ToLower(*str) == ch)
-					return str - m_sharedString->string.get();
-			}
-			while (*++str);
+		const char* end = &GetStringData()[m_size];
 
-			return npos;
-		}
+		const char* ch;
+		if (flags & CaseInsensitive)
+			ch = StringImpl::FindCharacters(&GetStringData()[pos], end, Detail::ToLower(character), Detail::ToUpper(character));
 		else
-		{
-			char* ch = std::strchr(&m_sharedString->string[pos], character);
-			if (ch)
-				return ch - m_sharedString->string.get();
-			else
-				return npos;
-		}
+			ch = StringImpl::FindCharacters(&GetStringData()[pos], end, character, character);
+
+		return (ch != end) ? ch - GetStringData() : npos;
 	}
 
 	std::size_t String::Find(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		const char* str = &GetStringData()[pos];
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
@@ -536,7 +501,7 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return ptrPos - m_sharedString->string.get();
+								return ptrPos - GetStringData();
 
 							if (*it == '\0')
 								return npos;
@@ -553,39 +518,18 @@ namespace Nz
 			}
 			else
 			{
-				char c = Detail::ToLower(string[0]);
-				do
-				{
-					if (Detail::ToLower(*str) == c)
-					{
-						char* ptrPos = str;
-						str++;
-
-						const char* ptr = &string[1];
-						for (;;)
-						{
-							if (*ptr == '\0')
-								return ptrPos - m_sharedString->string.get();
-
-							if (*str == '\0')
-								return npos;
-
-							if (Detail::ToLower(*str) != Detail::ToLower(*ptr))
-								break;
-
-							ptr++;
-							str++;
-						}
-					}
-				}
-				while (*++str);
+				const char* end = &GetStringData()[m_size];
+				const char* ch = StringImpl::FindString(str, end, string, std::strlen(string), true);
+				if (ch != end)
+					return ch - GetStringData();
 			}
 		}
 		else
 		{
-			char* ch = std::strstr(&m_sharedString->string[pos], string);
-			if (ch)
-				return ch - m_sharedString->string.get();
+			const char* end = &GetStringData()[m_size];
+			const char* ch = StringImpl::FindString(str, end, string, std::strlen(string), false);
+			if (ch != end)
+				return ch - GetStringData();
 		}
 
 		return npos;
@@ -598,17 +542,17 @@ namespace Nz
 
 	std::size_t String::FindAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0 || !string || !string[0])
+		if (m_size == 0 || !string || !string[0])
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		const char* str = &GetStringData()[pos];
 		if (flags & HandleUtf8)
 		{
 			while (utf8::internal::is_trail(*str))
@@ -625,7 +569,7 @@ namespace Nz
 					do
 					{
 						if (character == Unicode::GetLowercase(*it2))
-							return it.base() - m_sharedString->string.get();
+							return it.base() - GetStringData();
 					}
 					while (*++it2);
 				}
@@ -639,7 +583,7 @@ namespace Nz
 					do
 					{
 						if (*it == *it2)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - GetStringData();
 					}
 					while (*++it2);
 				}
@@ -657,7 +601,7 @@ namespace Nz
 					do
 					{
 						if (character == Detail::ToLower(*c))
-							return str - m_sharedString->string.get();
+							return str - GetStringData();
 					}
 					while (*++c);
 				}
@@ -667,7 +611,7 @@ namespace Nz
 			{
 				str = std::strpbrk(str, string);
 				if (str)
-					return str - m_sharedString->string.get();
+					return str - GetStringData();
 			}
 		}
 
@@ -681,17 +625,17 @@ namespace Nz
 
 	std::size_t String::FindLast(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* ptr = &m_sharedString->string[m_sharedString->size-1];
+		const char* ptr = &GetStringData()[m_size-1];
 
 		if (flags & CaseInsensitive)
 		{
@@ -699,18 +643,18 @@ namespace Nz
 			do
 			{
 				if (Detail::ToLower(*ptr) == character)
-					return ptr - m_sharedString->string.get();
+					return ptr - GetStringData();
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != GetStringData());
 		}
 		else
 		{
 			do
 			{
 				if (*ptr == character)
-					return ptr - m_sharedString->string.get();
+					return ptr - GetStringData();
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != GetStringData());
 		}
 
 		return npos;
@@ -718,18 +662,18 @@ namespace Nz
 
 	std::size_t String::FindLast(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 1.FindLast#3 (Taille du pattern inconnue)
-		const char* ptr = &m_sharedString->string[pos];
+		const char* ptr = &GetStringData()[pos];
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
@@ -751,9 +695,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return it.base() - m_sharedString->string.get();
+								return it.base() - GetStringData();
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*it2))
@@ -764,7 +708,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 			else
 			{
@@ -778,9 +722,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*p == '\0')
-								return ptr - m_sharedString->string.get();
+								return ptr - GetStringData();
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &GetStringData()[pos])
 								break;
 
 							if (Detail::ToLower(*tPtr) != Detail::ToLower(*p))
@@ -791,7 +735,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != GetStringData());
 			}
 		}
 		else
@@ -805,9 +749,9 @@ namespace Nz
 					for (;;)
 					{
 						if (*p == '\0')
-							return ptr - m_sharedString->string.get();
+							return ptr - GetStringData();
 
-						if (tPtr > &m_sharedString->string[pos])
+						if (tPtr > &GetStringData()[pos])
 							break;
 
 						if (*tPtr != *p)
@@ -818,7 +762,7 @@ namespace Nz
 					}
 				}
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != GetStringData());
 		}
 
 		return npos;
@@ -826,18 +770,18 @@ namespace Nz
 
 	std::size_t String::FindLast(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size || string.m_sharedString->size > m_sharedString->size)
+		if (pos >= m_size || string.m_size > m_size)
 			return npos;
 
-		const char* ptr = &m_sharedString->string[pos];
-		const char* limit = &m_sharedString->string[string.m_sharedString->size-1];
+		const char* ptr = &GetStringData()[pos];
+		const char* limit = &GetStringData()[string.m_size-1];
 
 		if (flags & CaseInsensitive)
 		{
@@ -861,9 +805,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return it.base() - m_sharedString->string.get();
+								return it.base() - GetStringData();
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*it2))
@@ -879,21 +823,21 @@ namespace Nz
 			else
 			{
 				///Algo 1.FindLast#4 (Taille du pattern connue)
-				char c = Detail::ToLower(string.m_sharedString->string[string.m_sharedString->size-1]);
+				char c = Detail::ToLower(string.GetStringData()[string.m_size-1]);
 				for (;;)
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.GetStringData()[string.m_size-1];
+						for (; p >= &string.GetStringData()[0]; --p, --ptr)
 						{
 							if (Detail::ToLower(*ptr) != Detail::ToLower(*p))
 								break;
 
-							if (p == &string.m_sharedString->string[0])
-								return ptr-m_sharedString->string.get();
+							if (p == &string.GetStringData()[0])
+								return ptr-GetStringData();
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == GetStringData())
 								return npos;
 						}
 					}
@@ -907,18 +851,18 @@ namespace Nz
 			///Algo 1.FindLast#4 (Taille du pattern connue)
 			for (;;)
 			{
-				if (*ptr == string.m_sharedString->string[string.m_sharedString->size-1])
+				if (*ptr == string.GetStringData()[string.m_size-1])
 				{
-					const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-					for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+					const char* p = &string.GetStringData()[string.m_size-1];
+					for (; p >= &string.GetStringData()[0]; --p, --ptr)
 					{
 						if (*ptr != *p)
 							break;
 
-						if (p == &string.m_sharedString->string[0])
-							return ptr-m_sharedString->string.get();
+						if (p == &string.GetStringData()[0])
+							return ptr-GetStringData();
 
-						if (ptr == m_sharedString->string.get())
+						if (ptr == GetStringData())
 							return npos;
 					}
 				}
@@ -932,17 +876,17 @@ namespace Nz
 
 	std::size_t String::FindLastAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		const char* str = &GetStringData()[pos];
 		if (flags & HandleUtf8)
 		{
 			while (utf8::internal::is_trail(*str))
@@ -959,11 +903,11 @@ namespace Nz
 					do
 					{
 						if (character == Unicode::GetLowercase(*it2))
-							return it.base() - m_sharedString->string.get();
+							return it.base() - GetStringData();
 					}
 					while (*++it2);
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 			else
 			{
@@ -973,11 +917,11 @@ namespace Nz
 					do
 					{
 						if (*it == *it2)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - GetStringData();
 					}
 					while (*++it2);
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 		}
 		else
@@ -991,11 +935,11 @@ namespace Nz
 					do
 					{
 						if (character == Detail::ToLower(*c))
-							return str - m_sharedString->string.get();
+							return str - GetStringData();
 					}
 					while (*++c);
 				}
-				while (str-- != m_sharedString->string.get());
+				while (str-- != GetStringData());
 			}
 			else
 			{
@@ -1005,11 +949,11 @@ namespace Nz
 					do
 					{
 						if (*str == *c)
-							return str - m_sharedString->string.get();
+							return str - GetStringData();
 					}
 					while (*++c);
 				}
-				while (str-- != m_sharedString->string.get());
+				while (str-- != GetStringData());
 			}
 		}
 
@@ -1023,18 +967,18 @@ namespace Nz
 
 	std::size_t String::FindLastWord(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 2.FindLastWord#1 (Taille du pattern inconnue)
-		const char* ptr = &m_sharedString->string[pos];
+		const char* ptr = &GetStringData()[pos];
 
 		if (flags & HandleUtf8)
 		{
@@ -1051,7 +995,7 @@ namespace Nz
 				{
 					if (Unicode::GetLowercase(*it) == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1067,12 +1011,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*tIt) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*p))
@@ -1083,7 +1027,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 			else
 			{
@@ -1093,7 +1037,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1109,12 +1053,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*tIt) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (*tIt != *p)
@@ -1125,7 +1069,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 		}
 		else
@@ -1137,7 +1081,7 @@ namespace Nz
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get() && !std::isspace(*(ptr-1)))
+						if (ptr != GetStringData() && !std::isspace(*(ptr-1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1147,12 +1091,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || std::isspace(*tPtr))
-									return ptr-m_sharedString->string.get();
+									return ptr-GetStringData();
 								else
 									break;
 							}
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &GetStringData()[pos])
 								break;
 
 							if (Detail::ToLower(*tPtr) != Detail::ToLower(*p))
@@ -1163,7 +1107,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != GetStringData());
 			}
 			else
 			{
@@ -1171,7 +1115,7 @@ namespace Nz
 				{
 					if (*ptr == string[0])
 					{
-						if (ptr != m_sharedString->string.get() && !std::isspace(*(ptr-1)))
+						if (ptr != GetStringData() && !std::isspace(*(ptr-1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1181,12 +1125,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || std::isspace(*tPtr))
-									return ptr-m_sharedString->string.get();
+									return ptr-GetStringData();
 								else
 									break;
 							}
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &GetStringData()[pos])
 								break;
 
 							if (*tPtr != *p)
@@ -1197,7 +1141,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != GetStringData());
 			}
 		}
 
@@ -1206,18 +1150,18 @@ namespace Nz
 
 	std::size_t String::FindLastWord(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		const char* ptr = &m_sharedString->string[pos];
-		const char* limit = &m_sharedString->string[string.m_sharedString->size-1];
+		const char* ptr = &GetStringData()[pos];
+		const char* limit = &GetStringData()[string.m_size-1];
 
 		if (flags & HandleUtf8)
 		{
@@ -1234,7 +1178,7 @@ namespace Nz
 				{
 					if (Unicode::GetLowercase(*it) == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1250,12 +1194,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*tIt) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*p))
@@ -1266,7 +1210,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 			else
 			{
@@ -1276,7 +1220,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1292,12 +1236,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*tIt) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &GetStringData()[pos])
 								break;
 
 							if (*tIt != *p)
@@ -1308,7 +1252,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != GetStringData());
 			}
 		}
 		else
@@ -1316,7 +1260,7 @@ namespace Nz
 			///Algo 2.FindLastWord#2 (Taille du pattern connue)
 			if (flags & CaseInsensitive)
 			{
-				char c = Detail::ToLower(string.m_sharedString->string[string.m_sharedString->size-1]);
+				char c = Detail::ToLower(string.GetStringData()[string.m_size-1]);
 				do
 				{
 					if (Detail::ToLower(*ptr) == c)
@@ -1324,21 +1268,21 @@ namespace Nz
 						if (*(ptr+1) != '\0' && !std::isspace(*(ptr+1)))
 							continue;
 
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.GetStringData()[string.m_size-1];
+						for (; p >= &string.GetStringData()[0]; --p, --ptr)
 						{
 							if (Detail::ToLower(*ptr) != Detail::ToLower(*p))
 								break;
 
-							if (p == &string.m_sharedString->string[0])
+							if (p == &string.GetStringData()[0])
 							{
-								if (ptr == m_sharedString->string.get() || std::isspace(*(ptr-1)))
-									return ptr-m_sharedString->string.get();
+								if (ptr == GetStringData() || std::isspace(*(ptr-1)))
+									return ptr-GetStringData();
 								else
 									break;
 							}
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == GetStringData())
 								return npos;
 						}
 					}
@@ -1349,26 +1293,26 @@ namespace Nz
 			{
 				do
 				{
-					if (*ptr == string.m_sharedString->string[string.m_sharedString->size-1])
+					if (*ptr == string.GetStringData()[string.m_size-1])
 					{
 						if (*(ptr+1) != '\0' && !std::isspace(*(ptr+1)))
 							continue;
 
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.GetStringData()[string.m_size-1];
+						for (; p >= &string.GetStringData()[0]; --p, --ptr)
 						{
 							if (*ptr != *p)
 								break;
 
-							if (p == &string.m_sharedString->string[0])
+							if (p == &string.GetStringData()[0])
 							{
-								if (ptr == m_sharedString->string.get() || std::isspace(*(ptr-1)))
-									return ptr-m_sharedString->string.get();
+								if (ptr == GetStringData() || std::isspace(*(ptr-1)))
+									return ptr-GetStringData();
 								else
 									break;
 							}
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == GetStringData())
 								return npos;
 						}
 					}
@@ -1382,18 +1326,18 @@ namespace Nz
 
 	std::size_t String::FindWord(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 3.FindWord#3 (Taille du pattern inconnue)
-		const char* ptr = m_sharedString->string.get();
+		const char* ptr = GetStringData();
 		if (flags & HandleUtf8)
 		{
 			if (utf8::internal::is_trail(*ptr))
@@ -1410,7 +1354,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1426,7 +1370,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*it++) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
@@ -1450,7 +1394,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1466,7 +1410,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*it++) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
@@ -1491,7 +1435,7 @@ namespace Nz
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get() && !std::isspace(*(ptr-1)))
+						if (ptr != GetStringData() && !std::isspace(*(ptr-1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1501,7 +1445,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || std::isspace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - GetStringData();
 								else
 									break;
 							}
@@ -1522,7 +1466,7 @@ namespace Nz
 				{
 					if (*ptr == string[0])
 					{
-						if (ptr != m_sharedString->string.get() && !std::isspace(*(ptr-1)))
+						if (ptr != GetStringData() && !std::isspace(*(ptr-1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1532,7 +1476,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || std::isspace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - GetStringData();
 								else
 									break;
 							}
@@ -1554,17 +1498,17 @@ namespace Nz
 
 	std::size_t String::FindWord(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* ptr = m_sharedString->string.get();
+		const char* ptr = GetStringData();
 		if (flags & HandleUtf8)
 		{
 			///Algo 3.FindWord#3 (Itérateur trop lent pour #2)
@@ -1582,7 +1526,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1598,7 +1542,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*it++) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
@@ -1622,7 +1566,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != GetStringData())
 						{
 							--it;
 							if (!(Unicode::GetCategory(*it++) & Unicode::Category_Separator))
@@ -1638,7 +1582,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Unicode::GetCategory(*it++) & Unicode::Category_Separator)
-									return it.base() - m_sharedString->string.get();
+									return it.base() - GetStringData();
 								else
 									break;
 							}
@@ -1659,22 +1603,22 @@ namespace Nz
 			///Algo 3.FindWord#2 (Taille du pattern connue)
 			if (flags & CaseInsensitive)
 			{
-				char c = Detail::ToLower(string.m_sharedString->string[0]);
+				char c = Detail::ToLower(string.GetStringData()[0]);
 				do
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get() && !std::isspace(*(ptr-1)))
+						if (ptr != GetStringData() && !std::isspace(*(ptr-1)))
 							continue;
 
-						const char* p = &string.m_sharedString->string[1];
+						const char* p = &string.GetStringData()[1];
 						const char* tPtr = ptr+1;
 						for (;;)
 						{
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || std::isspace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - GetStringData();
 								else
 									break;
 							}
@@ -1694,8 +1638,8 @@ namespace Nz
 				while ((ptr = std::strstr(ptr, string.GetConstBuffer())) != nullptr)
 				{
 					// Si le mot est bien isolé
-					if ((ptr == m_sharedString->string.get() || std::isspace(*(ptr-1))) && (*(ptr+m_sharedString->size) == '\0' || std::isspace(*(ptr+m_sharedString->size))))
-						return ptr - m_sharedString->string.get();
+					if ((ptr == GetStringData() || std::isspace(*(ptr-1))) && (*(ptr+m_size) == '\0' || std::isspace(*(ptr+m_size))))
+						return ptr - GetStringData();
 
 					ptr++;
 				}
@@ -1709,56 +1653,63 @@ namespace Nz
 	{
 		EnsureOwnership();
 
-		return m_sharedString->string.get();
+		return GetStringData();
 	}
 
 	std::size_t String::GetCapacity() const
 	{
-		return m_sharedString->capacity;
+		return (HasSharedString()) ? m_sharedString->capacity : SmallStringCapacity;
 	}
 
 	const char* String::GetConstBuffer() const
 	{
-		return m_sharedString->string.get();
+		return GetStringData();
 	}
 
 	std::size_t String::GetLength() const
 	{
-		return utf8::distance(m_sharedString->string.get(), &m_sharedString->string[m_sharedString->size]);
+		return StringImpl::GetUtf8Length(GetStringData(), &GetStringData()[m_size]);
 	}
 
 	std::size_t String::GetSize() const
 	{
-		return m_sharedString->size;
+		return m_size;
 	}
 
 	std::string String::GetUtf8String() const
 	{
-		return std::string(m_sharedString->string.get(), m_sharedString->size);
+		return std::string(GetStringData(), m_size);
 	}
 
 	std::u16string String::GetUtf16String() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::u16string();
 
+		// The ASCII part of the string is widened directly, only the rest has to be decoded
+		const char* asciiEnd = StringImpl::FindNonAscii(begin(), end());
+
 		std::u16string str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
+		str.assign(begin(), asciiEnd);
 
-		utf8::utf8to16(begin(), end(), std::back_inserter(str));
+		utf8::utf8to16(asciiEnd, end(), std::back_inserter(str));
 
 		return str;
 	}
 
 	std::u32string String::GetUtf32String() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::u32string();
 
+		const char* asciiEnd = StringImpl::FindNonAscii(begin(), end());
+
 		std::u32string str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
+		str.assign(begin(), asciiEnd);
 
-		utf8::utf8to32(begin(), end(), std::back_inserter(str));
+		utf8::utf8to32(asciiEnd, end(), std::back_inserter(str));
 
 		return str;
 	}
@@ -1766,18 +1717,20 @@ namespace Nz
 	std::wstring String::GetWideString() const
 	{
 		static_assert(sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4, "wchar_t size is not supported");
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::wstring();
 
+		const char* asciiEnd = StringImpl::FindNonAscii(begin(), end());
+
 		std::wstring str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
+		str.assign(begin(), asciiEnd);
 
 		if (sizeof(wchar_t) == 4) // Je veux du static_if :(
-			utf8::utf8to32(begin(), end(), std::back_inserter(str));
+			utf8::utf8to32(asciiEnd, end(), std::back_inserter(str));
 		else
 		{
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
-			do
+			for (utf8::unchecked::iterator<const char*> it(asciiEnd); it.base() != end(); ++it)
 			{
 				char32_t cp = *it;
 				if (cp <= 0xFFFF && (cp < 0xD800 || cp > 0xDFFF)) // @Laurent Gomila
@@ -1785,7 +1738,6 @@ namespace Nz
 				else
 					str.push_back(L'?');
 			}
-			while (*it++);
 		}
 
 		return str;
@@ -1798,7 +1750,7 @@ namespace Nz
 			return String();
 
 		std::intmax_t endPos = -1;
-		const char* ptr = &m_sharedString->string[startPos];
+		const char* ptr = &GetStringData()[startPos];
 		if (flags & HandleUtf8)
 		{
 			utf8::unchecked::iterator<const char*> it(ptr);
@@ -1806,7 +1758,7 @@ namespace Nz
 			{
 				if (Unicode::GetCategory(*it) & Unicode::Category_Separator)
 				{
-					endPos = static_cast<std::intmax_t>(it.base() - m_sharedString->string.get() - 1);
+					endPos = static_cast<std::intmax_t>(it.base() - GetStringData() - 1);
 					break;
 				}
 			}
@@ -1818,7 +1770,7 @@ namespace Nz
 			{
 				if (std::isspace(*ptr))
 				{
-					endPos = static_cast<std::intmax_t>(ptr - m_sharedString->string.get() - 1);
+					endPos = static_cast<std::intmax_t>(ptr - GetStringData() - 1);
 					break;
 				}
 			}
@@ -1830,13 +1782,13 @@ namespace Nz
 
 	std::size_t String::GetWordPosition(unsigned int index, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return npos;
 
 		unsigned int currentWord = 0;
 		bool inWord = false;
 
-		const char* ptr = m_sharedString->string.get();
+		const char* ptr = GetStringData();
 		if (flags & HandleUtf8)
 		{
 			utf8::unchecked::iterator<const char*> it(ptr);
@@ -1850,7 +1802,7 @@ namespace Nz
 					{
 						inWord = true;
 						if (++currentWord > index)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - GetStringData();
 					}
 				}
 			}
@@ -1868,7 +1820,7 @@ namespace Nz
 					{
 						inWord = true;
 						if (++currentWord > index)
-							return ptr - m_sharedString->string.get();
+							return ptr - GetStringData();
 					}
 				}
 			}
@@ -1894,40 +1846,41 @@ namespace Nz
 			return *this;
 
 		if (pos < 0)
-			pos = std::max<std::size_t>(m_sharedString->size + pos, 0);
+			pos = std::max<std::size_t>(m_size + pos, 0);
 
-		std::size_t start = std::min<std::size_t>(pos, m_sharedString->size);
+		std::size_t start = std::min<std::size_t>(pos, m_size);
 
 		// Si le buffer est déjà suffisamment grand
-		if (m_sharedString->capacity >= m_sharedString->size + length)
+		if (GetCapacity() >= m_size + length)
 		{
 			EnsureOwnership();
 
-			std::memmove(&m_sharedString->string[start+length], &m_sharedString->string[start], m_sharedString->size - start);
-			std::memcpy(&m_sharedString->string[start], string, length);
+			std::memmove(&GetStringData()[start+length], &GetStringData()[start], m_size - start);
+			std::memcpy(&GetStringData()[start], string, length);
 
-			m_sharedString->size += length;
-			m_sharedString->string[m_sharedString->size] = '\0';
+			m_size += length;
+			GetStringData()[m_size] = '\0';
 		}
 		else
 		{
-			auto newString = std::make_shared<SharedString>(m_sharedString->size + length);
+			String newString;
+			newString.Allocate(m_size + length);
 
-			char* ptr = newString->string.get();
+			char* ptr = newString.GetStringData();
 
 			if (start > 0)
 			{
-				std::memcpy(ptr, m_sharedString->string.get(), start*sizeof(char));
+				std::memcpy(ptr, GetStringData(), start*sizeof(char));
 				ptr += start;
 			}
 
 			std::memcpy(ptr, string, length*sizeof(char));
 			ptr += length;
 
-			if (m_sharedString->size > start)
-				std::memcpy(ptr, &m_sharedString->string[start], m_sharedString->size - start);
+			if (m_size > start)
+				std::memcpy(ptr, &GetStringData()[start], m_size - start);
 
-			m_sharedString = std::move(newString);
+			*this = std::move(newString);
 		}
 
 		return *this;
@@ -1935,17 +1888,17 @@ namespace Nz
 
 	String& String::Insert(std::intmax_t pos, const String& string)
 	{
-		return Insert(pos, string.GetConstBuffer(), string.m_sharedString->size);
+		return Insert(pos, string.GetConstBuffer(), string.m_size);
 	}
 
 	bool String::IsEmpty() const
 	{
-		return m_sharedString->size == 0;
+		return m_size == 0;
 	}
 
 	bool String::IsNull() const
 	{
-		return m_sharedString.get() == GetEmptyString().get();
+		return !HasSharedString() && m_size == 0;
 	}
 
 	bool String::IsNumber(UInt8 base, UInt32 flags) const
@@ -1958,14 +1911,14 @@ namespace Nz
 		}
 		#endif
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		String check = Simplified();
-		if (check.m_sharedString->size == 0)
+		if (check.m_size == 0)
 			return false;
 
-		char* ptr = (check.m_sharedString->string[0] == '-') ? &check.m_sharedString->string[1] : check.m_sharedString->string.get();
+		char* ptr = (check.GetStringData()[0] == '-') ? &check.GetStringData()[1] : check.GetStringData();
 
 		if (base > 10)
 		{
@@ -2012,12 +1965,12 @@ namespace Nz
 
 	bool String::Match(const char* pattern) const
 	{
-		if (m_sharedString->size == 0 || !pattern)
+		if (m_size == 0 || !pattern)
 			return false;
 
 		// Par Jack Handy - akkhandy@hotmail.com
 		// From : http://www.codeproject.com/Articles/1088/Wildcard-string-compare-globbing
-		const char* str = m_sharedString->string.get();
+		const char* str = GetStringData();
 		while (*str && *pattern != '*')
 		{
 			if (*pattern != *str && *pattern != '?')
@@ -2059,7 +2012,7 @@ namespace Nz
 
 	bool String::Match(const String& pattern) const
 	{
-		return Match(pattern.m_sharedString->string.get());
+		return Match(pattern.GetStringData());
 	}
 
 	String& String::Prepend(char character)
@@ -2091,14 +2044,14 @@ namespace Nz
 			return Replace(String(oldCharacter), String(), start);
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		unsigned int count = 0;
-		char* ptr = &m_sharedString->string[pos];
+		char* ptr = &GetStringData()[pos];
 		bool found = false;
 		if (flags & CaseInsensitive)
 		{
@@ -2110,11 +2063,11 @@ namespace Nz
 				{
 					if (!found)
 					{
-						std::ptrdiff_t offset = ptr - m_sharedString->string.get();
+						std::ptrdiff_t offset = ptr - GetStringData();
 
 						EnsureOwnership();
 
-						ptr = &m_sharedString->string[offset];
+						ptr = &GetStringData()[offset];
 						found = true;
 					}
 
@@ -2130,11 +2083,11 @@ namespace Nz
 			{
 				if (!found)
 				{
-					std::ptrdiff_t offset = ptr-m_sharedString->string.get();
+					std::ptrdiff_t offset = ptr-GetStringData();
 
 					EnsureOwnership();
 
-					ptr = &m_sharedString->string[offset];
+					ptr = &GetStringData()[offset];
 					found = true;
 				}
 
@@ -2157,10 +2110,10 @@ namespace Nz
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
 		unsigned int count = 0;
@@ -2177,7 +2130,7 @@ namespace Nz
 					found = true;
 				}
 
-				std::memcpy(&m_sharedString->string[pos], replaceString, oldLength);
+				std::memcpy(&GetStringData()[pos], replaceString, oldLength);
 				pos += oldLength;
 
 				++count;
@@ -2185,19 +2138,20 @@ namespace Nz
 		}
 		else ///TODO: Algorithme de remplacement sans changement de buffer (si replaceLength < oldLength)
 		{
-			std::size_t newSize = m_sharedString->size + Count(oldString)*(replaceLength - oldLength);
-			if (newSize == m_sharedString->size) // Alors c'est que Count(oldString) == 0
+			std::size_t newSize = m_size + Count(oldString)*(replaceLength - oldLength);
+			if (newSize == m_size) // Alors c'est que Count(oldString) == 0
 				return 0;
 
-			auto newString = std::make_shared<SharedString>(newSize);
+			String newString;
+			newString.Allocate(newSize);
 
 			///Algo 4.Replace#2
-			char* ptr = newString->string.get();
-			const char* p = m_sharedString->string.get();
+			char* ptr = newString.GetStringData();
+			const char* p = GetStringData();
 
 			while ((pos = Find(oldString, pos, flags)) != npos)
 			{
-				const char* r = &m_sharedString->string[pos];
+				const char* r = &GetStringData()[pos];
 
 				std::memcpy(ptr, p, r-p);
 				ptr += r-p;
@@ -2211,7 +2165,7 @@ namespace Nz
 
 			std::strcpy(ptr, p);
 
-			m_sharedString = std::move(newString);
+			*this = std::move(newString);
 		}
 
 		return count;
@@ -2219,7 +2173,7 @@ namespace Nz
 
 	unsigned int String::Replace(const String& oldString, const String& replaceString, std::intmax_t start, UInt32 flags)
 	{
-		return Replace(oldString.GetConstBuffer(), oldString.m_sharedString->size, replaceString.GetConstBuffer(), replaceString.m_sharedString->size, start, flags);
+		return Replace(oldString.GetConstBuffer(), oldString.m_size, replaceString.GetConstBuffer(), replaceString.m_size, start, flags);
 	}
 
 	unsigned int String::ReplaceAny(const char* oldCharacters, char replaceCharacter, std::intmax_t start, UInt32 flags)
@@ -2232,14 +2186,14 @@ namespace Nz
 			return ReplaceAny(String(oldCharacters), String(), start);*/
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		unsigned int count = 0;
-		char* ptr = &m_sharedString->string[pos];
+		char* ptr = &GetStringData()[pos];
 		if (flags & CaseInsensitive)
 		{
 			do
@@ -2253,11 +2207,11 @@ namespace Nz
 					{
 						if (!found)
 						{
-							std::ptrdiff_t offset = ptr - m_sharedString->string.get();
+							std::ptrdiff_t offset = ptr - GetStringData();
 
 							EnsureOwnership();
 
-							ptr = &m_sharedString->string[offset];
+							ptr = &GetStringData()[offset];
 							found = true;
 						}
 
@@ -2277,11 +2231,11 @@ namespace Nz
 			{
 				if (!found)
 				{
-					std::ptrdiff_t offset = ptr - m_sharedString->string.get();
+					std::ptrdiff_t offset = ptr - GetStringData();
 
 					EnsureOwnership();
 
-					ptr = &m_sharedString->string[offset];
+					ptr = &GetStringData()[offset];
 					found = true;
 				}
 
@@ -2297,7 +2251,7 @@ namespace Nz
 		{
 			if (start < 0)
 			{
-				start = m_sharedString->size+start;
+				start = m_size+start;
 				if (start < 0)
 					start = 0;
 			}
@@ -2306,7 +2260,7 @@ namespace Nz
 			unsigned int oSize = (oldCharacters) ? std::strlen(oldCharacters) : 0;
 			unsigned int rSize = (replaceString) ? std::strlen(replaceString) : 0;
 
-			if (pos >= m_sharedString->size || m_sharedString->size == 0 || oSize == 0)
+			if (pos >= m_size || m_size == 0 || oSize == 0)
 				return 0;
 
 			unsigned int count = 0;
@@ -2315,13 +2269,13 @@ namespace Nz
 			{
 				EnsureOwnership();
 
-				f or (; pos < m_sharedString->size; ++pos)
+				f or (; pos < m_size; ++pos)
 				{
 					for (unsigned int i = 0; i < oSize; ++i)
 					{
-						if (m_sharedString->string[pos] == oldCharacters[i])
+						if (GetStringData()[pos] == oldCharacters[i])
 						{
-							m_sharedString->string[pos] = replaceString[0];
+							GetStringData()[pos] = replaceString[0];
 							++count;
 
 							break;
@@ -2334,21 +2288,21 @@ namespace Nz
 				unsigned int newSize;
 				{
 					unsigned int count = CountAny(oldCharacters);
-					newSize = m_sharedString->size - count + count*rSize;
+					newSize = m_size - count + count*rSize;
 				}
 				char* newString = new char[newSize+1];
 
 				unsigned int j = 0;
-				for (unsigned int i = 0; i < m_sharedString->size; ++i)
+				for (unsigned int i = 0; i < m_size; ++i)
 				{
 					if (i < pos) // Avant la position où on est censé commencer à remplacer, on ne fait que recopier
-						newString[j++] = m_sharedString->string[i];
+						newString[j++] = GetStringData()[i];
 					else
 					{
 						bool found = false;
 						for (unsigned int l = 0; l < oSize; ++l)
 						{
-							if (m_sharedString->string[i] == oldCharacters[l])
+							if (GetStringData()[i] == oldCharacters[l])
 							{
 								for (unsigned int k = 0; k < rSize; ++k)
 									newString[j++] = replaceString[k];
@@ -2360,14 +2314,14 @@ namespace Nz
 						}
 
 						if (!found)
-							newString[j++] = m_sharedString->string[i];
+							newString[j++] = GetStringData()[i];
 					}
 				}
 				newString[newSize] = '\0';
 
 				ReleaseString();
 
-				m_sharedString->size = newSize;
+				m_size = newSize;
 				m_sharedString->string = newString;
 			}
 
@@ -2378,30 +2332,30 @@ namespace Nz
 		{
 			if (start < 0)
 			{
-				start = m_sharedString->size+start;
+				start = m_size+start;
 				if (start < 0)
 					start = 0;
 			}
 
 			unsigned int pos = static_cast<unsigned int>(start);
 
-			if (pos >= m_sharedString->size || m_sharedString->size == 0 || oldCharacters.m_sharedString->size == 0)
+			if (pos >= m_size || m_size == 0 || oldCharacters.m_size == 0)
 				return 0;
 
 			unsigned int count = 0;
 
-			if (replaceString.m_sharedString->size == 1) // On utilise un algorithme optimisé
+			if (replaceString.m_size == 1) // On utilise un algorithme optimisé
 			{
 				EnsureOwnership();
 
 				char character = replaceString[0];
-				for (; pos < m_sharedString->size; ++pos)
+				for (; pos < m_size; ++pos)
 				{
-					for (unsigned int i = 0; i < oldCharacters.m_sharedString->size; ++i)
+					for (unsigned int i = 0; i < oldCharacters.m_size; ++i)
 					{
-						if (m_sharedString->string[pos] == oldCharacters[i])
+						if (GetStringData()[pos] == oldCharacters[i])
 						{
-							m_sharedString->string[pos] = character;
+							GetStringData()[pos] = character;
 							++count;
 							break;
 						}
@@ -2413,23 +2367,23 @@ namespace Nz
 				unsigned int newSize;
 				{
 					unsigned int count = CountAny(oldCharacters);
-					newSize = m_sharedString->size - count + count*replaceString.m_sharedString->size;
+					newSize = m_size - count + count*replaceString.m_size;
 				}
 				char* newString = new char[newSize+1];
 
 				unsigned int j = 0;
-				for (unsigned int i = 0; i < m_sharedString->size; ++i)
+				for (unsigned int i = 0; i < m_size; ++i)
 				{
 					if (i < pos) // Avant la position où on est censé commencer à remplacer, on ne fait que recopier
-						newString[j++] = m_sharedString->string[i];
+						newString[j++] = GetStringData()[i];
 					else
 					{
 						bool found = false;
-						for (unsigned int l = 0; l < oldCharacters.m_sharedString->size; ++l)
+						for (unsigned int l = 0; l < oldCharacters.m_size; ++l)
 						{
-							if (m_sharedString->string[i] == oldCharacters[l])
+							if (GetStringData()[i] == oldCharacters[l])
 							{
-								for (unsigned int k = 0; k < replaceString.m_sharedString->size; ++k)
+								for (unsigned int k = 0; k < replaceString.m_size; ++k)
 									newString[j++] = replaceString[k];
 
 								++count;
@@ -2439,14 +2393,14 @@ namespace Nz
 						}
 
 						if (!found)
-							newString[j++] = m_sharedString->string[i];
+							newString[j++] = GetStringData()[i];
 					}
 				}
 				newString[newSize] = '\0';
 
 				ReleaseString();
 
-				m_sharedString->size = newSize;
+				m_size = newSize;
 				m_sharedString->string = newString;
 			}
 
@@ -2456,16 +2410,16 @@ namespace Nz
 
 	void String::Reserve(std::size_t bufferSize)
 	{
-		if (m_sharedString->capacity > bufferSize)
+		if (GetCapacity() > bufferSize)
 			return;
 
-		auto newString = std::make_shared<SharedString>(bufferSize);
-		newString->size = m_sharedString->size;
+		String newString;
+		newString.Allocate(m_size, bufferSize);
 
-		if (m_sharedString->size > 0)
-			std::memcpy(newString->string.get(), m_sharedString->string.get(), m_sharedString->size);
+		if (m_size > 0)
+			std::memcpy(newString.GetStringData(), GetStringData(), m_size);
 
-		m_sharedString = std::move(newString);
+		*this = std::move(newString);
 	}
 
 	String& String::Resize(std::intmax_t size, UInt32 flags)
@@ -2477,34 +2431,35 @@ namespace Nz
 		}
 
 		if (size < 0)
-			size = std::max<std::intmax_t>(m_sharedString->size + size, 0);
+			size = std::max<std::intmax_t>(m_size + size, 0);
 
 		std::size_t newSize = static_cast<std::size_t>(size);
 
-		if (flags & HandleUtf8 && newSize < m_sharedString->size)
+		if (flags & HandleUtf8 && newSize < m_size)
 		{
-			std::size_t characterToRemove = m_sharedString->size - newSize;
+			std::size_t characterToRemove = m_size - newSize;
 
-			char* ptr = &m_sharedString->string[m_sharedString->size];
+			char* ptr = &GetStringData()[m_size];
 			for (std::size_t i = 0; i < characterToRemove; ++i)
-				utf8::prior(ptr, m_sharedString->string.get());
+				utf8::prior(ptr, GetStringData());
 
-			newSize = ptr - m_sharedString->string.get();
+			newSize = ptr - GetStringData();
 		}
 
-		if (m_sharedString->capacity >= newSize)
+		if (GetCapacity() >= newSize)
 		{
 			EnsureOwnership();
 
-			m_sharedString->size = newSize;
-			m_sharedString->string[newSize] = '\0'; // Adds the EoS character
+			m_size = newSize;
+			GetStringData()[newSize] = '\0'; // Adds the EoS character
 		}
 		else // Then we want to make the string bigger
 		{
-			auto newString = std::make_shared<SharedString>(newSize);
-			std::memcpy(newString->string.get(), m_sharedString->string.get(), m_sharedString->size);
+			String newString;
+			newString.Allocate(newSize);
+			std::memcpy(newString.GetStringData(), GetStringData(), m_size);
 
-			m_sharedString = std::move(newString);
+			*this = std::move(newString);
 		}
 
 		return *this;
@@ -2513,44 +2468,45 @@ namespace Nz
 	String String::Resized(std::intmax_t size, UInt32 flags) const
 	{
 		if (size < 0)
-			size = m_sharedString->size + size;
+			size = m_size + size;
 
 		if (size <= 0)
 			return String();
 
 		std::size_t newSize = static_cast<std::size_t>(size);
-		if (newSize == m_sharedString->size)
+		if (newSize == m_size)
 			return *this;
 
-		if (flags & HandleUtf8 && newSize < m_sharedString->size)
+		if (flags & HandleUtf8 && newSize < m_size)
 		{
-			std::size_t characterToRemove = m_sharedString->size - newSize;
+			std::size_t characterToRemove = m_size - newSize;
 
-			char* ptr = &m_sharedString->string[m_sharedString->size - 1];
+			const char* ptr = &GetStringData()[m_size - 1];
 			for (std::size_t i = 0; i < characterToRemove; ++i)
-				utf8::prior(ptr, m_sharedString->string.get());
+				utf8::prior(ptr, GetStringData());
 
-			newSize = ptr - m_sharedString->string.get();
+			newSize = ptr - GetStringData();
 		}
 
-		auto sharedStr = std::make_shared<SharedString>(newSize);
-		if (newSize > m_sharedString->size)
-			std::memcpy(sharedStr->string.get(), m_sharedString->string.get(), m_sharedString->size);
+		String sharedStr;
+		sharedStr.Allocate(newSize);
+		if (newSize > m_size)
+			std::memcpy(sharedStr.GetStringData(), GetStringData(), m_size);
 		else
-			std::memcpy(sharedStr->string.get(), m_sharedString->string.get(), newSize);
+			std::memcpy(sharedStr.GetStringData(), GetStringData(), newSize);
 
-		return String(std::move(sharedStr));
+		return sharedStr;
 	}
 
 	String& String::Reverse()
 	{
-		if (m_sharedString->size != 0)
+		if (m_size != 0)
 		{
 			std::size_t i = 0;
-			std::size_t j = m_sharedString->size-1;
+			std::size_t j = m_size-1;
 
 			while (i < j)
-				std::swap(m_sharedString->string[i++], m_sharedString->string[j--]);
+				std::swap(GetStringData()[i++], GetStringData()[j--]);
 		}
 
 		return *this;
@@ -2558,38 +2514,31 @@ namespace Nz
 
 	String String::Reversed() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return String();
 
-		auto sharedStr = std::make_shared<SharedString>(m_sharedString->size);
+		String sharedStr;
+		sharedStr.Allocate(m_size);
 
-		char* ptr = &sharedStr->string[m_sharedString->size - 1];
-		char* p = m_sharedString->string.get();
+		char* ptr = &sharedStr.GetStringData()[m_size - 1];
+		const char* p = GetStringData();
 
 		do
 			*ptr-- = *p;
 		while (*(++p));
 
-		return String(std::move(sharedStr));
+		return sharedStr;
 	}
 
 	String& String::Set(char character)
 	{
 		if (character != '\0')
 		{
-			if (m_sharedString->capacity >= 1)
-			{
-				EnsureOwnership(true);
+			EnsureOwnership(true);
 
-				m_sharedString->size = 1;
-				m_sharedString->string[0] = character;
-				m_sharedString->string[1] = '\0';
-			}
-			else
-			{
-				auto newString = std::make_shared<SharedString>(1);
-				newString->string[0] = character;
-			}
+			m_size = 1;
+			GetStringData()[0] = character;
+			GetStringData()[1] = '\0';
 		}
 		else
 			ReleaseString();
@@ -2601,18 +2550,18 @@ namespace Nz
 	{
 		if (rep > 0)
 		{
-			if (m_sharedString->capacity >= rep)
+			if (GetCapacity() >= rep)
 			{
 				EnsureOwnership(true);
 
-				m_sharedString->size = rep;
-				m_sharedString->string[rep] = '\0';
+				m_size = rep;
+				GetStringData()[rep] = '\0';
 			}
 			else
-				m_sharedString = std::make_shared<SharedString>(rep);
+				Allocate(rep);
 
 			if (character != '\0')
-				std::memset(m_sharedString->string.get(), character, rep);
+				std::memset(GetStringData(), character, rep);
 		}
 		else
 			ReleaseString();
@@ -2631,18 +2580,18 @@ namespace Nz
 
 		if (totalSize > 0)
 		{
-			if (m_sharedString->capacity >= totalSize)
+			if (GetCapacity() >= totalSize)
 			{
 				EnsureOwnership(true);
 
-				m_sharedString->size = totalSize;
-				m_sharedString->string[totalSize] = '\0';
+				m_size = totalSize;
+				GetStringData()[totalSize] = '\0';
 			}
 			else
-				m_sharedString = std::make_shared<SharedString>(totalSize);
+				Allocate(totalSize);
 
 			for (std::size_t i = 0; i < rep; ++i)
-				std::memcpy(&m_sharedString->string[i*length], string, length);
+				std::memcpy(&GetStringData()[i*length], string, length);
 		}
 		else
 			ReleaseString();
@@ -2652,7 +2601,7 @@ namespace Nz
 
 	String& String::Set(std::size_t rep, const String& string)
 	{
-		return Set(rep, string.GetConstBuffer(), string.m_sharedString->size);
+		return Set(rep, string.GetConstBuffer(), string.m_size);
 	}
 
 	String& String::Set(const char* string)
@@ -2664,17 +2613,17 @@ namespace Nz
 	{
 		if (length > 0)
 		{
-			if (m_sharedString->capacity >= length)
+			if (GetCapacity() >= length)
 			{
 				EnsureOwnership(true);
 
-				m_sharedString->size = length;
-				m_sharedString->string[length] = '\0';
+				m_size = length;
+				GetStringData()[length] = '\0';
 			}
 			else
-				m_sharedString = std::make_shared<SharedString>(length);
+				Allocate(length);
 
-			std::memcpy(m_sharedString->string.get(), string, length);
+			std::memcpy(GetStringData(), string, length);
 		}
 		else
 			ReleaseString();
@@ -2689,28 +2638,54 @@ namespace Nz
 
 	String& String::Set(const String& string)
 	{
-		m_sharedString = string.m_sharedString;
+		if (this != &string)
+		{
+			if (string.HasSharedString())
+			{
+				string.m_sharedString->refCount.fetch_add(1, std::memory_order_relaxed);
+				SetSharedString(string.m_sharedString);
+			}
+			else
+			{
+				SetSharedString(nullptr);
+				std::memcpy(m_smallString, string.m_smallString, string.m_size + 1);
+			}
+
+			m_size = string.m_size;
+		}
 
 		return *this;
 	}
 
 	String& String::Set(String&& string) noexcept
 	{
-		std::swap(m_sharedString, string.m_sharedString);
+		// Like the move constructor, the source string is left empty
+		if (this != &string)
+		{
+			ReleaseString();
+
+			std::memcpy(m_smallString, string.m_smallString, sizeof(m_smallString));
+			m_size = string.m_size;
+
+			string.m_size = 0;
+			string.m_smallString[0] = '\0';
+			string.m_smallString[SharedStringTag] = 0;
+		}
 
 		return *this;
 	}
 
 	String String::Simplified(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return String();
 
-		auto newString = std::make_shared<SharedString>(m_sharedString->size);
-		char* str = newString->string.get();
+		String newString;
+		newString.Allocate(m_size);
+		char* str = newString.GetStringData();
 		char* p = str;
 
-		const char* ptr = m_sharedString->string.get();
+		const char* ptr = GetStringData();
 		bool inword = false;
 		if (flags & HandleUtf8)
 		{
@@ -2735,7 +2710,7 @@ namespace Nz
 		}
 		else
 		{
-			const char* limit = &m_sharedString->string[m_sharedString->size];
+			const char* limit = &GetStringData()[m_size];
 			do
 			{
 				if (std::isspace(*ptr))
@@ -2759,8 +2734,9 @@ namespace Nz
 			p--;
 
 		*p = '\0';
+		newString.m_size = p - str;
 
-		return String(std::move(newString));
+		return newString;
 	}
 
 	String& String::Simplify(UInt32 flags)
@@ -2770,7 +2746,7 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, char separation, std::intmax_t start, UInt32 flags) const
 	{
-		if (separation == '\0' || m_sharedString->size == 0)
+		if (separation == '\0' || m_size == 0)
 			return 0;
 
 		std::size_t lastSep = Find(separation, start, flags);
@@ -2794,7 +2770,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size-1)
+		if (lastSep != m_size-1)
 			result.push_back(SubString(lastSep+1));
 
 		return result.size();
@@ -2807,17 +2783,17 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, const char* separation, std::size_t length, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 		else if (length == 0)
 		{
-			result.reserve(m_sharedString->size);
-			for (std::size_t i = 0; i < m_sharedString->size; ++i)
-				result.push_back(String(m_sharedString->string[i]));
+			result.reserve(m_size);
+			for (std::size_t i = 0; i < m_size; ++i)
+				result.push_back(String(GetStringData()[i]));
 
-			return m_sharedString->size;
+			return m_size;
 		}
-		else if (length > m_sharedString->size)
+		else if (length > m_size)
 		{
 			result.push_back(*this);
 			return 1;
@@ -2842,7 +2818,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size - length)
+		if (lastSep != m_size - length)
 			result.push_back(SubString(lastSep + length));
 
 		return result.size()-oldSize;
@@ -2850,12 +2826,12 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, const String& separation, std::intmax_t start, UInt32 flags) const
 	{
-		return Split(result, separation.m_sharedString->string.get(), separation.m_sharedString->size, start, flags);
+		return Split(result, separation.GetStringData(), separation.m_size, start, flags);
 	}
 
 	unsigned int String::SplitAny(std::vector<String>& result, const char* separations, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 
 		std::size_t oldSize = result.size();
@@ -2878,7 +2854,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size-1)
+		if (lastSep != m_size-1)
 			result.push_back(SubString(lastSep+1));
 
 		return result.size()-oldSize;
@@ -2886,30 +2862,30 @@ namespace Nz
 
 	unsigned int String::SplitAny(std::vector<String>& result, const String& separations, std::intmax_t start, UInt32 flags) const
 	{
-		return SplitAny(result, separations.m_sharedString->string.get(), start, flags);
+		return SplitAny(result, separations.GetStringData(), start, flags);
 	}
 
 	bool String::StartsWith(char character, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return false;
 
 		if (flags & CaseInsensitive)
-			return Detail::ToLower(m_sharedString->string[0]) == Detail::ToLower(character);
+			return Detail::ToLower(GetStringData()[0]) == Detail::ToLower(character);
 		else
-			return m_sharedString->string[0] == character;
+			return GetStringData()[0] == character;
 	}
 
 	bool String::StartsWith(const char* string, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(GetStringData());
 				utf8::unchecked::iterator<const char*> it2(string);
 				do
 				{
@@ -2925,7 +2901,7 @@ namespace Nz
 			}
 			else
 			{
-				char* ptr = m_sharedString->string.get();
+				const char* ptr = GetStringData();
 				const char* s = string;
 				do
 				{
@@ -2942,7 +2918,7 @@ namespace Nz
 		}
 		else
 		{
-			char* ptr = m_sharedString->string.get();
+			const char* ptr = GetStringData();
 			const char* s = string;
 			do
 			{
@@ -2962,17 +2938,17 @@ namespace Nz
 
 	bool String::StartsWith(const String& string, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0)
+		if (string.m_size == 0)
 			return false;
 
-		if (m_sharedString->size < string.m_sharedString->size)
+		if (m_size < string.m_size)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(GetStringData());
 				utf8::unchecked::iterator<const char*> it2(string.GetConstBuffer());
 				do
 				{
@@ -2988,7 +2964,7 @@ namespace Nz
 			}
 			else
 			{
-				char* ptr = m_sharedString->string.get();
+				const char* ptr = GetStringData();
 				const char* s = string.GetConstBuffer();
 				do
 				{
@@ -3004,7 +2980,7 @@ namespace Nz
 			}
 		}
 		else
-			return std::memcmp(m_sharedString->string.get(), string.GetConstBuffer(), string.m_sharedString->size) == 0;
+			return std::memcmp(GetStringData(), string.GetConstBuffer(), string.m_size) == 0;
 
 		return false;
 	}
@@ -3012,27 +2988,28 @@ namespace Nz
 	String String::SubString(std::intmax_t startPos, std::intmax_t endPos) const
 	{
 		if (startPos < 0)
-			startPos = std::max<std::size_t>(m_sharedString->size + startPos, 0);
+			startPos = std::max<std::size_t>(m_size + startPos, 0);
 
 		std::size_t start = static_cast<std::size_t>(startPos);
 
 		if (endPos < 0)
 		{
-			endPos = m_sharedString->size+endPos;
+			endPos = m_size+endPos;
 			if (endPos < 0)
 				return String();
 		}
 
-		std::size_t minEnd = std::min(static_cast<std::size_t>(endPos), m_sharedString->size - 1);
-		if (start > minEnd || start >= m_sharedString->size)
+		std::size_t minEnd = std::min(static_cast<std::size_t>(endPos), m_size - 1);
+		if (start > minEnd || start >= m_size)
 			return String();
 
 		std::size_t size = minEnd - start + 1;
 
-		auto str = std::make_shared<SharedString>(size);
-		std::memcpy(str->string.get(), &m_sharedString->string[start], size);
+		String str;
+		str.Allocate(size);
+		std::memcpy(str.GetStringData(), &GetStringData()[start], size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::SubStringFrom(char character, std::intmax_t startPos, bool fromLast, bool include, UInt32 flags) const
@@ -3077,7 +3054,7 @@ namespace Nz
 
 	String String::SubStringFrom(const String& string, std::intmax_t startPos, bool fromLast, bool include, UInt32 flags) const
 	{
-		return SubStringFrom(string.GetConstBuffer(), string.m_sharedString->size, startPos, fromLast, include, flags);
+		return SubStringFrom(string.GetConstBuffer(), string.m_size, startPos, fromLast, include, flags);
 	}
 
 	String String::SubStringTo(char character, std::intmax_t startPos, bool toLast, bool include, UInt32 flags) const
@@ -3122,17 +3099,19 @@ namespace Nz
 
 	String String::SubStringTo(const String& string, std::intmax_t startPos, bool toLast, bool include, UInt32 flags) const
 	{
-		return SubStringTo(string.GetConstBuffer(), string.m_sharedString->size, startPos, toLast, include, flags);
+		return SubStringTo(string.GetConstBuffer(), string.m_size, startPos, toLast, include, flags);
 	}
 
 	void String::Swap(String& str)
 	{
-		std::swap(m_sharedString, str.m_sharedString);
+		// The inline buffer holds the shared string pointer as well
+		std::swap(m_size, str.m_size);
+		std::swap(m_smallString, str.m_smallString);
 	}
 
 	bool String::ToBool(bool* value, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		String word = GetWord(0);
@@ -3171,11 +3150,11 @@ namespace Nz
 
 	bool String::ToDouble(double* value) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (value)
-			*value = std::atof(m_sharedString->string.get());
+			*value = std::atof(GetStringData());
 
 		return true;
 	}
@@ -3195,65 +3174,63 @@ namespace Nz
 
 	String String::ToLower(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		if (flags & HandleUtf8)
 		{
+			// The ASCII prefix is converted in bulk, the rest goes through the Unicode tables
+			const char* asciiEnd = StringImpl::FindNonAscii(GetStringData(), &GetStringData()[m_size]);
+			std::size_t asciiSize = asciiEnd - GetStringData();
+
 			String lower;
-			lower.Reserve(m_sharedString->size);
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
-			do
+			lower.Reserve(m_size);
+			lower.Resize(asciiSize);
+			StringImpl::ToLower(GetStringData(), lower.GetStringData(), asciiSize);
+
+			for (utf8::unchecked::iterator<const char*> it(asciiEnd); it.base() != &GetStringData()[m_size]; ++it)
 				utf8::append(Unicode::GetLowercase(*it), std::back_inserter(lower));
-			while (*++it);
 
 			return lower;
 		}
 		else
 		{
-			auto str = std::make_shared<SharedString>(m_sharedString->size);
-
-			char* ptr = m_sharedString->string.get();
-			char* s = str->string.get();
-			do
-				*s++ = Detail::ToLower(*ptr);
-			while (*++ptr);
-
-			*s = '\0';
+			String str;
+			str.Allocate(m_size);
+			StringImpl::ToLower(GetStringData(), str.GetStringData(), m_size);
 
-			return String(std::move(str));
+			return str;
 		}
 	}
 
 	String String::ToUpper(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		if (flags & HandleUtf8)
 		{
+			// The ASCII prefix is converted in bulk, the rest goes through the Unicode tables
+			const char* asciiEnd = StringImpl::FindNonAscii(GetStringData(), &GetStringData()[m_size]);
+			std::size_t asciiSize = asciiEnd - GetStringData();
+
 			String upper;
-			upper.Reserve(m_sharedString->size);
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
-			do
+			upper.Reserve(m_size);
+			upper.Resize(asciiSize);
+			StringImpl::ToUpper(GetStringData(), upper.GetStringData(), asciiSize);
+
+			for (utf8::unchecked::iterator<const char*> it(asciiEnd); it.base() != &GetStringData()[m_size]; ++it)
 				utf8::append(Unicode::GetUppercase(*it), std::back_inserter(upper));
-			while (*++it);
 
 			return upper;
 		}
 		else
 		{
-			auto str = std::make_shared<SharedString>(m_sharedString->size);
-
-			char* ptr = m_sharedString->string.get();
-			char* s = str->string.get();
-			do
-				*s++ = Detail::ToUpper(*ptr);
-			while (*++ptr);
-
-			*s = '\0';
+			String str;
+			str.Allocate(m_size);
+			StringImpl::ToUpper(GetStringData(), str.GetStringData(), m_size);
 
-			return String(std::move(str));
+			return str;
 		}
 	}
 
@@ -3269,7 +3246,7 @@ namespace Nz
 
 	String String::Trimmed(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		std::size_t startPos;
@@ -3278,7 +3255,7 @@ namespace Nz
 		{
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(GetStringData());
 				do
 				{
 					if (Unicode::GetCategory(*it) & Unicode::Category_Separator)
@@ -3286,43 +3263,43 @@ namespace Nz
 				}
 				while (*++it);
 
-				startPos = it.base() - m_sharedString->string.get();
+				startPos = it.base() - GetStringData();
 			}
 			else
 				startPos = 0;
 
 			if ((flags & TrimOnlyLeft) == 0)
 			{
-				utf8::unchecked::iterator<const char*> it(&m_sharedString->string[m_sharedString->size]);
-				while ((it--).base() != m_sharedString->string.get())
+				utf8::unchecked::iterator<const char*> it(&GetStringData()[m_size]);
+				while ((it--).base() != GetStringData())
 				{
 					if (Unicode::GetCategory(*it) & Unicode::Category_Separator)
 						break;
 				}
 
-				endPos = it.base() - m_sharedString->string.get();
+				endPos = it.base() - GetStringData();
 			}
 			else
-				endPos = m_sharedString->size-1;
+				endPos = m_size-1;
 		}
 		else
 		{
 			startPos = 0;
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					if (!std::isspace(m_sharedString->string[startPos]))
+					if (!std::isspace(GetStringData()[startPos]))
 						break;
 				}
 			}
 
-			endPos = m_sharedString->size-1;
+			endPos = m_size-1;
 			if ((flags & TrimOnlyLeft) == 0)
 			{
 				for (; endPos > 0; --endPos)
 				{
-					if (!std::isspace(m_sharedString->string[endPos]))
+					if (!std::isspace(GetStringData()[endPos]))
 						break;
 				}
 			}
@@ -3333,19 +3310,19 @@ namespace Nz
 
 	String String::Trimmed(char character, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		std::size_t startPos = 0;
-		std::size_t endPos = m_sharedString->size-1;
+		std::size_t endPos = m_size-1;
 		if (flags & CaseInsensitive)
 		{
 			char ch = Detail::ToLower(character);
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					if (Detail::ToLower(m_sharedString->string[startPos]) != ch)
+					if (Detail::ToLower(GetStringData()[startPos]) != ch)
 						break;
 				}
 			}
@@ -3354,7 +3331,7 @@ namespace Nz
 			{
 				for (; endPos > 0; --endPos)
 				{
-					if (Detail::ToLower(m_sharedString->string[endPos]) != ch)
+					if (Detail::ToLower(GetStringData()[endPos]) != ch)
 						break;
 				}
 			}
@@ -3363,9 +3340,9 @@ namespace Nz
 		{
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					if (m_sharedString->string[startPos] != character)
+					if (GetStringData()[startPos] != character)
 						break;
 				}
 			}
@@ -3374,7 +3351,7 @@ namespace Nz
 			{
 				for (; endPos > 0; --endPos)
 				{
-					if (m_sharedString->string[endPos] != character)
+					if (GetStringData()[endPos] != character)
 						break;
 				}
 			}
@@ -3385,22 +3362,22 @@ namespace Nz
 
 	char* String::begin()
 	{
-		return m_sharedString->string.get();
+		return GetStringData();
 	}
 
 	const char* String::begin() const
 	{
-		return m_sharedString->string.get();
+		return GetStringData();
 	}
 
 	char* String::end()
 	{
-		return &m_sharedString->string[m_sharedString->size];
+		return &GetStringData()[m_size];
 	}
 
 	const char* String::end() const
 	{
-		return &m_sharedString->string[m_sharedString->size];
+		return &GetStringData()[m_size];
 	}
 
 	void String::push_front(char c)
@@ -3415,51 +3392,51 @@ namespace Nz
 	/*
 	char* String::rbegin()
 	{
-		return &m_sharedString->string[m_sharedString->size-1];
+		return &GetStringData()[m_size-1];
 	}
 
 	const char* String::rbegin() const
 	{
-		return &m_sharedString->string[m_sharedString->size-1];
+		return &GetStringData()[m_size-1];
 	}
 
 	char* String::rend()
 	{
-		return &m_sharedString->string[-1];
+		return &GetStringData()[-1];
 	}
 
 	const char* String::rend() const
 	{
-		return &m_sharedString->string[-1];
+		return &GetStringData()[-1];
 	}
 	*/
 
 	String::operator std::string() const
 	{
-		return std::string(m_sharedString->string.get(), m_sharedString->size);
+		return std::string(GetStringData(), m_size);
 	}
 
 	char& String::operator[](std::size_t pos)
 	{
 		EnsureOwnership();
 
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			Resize(pos+1);
 
-		return m_sharedString->string[pos];
+		return GetStringData()[pos];
 	}
 
 	char String::operator[](std::size_t pos) const
 	{
 		#if NAZARA_CORE_SAFE
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 		{
-			NazaraError("Index out of range (" + Number(pos) + " >= " + Number(m_sharedString->size) + ')');
+			NazaraError("Index out of range (" + Number(pos) + " >= " + Number(m_size) + ')');
 			return 0;
 		}
 		#endif
 
-		return m_sharedString->string[pos];
+		return GetStringData()[pos];
 	}
 
 	String& String::operator=(char character)
@@ -3484,7 +3461,7 @@ namespace Nz
 
 	String& String::operator=(String&& string) noexcept
 	{
-		return Set(string);
+		return Set(std::move(string));
 	}
 
 	String String::operator+(char character) const
@@ -3492,11 +3469,12 @@ namespace Nz
 		if (character == '\0')
 			return *this;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + 1);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		str->string[m_sharedString->size] = character;
+		String str;
+		str.Allocate(m_size + 1);
+		std::memcpy(str.GetStringData(), GetConstBuffer(), m_size);
+		str.GetStringData()[m_size] = character;
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::operator+(const char* string) const
@@ -3504,18 +3482,19 @@ namespace Nz
 		if (!string || !string[0])
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
 		std::size_t length = std::strlen(string);
 		if (length == 0)
 			return *this;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + length);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string, length+1);
+		String str;
+		str.Allocate(m_size + length);
+		std::memcpy(str.GetStringData(), GetConstBuffer(), m_size);
+		std::memcpy(&str.GetStringData()[m_size], string, length+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::operator+(const std::string& string) const
@@ -3523,65 +3502,67 @@ namespace Nz
 		if (string.empty())
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + string.size());
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string.c_str(), string.size()+1);
+		String str;
+		str.Allocate(m_size + string.size());
+		std::memcpy(str.GetStringData(), GetConstBuffer(), m_size);
+		std::memcpy(&str.GetStringData()[m_size], string.c_str(), string.size()+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::operator+(const String& string) const
 	{
-		if (string.m_sharedString->size == 0)
+		if (string.m_size == 0)
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + string.m_sharedString->size);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string.GetConstBuffer(), string.m_sharedString->size);
+		String str;
+		str.Allocate(m_size + string.m_size);
+		std::memcpy(str.GetStringData(), GetConstBuffer(), m_size);
+		std::memcpy(&str.GetStringData()[m_size], string.GetConstBuffer(), string.m_size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String& String::operator+=(char character)
 	{
-		return Insert(m_sharedString->size, character);
+		return Insert(m_size, character);
 	}
 
 	String& String::operator+=(const char* string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	String& String::operator+=(const std::string& string)
 	{
-		return Insert(m_sharedString->size, string.c_str(), string.size());
+		return Insert(m_size, string.c_str(), string.size());
 	}
 
 	String& String::operator+=(const String& string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	bool String::operator==(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return character == '\0';
 
-		if (m_sharedString->size > 1)
+		if (m_size > 1)
 			return false;
 
-		return m_sharedString->string[0] == character;
+		return GetStringData()[0] == character;
 	}
 
 	bool String::operator==(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return !string || !string[0];
 
 		if (!string || !string[0])
@@ -3592,10 +3573,10 @@ namespace Nz
 
 	bool String::operator==(const std::string& string) const
 	{
-		if (m_sharedString->size == 0 || string.empty())
-			return m_sharedString->size == string.size();
+		if (m_size == 0 || string.empty())
+			return m_size == string.size();
 
-		if (m_sharedString->size != string.size())
+		if (m_size != string.size())
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) == 0;
@@ -3603,21 +3584,21 @@ namespace Nz
 
 	bool String::operator!=(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return character != '\0';
 
-		if (character == '\0' || m_sharedString->size != 1)
+		if (character == '\0' || m_size != 1)
 			return true;
 
-		if (m_sharedString->size != 1)
+		if (m_size != 1)
 			return true;
 
-		return m_sharedString->string[0] != character;
+		return GetStringData()[0] != character;
 	}
 
 	bool String::operator!=(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string && string[0];
 
 		if (!string || !string[0])
@@ -3628,10 +3609,10 @@ namespace Nz
 
 	bool String::operator!=(const std::string& string) const
 	{
-		if (m_sharedString->size == 0 || string.empty())
-			return m_sharedString->size == string.size();
+		if (m_size == 0 || string.empty())
+			return m_size == string.size();
 
-		if (m_sharedString->size != string.size())
+		if (m_size != string.size())
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) != 0;
@@ -3642,10 +3623,10 @@ namespace Nz
 		if (character == '\0')
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
-		return m_sharedString->string[0] < character;
+		return GetStringData()[0] < character;
 	}
 
 	bool String::operator<(const char* string) const
@@ -3653,7 +3634,7 @@ namespace Nz
 		if (!string || !string[0])
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		return std::strcmp(GetConstBuffer(), string) < 0;
@@ -3664,7 +3645,7 @@ namespace Nz
 		if (string.empty())
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) < 0;
@@ -3672,18 +3653,18 @@ namespace Nz
 
 	bool String::operator<=(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (character == '\0')
 			return false;
 
-		return m_sharedString->string[0] < character || (m_sharedString->string[0] == character && m_sharedString->size == 1);
+		return GetStringData()[0] < character || (GetStringData()[0] == character && m_size == 1);
 	}
 
 	bool String::operator<=(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (!string || !string[0])
@@ -3694,7 +3675,7 @@ namespace Nz
 
 	bool String::operator<=(const std::string& string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (string.empty())
@@ -3705,18 +3686,18 @@ namespace Nz
 
 	bool String::operator>(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (character == '\0')
 			return true;
 
-		return m_sharedString->string[0] > character;
+		return GetStringData()[0] > character;
 	}
 
 	bool String::operator>(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (!string || !string[0])
@@ -3727,7 +3708,7 @@ namespace Nz
 
 	bool String::operator>(const std::string& string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (string.empty())
@@ -3741,10 +3722,10 @@ namespace Nz
 		if (character == '\0')
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
-		return m_sharedString->string[0] > character || (m_sharedString->string[0] == character && m_sharedString->size == 1);
+		return GetStringData()[0] > character || (GetStringData()[0] == character && m_size == 1);
 	}
 
 	bool String::operator>=(const char* string) const
@@ -3752,7 +3733,7 @@ namespace Nz
 		if (!string || !string[0])
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string) >= 0;
@@ -3763,7 +3744,7 @@ namespace Nz
 		if (string.empty())
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) >= 0;
@@ -3773,18 +3754,19 @@ namespace Nz
 	{
 		std::size_t size = (boolean) ? 4 : 5;
 
-		auto str = std::make_shared<SharedString>(size);
-		std::memcpy(str->string.get(), (boolean) ? "true" : "false", size);
+		String str;
+		str.Allocate(size);
+		std::memcpy(str.GetStringData(), (boolean) ? "true" : "false", size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	int String::Compare(const String& first, const String& second)
 	{
-		if (first.m_sharedString->size == 0)
-			return (second.m_sharedString->size == 0) ? 0 : -1;
+		if (first.m_size == 0)
+			return (second.m_size == 0) ? 0 : -1;
 
-		if (second.m_sharedString->size == 0)
+		if (second.m_size == 0)
 			return 1;
 
 		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer());
@@ -3871,10 +3853,11 @@ namespace Nz
 	{
 		const std::size_t capacity = sizeof(void*)*2 + 2;
 
-		auto str = std::make_shared<SharedString>(capacity);
-		str->size = std::sprintf(str->string.get(), "0x%p", ptr);
+		String str;
+		str.Allocate(capacity);
+		str.m_size = std::sprintf(str.GetStringData(), "0x%p", ptr);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::Unicode(char32_t character)
@@ -3892,10 +3875,11 @@ namespace Nz
 		else
 			count = 4;
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::append(character, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::append(character, str.GetStringData());
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::Unicode(const char* u8String)
@@ -3916,14 +3900,15 @@ namespace Nz
 
 		count *= 2; // On s'assure d'avoir la place suffisante
 
-		auto str = std::make_shared<SharedString>(count);
+		String str;
+		str.Allocate(count);
 
-		char* r = utf8::utf16to8(u16String, ptr, str->string.get());
+		char* r = utf8::utf16to8(u16String, ptr, str.GetStringData());
 		*r = '\0';
 
-		str->size = r - str->string.get();
+		str.m_size = r - str.GetStringData();
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::Unicode(const char32_t* u32String)
@@ -3947,10 +3932,11 @@ namespace Nz
 		}
 		while (*++ptr);
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::utf32to8(u32String, ptr, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::utf32to8(u32String, ptr, str.GetStringData());
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String String::Unicode(const wchar_t* wString)
@@ -3974,10 +3960,11 @@ namespace Nz
 		}
 		while (*++ptr);
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::utf32to8(wString, ptr, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::utf32to8(wString, ptr, str.GetStringData());
 
-		return String(std::move(str));
+		return str;
 	}
 
 	std::istream& operator>>(std::istream& is, String& str)
@@ -4009,7 +3996,7 @@ namespace Nz
 		if (str.IsEmpty())
 			return os;
 
-		return operator<<(os, str.m_sharedString->string.get());
+		return operator<<(os, str.GetStringData());
 	}
 
 	String operator+(char character, const String& string)
@@ -4020,11 +4007,12 @@ namespace Nz
 		if (string.IsEmpty())
 			return String(character);
 
-		auto str = std::make_shared<String::SharedString>(string.m_sharedString->size + 1);
-		str->string[0] = character;
-		std::memcpy(&str->string[1], string.GetConstBuffer(), string.m_sharedString->size);
+		String str;
+		str.Allocate(string.m_size + 1);
+		str.GetStringData()[0] = character;
+		std::memcpy(&str.GetStringData()[1], string.GetConstBuffer(), string.m_size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String operator+(const char* string, const String& nstring)
@@ -4036,13 +4024,14 @@ namespace Nz
 			return string;
 
 		std::size_t size = std::strlen(string);
-		std::size_t totalSize = size + nstring.m_sharedString->size;
+		std::size_t totalSize = size + nstring.m_size;
 
-		auto str = std::make_shared<String::SharedString>(totalSize);
-		std::memcpy(str->string.get(), string, size);
-		std::memcpy(&str->string[size], nstring.GetConstBuffer(), nstring.m_sharedString->size+1);
+		String str;
+		str.Allocate(totalSize);
+		std::memcpy(str.GetStringData(), string, size);
+		std::memcpy(&str.GetStringData()[size], nstring.GetConstBuffer(), nstring.m_size+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	String operator+(const std::string& string, const String& nstring)
@@ -4050,27 +4039,28 @@ namespace Nz
 		if (string.empty())
 			return nstring;
 
-		if (nstring.m_sharedString->size == 0)
+		if (nstring.m_size == 0)
 			return string;
 
-		std::size_t totalSize = string.size() + nstring.m_sharedString->size;
+		std::size_t totalSize = string.size() + nstring.m_size;
 
-		auto str = std::make_shared<String::SharedString>(totalSize);
-		std::memcpy(str->string.get(), string.c_str(), string.size());
-		std::memcpy(&str->string[string.size()], nstring.GetConstBuffer(), nstring.m_sharedString->size+1);
+		String str;
+		str.Allocate(totalSize);
+		std::memcpy(str.GetStringData(), string.c_str(), string.size());
+		std::memcpy(&str.GetStringData()[string.size()], nstring.GetConstBuffer(), nstring.m_size+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	bool operator==(const String& first, const String& second)
 	{
-		if (first.m_sharedString->size == 0 || second.m_sharedString->size == 0)
-			return first.m_sharedString->size == second.m_sharedString->size;
+		if (first.m_size == 0 || second.m_size == 0)
+			return first.m_size == second.m_size;
 
-		if (first.m_sharedString->size != second.m_sharedString->size)
+		if (first.m_size != second.m_size)
 			return false;
 
-		if (first.m_sharedString == second.m_sharedString)
+		if (first.HasSharedString() && second.HasSharedString() && first.m_sharedString == second.m_sharedString)
 			return true;
 
 		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer()) == 0;
@@ -4083,10 +4073,10 @@ namespace Nz
 
 	bool operator<(const String& first, const String& second)
 	{
-		if (second.m_sharedString->size == 0)
+		if (second.m_size == 0)
 			return false;
 
-		if (first.m_sharedString->size == 0)
+		if (first.m_size == 0)
 			return true;
 
 		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer()) < 0;
@@ -4197,25 +4187,31 @@ namespace Nz
 		return !operator<(string, nstring);
 	}
 
+	void String::Allocate(std::size_t size, std::size_t capacity)
+	{
+		///DOC: The previous content is lost, only the null terminator is written
+		capacity = std::max(size, capacity);
+		SetSharedString((capacity > SmallStringCapacity) ? new SharedString(capacity) : nullptr);
+
+		m_size = size;
+		GetStringData()[size] = '\0';
+	}
+
 	void String::EnsureOwnership(bool discardContent)
 	{
-		if (!m_sharedString)
+		// Inline strings are never shared
+		if (!HasSharedString() || m_sharedString->refCount.load(std::memory_order_acquire) == 1)
 			return;
 
-		if (!m_sharedString.unique())
-		{
-			auto newSharedString = std::make_shared<SharedString>(GetSize(), GetCapacity());
-			if (!discardContent)
-				std::memcpy(newSharedString->string.get(), GetConstBuffer(), GetSize()+1);
+		// Our reference is kept until the content is copied
+		SharedString* sharedString = m_sharedString;
+		m_smallString[SharedStringTag] = 0;
 
-			m_sharedString = std::move(newSharedString);
-		}
-	}
+		Allocate(m_size, sharedString->capacity);
+		if (!discardContent)
+			std::memcpy(GetStringData(), sharedString->string.get(), m_size);
 
-	const std::shared_ptr<String::SharedString>& String::GetEmptyString()
-	{
-		static auto emptyString = std::make_shared<SharedString>();
-		return emptyString;
+		ReleaseSharedString(sharedString);
 	}
 
 	bool Serialize(SerializationContext& context, const String& string)
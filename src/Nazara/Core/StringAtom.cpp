@@ -0,0 +1,135 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/StringAtom.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	StringAtom::StringAtom(const char* string) :
+	StringAtom(String(string))
+	{
+	}
+
+	StringAtom::StringAtom(const std::string& string) :
+	StringAtom(String(string))
+	{
+	}
+
+	StringAtom::StringAtom(const String& string) :
+	m_entry(Intern(string, true))
+	{
+		///DOC: The entry of an interned string is never freed, atoms should be built once and then reused
+	}
+
+	bool StringAtom::Find(const String& string, StringAtom* atom)
+	{
+		///DOC: Does not intern the string, returns false if it was never interned
+		NazaraAssert(atom, "Invalid atom");
+
+		const Entry* entry = Intern(string, false);
+		if (!entry)
+			return false;
+
+		atom->m_entry = entry;
+		return true;
+	}
+
+	const StringAtom::Entry* StringAtom::Intern(const String& string, bool insert)
+	{
+		if (string.IsEmpty())
+			return &s_emptyEntry;
+
+		// Open addressing table, whose slots are only ever filled, a full table is replaced by a bigger copy
+		// Lookups never take the lock this way, the replaced tables are kept as readers may still be probing them
+		struct Table
+		{
+			Table(std::size_t slotCount) :
+			slots(new std::atomic<const Entry*>[slotCount]),
+			count(0),
+			mask(slotCount - 1)
+			{
+				for (std::size_t i = 0; i < slotCount; ++i)
+					slots[i].store(nullptr, std::memory_order_relaxed);
+			}
+
+			const Entry* Find(const String& str, std::size_t hash, std::size_t* slot) const
+			{
+				// The table is never more than half full, an empty slot ends the probing
+				for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
+				{
+					const Entry* entry = slots[i].load(std::memory_order_acquire);
+					if (!entry || (entry->hash == hash && entry->string == str))
+					{
+						*slot = i;
+						return entry;
+					}
+				}
+			}
+
+			std::unique_ptr<std::atomic<const Entry*>[]> slots;
+			std::size_t count;
+			std::size_t mask;
+		};
+
+		static std::atomic<Table*> currentTable(nullptr);
+		static Mutex mutex;
+		static std::vector<std::unique_ptr<Entry>> entries;
+		static std::vector<std::unique_ptr<Table>> tables;
+
+		std::size_t hash = std::hash<String>()(string);
+		std::size_t slot;
+
+		if (const Table* table = currentTable.load(std::memory_order_acquire))
+		{
+			if (const Entry* entry = table->Find(string, hash, &slot))
+				return entry;
+		}
+
+		if (!insert)
+			return nullptr;
+
+		LockGuard lock(mutex);
+
+		// Another thread may have interned the string in the meantime
+		Table* table = currentTable.load(std::memory_order_relaxed);
+		if (table)
+		{
+			if (const Entry* entry = table->Find(string, hash, &slot))
+				return entry;
+		}
+
+		if (!table || (table->count + 1) * 2 > table->mask + 1)
+		{
+			std::unique_ptr<Table> newTable(new Table((table) ? (table->mask + 1) * 2 : 256));
+			for (const auto& entry : entries)
+			{
+				std::size_t entrySlot;
+				newTable->Find(entry->string, entry->hash, &entrySlot);
+				newTable->slots[entrySlot].store(entry.get(), std::memory_order_relaxed);
+			}
+			newTable->count = entries.size();
+
+			table = newTable.get();
+			tables.emplace_back(std::move(newTable));
+
+			table->Find(string, hash, &slot);
+			currentTable.store(table, std::memory_order_release);
+		}
+
+		entries.emplace_back(new Entry{string, hash});
+		table->slots[slot].store(entries.back().get(), std::memory_order_release);
+		table->count++;
+
+		return entries.back().get();
+	}
+
+	const StringAtom::Entry StringAtom::s_emptyEntry = {String(), std::hash<String>()(String())};
+}
@@ -0,0 +1,560 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/StringImpl.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <cstring>
+
+// SSE2 is part of x86-64, AVX2 kernels are compiled separately and only used if the processor supports them
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NAZARA_STRINGIMPL_SIMD
+
+	#include <emmintrin.h>
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG)
+		#define NAZARA_STRINGIMPL_AVX2 __attribute__((target("avx2")))
+	#else
+		#define NAZARA_STRINGIMPL_AVX2
+	#endif
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		inline char ToLowerAscii(char character)
+		{
+			return (character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character;
+		}
+
+		inline char ToUpperAscii(char character)
+		{
+			return (character >= 'a' && character <= 'z') ? character + ('A' - 'a') : character;
+		}
+
+		inline bool IsUtf8Continuation(char character)
+		{
+			return (static_cast<unsigned char>(character) & 0xC0) == 0x80;
+		}
+
+		bool EqualsCaseInsensitive(const char* first, const char* second, std::size_t length)
+		{
+			for (std::size_t i = 0; i < length; ++i)
+			{
+				if (ToLowerAscii(first[i]) != ToLowerAscii(second[i]))
+					return false;
+			}
+
+			return true;
+		}
+
+		/********************************** Scalar **********************************/
+
+		std::size_t CountCharactersScalar(const char* begin, const char* end, char first, char second)
+		{
+			std::size_t count = 0;
+			for (; begin != end; ++begin)
+			{
+				if (*begin == first || *begin == second)
+					count++;
+			}
+
+			return count;
+		}
+
+		const char* FindCharactersScalar(const char* begin, const char* end, char first, char second)
+		{
+			if (first == second)
+			{
+				const void* ptr = std::memchr(begin, first, end - begin);
+				return (ptr) ? static_cast<const char*>(ptr) : end;
+			}
+
+			for (; begin != end; ++begin)
+			{
+				if (*begin == first || *begin == second)
+					break;
+			}
+
+			return begin;
+		}
+
+		const char* FindNonAsciiScalar(const char* begin, const char* end)
+		{
+			for (; begin != end; ++begin)
+			{
+				if (static_cast<unsigned char>(*begin) >= 0x80)
+					break;
+			}
+
+			return begin;
+		}
+
+		const char* FindStringScalar(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive)
+		{
+			if (static_cast<std::size_t>(end - begin) < length)
+				return end;
+
+			const char* lastStart = end - length;
+			if (caseInsensitive)
+			{
+				for (const char* ptr = begin; ptr <= lastStart; ++ptr)
+				{
+					if (EqualsCaseInsensitive(ptr, string, length))
+						return ptr;
+				}
+			}
+			else
+			{
+				for (const char* ptr = begin; ptr <= lastStart; ++ptr)
+				{
+					ptr = static_cast<const char*>(std::memchr(ptr, string[0], lastStart - ptr + 1));
+					if (!ptr)
+						break;
+
+					if (std::memcmp(ptr + 1, string + 1, length - 1) == 0)
+						return ptr;
+				}
+			}
+
+			return end;
+		}
+
+		std::size_t GetUtf8LengthScalar(const char* begin, const char* end)
+		{
+			std::size_t length = 0;
+			for (; begin != end; ++begin)
+			{
+				if (!IsUtf8Continuation(*begin))
+					length++;
+			}
+
+			return length;
+		}
+
+		void ToLowerScalar(const char* source, char* destination, std::size_t size)
+		{
+			for (std::size_t i = 0; i < size; ++i)
+				destination[i] = ToLowerAscii(source[i]);
+		}
+
+		void ToUpperScalar(const char* source, char* destination, std::size_t size)
+		{
+			for (std::size_t i = 0; i < size; ++i)
+				destination[i] = ToUpperAscii(source[i]);
+		}
+
+		#ifdef NAZARA_STRINGIMPL_SIMD
+		inline unsigned int FindFirstBit(UInt32 mask)
+		{
+			return IntegralLog2Pot(mask & (~mask + 1));
+		}
+
+		/********************************** SSE2 **********************************/
+
+		inline std::size_t SumBytes(__m128i counters)
+		{
+			__m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+			return static_cast<std::size_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+		}
+
+		std::size_t CountCharactersSSE2(const char* begin, const char* end, char first, char second)
+		{
+			const __m128i firstMask = _mm_set1_epi8(first);
+			const __m128i secondMask = _mm_set1_epi8(second);
+
+			std::size_t count = 0;
+			while (end - begin >= 16)
+			{
+				// Each byte of the counters can be incremented at most 255 times before overflowing
+				std::size_t blockCount = std::min<std::size_t>((end - begin) / 16, 255);
+
+				__m128i counters = _mm_setzero_si128();
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+					__m128i matches = _mm_or_si128(_mm_cmpeq_epi8(block, firstMask), _mm_cmpeq_epi8(block, secondMask));
+					counters = _mm_sub_epi8(counters, matches); // Matches are 0xFF, which is -1
+
+					begin += 16;
+				}
+
+				count += SumBytes(counters);
+			}
+
+			return count + CountCharactersScalar(begin, end, first, second);
+		}
+
+		const char* FindCharactersSSE2(const char* begin, const char* end, char first, char second)
+		{
+			const __m128i firstMask = _mm_set1_epi8(first);
+			const __m128i secondMask = _mm_set1_epi8(second);
+
+			for (; end - begin >= 16; begin += 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+				UInt32 mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, firstMask), _mm_cmpeq_epi8(block, secondMask)));
+				if (mask)
+					return begin + FindFirstBit(mask);
+			}
+
+			return FindCharactersScalar(begin, end, first, second);
+		}
+
+		const char* FindNonAsciiSSE2(const char* begin, const char* end)
+		{
+			for (; end - begin >= 16; begin += 16)
+			{
+				// The sign bit of each byte is set for anything which is not ASCII
+				UInt32 mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin)));
+				if (mask)
+					return begin + FindFirstBit(mask);
+			}
+
+			return FindNonAsciiScalar(begin, end);
+		}
+
+		const char* FindStringSSE2(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive)
+		{
+			// Candidates are positions where both the first and the last character of the string match
+			// http://0x80.pl/articles/simd-strfind.html
+			char firstCharacter = string[0];
+			char lastCharacter = string[length - 1];
+
+			const __m128i firstLower = _mm_set1_epi8((caseInsensitive) ? ToLowerAscii(firstCharacter) : firstCharacter);
+			const __m128i firstUpper = _mm_set1_epi8((caseInsensitive) ? ToUpperAscii(firstCharacter) : firstCharacter);
+			const __m128i lastLower = _mm_set1_epi8((caseInsensitive) ? ToLowerAscii(lastCharacter) : lastCharacter);
+			const __m128i lastUpper = _mm_set1_epi8((caseInsensitive) ? ToUpperAscii(lastCharacter) : lastCharacter);
+
+			for (; static_cast<std::size_t>(end - begin) >= length + 15; begin += 16)
+			{
+				__m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+				__m128i lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + length - 1));
+
+				__m128i firstMatches = _mm_or_si128(_mm_cmpeq_epi8(firstBlock, firstLower), _mm_cmpeq_epi8(firstBlock, firstUpper));
+				__m128i lastMatches = _mm_or_si128(_mm_cmpeq_epi8(lastBlock, lastLower), _mm_cmpeq_epi8(lastBlock, lastUpper));
+
+				UInt32 mask = _mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches));
+				while (mask)
+				{
+					const char* candidate = begin + FindFirstBit(mask);
+					if (caseInsensitive)
+					{
+						if (EqualsCaseInsensitive(candidate, string, length))
+							return candidate;
+					}
+					else if (std::memcmp(candidate + 1, string + 1, length - 1) == 0)
+						return candidate;
+
+					mask &= mask - 1;
+				}
+			}
+
+			return FindStringScalar(begin, end, string, length, caseInsensitive);
+		}
+
+		std::size_t GetUtf8LengthSSE2(const char* begin, const char* end)
+		{
+			// Continuation bytes (0x80 to 0xBF) are the only ones lower or equal to -65 as signed bytes
+			const __m128i continuationLimit = _mm_set1_epi8(-65);
+
+			std::size_t length = 0;
+			while (end - begin >= 16)
+			{
+				std::size_t blockCount = std::min<std::size_t>((end - begin) / 16, 255);
+
+				__m128i counters = _mm_setzero_si128();
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+					counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, continuationLimit));
+
+					begin += 16;
+				}
+
+				length += SumBytes(counters);
+			}
+
+			return length + GetUtf8LengthScalar(begin, end);
+		}
+
+		void ChangeCaseSSE2(const char* source, char* destination, std::size_t size, char firstLetter)
+		{
+			// Letters are moved to the [-128, -103] range so a single signed comparison finds them, their case is then flipped
+			const __m128i offset = _mm_set1_epi8(static_cast<char>(128 - firstLetter));
+			const __m128i limit = _mm_set1_epi8(-128 + 26);
+			const __m128i caseBit = _mm_set1_epi8(0x20);
+
+			for (; size >= 16; size -= 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+				__m128i letters = _mm_cmplt_epi8(_mm_add_epi8(block, offset), limit);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_xor_si128(block, _mm_and_si128(letters, caseBit)));
+
+				source += 16;
+				destination += 16;
+			}
+
+			if (firstLetter == 'A')
+				ToLowerScalar(source, destination, size);
+			else
+				ToUpperScalar(source, destination, size);
+		}
+
+		void ToLowerSSE2(const char* source, char* destination, std::size_t size)
+		{
+			ChangeCaseSSE2(source, destination, size, 'A');
+		}
+
+		void ToUpperSSE2(const char* source, char* destination, std::size_t size)
+		{
+			ChangeCaseSSE2(source, destination, size, 'a');
+		}
+
+		/********************************** AVX2 **********************************/
+
+		NAZARA_STRINGIMPL_AVX2 std::size_t SumBytesAVX2(__m256i counters)
+		{
+			__m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+			__m128i halfSums = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+
+			return static_cast<std::size_t>(_mm_cvtsi128_si32(halfSums) + _mm_extract_epi16(halfSums, 4));
+		}
+
+		NAZARA_STRINGIMPL_AVX2 std::size_t CountCharactersAVX2(const char* begin, const char* end, char first, char second)
+		{
+			const __m256i firstMask = _mm256_set1_epi8(first);
+			const __m256i secondMask = _mm256_set1_epi8(second);
+
+			std::size_t count = 0;
+			while (end - begin >= 32)
+			{
+				std::size_t blockCount = std::min<std::size_t>((end - begin) / 32, 255);
+
+				__m256i counters = _mm256_setzero_si256();
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+					__m256i matches = _mm256_or_si256(_mm256_cmpeq_epi8(block, firstMask), _mm256_cmpeq_epi8(block, secondMask));
+					counters = _mm256_sub_epi8(counters, matches);
+
+					begin += 32;
+				}
+
+				count += SumBytesAVX2(counters);
+			}
+
+			return count + CountCharactersSSE2(begin, end, first, second);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 const char* FindCharactersAVX2(const char* begin, const char* end, char first, char second)
+		{
+			const __m256i firstMask = _mm256_set1_epi8(first);
+			const __m256i secondMask = _mm256_set1_epi8(second);
+
+			for (; end - begin >= 32; begin += 32)
+			{
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+				UInt32 mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, firstMask), _mm256_cmpeq_epi8(block, secondMask)));
+				if (mask)
+					return begin + FindFirstBit(mask);
+			}
+
+			return FindCharactersSSE2(begin, end, first, second);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 const char* FindNonAsciiAVX2(const char* begin, const char* end)
+		{
+			for (; end - begin >= 32; begin += 32)
+			{
+				UInt32 mask = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)));
+				if (mask)
+					return begin + FindFirstBit(mask);
+			}
+
+			return FindNonAsciiSSE2(begin, end);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 const char* FindStringAVX2(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive)
+		{
+			char firstCharacter = string[0];
+			char lastCharacter = string[length - 1];
+
+			const __m256i firstLower = _mm256_set1_epi8((caseInsensitive) ? ToLowerAscii(firstCharacter) : firstCharacter);
+			const __m256i firstUpper = _mm256_set1_epi8((caseInsensitive) ? ToUpperAscii(firstCharacter) : firstCharacter);
+			const __m256i lastLower = _mm256_set1_epi8((caseInsensitive) ? ToLowerAscii(lastCharacter) : lastCharacter);
+			const __m256i lastUpper = _mm256_set1_epi8((caseInsensitive) ? ToUpperAscii(lastCharacter) : lastCharacter);
+
+			for (; static_cast<std::size_t>(end - begin) >= length + 31; begin += 32)
+			{
+				__m256i firstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+				__m256i lastBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + length - 1));
+
+				__m256i firstMatches = _mm256_or_si256(_mm256_cmpeq_epi8(firstBlock, firstLower), _mm256_cmpeq_epi8(firstBlock, firstUpper));
+				__m256i lastMatches = _mm256_or_si256(_mm256_cmpeq_epi8(lastBlock, lastLower), _mm256_cmpeq_epi8(lastBlock, lastUpper));
+
+				UInt32 mask = _mm256_movemask_epi8(_mm256_and_si256(firstMatches, lastMatches));
+				while (mask)
+				{
+					const char* candidate = begin + FindFirstBit(mask);
+					if (caseInsensitive)
+					{
+						if (EqualsCaseInsensitive(candidate, string, length))
+							return candidate;
+					}
+					else if (std::memcmp(candidate + 1, string + 1, length - 1) == 0)
+						return candidate;
+
+					mask &= mask - 1;
+				}
+			}
+
+			return FindStringSSE2(begin, end, string, length, caseInsensitive);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 std::size_t GetUtf8LengthAVX2(const char* begin, const char* end)
+		{
+			const __m256i continuationLimit = _mm256_set1_epi8(-65);
+
+			std::size_t length = 0;
+			while (end - begin >= 32)
+			{
+				std::size_t blockCount = std::min<std::size_t>((end - begin) / 32, 255);
+
+				__m256i counters = _mm256_setzero_si256();
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+					counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(block, continuationLimit));
+
+					begin += 32;
+				}
+
+				length += SumBytesAVX2(counters);
+			}
+
+			return length + GetUtf8LengthSSE2(begin, end);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 void ChangeCaseAVX2(const char* source, char* destination, std::size_t size, char firstLetter)
+		{
+			const __m256i offset = _mm256_set1_epi8(static_cast<char>(128 - firstLetter));
+			const __m256i limit = _mm256_set1_epi8(-128 + 26);
+			const __m256i caseBit = _mm256_set1_epi8(0x20);
+
+			for (; size >= 32; size -= 32)
+			{
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+				__m256i letters = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, offset));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), _mm256_xor_si256(block, _mm256_and_si256(letters, caseBit)));
+
+				source += 32;
+				destination += 32;
+			}
+
+			ChangeCaseSSE2(source, destination, size, firstLetter);
+		}
+
+		NAZARA_STRINGIMPL_AVX2 void ToLowerAVX2(const char* source, char* destination, std::size_t size)
+		{
+			ChangeCaseAVX2(source, destination, size, 'A');
+		}
+
+		NAZARA_STRINGIMPL_AVX2 void ToUpperAVX2(const char* source, char* destination, std::size_t size)
+		{
+			ChangeCaseAVX2(source, destination, size, 'a');
+		}
+		#endif
+
+		struct Kernels
+		{
+			std::size_t (*countCharacters)(const char* begin, const char* end, char first, char second);
+			const char* (*findCharacters)(const char* begin, const char* end, char first, char second);
+			const char* (*findNonAscii)(const char* begin, const char* end);
+			const char* (*findString)(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive);
+			std::size_t (*getUtf8Length)(const char* begin, const char* end);
+			void (*toLower)(const char* source, char* destination, std::size_t size);
+			void (*toUpper)(const char* source, char* destination, std::size_t size);
+		};
+
+		Kernels SelectKernels()
+		{
+			Kernels kernels = {CountCharactersScalar, FindCharactersScalar, FindNonAsciiScalar, FindStringScalar, GetUtf8LengthScalar, ToLowerScalar, ToUpperScalar};
+
+			#ifdef NAZARA_STRINGIMPL_SIMD
+			if (HardwareInfo::Initialize())
+			{
+				if (HardwareInfo::HasCapability(ProcessorCap_AVX2))
+					kernels = {CountCharactersAVX2, FindCharactersAVX2, FindNonAsciiAVX2, FindStringAVX2, GetUtf8LengthAVX2, ToLowerAVX2, ToUpperAVX2};
+				else if (HardwareInfo::HasCapability(ProcessorCap_SSE2))
+					kernels = {CountCharactersSSE2, FindCharactersSSE2, FindNonAsciiSSE2, FindStringSSE2, GetUtf8LengthSSE2, ToLowerSSE2, ToUpperSSE2};
+			}
+			#endif
+
+			return kernels;
+		}
+
+		const Kernels& GetKernels()
+		{
+			static Kernels kernels = SelectKernels();
+			return kernels;
+		}
+	}
+
+	std::size_t StringImpl::CountCharacters(const char* begin, const char* end, char first, char second)
+	{
+		return GetKernels().countCharacters(begin, end, first, second);
+	}
+
+	const char* StringImpl::FindCharacters(const char* begin, const char* end, char first, char second)
+	{
+		return GetKernels().findCharacters(begin, end, first, second);
+	}
+
+	const char* StringImpl::FindNonAscii(const char* begin, const char* end)
+	{
+		return GetKernels().findNonAscii(begin, end);
+	}
+
+	const char* StringImpl::FindString(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive)
+	{
+		///DOC: The case insensitive search only folds ASCII letters
+		if (length == 0)
+			return begin;
+
+		if (length == 1)
+		{
+			if (caseInsensitive)
+				return GetKernels().findCharacters(begin, end, ToLowerAscii(string[0]), ToUpperAscii(string[0]));
+			else
+				return GetKernels().findCharacters(begin, end, string[0], string[0]);
+		}
+
+		return GetKernels().findString(begin, end, string, length, caseInsensitive);
+	}
+
+	std::size_t StringImpl::GetUtf8Length(const char* begin, const char* end)
+	{
+		///DOC: Counts the bytes which are not continuation bytes, the string is not validated
+		return GetKernels().getUtf8Length(begin, end);
+	}
+
+	void StringImpl::ToLower(const char* source, char* destination, std::size_t size)
+	{
+		///DOC: Only ASCII letters are converted, source and destination may be the same buffer
+		GetKernels().toLower(source, destination, size);
+	}
+
+	void StringImpl::ToUpper(const char* source, char* destination, std::size_t size)
+	{
+		GetKernels().toUpper(source, destination, size);
+	}
+}
@@ -0,0 +1,33 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STRINGIMPL_HPP
+#define NAZARA_STRINGIMPL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <cstddef>
+
+namespace Nz
+{
+	// Byte-level kernels used by String, the SSE2/AVX2 versions are selected at runtime
+	// Ranges are [begin, end[, searches return end when nothing was found
+	class StringImpl
+	{
+		public:
+			StringImpl() = delete;
+			~StringImpl() = delete;
+
+			static std::size_t CountCharacters(const char* begin, const char* end, char first, char second);
+			static const char* FindCharacters(const char* begin, const char* end, char first, char second);
+			static const char* FindNonAscii(const char* begin, const char* end);
+			static const char* FindString(const char* begin, const char* end, const char* string, std::size_t length, bool caseInsensitive);
+			static std::size_t GetUtf8Length(const char* begin, const char* end);
+			static void ToLower(const char* source, char* destination, std::size_t size);
+			static void ToUpper(const char* source, char* destination, std::size_t size);
+	};
+}
+
+#endif // NAZARA_STRINGIMPL_HPP
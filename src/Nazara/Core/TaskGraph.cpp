@@ -0,0 +1,218 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskGraph.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	void TaskGraph::AddDependency(TaskId task, TaskId dependency)
+	{
+		NazaraAssert(task < m_nodes.size(), "Invalid task");
+		NazaraAssert(dependency < m_nodes.size(), "Invalid dependency");
+
+		#if NAZARA_CORE_SAFE
+		if (task == dependency)
+		{
+			NazaraError("A task cannot depend on itself");
+			return;
+		}
+		#endif
+
+		Node& node = *m_nodes[task];
+		if (std::find(node.dependencies.begin(), node.dependencies.end(), dependency) != node.dependencies.end())
+			return;
+
+		node.dependencies.push_back(dependency);
+		m_nodes[dependency]->successors.push_back(task);
+
+		m_executionOrderUpdated = false;
+	}
+
+	void TaskGraph::Clear()
+	{
+		NazaraAssert(m_counter.IsDone(), "Graph is being executed");
+
+		m_criticalPath.clear();
+		m_criticalPathTime = 0;
+		m_executionOrder.clear();
+		m_executionOrderUpdated = false;
+		m_executionTime = 0;
+		m_nodes.clear();
+	}
+
+	bool TaskGraph::Execute()
+	{
+		///DOC: The graph can be executed again once this returns
+		if (!BuildExecutionOrder())
+		{
+			NazaraError("Task graph contains a cycle");
+			return false;
+		}
+
+		if (m_nodes.empty())
+			return true;
+
+		if (!TaskScheduler::Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return false;
+		}
+
+		for (const auto& node : m_nodes)
+			node->remainingDependencies.store(static_cast<unsigned int>(node->dependencies.size()), std::memory_order_relaxed);
+
+		UInt64 startTime = GetElapsedMicroseconds();
+
+		for (TaskId i = 0; i < m_nodes.size(); ++i)
+		{
+			if (m_nodes[i]->dependencies.empty())
+				TaskScheduler::Submit(m_counter, [this, i]() { RunNode(i); });
+		}
+
+		TaskScheduler::WaitForTasks(m_counter);
+
+		m_executionTime = GetElapsedMicroseconds() - startTime;
+
+		ComputeCriticalPath();
+
+		return true;
+	}
+
+	const std::vector<TaskGraph::TaskId>& TaskGraph::GetCriticalPath() const
+	{
+		return m_criticalPath;
+	}
+
+	UInt64 TaskGraph::GetCriticalPathTime() const
+	{
+		///DOC: Sum of the execution times (in microseconds) of the critical path tasks during the last execution
+		return m_criticalPathTime;
+	}
+
+	UInt64 TaskGraph::GetExecutionTime() const
+	{
+		return m_executionTime;
+	}
+
+	std::size_t TaskGraph::GetTaskCount() const
+	{
+		return m_nodes.size();
+	}
+
+	UInt64 TaskGraph::GetTaskTime(TaskId task) const
+	{
+		NazaraAssert(task < m_nodes.size(), "Invalid task");
+
+		const Node& node = *m_nodes[task];
+		return node.endTime - node.startTime;
+	}
+
+	TaskGraph::TaskId TaskGraph::AddNode(Functor* functor)
+	{
+		std::unique_ptr<Node> node(new Node);
+		node->functor.reset(functor);
+		node->endTime = 0;
+		node->remainingDependencies = 0;
+		node->startTime = 0;
+
+		m_nodes.emplace_back(std::move(node));
+		m_executionOrderUpdated = false;
+
+		return m_nodes.size() - 1;
+	}
+
+	bool TaskGraph::BuildExecutionOrder()
+	{
+		if (m_executionOrderUpdated)
+			return true;
+
+		// Kahn's algorithm, any task left out of the order is part of a cycle
+		std::vector<std::size_t> dependencyCount(m_nodes.size());
+
+		m_executionOrder.clear();
+		m_executionOrder.reserve(m_nodes.size());
+
+		for (TaskId i = 0; i < m_nodes.size(); ++i)
+		{
+			dependencyCount[i] = m_nodes[i]->dependencies.size();
+			if (dependencyCount[i] == 0)
+				m_executionOrder.push_back(i);
+		}
+
+		for (std::size_t i = 0; i < m_executionOrder.size(); ++i)
+		{
+			for (TaskId successor : m_nodes[m_executionOrder[i]]->successors)
+			{
+				if (--dependencyCount[successor] == 0)
+					m_executionOrder.push_back(successor);
+			}
+		}
+
+		if (m_executionOrder.size() != m_nodes.size())
+			return false;
+
+		m_executionOrderUpdated = true;
+		return true;
+	}
+
+	void TaskGraph::ComputeCriticalPath()
+	{
+		// Longest path through the graph, weighted by the time each task took
+		std::vector<UInt64> pathTimes(m_nodes.size());
+		std::vector<TaskId> previousTasks(m_nodes.size());
+
+		TaskId lastTask = m_executionOrder.front();
+		for (TaskId task : m_executionOrder)
+		{
+			const Node& node = *m_nodes[task];
+
+			UInt64 longestDependency = 0;
+			previousTasks[task] = task;
+			for (TaskId dependency : node.dependencies)
+			{
+				if (pathTimes[dependency] >= longestDependency)
+				{
+					longestDependency = pathTimes[dependency];
+					previousTasks[task] = dependency;
+				}
+			}
+
+			pathTimes[task] = longestDependency + (node.endTime - node.startTime);
+			if (pathTimes[task] >= pathTimes[lastTask])
+				lastTask = task;
+		}
+
+		m_criticalPathTime = pathTimes[lastTask];
+
+		m_criticalPath.clear();
+		for (TaskId task = lastTask; ; task = previousTasks[task])
+		{
+			m_criticalPath.push_back(task);
+			if (previousTasks[task] == task)
+				break;
+		}
+		std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+	}
+
+	void TaskGraph::RunNode(TaskId task)
+	{
+		Node& node = *m_nodes[task];
+
+		node.startTime = GetElapsedMicroseconds();
+		node.functor->Run();
+		node.endTime = GetElapsedMicroseconds();
+
+		// Release the successors whose dependencies are now all done, they are submitted before
+		// this task completes so the graph counter cannot reach zero in between
+		for (TaskId successor : node.successors)
+		{
+			if (m_nodes[successor]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				TaskScheduler::Submit(m_counter, [this, successor]() { RunNode(successor); });
+		}
+	}
+}
@@ -5,25 +5,30 @@
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
-
-#if defined(NAZARA_PLATFORM_WINDOWS)
-	#include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
-#elif defined(NAZARA_PLATFORM_POSIX)
-	#include <Nazara/Core/Posix/TaskSchedulerImpl.hpp>
-#else
-	#error Lack of implementation: Task Scheduler
-#endif
-
+#include <Nazara/Core/TaskSchedulerImpl.hpp>
+#include <vector>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
 	namespace
 	{
-		std::vector<Functor*> s_pendingWorks;
+		std::vector<TaskSchedulerImpl::Task*> s_pendingWorks;
 		unsigned int s_workerCount = 0;
 	}
 
+	void TaskScheduler::Dispatch(Functor* functor, unsigned int count, Counter& counter)
+	{
+		///DOC: The functor is not deleted by the scheduler and must outlive the counter
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		TaskSchedulerImpl::RunShared(functor, count, &counter);
+	}
+
 	unsigned int TaskScheduler::GetWorkerCount()
 	{
 		return (s_workerCount > 0) ? s_workerCount : HardwareInfo::GetProcessorCount();
@@ -44,7 +49,23 @@ namespace Nz
 
 		if (!s_pendingWorks.empty())
 		{
-			TaskSchedulerImpl::Run(&s_pendingWorks[0], s_pendingWorks.size());
+			TaskSchedulerImpl::Run(&s_pendingWorks[0], s_pendingWorks.size(), nullptr);
+			s_pendingWorks.clear();
+		}
+	}
+
+	void TaskScheduler::Run(Counter& counter)
+	{
+		///DOC: Every pending task is attached to the counter, which can then be waited on with WaitForTasks(counter)
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		if (!s_pendingWorks.empty())
+		{
+			TaskSchedulerImpl::Run(&s_pendingWorks[0], s_pendingWorks.size(), &counter);
 			s_pendingWorks.clear();
 		}
 	}
@@ -79,14 +100,44 @@ namespace Nz
 		TaskSchedulerImpl::WaitForTasks();
 	}
 
-	void TaskScheduler::AddTaskFunctor(Functor* taskFunctor)
+	void TaskScheduler::WaitForTasks(const Counter& counter)
+	{
+		///DOC: The calling thread helps executing tasks until the counter reaches zero
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		TaskSchedulerImpl::WaitForCounter(counter);
+	}
+
+	void TaskScheduler::AddPendingTask(Task* task)
+	{
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			TaskSchedulerImpl::FreeTask(task);
+			return;
+		}
+
+		s_pendingWorks.push_back(task);
+	}
+
+	TaskScheduler::Task* TaskScheduler::AllocateTask(std::size_t functorSize, void** functorStorage)
+	{
+		return TaskSchedulerImpl::AllocateTask(functorSize, functorStorage);
+	}
+
+	void TaskScheduler::SubmitTask(Task* task, Counter& counter)
 	{
 		if (!Initialize())
 		{
 			NazaraError("Failed to initialize Task Scheduler");
+			TaskSchedulerImpl::FreeTask(task);
 			return;
 		}
 
-		s_pendingWorks.push_back(taskFunctor);
+		TaskSchedulerImpl::Run(&task, 1, &counter);
 	}
 }
@@ -0,0 +1,632 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskSchedulerImpl.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Functors too big to be stored inline in the task but no bigger than this use a pooled block
+		constexpr std::size_t s_functorBlockSize = 512;
+
+		// Number of failed fetch attempts before a worker goes to sleep
+		constexpr unsigned int s_spinCount = 64;
+
+		thread_local UInt32 s_randomState = 0;
+
+		UInt32 NextRandom()
+		{
+			// xorshift32, only used to pick steal victims
+			UInt32 x = s_randomState;
+			if (x == 0)
+				x = (0x9E3779B9U ^ static_cast<UInt32>(reinterpret_cast<std::uintptr_t>(&s_randomState))) | 1U;
+
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			s_randomState = x;
+
+			return x;
+		}
+	}
+
+	// Chase-Lev work-stealing deque ("Correct and Efficient Work-Stealing for Weak Memory Models", Lê et al.)
+	// The owner pushes and pops at the bottom, thieves steal from the top
+	class TaskSchedulerImpl::TaskQueue
+	{
+		public:
+			TaskQueue() :
+			m_top(0),
+			m_bottom(0)
+			{
+				m_buffers.emplace_back(new Buffer(256));
+				m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+			}
+
+			bool IsEmpty() const
+			{
+				Int64 top = m_top.load(std::memory_order_relaxed);
+				Int64 bottom = m_bottom.load(std::memory_order_relaxed);
+
+				return bottom <= top;
+			}
+
+			Task* Pop()
+			{
+				Int64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+				Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+				m_bottom.store(bottom, std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				Int64 top = m_top.load(std::memory_order_relaxed);
+				if (top > bottom)
+				{
+					// Empty queue
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				Task* task = buffer->Get(bottom);
+				if (top == bottom)
+				{
+					// Last task, we're racing against the thieves for it
+					if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						task = nullptr;
+
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+
+				return task;
+			}
+
+			void Push(Task* task)
+			{
+				Int64 bottom = m_bottom.load(std::memory_order_relaxed);
+				Int64 top = m_top.load(std::memory_order_acquire);
+				Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+				if (bottom - top > buffer->mask)
+					buffer = Grow(buffer, top, bottom);
+
+				buffer->Set(bottom, task);
+				m_bottom.store(bottom + 1, std::memory_order_release); //< Publishes the task to the thieves
+			}
+
+			bool Steal(Task** task)
+			{
+				///DOC: Returns false if the steal failed because of a concurrent access (and should be retried)
+				Int64 top = m_top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				Int64 bottom = m_bottom.load(std::memory_order_acquire);
+
+				*task = nullptr;
+				if (top < bottom)
+				{
+					Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+					Task* stolenTask = buffer->Get(top);
+					if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						return false;
+
+					*task = stolenTask;
+				}
+
+				return true;
+			}
+
+		private:
+			struct Buffer
+			{
+				Buffer(Int64 capacity) :
+				mask(capacity - 1),
+				tasks(new std::atomic<Task*>[capacity])
+				{
+				}
+
+				Task* Get(Int64 index) const
+				{
+					return tasks[index & mask].load(std::memory_order_relaxed);
+				}
+
+				void Set(Int64 index, Task* task)
+				{
+					tasks[index & mask].store(task, std::memory_order_relaxed);
+				}
+
+				Int64 mask;
+				std::unique_ptr<std::atomic<Task*>[]> tasks;
+			};
+
+			Buffer* Grow(Buffer* buffer, Int64 top, Int64 bottom)
+			{
+				// Thieves may still be reading the old buffer, it is only released with the queue
+				m_buffers.emplace_back(new Buffer((buffer->mask + 1) * 2));
+
+				Buffer* newBuffer = m_buffers.back().get();
+				for (Int64 i = top; i < bottom; ++i)
+					newBuffer->Set(i, buffer->Get(i));
+
+				m_buffer.store(newBuffer, std::memory_order_release);
+
+				return newBuffer;
+			}
+
+			std::atomic<Int64> m_top;
+			UInt8 m_padding[64]; //< Keeps top and bottom on different cache lines
+			std::atomic<Int64> m_bottom;
+			std::atomic<Buffer*> m_buffer;
+			std::vector<std::unique_ptr<Buffer>> m_buffers;
+	};
+
+	struct TaskSchedulerImpl::Worker
+	{
+		TaskQueue queue;
+		Thread thread;
+		unsigned int id;
+	};
+
+	TaskSchedulerImpl::Task* TaskSchedulerImpl::AllocateTask(std::size_t functorSize, void** functorStorage)
+	{
+		///DOC: The functor must then be constructed in the returned storage and assigned to the task
+		Task* task = s_taskPool.New<Task>();
+		task->counter = nullptr;
+		task->functor = nullptr;
+		task->next = nullptr;
+
+		if (functorSize <= Task::InlineStorageSize)
+		{
+			task->functorBlock = nullptr;
+			task->functorLocation = Task::FunctorLocation_Inline;
+			*functorStorage = &task->inlineStorage;
+		}
+		else if (functorSize <= s_functorBlockSize)
+		{
+			task->functorBlock = s_functorPool.Allocate();
+			task->functorLocation = Task::FunctorLocation_Pool;
+			*functorStorage = task->functorBlock;
+		}
+		else
+		{
+			task->functorBlock = OperatorNew(functorSize);
+			task->functorLocation = Task::FunctorLocation_Heap;
+			*functorStorage = task->functorBlock;
+		}
+
+		return task;
+	}
+
+	void TaskSchedulerImpl::FreeTask(Task* task)
+	{
+		if (task->functorLocation != Task::FunctorLocation_External)
+			task->functor->~Functor();
+
+		switch (task->functorLocation)
+		{
+			case Task::FunctorLocation_External:
+			case Task::FunctorLocation_Inline:
+				break;
+
+			case Task::FunctorLocation_Heap:
+				OperatorDelete(task->functorBlock);
+				break;
+
+			case Task::FunctorLocation_Pool:
+				s_functorPool.Free(task->functorBlock);
+				break;
+		}
+
+		s_taskPool.Free(task);
+	}
+
+	bool TaskSchedulerImpl::Initialize(unsigned int workerCount)
+	{
+		if (IsInitialized())
+			return true; // Déjà initialisé
+
+		#if NAZARA_CORE_SAFE
+		if (workerCount == 0)
+		{
+			NazaraError("Invalid worker count ! (0)");
+			return false;
+		}
+		#endif
+
+		s_shouldFinish = false;
+		s_injectedTaskCount = 0;
+		s_sleepingWorkers = 0;
+		s_waitingThreads = 0;
+
+		s_workers.reset(new Worker[workerCount]);
+		s_workerCount = workerCount;
+
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			Worker& worker = s_workers[i];
+			worker.id = i;
+			worker.thread = Thread(WorkerProc, &worker);
+		}
+
+		return true;
+	}
+
+	bool TaskSchedulerImpl::IsInitialized()
+	{
+		return s_workerCount > 0;
+	}
+
+	void TaskSchedulerImpl::Run(Task** tasks, std::size_t count, TaskScheduler::Counter* counter)
+	{
+		if (count == 0)
+			return;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			tasks[i]->counter = counter;
+			tasks[i]->next = (i + 1 < count) ? tasks[i + 1] : nullptr;
+		}
+
+		Submit(tasks[0], tasks[count - 1], count, counter);
+	}
+
+	void TaskSchedulerImpl::RunShared(Functor* functor, std::size_t count, TaskScheduler::Counter* counter)
+	{
+		if (count == 0)
+			return;
+
+		Task* firstTask = nullptr;
+		Task* lastTask = nullptr;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			void* functorStorage;
+			Task* task = AllocateTask(0, &functorStorage);
+			task->counter = counter;
+			task->functor = functor;
+			task->functorLocation = Task::FunctorLocation_External;
+
+			if (lastTask)
+				lastTask->next = task;
+			else
+				firstTask = task;
+
+			lastTask = task;
+		}
+
+		Submit(firstTask, lastTask, count, counter);
+	}
+
+	void TaskSchedulerImpl::Uninitialize()
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (s_workerCount == 0)
+		{
+			NazaraError("Task scheduler is not initialized");
+			return;
+		}
+		#endif
+
+		// On réveille les threads pour qu'ils sortent de la boucle et terminent.
+		s_idleMutex.Lock();
+		s_shouldFinish = true;
+		s_idleCondition.SignalAll();
+		s_idleMutex.Unlock();
+
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+			s_workers[i].thread.Join();
+
+		// Tasks which were never started are released without being run
+		// Their counters are decremented all the same, threads waiting for them would never wake up otherwise
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+		{
+			while (Task* task = s_workers[i].queue.Pop())
+				DiscardTask(task);
+		}
+
+		s_injectionMutex.Lock();
+		while (s_injectedTasksHead)
+		{
+			Task* task = s_injectedTasksHead;
+			s_injectedTasksHead = task->next;
+
+			DiscardTask(task);
+		}
+
+		s_injectedTasksTail = nullptr;
+		s_injectedTaskCount = 0;
+		s_injectionMutex.Unlock();
+
+		s_globalCounter.m_pendingTasks = 0;
+
+		{
+			LockGuard lock(s_doneMutex);
+			s_doneCondition.SignalAll();
+		}
+
+		s_workers.reset();
+		s_workerCount = 0;
+	}
+
+	void TaskSchedulerImpl::WaitForCounter(const TaskScheduler::Counter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			// Rather than sleeping, the waiting thread helps the workers
+			Task* task = FetchTask(s_currentWorker);
+			if (task)
+			{
+				Execute(task);
+				continue;
+			}
+
+			// Nothing left to run, the remaining tasks are being executed by other threads
+			s_doneMutex.Lock();
+			s_waitingThreads.fetch_add(1);
+
+			while (!counter.IsDone() && !HasPendingTasks())
+				s_doneCondition.Wait(&s_doneMutex);
+
+			s_waitingThreads.fetch_sub(1);
+			s_doneMutex.Unlock();
+		}
+	}
+
+	void TaskSchedulerImpl::WaitForTasks()
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (s_workerCount == 0)
+		{
+			NazaraError("Task scheduler is not initialized");
+			return;
+		}
+		#endif
+
+		WaitForCounter(s_globalCounter);
+	}
+
+	void TaskSchedulerImpl::DiscardTask(Task* task)
+	{
+		TaskScheduler::Counter* counter = task->counter;
+
+		FreeTask(task);
+
+		if (counter)
+			counter->m_pendingTasks.fetch_sub(1);
+	}
+
+	void TaskSchedulerImpl::Execute(Task* task)
+	{
+		TaskScheduler::Counter* counter = task->counter;
+
+		task->functor->Run();
+
+		FreeTask(task);
+
+		// The counter may be destroyed by a waiting thread as soon as it reaches zero, it must not be used after this
+		bool counterDone = false;
+		if (counter && counter->m_pendingTasks.fetch_sub(1) == 1)
+			counterDone = true;
+
+		if (s_globalCounter.m_pendingTasks.fetch_sub(1) == 1)
+			counterDone = true;
+
+		if (counterDone && s_waitingThreads.load() > 0)
+		{
+			LockGuard lock(s_doneMutex);
+			s_doneCondition.SignalAll();
+		}
+	}
+
+	TaskSchedulerImpl::Task* TaskSchedulerImpl::FetchTask(Worker* worker)
+	{
+		if (worker)
+		{
+			Task* task = worker->queue.Pop();
+			if (task)
+				return task;
+		}
+
+		if (s_injectedTaskCount.load(std::memory_order_relaxed) > 0)
+		{
+			Task* task = nullptr;
+
+			s_injectionMutex.Lock();
+			if (s_injectedTasksHead)
+			{
+				task = s_injectedTasksHead;
+				s_injectedTasksHead = task->next;
+
+				std::size_t remainingTasks = s_injectedTaskCount.load(std::memory_order_relaxed) - 1;
+				if (worker)
+				{
+					// Workers take their share of the injected tasks at once, keeping the injection queue lock rarely used
+					std::size_t share = remainingTasks / s_workerCount;
+					for (std::size_t i = 0; i < share; ++i)
+					{
+						Task* sharedTask = s_injectedTasksHead;
+						s_injectedTasksHead = sharedTask->next;
+
+						worker->queue.Push(sharedTask);
+					}
+
+					remainingTasks -= share;
+				}
+
+				if (!s_injectedTasksHead)
+					s_injectedTasksTail = nullptr;
+
+				s_injectedTaskCount.store(remainingTasks, std::memory_order_relaxed);
+			}
+			s_injectionMutex.Unlock();
+
+			if (task)
+				return task;
+		}
+
+		return StealTask(worker);
+	}
+
+	bool TaskSchedulerImpl::HasPendingTasks()
+	{
+		// Pairs with the fence of WakeWorkers, either the sleeper sees the task or the waker sees the sleeper
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (s_injectedTaskCount.load(std::memory_order_relaxed) > 0)
+			return true;
+
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+		{
+			if (!s_workers[i].queue.IsEmpty())
+				return true;
+		}
+
+		return false;
+	}
+
+	void TaskSchedulerImpl::Park()
+	{
+		s_idleMutex.Lock();
+		s_sleepingWorkers.fetch_add(1);
+
+		while (!s_shouldFinish && !HasPendingTasks())
+			s_idleCondition.Wait(&s_idleMutex);
+
+		s_sleepingWorkers.fetch_sub(1);
+		s_idleMutex.Unlock();
+	}
+
+	TaskSchedulerImpl::Task* TaskSchedulerImpl::StealTask(Worker* thief)
+	{
+		unsigned int firstVictim = NextRandom() % s_workerCount;
+
+		bool shouldRetry;
+		do
+		{
+			shouldRetry = false;
+			for (unsigned int i = 0; i < s_workerCount; ++i)
+			{
+				Worker& victim = s_workers[(firstVictim + i) % s_workerCount];
+				if (&victim == thief)
+					continue;
+
+				Task* task;
+				if (!victim.queue.Steal(&task))
+					shouldRetry = true; // Someone else took the task we wanted, the queue may still have some
+				else if (task)
+					return task;
+			}
+		}
+		while (shouldRetry);
+
+		return nullptr;
+	}
+
+	void TaskSchedulerImpl::Submit(Task* firstTask, Task* lastTask, std::size_t count, TaskScheduler::Counter* counter)
+	{
+		// Counters must be incremented before any of the tasks can complete
+		if (counter)
+			counter->m_pendingTasks.fetch_add(static_cast<unsigned int>(count), std::memory_order_relaxed);
+
+		s_globalCounter.m_pendingTasks.fetch_add(static_cast<unsigned int>(count), std::memory_order_relaxed);
+
+		if (s_currentWorker)
+		{
+			// Tasks spawned by a task stay in the worker queue, idle workers will steal them
+			// A pushed task may be stolen and released right away, its successor must be read before
+			for (Task* task = firstTask; task;)
+			{
+				Task* nextTask = task->next;
+				s_currentWorker->queue.Push(task);
+				task = nextTask;
+			}
+		}
+		else
+		{
+			// The tasks are already linked together, the whole list is appended at once
+			LockGuard lock(s_injectionMutex);
+
+			if (s_injectedTasksTail)
+				s_injectedTasksTail->next = firstTask;
+			else
+				s_injectedTasksHead = firstTask;
+
+			s_injectedTasksTail = lastTask;
+			s_injectedTaskCount.store(s_injectedTaskCount.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+
+		WakeWorkers(count);
+	}
+
+	void TaskSchedulerImpl::WakeWorkers(std::size_t taskCount)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (s_sleepingWorkers.load(std::memory_order_relaxed) > 0)
+		{
+			LockGuard lock(s_idleMutex);
+			if (taskCount > 1)
+				s_idleCondition.SignalAll();
+			else
+				s_idleCondition.Signal();
+		}
+
+		// Threads waiting on a counter may help with the new tasks
+		if (s_waitingThreads.load(std::memory_order_relaxed) > 0)
+		{
+			LockGuard lock(s_doneMutex);
+			s_doneCondition.SignalAll();
+		}
+	}
+
+	void TaskSchedulerImpl::WorkerProc(Worker* worker)
+	{
+		s_currentWorker = worker;
+		s_randomState = (worker->id + 1) * 0x9E3779B9U;
+
+		unsigned int idleCount = 0;
+		while (!s_shouldFinish.load(std::memory_order_relaxed))
+		{
+			Task* task = FetchTask(worker);
+			if (task)
+			{
+				Execute(task);
+				idleCount = 0;
+			}
+			else if (++idleCount < s_spinCount)
+				std::this_thread::yield();
+			else
+			{
+				Park();
+				idleCount = 0;
+			}
+		}
+
+		s_currentWorker = nullptr;
+	}
+
+	std::atomic_bool TaskSchedulerImpl::s_shouldFinish;
+	std::atomic_size_t TaskSchedulerImpl::s_injectedTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_sleepingWorkers;
+	std::atomic_uint TaskSchedulerImpl::s_waitingThreads;
+	ConcurrentMemoryPool TaskSchedulerImpl::s_functorPool(s_functorBlockSize, 64);
+	ConcurrentMemoryPool TaskSchedulerImpl::s_taskPool(sizeof(TaskScheduler::Task), 256);
+	TaskSchedulerImpl::Task* TaskSchedulerImpl::s_injectedTasksHead = nullptr;
+	TaskSchedulerImpl::Task* TaskSchedulerImpl::s_injectedTasksTail = nullptr;
+	std::unique_ptr<TaskSchedulerImpl::Worker[]> TaskSchedulerImpl::s_workers;
+	unsigned int TaskSchedulerImpl::s_workerCount = 0;
+	ConditionVariable TaskSchedulerImpl::s_doneCondition;
+	ConditionVariable TaskSchedulerImpl::s_idleCondition;
+	Mutex TaskSchedulerImpl::s_doneMutex;
+	Mutex TaskSchedulerImpl::s_idleMutex;
+	Mutex TaskSchedulerImpl::s_injectionMutex;
+	TaskScheduler::Counter TaskSchedulerImpl::s_globalCounter;
+	thread_local TaskSchedulerImpl::Worker* TaskSchedulerImpl::s_currentWorker = nullptr;
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKSCHEDULERIMPL_HPP
+#define NAZARA_TASKSCHEDULERIMPL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Nz
+{
+	class TaskSchedulerImpl
+	{
+		public:
+			TaskSchedulerImpl() = delete;
+			~TaskSchedulerImpl() = delete;
+
+			using Task = TaskScheduler::Task;
+
+			static Task* AllocateTask(std::size_t functorSize, void** functorStorage);
+			static void FreeTask(Task* task);
+			static bool Initialize(unsigned int workerCount);
+			static bool IsInitialized();
+			static void Run(Task** tasks, std::size_t count, TaskScheduler::Counter* counter);
+			static void RunShared(Functor* functor, std::size_t count, TaskScheduler::Counter* counter);
+			static void Uninitialize();
+			static void WaitForCounter(const TaskScheduler::Counter& counter);
+			static void WaitForTasks();
+
+		private:
+			class TaskQueue;
+			struct Worker;
+
+			static void DiscardTask(Task* task);
+			static void Execute(Task* task);
+			static Task* FetchTask(Worker* worker);
+			static bool HasPendingTasks();
+			static void Park();
+			static Task* StealTask(Worker* thief);
+			static void Submit(Task* firstTask, Task* lastTask, std::size_t count, TaskScheduler::Counter* counter);
+			static void WakeWorkers(std::size_t taskCount);
+			static void WorkerProc(Worker* worker);
+
+			static std::atomic_bool s_shouldFinish;
+			static std::atomic_size_t s_injectedTaskCount;
+			static std::atomic_uint s_sleepingWorkers;
+			static std::atomic_uint s_waitingThreads;
+			static ConcurrentMemoryPool s_functorPool;
+			static ConcurrentMemoryPool s_taskPool;
+			static Task* s_injectedTasksHead;
+			static Task* s_injectedTasksTail;
+			static std::unique_ptr<Worker[]> s_workers;
+			static unsigned int s_workerCount;
+			static ConditionVariable s_doneCondition;
+			static ConditionVariable s_idleCondition;
+			static Mutex s_doneMutex;
+			static Mutex s_idleMutex;
+			static Mutex s_injectionMutex;
+			static TaskScheduler::Counter s_globalCounter;
+			static thread_local Worker* s_currentWorker;
+	};
+}
+
+#endif // NAZARA_TASKSCHEDULERIMPL_HPP
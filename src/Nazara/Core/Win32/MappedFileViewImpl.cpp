@@ -0,0 +1,83 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Win32/MappedFileViewImpl.hpp>
+#include <Nazara/Core/String.hpp>
+#include <limits>
+#include <windows.h>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	bool MappedFileViewImpl::Flush(UInt8* data, UInt64 size)
+	{
+		return FlushViewOfFile(data, static_cast<SIZE_T>(size)) != 0;
+	}
+
+	bool MappedFileViewImpl::Map(const String& filePath, UInt32 openMode, UInt8** data, UInt64* size)
+	{
+		bool writable = (openMode & OpenMode_WriteOnly) != 0;
+
+		DWORD access = (writable) ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+		DWORD shareMode = (openMode & OpenMode_Lock) ? FILE_SHARE_READ : FILE_SHARE_READ | FILE_SHARE_WRITE;
+
+		HANDLE file = CreateFileW(filePath.GetWideString().data(), access, shareMode, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || static_cast<UInt64>(fileSize.QuadPart) > std::numeric_limits<SIZE_T>::max())
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		// An empty file cannot be mapped, but it is still a valid (empty) view
+		void* view = nullptr;
+		if (fileSize.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingW(file, nullptr, (writable) ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping)
+			{
+				CloseHandle(file);
+				return false;
+			}
+
+			view = MapViewOfFile(mapping, (writable) ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+
+			// The view keeps the mapping (and the file) alive
+			CloseHandle(mapping);
+
+			if (!view)
+			{
+				CloseHandle(file);
+				return false;
+			}
+		}
+
+		CloseHandle(file);
+
+		*data = static_cast<UInt8*>(view);
+		*size = static_cast<UInt64>(fileSize.QuadPart);
+
+		return true;
+	}
+
+	bool MappedFileViewImpl::SetAccessPattern(UInt8* data, UInt64 size, AccessPattern pattern)
+	{
+		NazaraUnused(data);
+		NazaraUnused(size);
+		NazaraUnused(pattern);
+
+		// There is no madvise equivalent on Windows, the cache manager already detects sequential accesses
+		return true;
+	}
+
+	void MappedFileViewImpl::Unmap(UInt8* data, UInt64 size)
+	{
+		NazaraUnused(size);
+
+		UnmapViewOfFile(data);
+	}
+}
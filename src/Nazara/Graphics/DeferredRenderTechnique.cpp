@@ -8,6 +8,8 @@
 
 #include <Nazara/Graphics/DeferredRenderTechnique.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/DeferredBloomPass.hpp>
@@ -207,6 +209,9 @@ namespace Nz
 	bool DeferredRenderTechnique::Draw(const SceneData& sceneData) const
 	{
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
+		NazaraProfileZone("DeferredRenderTechnique::Draw");
+		MemoryTagScope memoryTag(MemoryTag_Graphics);
+
 		Recti viewerViewport = sceneData.viewer->GetViewport();
 
 		Vector2ui viewportDimensions(viewerViewport.width, viewerViewport.height);
@@ -4,7 +4,9 @@
 
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Core/OffsetOf.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/Drawable.hpp>
@@ -52,6 +54,8 @@ namespace Nz
 	bool ForwardRenderTechnique::Draw(const SceneData& sceneData) const
 	{
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
+		NazaraProfileZone("ForwardRenderTechnique::Draw");
+		MemoryTagScope memoryTag(MemoryTag_Graphics);
 
 		m_renderQueue.Sort(sceneData.viewer);
 
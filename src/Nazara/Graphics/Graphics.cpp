@@ -6,6 +6,7 @@
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/DeferredRenderTechnique.hpp>
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
@@ -46,6 +47,7 @@ namespace Nz
 		s_moduleReferenceCounter++;
 
 		// Initialisation du module
+		MemoryTagScope memoryTag(MemoryTag_Graphics);
 		CallOnExit onExit(Graphics::Uninitialize);
 
 		if (!Material::Initialize())
@@ -772,5 +772,6 @@ namespace Nz
 	MaterialLoader::LoaderList Material::s_loaders;
 	MaterialManager::ManagerMap Material::s_managerMap;
 	MaterialManager::ManagerParams Material::s_managerParameters;
+	MaterialManager::ManagerState Material::s_managerState;
 	MaterialRef Material::s_defaultMaterial = nullptr;
 }
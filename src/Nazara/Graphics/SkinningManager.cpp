@@ -4,6 +4,7 @@
 
 #include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/Parallel.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
@@ -76,14 +77,10 @@ namespace Nz
 			for (unsigned int i = 0; i < jointCount; ++i)
 				skinningData.joints[i].EnsureSkinningMatrixUpdate();
 
-			unsigned int workerCount = TaskScheduler::GetWorkerCount();
-
-			std::ldiv_t div = std::ldiv(mesh->GetVertexCount(), workerCount);
-			for (unsigned int i = 0; i < workerCount; ++i)
-				TaskScheduler::AddTask(SkinPositionNormalTangent, skinningData, i*div.quot, (i == workerCount-1) ? div.quot + div.rem : div.quot);
-
-			TaskScheduler::Run();
-			TaskScheduler::WaitForTasks();
+			ParallelFor(0, mesh->GetVertexCount(), [&skinningData](std::size_t first, std::size_t last)
+			{
+				SkinPositionNormalTangent(skinningData, static_cast<unsigned int>(first), static_cast<unsigned int>(last - first));
+			}, 256);
 		}
 	}
 
@@ -9,8 +9,11 @@
 #include <netinet/tcp.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -520,6 +523,55 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, int* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		// Buffers are sent MaxBufferCount at a time and up to the int limit, the caller loops on partial sends
+		constexpr std::size_t MaxBufferCount = 64;
+
+		bufferCount = std::min(bufferCount, MaxBufferCount);
+
+		iovec vectors[MaxBufferCount];
+		std::size_t totalLength = 0;
+		for (std::size_t i = 0; i < bufferCount; ++i)
+		{
+			std::size_t length = std::min<std::size_t>(buffers[i].dataLength, std::numeric_limits<int>::max() - totalLength);
+			vectors[i].iov_base = const_cast<void*>(buffers[i].data);
+			vectors[i].iov_len = length;
+
+			totalLength += length;
+			if (totalLength == static_cast<std::size_t>(std::numeric_limits<int>::max()))
+			{
+				bufferCount = i + 1;
+				break;
+			}
+		}
+
+		msghdr message;
+		std::memset(&message, 0, sizeof(msghdr));
+		message.msg_iov = vectors;
+		message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(bufferCount);
+
+		ssize_t byteSent = sendmsg(handle, &message, 0);
+		if (byteSent == SOCKET_ERROR)
+		{
+			if (error)
+				*error = TranslateErrnoToResolveError(GetLastErrorCode());
+
+			return false; //< Error
+		}
+
+		if (sent)
+			*sent = static_cast<int>(byteSent);
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendTo(SocketHandle handle, const void* buffer, int length, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -183,6 +183,123 @@ namespace Nz
 		return true;
 	}
 
+	bool TcpClient::Send(const ByteChain& chain, std::size_t* sent)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
+		NazaraAssert(!chain.IsEmpty(), "Invalid chain");
+
+		constexpr std::size_t MaxSegmentCount = 64;
+
+		ByteChain::Segment segments[MaxSegmentCount];
+		NetBuffer buffers[MaxSegmentCount];
+
+		std::size_t segmentCount = chain.GetSegmentCount();
+		std::size_t totalByteSent = 0;
+		for (std::size_t firstSegment = 0; firstSegment < segmentCount; firstSegment += MaxSegmentCount)
+		{
+			std::size_t count = chain.ExportSegments(segments, MaxSegmentCount, firstSegment);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				buffers[i].data = segments[i].data;
+				buffers[i].dataLength = segments[i].size;
+			}
+
+			std::size_t byteSent;
+			bool success = SendMultiple(buffers, count, &byteSent);
+			totalByteSent += byteSent;
+
+			if (!success)
+			{
+				if (sent)
+					*sent = totalByteSent;
+
+				return false;
+			}
+		}
+
+		if (sent)
+			*sent = totalByteSent;
+
+		return true;
+	}
+
+	bool TcpClient::SendMultiple(const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		CallOnExit updateSent;
+		std::size_t totalByteSent = 0;
+		if (sent)
+		{
+			updateSent.Reset([sent, &totalByteSent] ()
+			{
+				*sent = totalByteSent;
+			});
+		}
+
+		std::size_t bufferIndex = 0;
+		std::size_t bufferOffset = 0;
+		for (;;)
+		{
+			while (bufferIndex < bufferCount && bufferOffset == buffers[bufferIndex].dataLength)
+			{
+				bufferIndex++;
+				bufferOffset = 0;
+			}
+
+			if (bufferIndex == bufferCount)
+				break;
+
+			// A partially sent buffer is finished on its own before going back to vectored writes
+			bool result;
+			int sentSize;
+			if (bufferOffset > 0)
+			{
+				int sendSize = static_cast<int>(std::min<std::size_t>(buffers[bufferIndex].dataLength - bufferOffset, std::numeric_limits<int>::max())); //< Handle very large send
+				result = SocketImpl::Send(m_handle, static_cast<const UInt8*>(buffers[bufferIndex].data) + bufferOffset, sendSize, &sentSize, &m_lastError);
+			}
+			else
+				result = SocketImpl::SendMultiple(m_handle, &buffers[bufferIndex], bufferCount - bufferIndex, &sentSize, &m_lastError);
+
+			if (!result)
+			{
+				switch (m_lastError)
+				{
+					case SocketError_ConnectionClosed:
+					case SocketError_ConnectionRefused:
+						UpdateState(SocketState_NotConnected);
+						break;
+
+					default:
+						break;
+				}
+
+				return false;
+			}
+
+			totalByteSent += sentSize;
+
+			std::size_t remaining = static_cast<std::size_t>(sentSize);
+			while (remaining > 0)
+			{
+				std::size_t bufferRemaining = buffers[bufferIndex].dataLength - bufferOffset;
+				if (remaining < bufferRemaining)
+				{
+					bufferOffset += remaining;
+					break;
+				}
+
+				remaining -= bufferRemaining;
+				bufferIndex++;
+				bufferOffset = 0;
+			}
+		}
+
+		UpdateState(SocketState_Connected);
+		return true;
+	}
+
 	bool TcpClient::SetCursorPos(UInt64 offset)
 	{
 		NazaraError("SetCursorPos() cannot be used on sequential streams");
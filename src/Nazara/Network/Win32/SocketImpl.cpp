@@ -7,6 +7,8 @@
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Network/Win32/IpAddressImpl.hpp>
 #include <Mstcpip.h>
+#include <algorithm>
+#include <limits>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -522,6 +524,50 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, int* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		// Buffers are sent MaxBufferCount at a time and up to the int limit, the caller loops on partial sends
+		constexpr std::size_t MaxBufferCount = 64;
+
+		bufferCount = std::min(bufferCount, MaxBufferCount);
+
+		WSABUF wsaBuffers[MaxBufferCount];
+		std::size_t totalLength = 0;
+		for (std::size_t i = 0; i < bufferCount; ++i)
+		{
+			std::size_t length = std::min<std::size_t>(buffers[i].dataLength, std::numeric_limits<int>::max() - totalLength);
+			wsaBuffers[i].buf = const_cast<CHAR*>(static_cast<const CHAR*>(buffers[i].data));
+			wsaBuffers[i].len = static_cast<ULONG>(length);
+
+			totalLength += length;
+			if (totalLength == static_cast<std::size_t>(std::numeric_limits<int>::max()))
+			{
+				bufferCount = i + 1;
+				break;
+			}
+		}
+
+		DWORD byteSent;
+		if (WSASend(handle, wsaBuffers, static_cast<DWORD>(bufferCount), &byteSent, 0, nullptr, nullptr) == SOCKET_ERROR)
+		{
+			if (error)
+				*error = TranslateWSAErrorToSocketError(WSAGetLastError());
+
+			return false; //< Error
+		}
+
+		if (sent)
+			*sent = static_cast<int>(byteSent);
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendTo(SocketHandle handle, const void* buffer, int length, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Physics/PhysWorld.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Newton/Newton.h>
 #include <Nazara/Physics/Debug.hpp>
 
@@ -54,6 +56,9 @@ namespace Nz
 
 	void PhysWorld::Step(float timestep)
 	{
+		NazaraProfileZone("PhysWorld::Step");
+		MemoryTagScope memoryTag(MemoryTag_Physics);
+
 		m_timestepAccumulator += timestep;
 
 		while (m_timestepAccumulator >= m_stepSize)
@@ -8,6 +8,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Context.hpp>
@@ -554,6 +555,7 @@ namespace Nz
 		s_moduleReferenceCounter++;
 
 		// Initialisation du module
+		MemoryTagScope memoryTag(MemoryTag_Renderer);
 		CallOnExit onExit(Renderer::Uninitialize);
 
 		// Initialisation d'OpenGL
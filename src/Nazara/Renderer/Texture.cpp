@@ -1284,4 +1284,5 @@ namespace Nz
 	TextureLibrary::LibraryMap Texture::s_library;
 	TextureManager::ManagerMap Texture::s_managerMap;
 	TextureManager::ManagerParams Texture::s_managerParameters;
+	TextureManager::ManagerState Texture::s_managerState;
 }
@@ -79,7 +79,7 @@ namespace Nz
 							code << "#define EARLY_FRAGMENT_TEST " << (glslVersion >= 420 || OpenGL::IsSupported(OpenGLExtension_Shader_ImageLoadStore)) << "\n\n";
 
 							for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
-								code << "#define " << it->first << ' ' << ((stageFlags & it->second) ? '1' : '0') << '\n';
+								code << "#define " << it->first.GetString() << ' ' << ((stageFlags & it->second) ? '1' : '0') << '\n';
 
 							code << "\n#line 1\n"; // Pour que les éventuelles erreurs du shader se réfèrent à la bonne ligne
 							code << shaderStage.source;
@@ -123,13 +123,16 @@ namespace Nz
 
 		for (String& flag : flags)
 		{
-			auto it = m_flags.find(flag);
+			// Les flags sont enregistrés, c'est ici qu'ils sont internés
+			StringAtom flagAtom(flag);
+
+			auto it = m_flags.find(flagAtom);
 			if (it == m_flags.end())
-				m_flags[flag] = 1U << m_flags.size();
+				m_flags[flagAtom] = 1U << m_flags.size();
 
-			auto it2 = shader.flags.find(flag);
+			auto it2 = shader.flags.find(flagAtom);
 			if (it2 == shader.flags.end())
-				shader.flags[flag] = 1U << shader.flags.size();
+				shader.flags[flagAtom] = 1U << shader.flags.size();
 		}
 
 		// On construit les flags requis pour l'activation du shader
@@ -140,13 +143,14 @@ namespace Nz
 
 		for (String& flag : flags)
 		{
+			StringAtom flagAtom(flag);
 			UInt32 flagVal;
 
-			auto it = m_flags.find(flag);
+			auto it = m_flags.find(flagAtom);
 			if (it == m_flags.end())
 			{
 				flagVal = 1U << m_flags.size();
-				m_flags[flag] = flagVal;
+				m_flags[flagAtom] = flagVal;
 			}
 			else
 				flagVal = it->second;
@@ -26,6 +26,7 @@
  */
 
 #include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/Parallel.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <algorithm>
@@ -635,11 +636,18 @@ namespace Nz
 		Boxf aabb;
 		if (vertexCount > 0)
 		{
+			// Extending a box to its own origin doesn't change it, the first vertex is a valid identity for the reduction
 			aabb.Set(positionPtr->x, positionPtr->y, positionPtr->z, 0.f, 0.f, 0.f);
-			--positionPtr;
 
-			for (unsigned int i = 1; i < vertexCount; ++i)
-				aabb.ExtendTo(*positionPtr++);
+			aabb = ParallelReduce(1, vertexCount, aabb, [positionPtr](std::size_t first, std::size_t last, Boxf& box)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					box.ExtendTo(positionPtr[static_cast<int>(i)]);
+			},
+			[](const Boxf& lhs, const Boxf& rhs)
+			{
+				return Boxf(lhs).ExtendTo(rhs);
+			}, 4096);
 		}
 		else
 			aabb.MakeZero();
@@ -539,4 +539,5 @@ namespace Nz
 	AnimationLoader::LoaderList Animation::s_loaders;
 	AnimationManager::ManagerMap Animation::s_managerMap;
 	AnimationManager::ManagerParams Animation::s_managerParameters;
+	AnimationManager::ManagerState Animation::s_managerState;
 }
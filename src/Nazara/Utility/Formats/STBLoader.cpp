@@ -10,6 +10,7 @@
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Utility/Image.hpp>
+#include <limits>
 #include <set>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -37,6 +38,23 @@ namespace Nz
 
 		static stbi_io_callbacks callbacks = {Read, Skip, Eof};
 
+		const UInt8* GetMemoryData(Stream& stream, int* size)
+		{
+			// Decode in place from memory (mapped files, memory views), without going through the stream
+			// stb_image takes an int size, bigger inputs are read through the callbacks
+			const UInt8* data = static_cast<const UInt8*>(stream.GetMemoryPointer());
+			if (!data)
+				return nullptr;
+
+			UInt64 cursorPos = stream.GetCursorPos();
+			UInt64 remainingSize = stream.GetSize() - cursorPos;
+			if (remainingSize > static_cast<UInt64>(std::numeric_limits<int>::max()))
+				return nullptr;
+
+			*size = static_cast<int>(remainingSize);
+			return &data[cursorPos];
+		}
+
 		bool IsSupported(const String& extension)
 		{
 			static std::set<String> supportedExtensions = {"bmp", "gif", "hdr", "jpg", "jpeg", "pic", "png", "ppm", "pgm", "psd", "tga"};
@@ -48,7 +66,15 @@ namespace Nz
 			NazaraUnused(parameters);
 
 			int width, height, bpp;
-			if (stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &bpp))
+
+			int result;
+			int size;
+			if (const UInt8* data = GetMemoryData(stream, &size))
+				result = stbi_info_from_memory(data, size, &width, &height, &bpp);
+			else
+				result = stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &bpp);
+
+			if (result)
 				return Ternary_True;
 			else
 				return Ternary_False;
@@ -60,7 +86,13 @@ namespace Nz
 			// Ceci à cause d'un bug de STB lorsqu'il s'agit de charger certaines images (ex: JPG) en "default"
 
 			int width, height, bpp;
-			UInt8* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+
+			UInt8* ptr;
+			int size;
+			if (const UInt8* data = GetMemoryData(stream, &size))
+				ptr = stbi_load_from_memory(data, size, &width, &height, &bpp, STBI_rgb_alpha);
+			else
+				ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
 			if (!ptr)
 			{
 				NazaraError("Failed to load image: " + String(stbi_failure_reason()));
@@ -3,13 +3,17 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Image.hpp>
+#include <Nazara/Core/AssetCache.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 ///TODO: Rajouter des warnings (Formats compressés avec les méthodes Copy/Update, tests taille dans Copy)
@@ -32,6 +36,107 @@ namespace Nz
 		{
 			return &base[(width*(height*z + y) + x)*bpp];
 		}
+
+		// Cache entries hold this header followed by every level, each one starting on a 16 bytes boundary
+		struct CachedImageHeader
+		{
+			UInt32 type;
+			UInt32 format;
+			UInt32 width;
+			UInt32 height;
+			UInt32 depth;
+			UInt32 levelCount;
+			UInt32 padding[2];
+		};
+
+		constexpr UInt32 CacheFormatVersion = 1;
+		constexpr std::size_t CacheLevelAlignment = 16;
+
+		inline std::size_t AlignCacheOffset(std::size_t offset)
+		{
+			return (offset + CacheLevelAlignment - 1) & ~(CacheLevelAlignment - 1);
+		}
+
+		String GetCacheEntryPath(const String& filePath, const ImageParams& params)
+		{
+			UInt32 variant[2] = {static_cast<UInt32>(params.loadFormat), params.levelCount};
+
+			return AssetCache::GetEntryPath(filePath, "Image", variant, sizeof(variant));
+		}
+
+		bool LoadFromCache(Image* image, const String& entryPath)
+		{
+			MappedFileView view;
+			if (!AssetCache::OpenEntry(entryPath, CacheFormatVersion, &view))
+				return false;
+
+			const UInt8* payload = view.GetConstData() + view.GetCursorPos();
+			std::size_t payloadSize = static_cast<std::size_t>(view.GetSize() - view.GetCursorPos());
+			if (payloadSize < sizeof(CachedImageHeader))
+				return false;
+
+			const CachedImageHeader* header = reinterpret_cast<const CachedImageHeader*>(payload);
+			if (!image->Create(static_cast<ImageType>(header->type), static_cast<PixelFormatType>(header->format), header->width, header->height, header->depth, static_cast<UInt8>(header->levelCount)))
+				return false;
+
+			std::size_t offset = sizeof(CachedImageHeader);
+			for (UInt8 level = 0; level < image->GetLevelCount(); ++level)
+			{
+				offset = AlignCacheOffset(offset);
+
+				std::size_t levelSize = image->GetMemoryUsage(level);
+				if (offset + levelSize > payloadSize)
+				{
+					image->Destroy();
+					return false;
+				}
+
+				std::memcpy(image->GetPixels(0, 0, 0, level), &payload[offset], levelSize);
+				offset += levelSize;
+			}
+
+			return true;
+		}
+
+		void SaveToCache(const Image& image, const String& entryPath)
+		{
+			UInt8 levelCount = image.GetLevelCount();
+
+			std::size_t payloadSize = sizeof(CachedImageHeader);
+			for (UInt8 level = 0; level < levelCount; ++level)
+			{
+				// Formats using less than a byte per pixel (compressed ones) are not handled by GetMemoryUsage
+				std::size_t levelSize = image.GetMemoryUsage(level);
+				if (levelSize == 0)
+					return;
+
+				payloadSize = AlignCacheOffset(payloadSize) + levelSize;
+			}
+
+			std::vector<UInt8> payload(payloadSize, 0);
+
+			CachedImageHeader* header = reinterpret_cast<CachedImageHeader*>(payload.data());
+			header->type = image.GetType();
+			header->format = image.GetFormat();
+			header->width = image.GetWidth();
+			header->height = image.GetHeight();
+			header->depth = image.GetDepth();
+			header->levelCount = levelCount;
+
+			std::size_t offset = sizeof(CachedImageHeader);
+			for (UInt8 level = 0; level < levelCount; ++level)
+			{
+				offset = AlignCacheOffset(offset);
+
+				std::size_t levelSize = image.GetMemoryUsage(level);
+				std::memcpy(&payload[offset], image.GetConstPixels(0, 0, 0, level), levelSize);
+				offset += levelSize;
+			}
+
+			// A cache failing to write is not a load failure
+			ErrorFlags flags(ErrorFlag_Silent);
+			AssetCache::WriteEntry(entryPath, CacheFormatVersion, payload.data(), payload.size());
+		}
 	}
 
 	bool ImageParams::IsValid() const
@@ -823,7 +928,24 @@ namespace Nz
 
 	bool Image::LoadFromFile(const String& filePath, const ImageParams& params)
 	{
-		return ImageLoader::LoadFromFile(this, filePath, params);
+		String cacheEntry;
+		if (AssetCache::IsEnabled() && params.IsValid())
+		{
+			cacheEntry = GetCacheEntryPath(filePath, params);
+			if (LoadFromCache(this, cacheEntry))
+			{
+				SetFilePath(filePath);
+				return true;
+			}
+		}
+
+		if (!ImageLoader::LoadFromFile(this, filePath, params))
+			return false;
+
+		if (!cacheEntry.IsEmpty())
+			SaveToCache(*this, cacheEntry);
+
+		return true;
 	}
 
 	bool Image::LoadFromMemory(const void* data, std::size_t size, const ImageParams& params)
@@ -1377,4 +1499,5 @@ namespace Nz
 	ImageLoader::LoaderList Image::s_loaders;
 	ImageManager::ManagerMap Image::s_managerMap;
 	ImageManager::ManagerParams Image::s_managerParameters;
+	ImageManager::ManagerState Image::s_managerState;
 }
@@ -3,13 +3,19 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Core/AssetCache.hpp>
 #include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Animation.hpp>
 #include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
@@ -25,6 +31,62 @@
 
 namespace Nz
 {
+	namespace
+	{
+		// Cache entries store values in native endianness, one after the other
+		constexpr UInt32 CacheFormatVersion = 2;
+
+		template<typename T>
+		bool ReadCacheValue(Stream& stream, T* value)
+		{
+			return stream.Read(value, sizeof(T)) == sizeof(T);
+		}
+
+		bool ReadCacheString(Stream& stream, String* string)
+		{
+			UInt32 size;
+			if (!ReadCacheValue(stream, &size) || size > stream.GetSize() - stream.GetCursorPos())
+				return false;
+
+			string->Resize(size);
+			return stream.Read(string->GetBuffer(), size) == size;
+		}
+
+		bool ReadCachePath(Stream& stream, const String& sourceDirectory, String* path)
+		{
+			UInt8 relative;
+			if (!ReadCacheValue(stream, &relative) || !ReadCacheString(stream, path))
+				return false;
+
+			if (relative)
+				path->Insert(0, sourceDirectory);
+
+			return true;
+		}
+
+		template<typename T>
+		void WriteCacheValue(Stream& stream, T value)
+		{
+			stream.Write(&value, sizeof(T));
+		}
+
+		void WriteCacheString(Stream& stream, const String& string)
+		{
+			WriteCacheValue<UInt32>(stream, static_cast<UInt32>(string.GetSize()));
+			stream.Write(string.GetConstBuffer(), string.GetSize());
+		}
+
+		// Loaders resolve materials and animations next to the source file, these are stored relative to it
+		// so an identical file elsewhere (or a moved asset tree) doesn't get paths into the old location
+		void WriteCachePath(Stream& stream, const String& sourceDirectory, const String& path)
+		{
+			bool relative = !sourceDirectory.IsEmpty() && path.StartsWith(sourceDirectory);
+
+			WriteCacheValue<UInt8>(stream, (relative) ? 1 : 0);
+			WriteCacheString(stream, (relative) ? path.SubString(sourceDirectory.GetSize()) : path);
+		}
+	}
+
 	MeshParams::MeshParams()
 	{
 		if (!Buffer::IsStorageSupported(storage))
@@ -787,7 +849,32 @@ namespace Nz
 
 	bool Mesh::LoadFromFile(const String& filePath, const MeshParams& params)
 	{
-		return MeshLoader::LoadFromFile(this, filePath, params);
+		String cacheEntry;
+		if (AssetCache::IsEnabled() && params.IsValid())
+		{
+			// The storage doesn't change the content of the buffers, it isn't a part of the variant
+			struct
+			{
+				float scale[3];
+				UInt32 flags;
+			} variant = {{params.scale.x, params.scale.y, params.scale.z}, UInt32(params.animated) | UInt32(params.center) << 1 | UInt32(params.flipUVs) << 2 | UInt32(params.optimizeIndexBuffers) << 3};
+
+			cacheEntry = AssetCache::GetEntryPath(filePath, "Mesh", &variant, sizeof(variant));
+			if (LoadFromCache(cacheEntry, File::GetDirectory(File::NormalizePath(filePath)), params))
+			{
+				SetFilePath(filePath);
+				return true;
+			}
+		}
+
+		if (!MeshLoader::LoadFromFile(this, filePath, params))
+			return false;
+
+		// Skeletal meshes also depend on their skeleton, only static ones are cached
+		if (!cacheEntry.IsEmpty() && m_impl->animationType == AnimationType_Static)
+			SaveToCache(cacheEntry, File::GetDirectory(File::NormalizePath(filePath)));
+
+		return true;
 	}
 
 	bool Mesh::LoadFromMemory(const void* data, std::size_t size, const MeshParams& params)
@@ -1004,6 +1091,207 @@ namespace Nz
 		m_impl->aabbUpdated = false;
 	}
 
+	bool Mesh::LoadFromCache(const String& entryPath, const String& sourceDirectory, const MeshParams& params)
+	{
+		MappedFileView view;
+		if (!AssetCache::OpenEntry(entryPath, CacheFormatVersion, &view))
+			return false;
+
+		// The entry was validated by the cache, a truncated content only means it has been written by a buggy version
+		auto Fail = [this]() -> bool
+		{
+			Destroy();
+			return false;
+		};
+
+		CreateStatic();
+
+		UInt32 materialCount;
+		if (!ReadCacheValue(view, &materialCount) || materialCount == 0)
+			return Fail();
+
+		SetMaterialCount(materialCount);
+		for (UInt32 i = 0; i < materialCount; ++i)
+		{
+			if (!ReadCachePath(view, sourceDirectory, &m_impl->materials[i]))
+				return Fail();
+		}
+
+		if (!ReadCachePath(view, sourceDirectory, &m_impl->animationPath))
+			return Fail();
+
+		UInt32 subMeshCount;
+		if (!ReadCacheValue(view, &subMeshCount))
+			return Fail();
+
+		for (UInt32 i = 0; i < subMeshCount; ++i)
+		{
+			UInt32 materialIndex;
+			UInt32 primitiveMode;
+			Boxf aabb;
+			UInt32 stride;
+			UInt32 componentCount;
+			if (!ReadCacheValue(view, &materialIndex) || !ReadCacheValue(view, &primitiveMode) || !ReadCacheValue(view, &aabb) ||
+			    !ReadCacheValue(view, &stride) || !ReadCacheValue(view, &componentCount))
+				return Fail();
+
+			VertexDeclarationRef declaration = VertexDeclaration::New();
+			for (UInt32 j = 0; j < componentCount; ++j)
+			{
+				UInt32 component;
+				UInt32 type;
+				UInt32 offset;
+				if (!ReadCacheValue(view, &component) || !ReadCacheValue(view, &type) || !ReadCacheValue(view, &offset))
+					return Fail();
+
+				declaration->EnableComponent(static_cast<VertexComponent>(component), static_cast<ComponentType>(type), offset);
+			}
+			declaration->SetStride(stride);
+
+			// Buffers are filled straight from the mapped pages
+			UInt32 vertexCount;
+			if (!ReadCacheValue(view, &vertexCount))
+				return Fail();
+
+			UInt64 vertexSize = UInt64(vertexCount) * stride;
+			if (vertexSize > view.GetSize() - view.GetCursorPos())
+				return Fail();
+
+			VertexBufferRef vertexBuffer = VertexBuffer::New(declaration, vertexCount, params.storage, BufferUsage_Static);
+			vertexBuffer->FillRaw(view.GetConstData() + view.GetCursorPos(), 0, static_cast<unsigned int>(vertexSize));
+			view.SetCursorPos(view.GetCursorPos() + vertexSize);
+
+			StaticMeshRef subMesh = StaticMesh::New(this);
+			if (!subMesh->Create(vertexBuffer))
+				return Fail();
+
+			UInt8 indexInfo;
+			if (!ReadCacheValue(view, &indexInfo))
+				return Fail();
+
+			if (indexInfo != 0)
+			{
+				bool largeIndices = (indexInfo == 2);
+
+				UInt32 indexCount;
+				if (!ReadCacheValue(view, &indexCount))
+					return Fail();
+
+				UInt64 indexSize = UInt64(indexCount) * ((largeIndices) ? sizeof(UInt32) : sizeof(UInt16));
+				if (indexSize > view.GetSize() - view.GetCursorPos())
+					return Fail();
+
+				IndexBufferRef indexBuffer = IndexBuffer::New(largeIndices, indexCount, params.storage, BufferUsage_Static);
+				indexBuffer->FillRaw(view.GetConstData() + view.GetCursorPos(), 0, static_cast<unsigned int>(indexSize));
+				view.SetCursorPos(view.GetCursorPos() + indexSize);
+
+				subMesh->SetIndexBuffer(indexBuffer);
+			}
+
+			subMesh->SetAABB(aabb);
+			subMesh->SetMaterialIndex(materialIndex);
+			subMesh->SetPrimitiveMode(static_cast<PrimitiveMode>(primitiveMode));
+
+			AddSubMesh(subMesh);
+		}
+
+		UInt32 identifierCount;
+		if (!ReadCacheValue(view, &identifierCount))
+			return Fail();
+
+		for (UInt32 i = 0; i < identifierCount; ++i)
+		{
+			String identifier;
+			UInt32 index;
+			if (!ReadCacheString(view, &identifier) || !ReadCacheValue(view, &index) || index >= subMeshCount)
+				return Fail();
+
+			m_impl->subMeshMap[identifier] = index;
+		}
+
+		return true;
+	}
+
+	void Mesh::SaveToCache(const String& entryPath, const String& sourceDirectory) const
+	{
+		MemoryStream stream;
+
+		WriteCacheValue<UInt32>(stream, static_cast<UInt32>(m_impl->materials.size()));
+		for (const String& material : m_impl->materials)
+			WriteCachePath(stream, sourceDirectory, material);
+
+		WriteCachePath(stream, sourceDirectory, m_impl->animationPath);
+
+		WriteCacheValue<UInt32>(stream, static_cast<UInt32>(m_impl->subMeshes.size()));
+		for (const SubMeshRef& subMesh : m_impl->subMeshes)
+		{
+			const StaticMesh* staticMesh = static_cast<const StaticMesh*>(subMesh.Get());
+			const VertexBuffer* vertexBuffer = staticMesh->GetVertexBuffer();
+			const VertexDeclaration* declaration = vertexBuffer->GetVertexDeclaration();
+
+			WriteCacheValue<UInt32>(stream, staticMesh->GetMaterialIndex());
+			WriteCacheValue<UInt32>(stream, staticMesh->GetPrimitiveMode());
+			WriteCacheValue(stream, staticMesh->GetAABB());
+			WriteCacheValue<UInt32>(stream, static_cast<UInt32>(declaration->GetStride()));
+
+			UInt32 componentCount = 0;
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				bool enabled;
+				declaration->GetComponent(static_cast<VertexComponent>(i), &enabled, nullptr, nullptr);
+				if (enabled)
+					componentCount++;
+			}
+
+			WriteCacheValue(stream, componentCount);
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				bool enabled;
+				ComponentType type;
+				std::size_t offset;
+				declaration->GetComponent(static_cast<VertexComponent>(i), &enabled, &type, &offset);
+				if (enabled)
+				{
+					WriteCacheValue<UInt32>(stream, i);
+					WriteCacheValue<UInt32>(stream, type);
+					WriteCacheValue<UInt32>(stream, static_cast<UInt32>(offset));
+				}
+			}
+
+			UInt32 vertexCount = vertexBuffer->GetVertexCount();
+			WriteCacheValue(stream, vertexCount);
+			{
+				BufferMapper<VertexBuffer> mapper(vertexBuffer, BufferAccess_ReadOnly);
+				stream.Write(mapper.GetPointer(), vertexCount * declaration->GetStride());
+			}
+
+			const IndexBuffer* indexBuffer = staticMesh->GetIndexBuffer();
+			if (indexBuffer)
+			{
+				UInt32 indexCount = indexBuffer->GetIndexCount();
+
+				WriteCacheValue<UInt8>(stream, (indexBuffer->HasLargeIndices()) ? 2 : 1);
+				WriteCacheValue(stream, indexCount);
+
+				BufferMapper<IndexBuffer> mapper(indexBuffer, BufferAccess_ReadOnly);
+				stream.Write(mapper.GetPointer(), indexCount * indexBuffer->GetStride());
+			}
+			else
+				WriteCacheValue<UInt8>(stream, 0);
+		}
+
+		WriteCacheValue<UInt32>(stream, static_cast<UInt32>(m_impl->subMeshMap.size()));
+		for (const auto& pair : m_impl->subMeshMap)
+		{
+			WriteCacheString(stream, pair.first);
+			WriteCacheValue<UInt32>(stream, pair.second);
+		}
+
+		// A cache failing to write is not a load failure
+		ErrorFlags flags(ErrorFlag_Silent);
+		AssetCache::WriteEntry(entryPath, CacheFormatVersion, stream.GetData(), static_cast<std::size_t>(stream.GetSize()));
+	}
+
 	bool Mesh::Initialize()
 	{
 		if (!MeshLibrary::Initialize())
@@ -1031,4 +1319,5 @@ namespace Nz
 	MeshLoader::LoaderList Mesh::s_loaders;
 	MeshManager::ManagerMap Mesh::s_managerMap;
 	MeshManager::ManagerParams Mesh::s_managerParameters;
+	MeshManager::ManagerState Mesh::s_managerState;
 }
@@ -8,6 +8,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MemoryManager.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Thread.hpp>
 #include <Nazara/Utility/Animation.hpp>
@@ -48,6 +49,7 @@ namespace Nz
 		s_moduleReferenceCounter++;
 
 		// Initialisation du module
+		MemoryTagScope memoryTag(MemoryTag_Utility);
 		CallOnExit onExit(Utility::Uninitialize);
 
 		if (!Animation::Initialize())
@@ -0,0 +1,116 @@
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	Nz::String Hash(Nz::HashType type, const void* data, std::size_t size, std::size_t pieceSize = 0)
+	{
+		std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(type);
+		hash->Begin();
+
+		// Feeding the input piece by piece must give the same result
+		const Nz::UInt8* bytes = static_cast<const Nz::UInt8*>(data);
+		if (pieceSize == 0)
+			pieceSize = size;
+
+		for (std::size_t offset = 0; offset < size; offset += pieceSize)
+			hash->Append(bytes + offset, std::min(pieceSize, size - offset));
+
+		return hash->End().ToHex();
+	}
+
+	Nz::String Hash(Nz::HashType type, const char* string)
+	{
+		return Hash(type, string, std::strlen(string));
+	}
+}
+
+SCENARIO("AbstractHash", "[CORE][ABSTRACTHASH]")
+{
+	GIVEN("Some inputs")
+	{
+		const char* fox = "The quick brown fox jumps over the lazy dog";
+
+		std::vector<Nz::UInt8> big(1000);
+		for (std::size_t i = 0; i < big.size(); ++i)
+			big[i] = static_cast<Nz::UInt8>(i * 7 + 3);
+
+		WHEN("We hash them with CRC32 and CRC32C")
+		{
+			THEN("We get the reference checksums")
+			{
+				REQUIRE(Hash(Nz::HashType_CRC32, "123456789") == "cbf43926");
+				REQUIRE(Hash(Nz::HashType_CRC32, fox) == "414fa339");
+
+				REQUIRE(Hash(Nz::HashType_CRC32C, "") == "00000000");
+				REQUIRE(Hash(Nz::HashType_CRC32C, "123456789") == "e3069283");
+				REQUIRE(Hash(Nz::HashType_CRC32C, fox) == "22620404");
+				REQUIRE(Hash(Nz::HashType_CRC32C, big.data(), big.size(), 13) == "dd2edff7");
+				REQUIRE(Nz::String(Nz::AbstractHash::Get(Nz::HashType_CRC32C)->GetHashName()) == "CRC32C");
+			}
+		}
+
+		WHEN("We hash them with XXHash64")
+		{
+			THEN("We get the reference digests")
+			{
+				REQUIRE(Hash(Nz::HashType_XXHash64, "") == "ef46db3751d8e999");
+				REQUIRE(Hash(Nz::HashType_XXHash64, "123456789") == "8cb841db40e6ae83");
+				REQUIRE(Hash(Nz::HashType_XXHash64, fox) == "0b242d361fda71bc");
+				REQUIRE(Hash(Nz::HashType_XXHash64, big.data(), big.size()) == "5f235fa033f1a3fb");
+				REQUIRE(Hash(Nz::HashType_XXHash64, big.data(), big.size(), 7) == "5f235fa033f1a3fb");
+			}
+		}
+
+		WHEN("We hash them with SHA-1 and SHA-2")
+		{
+			THEN("We get the reference digests")
+			{
+				REQUIRE(Hash(Nz::HashType_SHA1, "") == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+				REQUIRE(Hash(Nz::HashType_SHA1, fox) == "2fd4e1c67a2d28fced849ee1bb76e7391b93eb12");
+				REQUIRE(Hash(Nz::HashType_SHA1, big.data(), big.size(), 100) == "4231a8a50a10fa9758db8ec71fdef855b751048a");
+
+				REQUIRE(Hash(Nz::HashType_SHA224, fox) == "730e109bd7a8a32b1cb9d9a09aa2325d2430587ddbc0c38bad911525");
+
+				REQUIRE(Hash(Nz::HashType_SHA256, "") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+				REQUIRE(Hash(Nz::HashType_SHA256, fox) == "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
+				REQUIRE(Hash(Nz::HashType_SHA256, big.data(), big.size(), 100) == "1e9bc38cbf860b9ec31918b065f9b52476c549a782e0e7990bed8ce3868d2371");
+			}
+		}
+
+		WHEN("We hash many inputs at once")
+		{
+			Nz::TaskScheduler::SetWorkerCount(4);
+
+			std::vector<const Nz::UInt8*> data(500);
+			std::vector<std::size_t> sizes(data.size());
+			for (std::size_t i = 0; i < data.size(); ++i)
+			{
+				data[i] = big.data() + i;
+				sizes[i] = i % 64;
+			}
+
+			std::vector<Nz::ByteArray> digests(data.size());
+			Nz::AbstractHash::ComputeMany(Nz::HashType_XXHash64, data.data(), sizes.data(), data.size(), digests.data());
+
+			THEN("Every digest matches the one computed alone")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < data.size(); ++i)
+				{
+					if (digests[i].ToHex() != Hash(Nz::HashType_XXHash64, data[i], sizes[i]))
+						valid = false;
+				}
+
+				REQUIRE(valid);
+			}
+
+			Nz::TaskScheduler::Uninitialize();
+		}
+	}
+}
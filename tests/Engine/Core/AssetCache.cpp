@@ -0,0 +1,94 @@
+#include <Nazara/Core/AssetCache.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFileView.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+
+SCENARIO("AssetCache", "[CORE][ASSETCACHE]")
+{
+	GIVEN("A source file and a cache directory")
+	{
+		{
+			Nz::File file("Cached Source.txt", Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+			file.Write(Nz::String("Source content"));
+		}
+
+		Nz::AssetCache::SetDirectory("Asset Cache");
+		REQUIRE(Nz::AssetCache::IsEnabled());
+
+		int variant = 42;
+		Nz::String entryPath = Nz::AssetCache::GetEntryPath("Cached Source.txt", "Test", &variant, sizeof(int));
+		REQUIRE(!entryPath.IsEmpty());
+
+		unsigned int hitCount = Nz::AssetCache::GetHitCount();
+		unsigned int missCount = Nz::AssetCache::GetMissCount();
+
+		WHEN("We look for an entry which was never written")
+		{
+			Nz::MappedFileView view;
+
+			THEN("It is a miss")
+			{
+				REQUIRE(!Nz::AssetCache::OpenEntry(entryPath, 1, &view));
+				REQUIRE(Nz::AssetCache::GetMissCount() == missCount + 1);
+			}
+		}
+
+		WHEN("We write an entry")
+		{
+			const char payload[] = "Built asset";
+			REQUIRE(Nz::AssetCache::WriteEntry(entryPath, 1, payload, sizeof(payload)));
+
+			THEN("It can be mapped back")
+			{
+				Nz::MappedFileView view;
+				REQUIRE(Nz::AssetCache::OpenEntry(entryPath, 1, &view));
+				REQUIRE(Nz::AssetCache::GetHitCount() == hitCount + 1);
+				REQUIRE(view.GetSize() - view.GetCursorPos() == sizeof(payload));
+				REQUIRE(std::memcmp(view.GetConstData() + view.GetCursorPos(), payload, sizeof(payload)) == 0);
+			}
+
+			THEN("Other variants and contents are different entries")
+			{
+				int otherVariant = 24;
+				REQUIRE(Nz::AssetCache::GetEntryPath("Cached Source.txt", "Test", &otherVariant, sizeof(int)) != entryPath);
+				REQUIRE(Nz::AssetCache::GetEntryPath("Cached Source.txt", "Other", &variant, sizeof(int)) != entryPath);
+
+				{
+					Nz::File file("Cached Source.txt", Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+					file.Write(Nz::String("Modified content"));
+				}
+
+				REQUIRE(Nz::AssetCache::GetEntryPath("Cached Source.txt", "Test", &variant, sizeof(int)) != entryPath);
+			}
+
+			THEN("An outdated format version is removed")
+			{
+				Nz::MappedFileView view;
+				REQUIRE(!Nz::AssetCache::OpenEntry(entryPath, 2, &view));
+				REQUIRE(!Nz::File::Exists(entryPath));
+			}
+
+			THEN("Invalidating the source removes it")
+			{
+				REQUIRE(Nz::AssetCache::Invalidate("Cached Source.txt"));
+				REQUIRE(!Nz::File::Exists(entryPath));
+			}
+
+			THEN("Clearing the cache removes it")
+			{
+				REQUIRE(Nz::AssetCache::Clear());
+				REQUIRE(!Nz::File::Exists(entryPath));
+			}
+		}
+
+		Nz::AssetCache::Clear();
+		Nz::AssetCache::SetDirectory(Nz::String());
+		REQUIRE(!Nz::AssetCache::IsEnabled());
+
+		Nz::Directory::Remove("Asset Cache");
+		Nz::File::Delete("Cached Source.txt");
+	}
+}
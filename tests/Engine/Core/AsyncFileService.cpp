@@ -0,0 +1,209 @@
+#include <Nazara/Core/AsyncFileService.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Resource.hpp>
+#include <Nazara/Core/ResourceLoader.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct TextParams
+	{
+		bool IsValid() const
+		{
+			return true;
+		}
+	};
+
+	class Text;
+
+	using TextLoader = Nz::ResourceLoader<Text, TextParams>;
+
+	class Text : public Nz::Resource
+	{
+		friend TextLoader;
+
+		public:
+			Nz::String content;
+			Nz::String directory;
+
+			static bool IsExtensionSupported(const Nz::String& extension)
+			{
+				return extension == "txt";
+			}
+
+			static Nz::Ternary Check(Nz::Stream& stream, const TextParams&)
+			{
+				return (stream.GetSize() > 0) ? Nz::Ternary_True : Nz::Ternary_False;
+			}
+
+			static bool Load(Text* text, Nz::Stream& stream, const TextParams&)
+			{
+				text->content = stream.ReadLine();
+				text->directory = stream.GetDirectory();
+				return true;
+			}
+
+		private:
+			static TextLoader::LoaderList s_loaders;
+	};
+
+	TextLoader::LoaderList Text::s_loaders;
+}
+
+SCENARIO("AsyncFileService", "[CORE][ASYNCFILESERVICE]")
+{
+	GIVEN("A file")
+	{
+		{
+			Nz::File file("Async File.txt", Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+			file.Write(Nz::String("Asynchronous content"));
+		}
+
+		WHEN("We read it with a deferred completion")
+		{
+			bool called = false;
+			Nz::AsyncFileService::Read("Async File.txt", [&called](Nz::AsyncFileService::ReadResult& result)
+			{
+				called = true;
+
+				REQUIRE(result.success);
+				REQUIRE(result.filePath == "Async File.txt");
+				REQUIRE(result.data.GetSize() == 20);
+				REQUIRE(std::memcmp(result.data.GetConstBuffer(), "Asynchronous", 12) == 0);
+			});
+
+			Nz::AsyncFileService::WaitForRequests();
+
+			THEN("The callback is only called when completions are dispatched")
+			{
+				REQUIRE(!called);
+				REQUIRE(Nz::AsyncFileService::GetPendingRequestCount() == 0);
+				REQUIRE(Nz::AsyncFileService::DispatchCompletions() == 1);
+				REQUIRE(called);
+			}
+		}
+
+		WHEN("We read a batch of ranges, one of them being invalid")
+		{
+			std::vector<Nz::String> results(4);
+			std::vector<bool> successes(4);
+
+			std::vector<Nz::AsyncFileService::ReadRequest> requests(4);
+			for (std::size_t i = 0; i < requests.size(); ++i)
+			{
+				requests[i].callback = [&results, &successes, i](Nz::AsyncFileService::ReadResult& result)
+				{
+					results[i] = result.data.ToString();
+					successes[i] = result.success;
+				};
+				requests[i].filePath = "Async File.txt";
+			}
+
+			requests[0].offset = 13;
+			requests[1].size = 5;
+			requests[2].filePath = "Missing File.txt";
+			requests[3].offset = 15;
+			requests[3].size = 10;
+
+			Nz::AsyncFileService::Read(requests.data(), requests.size());
+			Nz::AsyncFileService::WaitForRequests();
+
+			THEN("Every callback is called with its own result")
+			{
+				REQUIRE(Nz::AsyncFileService::DispatchCompletions() == 4);
+
+				REQUIRE(successes[0]);
+				REQUIRE(results[0] == "content");
+				REQUIRE(successes[1]);
+				REQUIRE(results[1] == "Async");
+				REQUIRE(!successes[2]);
+				REQUIRE(!successes[3]);
+			}
+		}
+
+		WHEN("We read it with completions on the task scheduler")
+		{
+			std::atomic_uint completed(0);
+			for (unsigned int i = 0; i < 10; ++i)
+			{
+				Nz::AsyncFileService::Read("Async File.txt", [&completed](Nz::AsyncFileService::ReadResult& result)
+				{
+					if (result.success && result.data.GetSize() == 20)
+						completed++;
+				}, Nz::CompletionMode_TaskScheduler);
+			}
+
+			// Waits for the task completions as well
+			Nz::AsyncFileService::Uninitialize();
+
+			THEN("Every callback has been run without dispatching")
+			{
+				REQUIRE(completed == 10);
+				REQUIRE(Nz::AsyncFileService::DispatchCompletions() == 0);
+			}
+		}
+
+		WHEN("Several threads make their first read at the same time")
+		{
+			Nz::AsyncFileService::Uninitialize();
+
+			std::atomic_uint completed(0);
+			std::vector<std::thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&completed]()
+				{
+					Nz::AsyncFileService::Read("Async File.txt", [&completed](Nz::AsyncFileService::ReadResult& result)
+					{
+						if (result.success)
+							completed++;
+					});
+				});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			Nz::AsyncFileService::WaitForRequests();
+
+			THEN("The service is initialized once and serves every read")
+			{
+				REQUIRE(Nz::AsyncFileService::IsInitialized());
+				REQUIRE(Nz::AsyncFileService::DispatchCompletions() == 4);
+				REQUIRE(completed == 4);
+			}
+		}
+
+		WHEN("We load a resource asynchronously")
+		{
+			TextLoader::RegisterLoader(Text::IsExtensionSupported, Text::Check, Text::Load);
+
+			Text text;
+			bool loaded = false;
+			REQUIRE(TextLoader::LoadFromFileAsync(&text, "Async File.txt", [&loaded](Text*, bool success) { loaded = success; }));
+
+			Nz::AsyncFileService::WaitForRequests();
+			Nz::AsyncFileService::DispatchCompletions();
+
+			TextLoader::UnregisterLoader(Text::IsExtensionSupported, Text::Check, Text::Load);
+
+			THEN("It is loaded from the file content")
+			{
+				REQUIRE(loaded);
+				REQUIRE(text.content == "Asynchronous content");
+				REQUIRE(text.GetFilePath() == "Async File.txt");
+				REQUIRE(text.directory == Nz::File::GetDirectory(Nz::File::NormalizePath("Async File.txt")));
+			}
+		}
+
+		Nz::AsyncFileService::Uninitialize();
+		Nz::TaskScheduler::Uninitialize();
+		Nz::File::Delete("Async File.txt");
+	}
+}
@@ -0,0 +1,124 @@
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+	class CountingLogger : public Nz::AbstractLogger
+	{
+		public:
+			CountingLogger(std::atomic_size_t& writeCount, std::atomic_size_t& errorCount) :
+			m_errorCount(errorCount),
+			m_writeCount(writeCount)
+			{
+			}
+
+			void EnableStdReplication(bool /*enable*/) override
+			{
+			}
+
+			bool IsStdReplicationEnabled() override
+			{
+				return false;
+			}
+
+			void Write(const Nz::String& string) override
+			{
+				if (string == "Message")
+					m_writeCount++;
+			}
+
+			void WriteError(Nz::ErrorType type, const Nz::String& error, unsigned int line, const char* /*file*/, const char* /*function*/) override
+			{
+				if (type == Nz::ErrorType_Warning && error == "Warning" && line == 42)
+					m_errorCount++;
+			}
+
+		private:
+			std::atomic_size_t& m_errorCount;
+			std::atomic_size_t& m_writeCount;
+	};
+}
+
+SCENARIO("AsyncLogger", "[CORE][ASYNCLOGGER]")
+{
+	std::atomic_size_t writeCount(0);
+	std::atomic_size_t errorCount(0);
+
+	GIVEN("An asynchronous logger blocking when full")
+	{
+		Nz::AsyncLogger logger(std::unique_ptr<Nz::AbstractLogger>(new CountingLogger(writeCount, errorCount)), 100);
+
+		REQUIRE(logger.GetQueueSize() == 128);
+
+		WHEN("Many threads log at the same time")
+		{
+			constexpr unsigned int ThreadCount = 4;
+			constexpr unsigned int MessageCount = 2000;
+
+			std::vector<Nz::Thread> threads;
+			for (unsigned int i = 0; i < ThreadCount; ++i)
+			{
+				threads.emplace_back([&logger] ()
+				{
+					for (unsigned int j = 0; j < MessageCount; ++j)
+					{
+						if (j % 10 == 0)
+							logger.WriteError(Nz::ErrorType_Warning, "Warning", 42, __FILE__, "Test");
+						else
+							logger.Write("Message");
+					}
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			logger.Flush();
+
+			THEN("Every message is written once flushed")
+			{
+				REQUIRE(errorCount == ThreadCount * MessageCount / 10);
+				REQUIRE(writeCount == ThreadCount * MessageCount - errorCount);
+				REQUIRE(logger.GetDroppedCount() == 0);
+			}
+		}
+	}
+
+	GIVEN("An asynchronous logger dropping messages when full")
+	{
+		constexpr unsigned int MessageCount = 10000;
+
+		Nz::AsyncLogger logger(std::unique_ptr<Nz::AbstractLogger>(new CountingLogger(writeCount, errorCount)), 4, Nz::LogOverflowPolicy_Drop);
+
+		WHEN("We log faster than the messages are written")
+		{
+			for (unsigned int i = 0; i < MessageCount; ++i)
+				logger.Write("Message");
+
+			logger.Flush();
+
+			THEN("Messages are either written or counted as dropped")
+			{
+				REQUIRE(writeCount + logger.GetDroppedCount() == MessageCount);
+			}
+		}
+	}
+
+	GIVEN("An asynchronous logger destroyed with queued messages")
+	{
+		{
+			Nz::AsyncLogger logger(std::unique_ptr<Nz::AbstractLogger>(new CountingLogger(writeCount, errorCount)));
+			for (unsigned int i = 0; i < 1000; ++i)
+				logger.Write("Message");
+		}
+
+		THEN("They are written before the destruction")
+		{
+			REQUIRE(writeCount == 1000);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#include <Nazara/Core/Bitset.hpp>
+#include <Catch/catch.hpp>
+
+#include <vector>
+
+SCENARIO("Bitset", "[CORE][BITSET]")
+{
+	GIVEN("Two large bitsets")
+	{
+		Nz::Bitset<Nz::UInt64> multiplesOf3(1000);
+		Nz::Bitset<Nz::UInt64> multiplesOf5(1003);
+		for (unsigned int i = 0; i < 1000; i += 3)
+			multiplesOf3.Set(i);
+
+		for (unsigned int i = 0; i < 1003; i += 5)
+			multiplesOf5.Set(i);
+
+		WHEN("We combine them")
+		{
+			Nz::Bitset<Nz::UInt64> andResult = multiplesOf3 & multiplesOf5;
+			Nz::Bitset<Nz::UInt64> orResult = multiplesOf3 | multiplesOf5;
+			Nz::Bitset<Nz::UInt64> xorResult = multiplesOf3 ^ multiplesOf5;
+			Nz::Bitset<Nz::UInt64> notResult = ~multiplesOf3;
+
+			THEN("Every bit is computed and the counts match")
+			{
+				REQUIRE(andResult.GetSize() == 1003);
+				REQUIRE(andResult.Count() == 67);
+				REQUIRE(orResult.Count() == 334 + 201 - 67);
+				REQUIRE(xorResult.Count() == 334 + 201 - 2 * 67);
+				REQUIRE(notResult.Count() == 1000 - 334);
+
+				for (unsigned int i = 0; i < 1000; ++i)
+				{
+					if (andResult.Test(i) != (i % 15 == 0) || orResult.Test(i) != (i % 3 == 0 || i % 5 == 0))
+						FAIL("Bit " << i << " is wrong");
+				}
+			}
+
+			THEN("The operation can be done in place")
+			{
+				Nz::Bitset<Nz::UInt64> bitset = multiplesOf3;
+				bitset &= multiplesOf5;
+				REQUIRE(bitset == andResult);
+
+				bitset = multiplesOf5;
+				bitset |= multiplesOf3;
+				REQUIRE(bitset == orResult);
+
+				bitset = multiplesOf3;
+				bitset ^= multiplesOf5;
+				REQUIRE(bitset == xorResult);
+			}
+		}
+
+		WHEN("We iterate over the set bits")
+		{
+			std::vector<unsigned int> bits;
+			multiplesOf5.ForEachSetBit([&bits](unsigned int bit) { bits.push_back(bit); });
+
+			THEN("We get the same bits as with FindFirst/FindNext")
+			{
+				std::vector<unsigned int> expectedBits;
+				for (unsigned int i = multiplesOf5.FindFirst(); i != multiplesOf5.npos; i = multiplesOf5.FindNext(i))
+					expectedBits.push_back(i);
+
+				REQUIRE(bits.size() == 201);
+				REQUIRE(bits == expectedBits);
+			}
+		}
+	}
+
+	GIVEN("A component mask")
+	{
+		Nz::Bitset<> components("10110");
+		Nz::Bitset<> required("110");
+		Nz::Bitset<> excluded("1000001");
+
+		THEN("It matches filters with a single test")
+		{
+			REQUIRE(components.Matches(required, excluded));
+			REQUIRE_FALSE(components.Matches(Nz::Bitset<>("1000"), Nz::Bitset<>()));
+			REQUIRE_FALSE(components.Matches(required, Nz::Bitset<>("10000")));
+			REQUIRE(Nz::Bitset<>().Matches(Nz::Bitset<>(), excluded));
+		}
+
+		THEN("TestAll only succeeds when every bit is set")
+		{
+			REQUIRE_FALSE(components.TestAll());
+			REQUIRE(Nz::Bitset<>("11111").TestAll());
+			REQUIRE(Nz::Bitset<>(64, true).TestAll());
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#include <Nazara/Core/ByteChain.hpp>
+#include <Nazara/Core/Serializer.hpp>
+#include <Nazara/Core/Unserializer.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+
+SCENARIO("ByteChain", "[CORE][BYTECHAIN]")
+{
+	GIVEN("A chain built from small appends and an adopted array")
+	{
+		Nz::ByteChain chain;
+		chain.Append("Hello", 5);
+		chain.Append(" ", 1);
+
+		Nz::ByteArray world("World", 5);
+		const Nz::UInt8* worldBuffer = world.GetConstBuffer();
+		chain.Append(std::move(world));
+
+		THEN("Small appends share a block and the array is not copied")
+		{
+			REQUIRE(chain.GetSize() == 11);
+			REQUIRE(chain.GetSegmentCount() == 2);
+			REQUIRE(chain.ToByteArray() == Nz::ByteArray("Hello World", 11));
+
+			Nz::ByteChain::Segment segments[2];
+			REQUIRE(chain.ExportSegments(segments, 2) == 2);
+			REQUIRE(segments[0].size == 6);
+			REQUIRE(segments[1].data == worldBuffer);
+			REQUIRE(segments[1].size == 5);
+		}
+
+		WHEN("We prepend a header and take slices")
+		{
+			chain.Prepend("[", 1);
+
+			Nz::ByteChain subChain = chain.SubChain(4, 5);
+			Nz::ByteChain copy(chain);
+			copy.Append("!", 1);
+
+			THEN("Slices reference the same memory without affecting the source")
+			{
+				REQUIRE(chain.ToByteArray() == Nz::ByteArray("[Hello World", 12));
+				REQUIRE(subChain.ToByteArray() == Nz::ByteArray("lo Wo", 5));
+				REQUIRE(subChain.GetSegmentCount() == 2);
+				REQUIRE(copy.ToByteArray() == Nz::ByteArray("[Hello World!", 13));
+				REQUIRE(chain.GetSize() == 12);
+
+				char buffer[4];
+				REQUIRE(chain.CopyTo(buffer, 4, 10) == 2);
+				REQUIRE(std::memcmp(buffer, "ld", 2) == 0);
+			}
+
+			AND_WHEN("We discard the sent part")
+			{
+				chain.Discard(7);
+
+				THEN("Only the remaining bytes are kept")
+				{
+					REQUIRE(chain.GetSize() == 5);
+					REQUIRE(chain.GetSegmentCount() == 1);
+					REQUIRE(chain.ToByteArray() == Nz::ByteArray("World", 5));
+				}
+			}
+		}
+
+		WHEN("We append the chain to itself")
+		{
+			chain.Append(chain);
+
+			THEN("Its content is repeated")
+			{
+				REQUIRE(chain.ToByteArray() == Nz::ByteArray("Hello WorldHello World", 22));
+			}
+		}
+	}
+
+	GIVEN("A byte chain stream")
+	{
+		Nz::ByteChainStream stream;
+
+		WHEN("We serialize values into it")
+		{
+			{
+				Nz::Serializer serializer(stream);
+				serializer << Nz::UInt32(0xDEADBEEF) << Nz::String("Nazara");
+			}
+
+			THEN("They can be read back from the chain")
+			{
+				REQUIRE(stream.GetSize() == 4 + 4 + 6);
+
+				Nz::UInt32 value;
+				Nz::String string;
+				Nz::Unserializer unserializer(stream);
+				unserializer >> value >> string;
+
+				REQUIRE(value == 0xDEADBEEF);
+				REQUIRE(string == "Nazara");
+				REQUIRE(stream.EndOfStream());
+			}
+		}
+	}
+}
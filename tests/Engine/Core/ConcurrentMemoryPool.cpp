@@ -0,0 +1,87 @@
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+SCENARIO("ConcurrentMemoryPool", "[CORE][CONCURRENTMEMORYPOOL]")
+{
+	GIVEN("A pool of 24 bytes blocks")
+	{
+		Nz::ConcurrentMemoryPool pool(24, 64, 8);
+
+		THEN("Blocks are rounded to keep them aligned")
+		{
+			REQUIRE(pool.GetBlockSize() % alignof(std::max_align_t) == 0);
+		}
+
+		WHEN("We allocate and free blocks from the same thread")
+		{
+			std::vector<void*> blocks;
+			for (unsigned int i = 0; i < 200; ++i)
+				blocks.push_back(pool.Allocate());
+
+			std::set<void*> uniqueBlocks(blocks.begin(), blocks.end());
+
+			pool.Free(blocks.data(), blocks.size());
+
+			THEN("Every block is distinct and freed blocks are reused")
+			{
+				REQUIRE(uniqueBlocks.size() == blocks.size());
+
+				std::size_t blockCount = pool.GetBlockCount();
+				for (unsigned int i = 0; i < 200; ++i)
+					blocks[i] = pool.Allocate();
+
+				pool.Free(blocks.data(), blocks.size());
+
+				REQUIRE(pool.GetBlockCount() == blockCount);
+			}
+		}
+
+		WHEN("Blocks are allocated by a thread and freed by others")
+		{
+			std::vector<void*> blocks(4000);
+			for (void*& block : blocks)
+				block = pool.New<unsigned int>(42U);
+
+			std::atomic_bool valid(true);
+			std::vector<std::thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&, i]()
+				{
+					for (std::size_t j = i; j < blocks.size(); j += 4)
+					{
+						unsigned int* value = static_cast<unsigned int*>(blocks[j]);
+						if (*value != 42U)
+							valid = false;
+
+						pool.Delete(value);
+
+						// Churn through the thread magazine
+						pool.Free(pool.Allocate());
+					}
+				});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			THEN("The blocks are given back to the pool")
+			{
+				REQUIRE(valid);
+
+				std::size_t blockCount = pool.GetBlockCount();
+				for (void*& block : blocks)
+					block = pool.Allocate();
+
+				REQUIRE(pool.GetBlockCount() == blockCount);
+
+				pool.Free(blocks.data(), blocks.size());
+			}
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#include <Nazara/Core/MappedFileView.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+
+SCENARIO("MappedFileView", "[CORE][MAPPEDFILEVIEW]")
+{
+	GIVEN("A file with a few lines")
+	{
+		{
+			Nz::File file("Mapped File.txt", Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+			file.Write(Nz::String("First line\nSecond line\r\nLast"));
+		}
+
+		WHEN("We map it for reading")
+		{
+			Nz::MappedFileView view("Mapped File.txt");
+			REQUIRE(view.IsOpen());
+			REQUIRE(view.SetAccessPattern(Nz::AccessPattern_Sequential));
+
+			THEN("Its content is directly accessible")
+			{
+				REQUIRE(view.GetSize() == 28);
+				REQUIRE(view.GetMemoryPointer() == view.GetConstData());
+				REQUIRE(std::memcmp(view.GetConstData(), "First", 5) == 0);
+				REQUIRE(view.GetDirectory() == Nz::Directory::GetCurrent() + NAZARA_DIRECTORY_SEPARATOR);
+			}
+
+			AND_THEN("It can be read as a stream")
+			{
+				REQUIRE(view.ReadLine() == "First line");
+				REQUIRE(view.ReadLine() == "Second line\r");
+				REQUIRE(view.ReadLine() == "Last");
+				REQUIRE(view.EndOfStream());
+
+				char buffer[5];
+				view.SetCursorPos(6);
+				REQUIRE(view.Read(buffer, 4) == 4);
+				REQUIRE(std::memcmp(buffer, "line", 4) == 0);
+			}
+		}
+
+		WHEN("We map it for writing")
+		{
+			{
+				Nz::MappedFileView view("Mapped File.txt", Nz::OpenMode_ReadWrite);
+				REQUIRE(view.IsOpen());
+
+				view.GetData()[0] = 'f';
+				view.SetCursorPos(25);
+				REQUIRE(view.Write("TEXT", 4) == 3); // The file cannot grow
+			}
+
+			THEN("The file is modified")
+			{
+				Nz::File file("Mapped File.txt", Nz::OpenMode_ReadOnly | Nz::OpenMode_Text);
+				REQUIRE(file.GetSize() == 28);
+				REQUIRE(file.ReadLine() == "first line");
+				file.ReadLine();
+				REQUIRE(file.ReadLine() == "LTEX");
+			}
+		}
+
+		Nz::File::Delete("Mapped File.txt");
+	}
+
+	GIVEN("A file which does not exist")
+	{
+		Nz::MappedFileView view("This file does not exist.txt");
+
+		THEN("It cannot be mapped")
+		{
+			REQUIRE(!view.IsOpen());
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+SCENARIO("MemoryManager", "[CORE][MEMORYMANAGER]")
+{
+	GIVEN("A snapshot of the memory manager counters")
+	{
+		Nz::MemoryManager::Snapshot before = Nz::MemoryManager::TakeSnapshot();
+
+		WHEN("We allocate under different tags on two threads")
+		{
+			void* untagged = Nz::MemoryManager::Allocate(10);
+
+			void* rendererBlock;
+			{
+				Nz::MemoryTagScope scope(Nz::MemoryTag_Renderer);
+				rendererBlock = Nz::MemoryManager::Allocate(100);
+
+				{
+					Nz::MemoryTagScope nestedScope(Nz::MemoryTag_SDK);
+					Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(50));
+				}
+
+				REQUIRE(Nz::MemoryManager::GetCurrentTag() == Nz::MemoryTag_Renderer);
+			}
+
+			Nz::Thread thread([rendererBlock] ()
+			{
+				Nz::MemoryTagScope scope(Nz::MemoryTag_Utility);
+				Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(1000));
+
+				// Frees are attributed to the tag of the allocation
+				Nz::MemoryManager::Free(rendererBlock);
+			});
+			thread.Join();
+
+			Nz::MemoryManager::Snapshot diff = Nz::MemoryManager::Diff(before, Nz::MemoryManager::TakeSnapshot());
+			Nz::MemoryManager::Free(untagged);
+
+			THEN("Counters are split by tag")
+			{
+				CHECK(Nz::MemoryManager::GetCurrentTag() == Nz::MemoryTag_Unknown);
+				CHECK(diff.tags[Nz::MemoryTag_Unknown].allocationCount == 1);
+				CHECK(diff.tags[Nz::MemoryTag_Unknown].freeCount == 0);
+				CHECK(diff.tags[Nz::MemoryTag_Renderer].allocatedSize == 100);
+				CHECK(diff.tags[Nz::MemoryTag_Renderer].freedSize == 100);
+				CHECK(diff.tags[Nz::MemoryTag_SDK].allocationCount == 1);
+				CHECK(diff.tags[Nz::MemoryTag_SDK].freeCount == 1);
+				CHECK(diff.tags[Nz::MemoryTag_Utility].allocatedSize == 1000);
+				CHECK(std::string(Nz::MemoryManager::GetTagName(Nz::MemoryTag_Utility)) == "Utility");
+			}
+		}
+
+		WHEN("We allocate without leak tracking")
+		{
+			Nz::MemoryManager::EnableLeakTracking(false);
+
+			std::vector<void*> blocks;
+			for (unsigned int i = 0; i < 100; ++i)
+				blocks.push_back(Nz::MemoryManager::Allocate(16));
+
+			Nz::MemoryManager::EnableLeakTracking(true);
+
+			unsigned int liveBlocks = Nz::MemoryManager::GetAllocatedBlockCount();
+			for (void* block : blocks)
+				Nz::MemoryManager::Free(block);
+
+			THEN("Blocks are still counted")
+			{
+				CHECK(liveBlocks >= 100);
+				CHECK(Nz::MemoryManager::GetAllocatedBlockCount() == liveBlocks - 100);
+
+				Nz::MemoryManager::Snapshot diff = Nz::MemoryManager::Diff(before, Nz::MemoryManager::TakeSnapshot());
+				CHECK(diff.tags[Nz::MemoryTag_Unknown].allocationCount == 100);
+				CHECK(diff.tags[Nz::MemoryTag_Unknown].freedSize == 1600);
+			}
+		}
+
+		WHEN("We sample every allocation call stack")
+		{
+			Nz::MemoryManager::ClearCallStackSamples();
+			Nz::MemoryManager::SetCallStackSamplingRate(1);
+
+			for (unsigned int i = 0; i < 10; ++i)
+				Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(32, false, __FILE__, 42));
+
+			Nz::MemoryManager::SetCallStackSamplingRate(0);
+
+			THEN("Allocations from the same call site are aggregated")
+			{
+				Nz::MemoryManager::CallStackSample samples[4];
+				REQUIRE(Nz::MemoryManager::GetCallStackSamples(samples, 4) == 1);
+				CHECK(samples[0].sampleCount == 10);
+				CHECK(samples[0].sampledSize == 320);
+				CHECK(samples[0].line == 42);
+				CHECK(samples[0].frameCount > 0);
+			}
+		}
+
+		WHEN("We enable sampling while another thread is already running")
+		{
+			Nz::MemoryManager::ClearCallStackSamples();
+
+			std::atomic_bool allocated(false);
+			std::atomic_bool samplingEnabled(false);
+			Nz::Thread thread([&allocated, &samplingEnabled] ()
+			{
+				// Sampling is disabled when this thread first allocates
+				Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(16));
+				allocated = true;
+
+				while (!samplingEnabled)
+					Nz::Thread::Sleep(1);
+
+				for (unsigned int i = 0; i < 5; ++i)
+					Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(64, false, __FILE__, 24));
+			});
+
+			while (!allocated)
+				Nz::Thread::Sleep(1);
+
+			Nz::MemoryManager::SetCallStackSamplingRate(1);
+			samplingEnabled = true;
+			thread.Join();
+
+			Nz::MemoryManager::SetCallStackSamplingRate(0);
+
+			THEN("The running thread samples too")
+			{
+				Nz::MemoryManager::CallStackSample samples[4];
+				REQUIRE(Nz::MemoryManager::GetCallStackSamples(samples, 4) == 1);
+				CHECK(samples[0].sampleCount == 5);
+				CHECK(samples[0].line == 24);
+			}
+		}
+	}
+}
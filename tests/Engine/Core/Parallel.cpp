@@ -0,0 +1,72 @@
+#include <Nazara/Core/Parallel.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+SCENARIO("Parallel", "[CORE][PARALLEL]")
+{
+	GIVEN("A big array of numbers")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+
+		std::vector<unsigned int> values(100000);
+
+		WHEN("We fill it with ParallelFor")
+		{
+			std::atomic_uint callCount(0);
+			Nz::ParallelFor(0, values.size(), [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					values[i] += static_cast<unsigned int>(i);
+
+				callCount++;
+			}, 1000);
+
+			THEN("Every index has been processed once")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					valid = valid && (values[i] == i);
+
+				REQUIRE(valid);
+				REQUIRE(callCount > 1);
+			}
+
+			AND_THEN("We sum it with ParallelReduce")
+			{
+				unsigned long long sum = Nz::ParallelReduce(0, values.size(), 0ULL, [&](std::size_t first, std::size_t last, unsigned long long& partialSum)
+				{
+					for (std::size_t i = first; i < last; ++i)
+						partialSum += values[i];
+				},
+				[](unsigned long long lhs, unsigned long long rhs)
+				{
+					return lhs + rhs;
+				}, 1000);
+
+				REQUIRE(sum == 99999ULL * 100000ULL / 2ULL);
+			}
+		}
+
+		WHEN("The range is smaller than the grain size")
+		{
+			unsigned int callCount = 0;
+			Nz::ParallelFor(0, 10, [&](std::size_t first, std::size_t last)
+			{
+				REQUIRE(first == 0);
+				REQUIRE(last == 10);
+				callCount++;
+			}, 100);
+
+			THEN("It is processed inline in one call")
+			{
+				REQUIRE(callCount == 1);
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+}
@@ -0,0 +1,97 @@
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	const Nz::Profiler::ZoneStats* FindZone(const char* name)
+	{
+		const auto& zones = Nz::Profiler::GetLastFrameStats().zones;
+		auto it = std::find_if(zones.begin(), zones.end(), [name] (const Nz::Profiler::ZoneStats& stats)
+		{
+			return std::strcmp(stats.name, name) == 0;
+		});
+
+		return (it != zones.end()) ? &*it : nullptr;
+	}
+}
+
+SCENARIO("Profiler", "[CORE][PROFILER]")
+{
+	GIVEN("Nested zones opened on two threads")
+	{
+		Nz::Profiler::EndFrame(); // Discard zones of previous tests
+		Nz::Profiler::StartCapture();
+
+		auto work = [] ()
+		{
+			Nz::ProfilerZone frameZone("Test::Frame");
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				Nz::ProfilerZone childZone("Test::Child");
+
+				Nz::UInt64 begin = Nz::GetElapsedMicroseconds();
+				while (Nz::GetElapsedMicroseconds() - begin < 1000);
+			}
+		};
+
+		Nz::Thread thread(work);
+		work();
+		thread.Join();
+
+		WHEN("We end the frame")
+		{
+			Nz::Profiler::EndFrame();
+			Nz::Profiler::StopCapture();
+
+			THEN("Zones are aggregated by name across threads")
+			{
+				const Nz::Profiler::ZoneStats* frameStats = FindZone("Test::Frame");
+				const Nz::Profiler::ZoneStats* childStats = FindZone("Test::Child");
+				REQUIRE(frameStats);
+				REQUIRE(childStats);
+
+				CHECK(frameStats->callCount == 2);
+				CHECK(childStats->callCount == 6);
+				CHECK(childStats->totalTime >= 6 * 1000);
+				CHECK(frameStats->totalTime >= childStats->totalTime);
+				CHECK(frameStats->selfTime == frameStats->totalTime - childStats->totalTime);
+				CHECK(Nz::Profiler::GetLastFrameStats().zones.front().totalTime == frameStats->totalTime);
+				CHECK(Nz::Profiler::GetLastFrameStats().droppedEvents == 0);
+			}
+
+			THEN("The capture can be exported as a Chrome trace")
+			{
+				Nz::MemoryStream stream;
+				REQUIRE(Nz::Profiler::ExportChromeTrace(stream));
+
+				Nz::String json(reinterpret_cast<const char*>(stream.GetBuffer().GetConstBuffer()), static_cast<std::size_t>(stream.GetSize()));
+				CHECK(json.StartsWith("{\"traceEvents\":["));
+				CHECK(json.Count("\"name\":\"Test::Child\"") == 6);
+				CHECK(json.Find("\"ph\":\"X\"") != Nz::String::npos);
+			}
+		}
+
+		WHEN("The profiler is disabled")
+		{
+			Nz::Profiler::Enable(false);
+			work();
+			Nz::Profiler::Enable(true);
+
+			Nz::Profiler::EndFrame();
+			Nz::Profiler::StopCapture();
+
+			THEN("Only the zones recorded while enabled are reported")
+			{
+				const Nz::Profiler::ZoneStats* frameStats = FindZone("Test::Frame");
+				REQUIRE(frameStats);
+				CHECK(frameStats->callCount == 2);
+			}
+		}
+	}
+}
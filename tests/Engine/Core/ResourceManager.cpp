@@ -0,0 +1,171 @@
+#include <Nazara/Core/ResourceManager.hpp>
+#include <Nazara/Core/AsyncFileService.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/RefCounted.hpp>
+#include <Nazara/Core/Resource.hpp>
+#include <Catch/catch.hpp>
+
+#include <memory>
+
+namespace
+{
+	struct TestParams
+	{
+		bool IsValid() const
+		{
+			return true;
+		}
+	};
+
+	class TestResource;
+
+	using TestResourceManager = Nz::ResourceManager<TestResource, TestParams>;
+	using TestResourceRef = Nz::ObjectRef<TestResource>;
+
+	class TestResource : public Nz::RefCounted, public Nz::Resource
+	{
+		friend TestResourceManager;
+
+		public:
+			Nz::String content;
+			Nz::String directory;
+
+			bool LoadFromFile(const Nz::String& filePath, const TestParams&)
+			{
+				Nz::File file(filePath, Nz::OpenMode_ReadOnly);
+				if (!file.IsOpen())
+					return false;
+
+				content = file.ReadLine();
+				return true;
+			}
+
+			bool LoadFromStream(Nz::Stream& stream, const TestParams&)
+			{
+				content = stream.ReadLine();
+				directory = stream.GetDirectory();
+				return true;
+			}
+
+			static TestResourceRef New()
+			{
+				std::unique_ptr<TestResource> object(new TestResource);
+				object->SetPersistent(false);
+
+				return object.release();
+			}
+
+		private:
+			static TestResourceManager::ManagerMap s_managerMap;
+			static TestResourceManager::ManagerParams s_managerParameters;
+			static TestResourceManager::ManagerState s_managerState;
+	};
+
+	TestResourceManager::ManagerMap TestResource::s_managerMap;
+	TestResourceManager::ManagerParams TestResource::s_managerParameters;
+	TestResourceManager::ManagerState TestResource::s_managerState;
+
+	void LoadStreamedResources()
+	{
+		TestResourceManager::Update();
+		Nz::AsyncFileService::WaitForRequests();
+		Nz::AsyncFileService::DispatchCompletions();
+	}
+}
+
+SCENARIO("ResourceManager", "[CORE][RESOURCEMANAGER]")
+{
+	GIVEN("Three resource files")
+	{
+		for (const char* name : {"Resource A.txt", "Resource B.txt", "Resource C.txt"})
+		{
+			Nz::File file(name, Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+			file.Write(Nz::String("Content of ") + name);
+		}
+
+		WHEN("We get a resource without streaming")
+		{
+			TestResourceRef resource = TestResourceManager::Get("Resource A.txt");
+
+			THEN("It is loaded right away and shared")
+			{
+				REQUIRE(resource);
+				REQUIRE(resource->content == "Content of Resource A.txt");
+				REQUIRE(TestResourceManager::Get("Resource A.txt").Get() == resource.Get());
+
+				TestResourceManager::ResourceInfo info;
+				REQUIRE(TestResourceManager::GetInfo("Resource A.txt", &info));
+				REQUIRE(info.state == Nz::ResourceState_Loaded);
+				REQUIRE(info.residentSize == 25);
+				REQUIRE(TestResourceManager::GetResidentSize() == 25);
+			}
+		}
+
+		WHEN("We stream resources with priorities")
+		{
+			TestResourceManager::EnableStreaming(true);
+			TestResourceManager::SetMaxConcurrentLoads(1);
+
+			TestResourceRef low = TestResourceManager::Get("Resource A.txt", 0);
+			TestResourceRef high = TestResourceManager::Get("Resource B.txt", 10);
+			TestResourceRef cancelled = TestResourceManager::Get("Resource C.txt", 5);
+
+			THEN("They are returned empty and loaded by priority")
+			{
+				REQUIRE(high->content.IsEmpty());
+
+				REQUIRE(TestResourceManager::Cancel("Resource C.txt"));
+
+				LoadStreamedResources();
+				REQUIRE(high->content == "Content of Resource B.txt");
+				REQUIRE(low->content.IsEmpty());
+
+				TestResourceManager::ResourceInfo info;
+				REQUIRE(TestResourceManager::GetInfo("Resource A.txt", &info));
+				REQUIRE(info.state == Nz::ResourceState_Queued);
+				REQUIRE(TestResourceManager::GetInfo("Resource B.txt", &info));
+				REQUIRE(info.state == Nz::ResourceState_Loaded);
+				REQUIRE(high->GetFilePath() == Nz::File::AbsolutePath("Resource B.txt"));
+				REQUIRE(high->directory == Nz::File::GetDirectory(Nz::File::AbsolutePath("Resource B.txt")));
+
+				LoadStreamedResources();
+				REQUIRE(low->content == "Content of Resource A.txt");
+
+				LoadStreamedResources();
+				REQUIRE(cancelled->content.IsEmpty());
+				REQUIRE(!TestResourceManager::GetInfo("Resource C.txt", &info));
+			}
+
+			AND_WHEN("A memory budget is set")
+			{
+				LoadStreamedResources();
+				LoadStreamedResources();
+
+				TestResourceManager::SetMemoryBudget(30);
+				TestResourceManager::Get("Resource A.txt"); // Most recently used
+
+				low.Reset();
+				high.Reset();
+				TestResourceManager::Update();
+
+				THEN("The least recently used unreferenced resources are evicted")
+				{
+					TestResourceManager::ResourceInfo info;
+					REQUIRE(TestResourceManager::GetInfo("Resource A.txt", &info));
+					REQUIRE(!TestResourceManager::GetInfo("Resource B.txt", &info));
+					REQUIRE(TestResourceManager::GetResidentSize() == 25);
+				}
+			}
+
+			TestResourceManager::EnableStreaming(false);
+			TestResourceManager::SetMaxConcurrentLoads(4);
+			TestResourceManager::SetMemoryBudget(0);
+		}
+
+		TestResourceManager::Clear();
+		Nz::AsyncFileService::Uninitialize();
+
+		for (const char* name : {"Resource A.txt", "Resource B.txt", "Resource C.txt"})
+			Nz::File::Delete(name);
+	}
+}
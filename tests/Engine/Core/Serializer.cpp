@@ -0,0 +1,148 @@
+#include <Nazara/Core/Serializer.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/Unserializer.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Catch/catch.hpp>
+
+#include <limits>
+
+namespace
+{
+	struct Snapshot
+	{
+		Nz::UInt32 health;
+		Nz::UInt32 ammo;
+		float position[3];
+	};
+}
+
+SCENARIO("Serializer", "[CORE][SERIALIZER]")
+{
+	GIVEN("A serializer writing into a memory stream")
+	{
+		Nz::MemoryStream stream;
+		Nz::Serializer serializer(stream);
+		Nz::SerializationContext& context = serializer.GetContext();
+
+		WHEN("We write varints and zig-zag integers")
+		{
+			REQUIRE(Nz::SerializeVarInt(context, Nz::UInt32(1)));
+			REQUIRE(Nz::SerializeVarInt(context, Nz::UInt32(300)));
+			REQUIRE(Nz::SerializeVarInt(context, std::numeric_limits<Nz::UInt64>::max()));
+			REQUIRE(Nz::SerializeZigZag(context, Nz::Int32(-1)));
+			REQUIRE(Nz::SerializeZigZag(context, std::numeric_limits<Nz::Int64>::min()));
+
+			THEN("Small values take less space and are read back")
+			{
+				REQUIRE(stream.GetSize() == 1 + 2 + 10 + 1 + 10);
+				REQUIRE(stream.GetBuffer()[1] == 0xAC);
+				REQUIRE(stream.GetBuffer()[2] == 0x02);
+
+				stream.SetCursorPos(0);
+				Nz::Unserializer unserializer(stream);
+				Nz::UnserializationContext& readContext = unserializer.GetContext();
+
+				Nz::UInt32 small, medium;
+				Nz::UInt64 large;
+				Nz::Int32 negative;
+				Nz::Int64 minimum;
+				REQUIRE(Nz::UnserializeVarInt(readContext, &small));
+				REQUIRE(Nz::UnserializeVarInt(readContext, &medium));
+				REQUIRE(Nz::UnserializeVarInt(readContext, &large));
+				REQUIRE(Nz::UnserializeZigZag(readContext, &negative));
+				REQUIRE(Nz::UnserializeZigZag(readContext, &minimum));
+
+				CHECK(small == 1);
+				CHECK(medium == 300);
+				CHECK(large == std::numeric_limits<Nz::UInt64>::max());
+				CHECK(negative == -1);
+				CHECK(minimum == std::numeric_limits<Nz::Int64>::min());
+			}
+
+			THEN("A varint too large for the target type is rejected")
+			{
+				stream.SetCursorPos(3);
+				Nz::Unserializer unserializer(stream);
+
+				Nz::UInt32 value;
+				REQUIRE_FALSE(Nz::UnserializeVarInt(unserializer.GetContext(), &value));
+			}
+		}
+
+		WHEN("We pack bits, booleans and quantized values")
+		{
+			REQUIRE(Nz::SerializeBits(context, 5, 3));
+			serializer << true;
+			REQUIRE(Nz::SerializeQuantized(context, 0.5f, -1.f, 1.f, 10));
+			REQUIRE(Nz::SerializeQuantized(context, Nz::Vector3f(-10.f, 2.5f, 100.f), -50.f, 50.f, 12));
+			REQUIRE(Nz::SerializeQuantized(context, Nz::Quaternionf(Nz::EulerAnglesf(30.f, -45.f, 120.f)), 12));
+			serializer.FlushBits();
+
+			THEN("They share bytes and are read back within the quantization precision")
+			{
+				// 3 + 1 + 10 + 3 * 12 + 2 + 3 * 12 bits
+				REQUIRE(stream.GetSize() == 11);
+
+				stream.SetCursorPos(0);
+				Nz::Unserializer unserializer(stream);
+				Nz::UnserializationContext& readContext = unserializer.GetContext();
+
+				Nz::UInt64 bits;
+				bool flag;
+				float value;
+				Nz::Vector3f vector;
+				Nz::Quaternionf rotation;
+				REQUIRE(Nz::UnserializeBits(readContext, &bits, 3));
+				unserializer >> flag;
+				REQUIRE(Nz::UnserializeQuantized(readContext, &value, -1.f, 1.f, 10));
+				REQUIRE(Nz::UnserializeQuantized(readContext, &vector, -50.f, 50.f, 12));
+				REQUIRE(Nz::UnserializeQuantized(readContext, &rotation, 12));
+
+				CHECK(bits == 5);
+				CHECK(flag);
+				CHECK(value == Approx(0.5f).epsilon(0.002f));
+				CHECK(vector.x == Approx(-10.f).epsilon(0.005f));
+				CHECK(vector.y == Approx(2.5f).epsilon(0.01f));
+				CHECK(vector.z == Approx(50.f));
+
+				Nz::Quaternionf expected(Nz::EulerAnglesf(30.f, -45.f, 120.f));
+				CHECK(std::abs(rotation.DotProduct(expected)) == Approx(1.f).epsilon(0.001f));
+			}
+		}
+
+		WHEN("We write values against a baseline")
+		{
+			Snapshot baseline = {100, 30, {1.f, 2.f, 3.f}};
+			Snapshot current = baseline;
+			current.ammo = 29;
+
+			REQUIRE(Nz::SerializeDelta(context, current, baseline));
+			REQUIRE(Nz::SerializeDelta(context, baseline, baseline));
+			REQUIRE(Nz::SerializeDelta(context, Nz::UInt32(1000), Nz::UInt32(1003)));
+			serializer.FlushBits();
+
+			THEN("Only the differences are written")
+			{
+				// Changed flag, one bit per byte and the changed byte, then the unchanged flag (in the same byte)
+				REQUIRE(stream.GetSize() == (1 + sizeof(Snapshot) + 8 + 1 + 7) / 8 + 1);
+
+				stream.SetCursorPos(0);
+				Nz::Unserializer unserializer(stream);
+				Nz::UnserializationContext& readContext = unserializer.GetContext();
+
+				Snapshot decoded, unchanged;
+				Nz::UInt32 integer;
+				REQUIRE(Nz::UnserializeDelta(readContext, &decoded, baseline));
+				REQUIRE(Nz::UnserializeDelta(readContext, &unchanged, baseline));
+				REQUIRE(Nz::UnserializeDelta(readContext, &integer, Nz::UInt32(1003)));
+
+				CHECK(decoded.health == 100);
+				CHECK(decoded.ammo == 29);
+				CHECK(decoded.position[2] == 3.f);
+				CHECK(unchanged.ammo == 30);
+				CHECK(integer == 1000);
+			}
+		}
+	}
+}
@@ -0,0 +1,188 @@
+#include <Nazara/Core/Signal.hpp>
+#include <Catch/catch.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Counter
+	{
+		void Increment(int value)
+		{
+			count += value;
+		}
+
+		int count = 0;
+	};
+}
+
+SCENARIO("Signal", "[CORE][SIGNAL]")
+{
+	GIVEN("A signal")
+	{
+		Nz::Signal<int> signal;
+
+		WHEN("We connect a method and a lambda")
+		{
+			Counter counter;
+			int lambdaSum = 0;
+
+			Nz::Signal<int>::Connection methodConnection = signal.Connect(counter, &Counter::Increment);
+			Nz::Signal<int>::ConnectionGuard lambdaConnection = signal.Connect([&lambdaSum](int value) { lambdaSum += value; });
+
+			signal(2);
+			signal(3);
+
+			THEN("Both are called on each emission")
+			{
+				REQUIRE(counter.count == 5);
+				REQUIRE(lambdaSum == 5);
+				REQUIRE(methodConnection.IsConnected());
+			}
+
+			AND_WHEN("We disconnect one of them")
+			{
+				methodConnection.Disconnect();
+				signal(10);
+
+				THEN("Only the other one is called")
+				{
+					REQUIRE(!methodConnection.IsConnected());
+					REQUIRE(lambdaConnection.IsConnected());
+					REQUIRE(counter.count == 5);
+					REQUIRE(lambdaSum == 15);
+				}
+			}
+		}
+
+		WHEN("Slots disconnect themselves and others during the emission")
+		{
+			int firstCount = 0;
+			int secondCount = 0;
+			int thirdCount = 0;
+
+			Nz::Signal<int>::Connection first;
+			Nz::Signal<int>::Connection second;
+			Nz::Signal<int>::Connection third;
+
+			first = signal.Connect([&](int)
+			{
+				firstCount++;
+				first.Disconnect();
+				third.Disconnect();
+			});
+
+			second = signal.Connect([&](int)
+			{
+				secondCount++;
+				signal.Connect([&](int) { thirdCount += 100; });
+			});
+
+			third = signal.Connect([&](int) { thirdCount++; });
+
+			signal(0);
+
+			THEN("Disconnected slots are not called and connected slots are called by the same emission")
+			{
+				REQUIRE(firstCount == 1);
+				REQUIRE(secondCount == 1);
+				REQUIRE(thirdCount == 100);
+				REQUIRE(!first.IsConnected());
+				REQUIRE(!third.IsConnected());
+				REQUIRE(second.IsConnected());
+
+				second.Disconnect();
+				signal(0);
+
+				REQUIRE(firstCount == 1);
+				REQUIRE(secondCount == 1);
+				REQUIRE(thirdCount == 200);
+			}
+		}
+
+		WHEN("A slot throws during the emission")
+		{
+			std::shared_ptr<int> resource = std::make_shared<int>(0);
+
+			Nz::Signal<int>::Connection throwing = signal.Connect([](int) { throw 42; });
+			Nz::Signal<int>::Connection holder = signal.Connect([resource](int) {});
+
+			REQUIRE_THROWS(signal(0));
+
+			THEN("The emission is over and slots are released right away again")
+			{
+				REQUIRE(resource.use_count() == 2);
+
+				holder.Disconnect();
+				REQUIRE(resource.use_count() == 1);
+
+				throwing.Disconnect();
+				signal(0);
+			}
+		}
+
+		WHEN("We move a signal into itself")
+		{
+			int count = 0;
+			Nz::Signal<int>::Connection connection = signal.Connect([&count](int) { count++; });
+
+			Nz::Signal<int>& self = signal;
+			signal = std::move(self);
+			signal(0);
+
+			THEN("It is left untouched")
+			{
+				REQUIRE(connection.IsConnected());
+				REQUIRE(count == 1);
+			}
+		}
+
+		WHEN("A connection outlives its signal")
+		{
+			std::unique_ptr<Nz::Signal<int>> temporarySignal(new Nz::Signal<int>);
+			Nz::Signal<int>::ConnectionGuard guard = temporarySignal->Connect([](int) {});
+
+			Nz::Signal<int> movedSignal(std::move(*temporarySignal));
+			REQUIRE(guard.IsConnected());
+
+			movedSignal.Clear();
+			REQUIRE(!guard.IsConnected());
+
+			guard.Connect(*temporarySignal, [](int) {});
+			temporarySignal.reset();
+
+			THEN("It is disconnected")
+			{
+				REQUIRE(!guard.IsConnected());
+			}
+		}
+
+		WHEN("Copies of a connection are released from several threads")
+		{
+			std::unique_ptr<Nz::Signal<int>> temporarySignal(new Nz::Signal<int>);
+			Nz::Signal<int>::Connection connection = temporarySignal->Connect([](int) {});
+
+			std::vector<std::thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([connection]()
+				{
+					for (unsigned int j = 0; j < 10000; ++j)
+						Nz::Signal<int>::Connection copy(connection);
+				});
+			}
+
+			temporarySignal.reset();
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			THEN("The slot table is only freed once the last reference is gone")
+			{
+				REQUIRE(!connection.IsConnected());
+			}
+		}
+	}
+}
@@ -0,0 +1,100 @@
+#include <Nazara/Core/StackArena.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+SCENARIO("StackArena", "[CORE][STACKARENA]")
+{
+	GIVEN("An arena of 1024 bytes blocks")
+	{
+		Nz::StackArena arena(1024);
+
+		WHEN("We allocate aligned memory")
+		{
+			void* first = arena.Allocate(3, 1);
+			void* second = arena.Allocate(16, 16);
+
+			THEN("Allocations follow each other and respect the alignment")
+			{
+				REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 16 == 0);
+				REQUIRE(static_cast<Nz::UInt8*>(second) > static_cast<Nz::UInt8*>(first));
+				REQUIRE(arena.GetAllocatedBytes() >= 19);
+				REQUIRE(arena.GetOverflowCount() == 0);
+			}
+		}
+
+		WHEN("We use markers")
+		{
+			void* first = arena.Allocate(96);
+			Nz::StackArena::Marker marker = arena.GetMarker();
+
+			{
+				Nz::StackArena::ScopedMarker scopedMarker(arena);
+				arena.Allocate(200);
+				arena.Allocate(2000); // Overflows
+			}
+
+			THEN("Rewinding frees what was allocated after the marker")
+			{
+				REQUIRE(arena.GetAllocatedBytes() == marker.allocatedBytes);
+				REQUIRE(arena.GetOverflowCount() == 1);
+				REQUIRE(arena.GetPeakBytes() >= 2296);
+				REQUIRE(arena.Allocate(100) == static_cast<Nz::UInt8*>(first) + 96);
+			}
+
+			AND_THEN("Resetting merges the blocks")
+			{
+				std::size_t capacity = arena.GetCapacity();
+				arena.Reset();
+
+				REQUIRE(arena.GetAllocatedBytes() == 0);
+				REQUIRE(arena.GetCapacity() == capacity);
+
+				arena.ResetStats();
+				arena.Allocate(capacity / 2);
+				arena.Allocate(capacity / 4);
+
+				REQUIRE(arena.GetOverflowCount() == 0);
+			}
+		}
+
+		WHEN("We use it with a standard container")
+		{
+			std::vector<int, Nz::StackAllocator<int>> values{Nz::StackAllocator<int>(arena)};
+			for (int i = 0; i < 100; ++i)
+				values.push_back(i);
+
+			THEN("The container memory comes from the arena")
+			{
+				REQUIRE(values.size() == 100);
+				REQUIRE(values[99] == 99);
+				REQUIRE(arena.GetAllocatedBytes() >= 100 * sizeof(int));
+			}
+		}
+	}
+	GIVEN("An arena which overflowed into blocks of different sizes")
+	{
+		Nz::StackArena arena(64);
+		Nz::StackArena::Marker marker = arena.GetMarker();
+
+		arena.Allocate(60, 1);
+		arena.Allocate(60, 1);  // Second block
+		arena.Allocate(200, 1); // Third block, bigger than the others
+
+		arena.Rewind(marker);
+
+		WHEN("An allocation skips a block too small for it")
+		{
+			arena.Allocate(60, 1);
+			arena.Allocate(100, 1);
+
+			THEN("The skipped block counts as allocated")
+			{
+				// The end of the first block and the whole second block are lost until the next rewind
+				REQUIRE(arena.GetAllocatedBytes() == 64 + 64 + 100);
+				REQUIRE(arena.GetOverflowCount() == 2);
+			}
+		}
+	}
+}
@@ -82,6 +82,133 @@ SCENARIO("String", "[CORE][STRING]")
 		}
 	}
 
+	GIVEN("A short string and a long string")
+	{
+		// The inline buffer shares its storage with the shared string pointer
+		REQUIRE(sizeof(Nz::String) <= 2 * sizeof(void*) + sizeof(std::size_t));
+
+		Nz::String shortString("short");
+		Nz::String longString("a string which is too long to be stored inline");
+
+		WHEN("We copy and modify them")
+		{
+			Nz::String shortCopy = shortString;
+			Nz::String longCopy = longString;
+
+			shortCopy[0] = 'S';
+			longCopy[0] = 'A';
+
+			THEN("The originals are untouched")
+			{
+				REQUIRE(shortString == "short");
+				REQUIRE(shortCopy == "Short");
+				REQUIRE(longString[0] == 'a');
+				REQUIRE(longCopy[0] == 'A');
+			}
+		}
+
+		WHEN("We grow the short string and shrink the long one")
+		{
+			shortString.Append(" and now it is a long one");
+			longString.Resize(4);
+
+			THEN("Their content is preserved")
+			{
+				REQUIRE(shortString == "short and now it is a long one");
+				REQUIRE(longString == "a st");
+				REQUIRE(longString.GetCapacity() >= 4);
+			}
+		}
+
+		WHEN("We move them")
+		{
+			Nz::String movedShort(std::move(shortString));
+			Nz::String movedLong(std::move(longString));
+
+			THEN("The content follows")
+			{
+				REQUIRE(movedShort == "short");
+				REQUIRE(movedLong == "a string which is too long to be stored inline");
+				REQUIRE(shortString.IsEmpty());
+				REQUIRE(longString.IsEmpty());
+			}
+		}
+
+		WHEN("We move assign them")
+		{
+			Nz::String movedShort("a string which will be replaced");
+			Nz::String movedLong("replaced");
+			movedShort = std::move(shortString);
+			movedLong = std::move(longString);
+
+			THEN("The content follows and the sources are left empty")
+			{
+				REQUIRE(movedShort == "short");
+				REQUIRE(movedLong == "a string which is too long to be stored inline");
+				REQUIRE(shortString.IsEmpty());
+				REQUIRE(longString.IsEmpty());
+			}
+		}
+
+		WHEN("We swap them")
+		{
+			shortString.Swap(longString);
+
+			THEN("Both contents are exchanged")
+			{
+				REQUIRE(longString == "short");
+				REQUIRE(shortString == "a string which is too long to be stored inline");
+			}
+		}
+	}
+
+	GIVEN("A long string")
+	{
+		Nz::String longString = Nz::String(100, "abcd") + "NEEDLE in a haystack" + Nz::String(10, "\xC3\xA9");
+
+		WHEN("We search in it")
+		{
+			THEN("Results are the same as with short strings")
+			{
+				REQUIRE(longString.Find("NEEDLE") == 400);
+				REQUIRE(longString.Find("needle", 0, Nz::String::CaseInsensitive) == 400);
+				REQUIRE(longString.Find("needle") == Nz::String::npos);
+				REQUIRE(longString.Find('N', 10) == 400);
+				REQUIRE(longString.Find('n', 0, Nz::String::CaseInsensitive) == 400);
+				REQUIRE(longString.Count('a') == 103);
+				REQUIRE(longString.Count("bcd") == 100);
+				REQUIRE(longString.Count("ABCD", 0, Nz::String::CaseInsensitive) == 100);
+			}
+		}
+
+		WHEN("We convert its case")
+		{
+			Nz::String upper = longString.ToUpper();
+			Nz::String lower = upper.ToLower(Nz::String::HandleUtf8);
+
+			THEN("ASCII letters are converted and other characters are preserved")
+			{
+				REQUIRE(upper.SubString(0, 3) == "ABCD");
+				REQUIRE(upper.EndsWith(Nz::String(10, "\xC3\xA9")));
+				REQUIRE(lower.StartsWith("abcdabcd"));
+				REQUIRE(lower.Find("needle in a haystack") == 400);
+				REQUIRE(longString.ToUpper(Nz::String::HandleUtf8).StartsWith("ABCDABCD"));
+				REQUIRE(longString.ToUpper(Nz::String::HandleUtf8).GetLength() == longString.GetLength());
+			}
+		}
+
+		WHEN("We decode it")
+		{
+			THEN("Multi-byte characters are counted once")
+			{
+				REQUIRE(longString.GetSize() == 440);
+				REQUIRE(longString.GetLength() == 430);
+				REQUIRE(longString.GetUtf32String().size() == 430);
+				REQUIRE(longString.GetUtf16String().back() == 0xE9);
+			}
+		}
+	}
+
 	/* TODO
 	GIVEN("One unicode string")
 	{
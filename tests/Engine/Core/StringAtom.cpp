@@ -0,0 +1,117 @@
+#include <Nazara/Core/StringAtom.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+SCENARIO("StringAtom", "[CORE][STRINGATOM]")
+{
+	GIVEN("Atoms built from the same string")
+	{
+		Nz::StringAtom first("DIFFUSE_MAPPING");
+		Nz::StringAtom second(Nz::String("DIFFUSE") + "_MAPPING");
+		Nz::StringAtom other("ALPHA_MAPPING");
+
+		THEN("They share the same entry")
+		{
+			REQUIRE(first == second);
+			REQUIRE(first != other);
+			REQUIRE(first.GetHash() == second.GetHash());
+			REQUIRE(first.GetString() == "DIFFUSE_MAPPING");
+		}
+
+		WHEN("We use them as keys")
+		{
+			std::unordered_map<Nz::StringAtom, int> map;
+			map[first] = 1;
+			map[other] = 2;
+
+			THEN("They can be found from a string")
+			{
+				REQUIRE(map.size() == 2);
+				REQUIRE(map[Nz::StringAtom("DIFFUSE_MAPPING")] == 1);
+
+				Nz::StringAtom found;
+				REQUIRE(Nz::StringAtom::Find("ALPHA_MAPPING", &found));
+				REQUIRE(map.find(found) != map.end());
+			}
+		}
+	}
+
+	GIVEN("A string which was never interned")
+	{
+		Nz::String string = "NEVER_INTERNED_STRING";
+
+		WHEN("We look for its atom")
+		{
+			Nz::StringAtom atom;
+			bool found = Nz::StringAtom::Find(string, &atom);
+
+			THEN("It is not found, and looking for it doesn't intern it")
+			{
+				REQUIRE_FALSE(found);
+				REQUIRE(atom.IsEmpty());
+				REQUIRE_FALSE(Nz::StringAtom::Find(string, &atom));
+
+				Nz::StringAtom interned(string);
+				REQUIRE(Nz::StringAtom::Find(string, &atom));
+				REQUIRE(atom == interned);
+			}
+		}
+	}
+
+	GIVEN("An empty atom")
+	{
+		Nz::StringAtom empty;
+
+		THEN("It is equal to an atom built from an empty string")
+		{
+			REQUIRE(empty.IsEmpty());
+			REQUIRE(empty == Nz::StringAtom(""));
+			REQUIRE(empty.GetString().IsEmpty());
+		}
+	}
+	GIVEN("Threads interning many strings while others look them up")
+	{
+		constexpr unsigned int threadCount = 4;
+		constexpr unsigned int stringCount = 1000; // Per thread, enough for the atom table to grow a few times
+
+		Nz::StringAtom firstAtom("CONCURRENT_0_0");
+		std::atomic_bool mismatch(false);
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([i, &firstAtom, &mismatch] ()
+			{
+				for (unsigned int j = 0; j < stringCount; ++j)
+				{
+					Nz::String string = "CONCURRENT_" + Nz::String::Number(i) + '_' + Nz::String::Number(j);
+					Nz::StringAtom atom(string);
+
+					Nz::StringAtom found;
+					if (!Nz::StringAtom::Find(string, &found) || found != atom || atom.GetString() != string)
+						mismatch = true;
+
+					// An atom interned before the table grew stays the same
+					if (!Nz::StringAtom::Find("CONCURRENT_0_0", &found) || found != firstAtom)
+						mismatch = true;
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		THEN("Every lookup finds the atom of its string")
+		{
+			REQUIRE_FALSE(mismatch);
+
+			Nz::StringAtom found;
+			REQUIRE(Nz::StringAtom::Find("CONCURRENT_3_999", &found));
+			REQUIRE(found == Nz::StringAtom("CONCURRENT_3_999"));
+		}
+	}
+}
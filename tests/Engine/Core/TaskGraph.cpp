@@ -0,0 +1,64 @@
+#include <Nazara/Core/TaskGraph.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+
+SCENARIO("TaskGraph", "[CORE][TASKGRAPH]")
+{
+	GIVEN("A diamond shaped graph")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+
+		std::atomic_uint step(0);
+		unsigned int firstStep = 0;
+		unsigned int leftStep = 0;
+		unsigned int rightStep = 0;
+		unsigned int lastStep = 0;
+
+		Nz::TaskGraph graph;
+		Nz::TaskGraph::TaskId first = graph.AddTask([&]() { firstStep = ++step; });
+		Nz::TaskGraph::TaskId left = graph.AddContinuation(first, [&]() { leftStep = ++step; });
+		Nz::TaskGraph::TaskId right = graph.AddContinuation(first, [&]() { rightStep = ++step; });
+		Nz::TaskGraph::TaskId last = graph.AddTask([&]() { lastStep = ++step; });
+		graph.AddDependency(last, left);
+		graph.AddDependency(last, right);
+
+		WHEN("We execute it twice")
+		{
+			REQUIRE(graph.Execute());
+			REQUIRE(graph.Execute());
+
+			THEN("Dependencies are respected")
+			{
+				REQUIRE(step == 8);
+				REQUIRE(firstStep == 5);
+				REQUIRE(leftStep > firstStep);
+				REQUIRE(rightStep > firstStep);
+				REQUIRE(lastStep == 8);
+			}
+
+			THEN("The critical path goes through the whole graph")
+			{
+				const std::vector<Nz::TaskGraph::TaskId>& criticalPath = graph.GetCriticalPath();
+				REQUIRE(criticalPath.size() == 3);
+				REQUIRE(criticalPath.front() == first);
+				REQUIRE(criticalPath.back() == last);
+				REQUIRE(graph.GetCriticalPathTime() <= graph.GetExecutionTime());
+			}
+		}
+
+		WHEN("We add a cycle")
+		{
+			graph.AddDependency(first, last);
+
+			THEN("The graph cannot be executed")
+			{
+				REQUIRE(!graph.Execute());
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+}
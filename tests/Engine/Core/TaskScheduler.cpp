@@ -0,0 +1,133 @@
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+SCENARIO("TaskScheduler", "[CORE][TASKSCHEDULER]")
+{
+	GIVEN("A task scheduler with four workers")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+		REQUIRE(Nz::TaskScheduler::Initialize());
+
+		WHEN("We run a lot of small tasks")
+		{
+			std::atomic_uint sum(0);
+			for (unsigned int i = 1; i <= 10000; ++i)
+				Nz::TaskScheduler::AddTask([&sum, i]() { sum += i; });
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Every task has been executed once")
+			{
+				REQUIRE(sum == 10000U * 10001U / 2U);
+			}
+		}
+
+		WHEN("We wait on two counters")
+		{
+			std::atomic_uint firstCount(0);
+			std::atomic_uint secondCount(0);
+
+			Nz::TaskScheduler::Counter firstCounter;
+			for (unsigned int i = 0; i < 100; ++i)
+				Nz::TaskScheduler::AddTask([&firstCount]() { firstCount++; });
+
+			Nz::TaskScheduler::Run(firstCounter);
+
+			Nz::TaskScheduler::Counter secondCounter;
+			for (unsigned int i = 0; i < 50; ++i)
+				Nz::TaskScheduler::AddTask([&secondCount]() { secondCount++; });
+
+			Nz::TaskScheduler::Run(secondCounter);
+
+			Nz::TaskScheduler::WaitForTasks(secondCounter);
+			Nz::TaskScheduler::WaitForTasks(firstCounter);
+
+			THEN("Each counter tracks its own tasks")
+			{
+				REQUIRE(firstCounter.IsDone());
+				REQUIRE(secondCounter.IsDone());
+				REQUIRE(firstCount == 100);
+				REQUIRE(secondCount == 50);
+			}
+		}
+
+		WHEN("We submit tasks of different sizes, from tasks")
+		{
+			std::atomic_uint sum(0);
+			std::array<unsigned int, 64> medium;
+			std::array<unsigned int, 512> big;
+			medium.fill(1);
+			big.fill(1);
+
+			Nz::TaskScheduler::Counter counter;
+			for (unsigned int i = 0; i < 1000; ++i)
+			{
+				Nz::TaskScheduler::Submit(counter, [&sum, &counter, medium, big]()
+				{
+					sum += medium[0];
+					Nz::TaskScheduler::Submit(counter, [&sum, big]() { sum += big[0]; });
+				});
+			}
+
+			Nz::TaskScheduler::WaitForTasks(counter);
+
+			THEN("Every task has been executed once")
+			{
+				REQUIRE(counter.IsDone());
+				REQUIRE(sum == 2000);
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+
+	GIVEN("A task scheduler with a single busy worker")
+	{
+		Nz::TaskScheduler::SetWorkerCount(1);
+		REQUIRE(Nz::TaskScheduler::Initialize());
+
+		std::atomic_bool release(false);
+		Nz::TaskScheduler::Counter blockerCounter;
+		Nz::TaskScheduler::Submit(blockerCounter, [&release]()
+		{
+			while (!release)
+				std::this_thread::yield();
+		});
+
+		WHEN("We uninitialize it while tasks are still queued")
+		{
+			std::atomic_uint executed(0);
+			Nz::TaskScheduler::Counter counter;
+			for (unsigned int i = 0; i < 100; ++i)
+				Nz::TaskScheduler::Submit(counter, [&executed]() { executed++; });
+
+			std::thread releaser([&release]()
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				release = true;
+			});
+
+			Nz::TaskScheduler::Uninitialize();
+			releaser.join();
+
+			THEN("The counters of the discarded tasks are done as well")
+			{
+				REQUIRE(blockerCounter.IsDone());
+				REQUIRE(counter.IsDone());
+				REQUIRE(counter.GetPendingTaskCount() == 0);
+				REQUIRE(executed < 100);
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+}
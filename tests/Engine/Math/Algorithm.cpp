@@ -48,6 +48,14 @@ TEST_CASE("CountBits", "[ALGORITHM]")
 	{
 		REQUIRE(Nz::CountBits(0) == 0);
 	}
+
+	SECTION("Negative numbers of narrow signed types only count their own bits")
+	{
+		REQUIRE(Nz::CountBits(static_cast<Nz::Int8>(-1)) == 8);
+		REQUIRE(Nz::CountBits(static_cast<Nz::Int16>(-1)) == 16);
+		REQUIRE(Nz::CountBits(static_cast<Nz::Int8>(-128)) == 1);
+		REQUIRE(Nz::CountBits(static_cast<Nz::Int64>(-1)) == 64);
+	}
 }
 
 TEST_CASE("DegreeToRadian", "[ALGORITHM]")
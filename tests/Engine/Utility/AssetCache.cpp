@@ -0,0 +1,132 @@
+#include <Nazara/Core/AssetCache.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+
+namespace
+{
+	const char md5Mesh[] =
+		"MD5Version 10\n"
+		"commandline \"\"\n"
+		"\n"
+		"numJoints 1\n"
+		"numMeshes 1\n"
+		"\n"
+		"joints {\n"
+		"\t\"origin\"\t-1 ( 0 0 0 ) ( 0 0 0 )\n"
+		"}\n"
+		"\n"
+		"mesh {\n"
+		"\tshader \"skin.tga\"\n"
+		"\n"
+		"\tnumverts 3\n"
+		"\tvert 0 ( 0 0 ) 0 1\n"
+		"\tvert 1 ( 1 0 ) 1 1\n"
+		"\tvert 2 ( 0 1 ) 2 1\n"
+		"\n"
+		"\tnumtris 1\n"
+		"\ttri 0 0 1 2\n"
+		"\n"
+		"\tnumweights 3\n"
+		"\tweight 0 0 1 ( 0 0 0 )\n"
+		"\tweight 1 0 1 ( 1 0 0 )\n"
+		"\tweight 2 0 1 ( 0 1 0 )\n"
+		"}\n";
+
+	void WriteFile(const Nz::String& filePath, const void* data, std::size_t size)
+	{
+		Nz::File file(filePath, Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+		REQUIRE(file.IsOpen());
+		REQUIRE(file.Write(data, size) == size);
+	}
+}
+
+SCENARIO("AssetCache round trip", "[UTILITY][ASSETCACHE]")
+{
+	Nz::Initializer<Nz::Utility> utility;
+	REQUIRE(utility);
+
+	Nz::AssetCache::SetDirectory("Asset Cache");
+	REQUIRE(Nz::AssetCache::IsEnabled());
+
+	GIVEN("An image file")
+	{
+		// 2x2 RGB binary PPM
+		const char ppm[] = "P6\n2 2\n255\n\xFF\x00\x00\x00\xFF\x00\x00\x00\xFF\xFF\xFF\xFF";
+		WriteFile("Cached Image.ppm", ppm, sizeof(ppm) - 1);
+
+		Nz::Image source;
+		REQUIRE(source.LoadFromFile("Cached Image.ppm"));
+
+		WHEN("We load it again")
+		{
+			unsigned int hitCount = Nz::AssetCache::GetHitCount();
+
+			Nz::Image cached;
+			REQUIRE(cached.LoadFromFile("Cached Image.ppm"));
+
+			THEN("It is read back from the cache with the same pixels")
+			{
+				REQUIRE(Nz::AssetCache::GetHitCount() == hitCount + 1);
+				REQUIRE(cached.GetFormat() == source.GetFormat());
+				REQUIRE(cached.GetWidth() == 2);
+				REQUIRE(cached.GetHeight() == 2);
+				REQUIRE(cached.GetLevelCount() == source.GetLevelCount());
+				REQUIRE(std::memcmp(cached.GetConstPixels(), source.GetConstPixels(), source.GetMemoryUsage()) == 0);
+			}
+		}
+
+		Nz::File::Delete("Cached Image.ppm");
+	}
+
+	GIVEN("The same static mesh file in two directories")
+	{
+		REQUIRE(Nz::Directory::Create("Cached Mesh A"));
+		REQUIRE(Nz::Directory::Create("Cached Mesh B"));
+		WriteFile("Cached Mesh A/mesh.md5mesh", md5Mesh, sizeof(md5Mesh) - 1);
+		WriteFile("Cached Mesh B/mesh.md5mesh", md5Mesh, sizeof(md5Mesh) - 1);
+
+		Nz::MeshParams params;
+		params.animated = false;
+
+		Nz::Mesh source;
+		REQUIRE(source.LoadFromFile("Cached Mesh A/mesh.md5mesh", params));
+		REQUIRE(source.GetMaterialCount() == 1);
+		REQUIRE(source.GetMaterial(0) == Nz::File::GetDirectory(Nz::File::NormalizePath("Cached Mesh A/mesh.md5mesh")) + "skin.tga");
+
+		WHEN("We load the copy living in the other directory")
+		{
+			unsigned int hitCount = Nz::AssetCache::GetHitCount();
+
+			Nz::Mesh cached;
+			REQUIRE(cached.LoadFromFile("Cached Mesh B/mesh.md5mesh", params));
+
+			THEN("It is read back from the cache with its materials next to it")
+			{
+				REQUIRE(Nz::AssetCache::GetHitCount() == hitCount + 1);
+				REQUIRE(cached.IsValid());
+				REQUIRE(cached.GetAnimationType() == Nz::AnimationType_Static);
+				REQUIRE(cached.GetSubMeshCount() == source.GetSubMeshCount());
+				REQUIRE(cached.GetVertexCount() == source.GetVertexCount());
+				REQUIRE(cached.GetTriangleCount() == source.GetTriangleCount());
+				REQUIRE(cached.GetMaterialCount() == 1);
+				REQUIRE(cached.GetMaterial(0) == Nz::File::GetDirectory(Nz::File::NormalizePath("Cached Mesh B/mesh.md5mesh")) + "skin.tga");
+			}
+		}
+
+		Nz::File::Delete("Cached Mesh A/mesh.md5mesh");
+		Nz::File::Delete("Cached Mesh B/mesh.md5mesh");
+		Nz::Directory::Remove("Cached Mesh A");
+		Nz::Directory::Remove("Cached Mesh B");
+	}
+
+	Nz::AssetCache::Clear();
+	Nz::AssetCache::SetDirectory(Nz::String());
+	Nz::Directory::Remove("Asset Cache");
+}
@@ -0,0 +1,148 @@
+#include <NDK/BaseSystem.hpp>
+#include <NDK/Component.hpp>
+#include <NDK/System.hpp>
+#include <NDK/World.hpp>
+#include <Nazara/Core/CallOnExit.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+	class CounterComponent : public Ndk::Component<CounterComponent>
+	{
+		public:
+			CounterComponent(int v = 0) :
+			value(v),
+			visitCount(0)
+			{
+			}
+
+			CounterComponent(const CounterComponent& component) :
+			value(component.value),
+			visitCount(component.visitCount.load())
+			{
+			}
+
+			int value;
+			std::atomic_uint visitCount;
+
+			static Ndk::ComponentIndex componentIndex;
+	};
+
+	class MarkerComponent : public Ndk::Component<MarkerComponent>
+	{
+		public:
+			static Ndk::ComponentIndex componentIndex;
+	};
+
+	Ndk::ComponentIndex CounterComponent::componentIndex;
+	Ndk::ComponentIndex MarkerComponent::componentIndex;
+
+	class ParallelSystem : public Ndk::System<ParallelSystem>
+	{
+		public:
+			ParallelSystem()
+			{
+				Requires<CounterComponent>();
+				SetUpdateRate(0.f);
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+				ForEachParallel([] (const Ndk::EntityHandle& entity, Ndk::EntityCommandBuffer& commands)
+				{
+					CounterComponent& counter = entity->GetComponent<CounterComponent>();
+					counter.visitCount++;
+
+					// Odd entities are killed, even ones are marked
+					if (counter.value % 2 == 1)
+						commands.Kill(entity);
+					else
+						commands.AddComponent<MarkerComponent>(entity);
+				}, 7);
+			}
+	};
+
+	Ndk::SystemIndex ParallelSystem::systemIndex;
+
+	void RegisterTestComponents()
+	{
+		static bool registered = false;
+		if (!registered)
+		{
+			CounterComponent::componentIndex = CounterComponent::RegisterComponent("TCounter");
+			MarkerComponent::componentIndex = MarkerComponent::RegisterComponent("TMarker");
+
+			ParallelSystem::systemIndex = ParallelSystem::RegisterSystem();
+			registered = true;
+		}
+	}
+}
+
+SCENARIO("BaseSystem", "[NDK][BASESYSTEM]")
+{
+	RegisterTestComponents();
+
+	GIVEN("A system iterating over its entities in parallel")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+		Nz::CallOnExit stopScheduler([] ()
+		{
+			Nz::TaskScheduler::Uninitialize();
+			Nz::TaskScheduler::SetWorkerCount(0);
+		});
+
+		Ndk::World world(false);
+		ParallelSystem& system = world.AddSystem<ParallelSystem>();
+
+		// Not a multiple of the grain size, the last chunk is partial
+		constexpr int entityCount = 1000;
+
+		std::vector<Ndk::EntityHandle> entities;
+		for (int i = 0; i < entityCount; ++i)
+		{
+			entities.emplace_back(world.CreateEntity());
+			entities.back()->AddComponent<CounterComponent>(i);
+		}
+
+		Ndk::EntityHandle ignored = world.CreateEntity();
+		world.Update();
+
+		REQUIRE(system.GetEntities().size() == entityCount);
+
+		WHEN("We update it")
+		{
+			world.Update(0.f);
+
+			THEN("Every entity is visited exactly once and the recorded commands are applied")
+			{
+				for (int i = 0; i < entityCount; ++i)
+				{
+					const Ndk::EntityHandle& entity = entities[i];
+					REQUIRE(entity->GetComponent<CounterComponent>().visitCount == 1);
+
+					if (i % 2 == 0)
+						REQUIRE(entity->HasComponent<MarkerComponent>());
+					else
+						REQUIRE(!entity->HasComponent<MarkerComponent>());
+				}
+
+				REQUIRE(!ignored->HasComponent<MarkerComponent>());
+
+				world.Update();
+
+				for (int i = 0; i < entityCount; ++i)
+					REQUIRE(entities[i].IsValid() == (i % 2 == 0));
+
+				REQUIRE(system.GetEntities().size() == entityCount / 2);
+			}
+		}
+	}
+}
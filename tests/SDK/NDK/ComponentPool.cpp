@@ -0,0 +1,148 @@
+#include <NDK/ComponentPool.hpp>
+#include <NDK/Component.hpp>
+#include <NDK/World.hpp>
+#include <Catch/catch.hpp>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace
+{
+	class PooledComponent : public Ndk::Component<PooledComponent>
+	{
+		public:
+			PooledComponent(int v = 0) :
+			value(v)
+			{
+			}
+
+			PooledComponent(const PooledComponent&) = default;
+
+			~PooledComponent()
+			{
+				destroyedCount++;
+			}
+
+			int value;
+
+			static Ndk::ComponentIndex componentIndex;
+			static unsigned int destroyedCount;
+	};
+
+	Ndk::ComponentIndex PooledComponent::componentIndex;
+	unsigned int PooledComponent::destroyedCount = 0;
+
+	void RegisterTestComponents()
+	{
+		static bool registered = false;
+		if (!registered)
+		{
+			PooledComponent::componentIndex = PooledComponent::RegisterComponent("TPooled");
+			registered = true;
+		}
+	}
+}
+
+SCENARIO("ComponentPool", "[NDK][COMPONENTPOOL]")
+{
+	RegisterTestComponents();
+
+	GIVEN("A component pool")
+	{
+		Ndk::ComponentPool<PooledComponent> pool;
+
+		WHEN("We create more components than a chunk holds")
+		{
+			std::vector<PooledComponent*> components;
+			for (std::size_t i = 0; i < Ndk::ComponentPool<PooledComponent>::ChunkSize + 1; ++i)
+				components.push_back(pool.New(static_cast<int>(i)));
+
+			THEN("They are never moved and each one is visited once")
+			{
+				REQUIRE(pool.GetSize() == components.size());
+				for (std::size_t i = 0; i < components.size(); ++i)
+					REQUIRE(components[i]->value == static_cast<int>(i));
+
+				std::set<PooledComponent*> visited;
+				pool.ForEach([&visited] (PooledComponent& component)
+				{
+					REQUIRE(visited.insert(&component).second);
+				});
+
+				REQUIRE(visited == std::set<PooledComponent*>(components.begin(), components.end()));
+			}
+
+			AND_WHEN("We delete one and create another")
+			{
+				PooledComponent* deleted = components[42];
+				unsigned int destroyedCount = PooledComponent::destroyedCount;
+
+				pool.Delete(deleted);
+				REQUIRE(PooledComponent::destroyedCount == destroyedCount + 1);
+				REQUIRE(pool.GetSize() == components.size() - 1);
+
+				PooledComponent* created = pool.New(1000);
+
+				THEN("Its slot is reused")
+				{
+					REQUIRE(created == deleted);
+					REQUIRE(created->value == 1000);
+					REQUIRE(pool.GetSize() == components.size());
+				}
+			}
+		}
+
+		WHEN("We adopt a component allocated elsewhere")
+		{
+			PooledComponent* external = new PooledComponent(7);
+			pool.New(1);
+
+			Ndk::BaseComponent* adopted = pool.Adopt(std::unique_ptr<Ndk::BaseComponent>(external));
+
+			THEN("The pool owns it without moving it")
+			{
+				REQUIRE(adopted == external);
+				REQUIRE(pool.GetSize() == 2);
+
+				int sum = 0;
+				pool.ForEach([&sum] (PooledComponent& component)
+				{
+					sum += component.value;
+				});
+				REQUIRE(sum == 8);
+
+				unsigned int destroyedCount = PooledComponent::destroyedCount;
+				pool.Delete(adopted);
+
+				REQUIRE(PooledComponent::destroyedCount == destroyedCount + 1);
+				REQUIRE(pool.GetSize() == 1);
+			}
+		}
+	}
+
+	GIVEN("An entity")
+	{
+		Ndk::World world(false);
+		Ndk::EntityHandle entity = world.CreateEntity();
+
+		WHEN("We give it a component we allocated")
+		{
+			PooledComponent* component = new PooledComponent(3);
+			Ndk::BaseComponent& added = entity->AddComponent(std::unique_ptr<Ndk::BaseComponent>(component));
+
+			THEN("Our pointer to it stays valid")
+			{
+				REQUIRE(&added == component);
+				REQUIRE(&entity->GetComponent<PooledComponent>() == component);
+				REQUIRE(world.GetComponentPool<PooledComponent>().GetSize() == 1);
+
+				unsigned int destroyedCount = PooledComponent::destroyedCount;
+				entity->RemoveComponent<PooledComponent>();
+
+				REQUIRE(PooledComponent::destroyedCount == destroyedCount + 1);
+				REQUIRE(world.GetComponentPool<PooledComponent>().GetSize() == 0);
+			}
+		}
+	}
+}
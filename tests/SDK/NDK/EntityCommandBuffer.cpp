@@ -0,0 +1,130 @@
+#include <NDK/EntityCommandBuffer.hpp>
+#include <NDK/Component.hpp>
+#include <NDK/World.hpp>
+#include <Catch/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	class CommandComponent : public Ndk::Component<CommandComponent>
+	{
+		public:
+			CommandComponent(int v = 0) :
+			value(v)
+			{
+			}
+
+			int value;
+
+			static Ndk::ComponentIndex componentIndex;
+	};
+
+	Ndk::ComponentIndex CommandComponent::componentIndex;
+
+	void RegisterTestComponents()
+	{
+		static bool registered = false;
+		if (!registered)
+		{
+			CommandComponent::componentIndex = CommandComponent::RegisterComponent("TCommand");
+			registered = true;
+		}
+	}
+}
+
+SCENARIO("EntityCommandBuffer", "[NDK][ENTITYCOMMANDBUFFER]")
+{
+	RegisterTestComponents();
+
+	GIVEN("A world with two entities and a command buffer")
+	{
+		Ndk::World world(false);
+		Ndk::EntityHandle first = world.CreateEntity();
+		Ndk::EntityHandle second = world.CreateEntity();
+		world.Update();
+
+		Ndk::EntityCommandBuffer commands;
+
+		WHEN("We record component changes")
+		{
+			commands.AddComponent<CommandComponent>(first, 1);
+			commands.RemoveComponent<CommandComponent>(first);
+			commands.AddComponent<CommandComponent>(first, 2).value *= 10;
+			commands.AddComponent<CommandComponent>(second, 3);
+
+			THEN("Nothing changes until the buffer is applied")
+			{
+				REQUIRE(commands.GetCommandCount() == 4);
+				REQUIRE(!first->HasComponent<CommandComponent>());
+				REQUIRE(!second->HasComponent<CommandComponent>());
+			}
+
+			AND_WHEN("We apply it")
+			{
+				commands.Apply();
+
+				THEN("The commands are applied in the order they were recorded")
+				{
+					REQUIRE(commands.IsEmpty());
+					REQUIRE(first->GetComponent<CommandComponent>().value == 20);
+					REQUIRE(second->GetComponent<CommandComponent>().value == 3);
+				}
+			}
+		}
+
+		WHEN("We record the creation of entities before changing an existing one")
+		{
+			std::size_t entityCount = world.GetEntities().size();
+
+			for (int i = 0; i < 100; ++i)
+			{
+				std::vector<std::unique_ptr<Ndk::BaseComponent>> components;
+				components.emplace_back(new CommandComponent(i));
+
+				commands.CreateEntity(&world, std::move(components));
+			}
+			commands.CreateEntity(&world);
+			commands.AddComponent<CommandComponent>(second, 42);
+
+			commands.Apply();
+			world.Update();
+
+			THEN("The entities are created with their components and the existing one is still found")
+			{
+				const Ndk::World::EntityList& entities = world.GetEntities();
+				REQUIRE(entities.size() == entityCount + 101);
+
+				int componentSum = 0;
+				for (std::size_t i = entityCount; i < entities.size(); ++i)
+				{
+					if (entities[i]->HasComponent<CommandComponent>())
+						componentSum += entities[i]->GetComponent<CommandComponent>().value;
+				}
+				REQUIRE(componentSum == 99 * 100 / 2);
+				REQUIRE(!entities.back()->HasComponent<CommandComponent>());
+
+				REQUIRE(second->GetComponent<CommandComponent>().value == 42);
+			}
+		}
+
+		WHEN("We record a kill followed by a change of the same entity")
+		{
+			commands.Kill(first);
+			commands.AddComponent<CommandComponent>(first, 1);
+			commands.Apply();
+
+			THEN("The entity is killed once the world updates")
+			{
+				REQUIRE(first.IsValid());
+				REQUIRE(first->HasComponent<CommandComponent>());
+
+				world.Update();
+
+				REQUIRE(!first.IsValid());
+				REQUIRE(second.IsValid());
+			}
+		}
+	}
+}
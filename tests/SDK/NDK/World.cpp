@@ -0,0 +1,331 @@
+#include <NDK/World.hpp>
+#include <NDK/Component.hpp>
+#include <NDK/System.hpp>
+#include <Nazara/Core/CallOnExit.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+	class PrototypeComponent : public Ndk::Component<PrototypeComponent>
+	{
+		public:
+			PrototypeComponent(int v = 0) :
+			value(v)
+			{
+			}
+
+			int value;
+
+			static Ndk::ComponentIndex componentIndex;
+	};
+
+	Ndk::ComponentIndex PrototypeComponent::componentIndex;
+
+	class OtherComponent : public Ndk::Component<OtherComponent>
+	{
+		public:
+			static Ndk::ComponentIndex componentIndex;
+	};
+
+	Ndk::ComponentIndex OtherComponent::componentIndex;
+
+	std::atomic_bool s_writerDone;
+	std::atomic_bool s_readerSawWriterDone;
+
+	class WriterSystem : public Ndk::System<WriterSystem>
+	{
+		public:
+			WriterSystem()
+			{
+				Writes<PrototypeComponent>();
+				SetUpdateRate(0.f);
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+				// Gives a concurrent reader the time to start if nothing prevents it
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				s_writerDone = true;
+			}
+	};
+
+	class ReaderSystem : public Ndk::System<ReaderSystem>
+	{
+		public:
+			ReaderSystem()
+			{
+				Reads<PrototypeComponent>();
+				SetUpdateRate(0.f);
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+				s_readerSawWriterDone = s_writerDone.load();
+			}
+	};
+
+	class OtherWriterSystem : public Ndk::System<OtherWriterSystem>
+	{
+		public:
+			OtherWriterSystem()
+			{
+				Writes<OtherComponent>();
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+			}
+	};
+
+	class UndeclaredSystem : public Ndk::System<UndeclaredSystem>
+	{
+		public:
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+			}
+	};
+
+	class PrototypeSystem : public Ndk::System<PrototypeSystem>
+	{
+		public:
+			PrototypeSystem()
+			{
+				Requires<PrototypeComponent>();
+			}
+
+			void ExcludeOther()
+			{
+				Excludes<OtherComponent>();
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+			}
+	};
+
+	class OtherSystem : public Ndk::System<OtherSystem>
+	{
+		public:
+			OtherSystem()
+			{
+				Requires<OtherComponent>();
+			}
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float) override
+			{
+			}
+	};
+
+	Ndk::SystemIndex WriterSystem::systemIndex;
+	Ndk::SystemIndex ReaderSystem::systemIndex;
+	Ndk::SystemIndex OtherWriterSystem::systemIndex;
+	Ndk::SystemIndex UndeclaredSystem::systemIndex;
+	Ndk::SystemIndex PrototypeSystem::systemIndex;
+	Ndk::SystemIndex OtherSystem::systemIndex;
+
+	void RegisterTestComponents()
+	{
+		// Registered on first use, the component registry is itself a static of the SDK
+		static bool registered = false;
+		if (!registered)
+		{
+			PrototypeComponent::componentIndex = PrototypeComponent::RegisterComponent("TPrototy");
+			OtherComponent::componentIndex = OtherComponent::RegisterComponent("TOther");
+
+			WriterSystem::systemIndex = WriterSystem::RegisterSystem();
+			ReaderSystem::systemIndex = ReaderSystem::RegisterSystem();
+			OtherWriterSystem::systemIndex = OtherWriterSystem::RegisterSystem();
+			UndeclaredSystem::systemIndex = UndeclaredSystem::RegisterSystem();
+			PrototypeSystem::systemIndex = PrototypeSystem::RegisterSystem();
+			OtherSystem::systemIndex = OtherSystem::RegisterSystem();
+			registered = true;
+		}
+	}
+}
+
+SCENARIO("World", "[NDK][WORLD]")
+{
+	RegisterTestComponents();
+
+	GIVEN("A world with a prototype entity")
+	{
+		Ndk::World world(false);
+
+		Ndk::EntityHandle prototype = world.CreateEntity();
+		prototype->AddComponent<PrototypeComponent>(42);
+
+		WHEN("We clone it enough times for the world storage to grow")
+		{
+			unsigned int count = 1000;
+			Ndk::World::EntityList clones = world.CreateEntities(count, prototype);
+
+			THEN("Every clone has a copy of the prototype components")
+			{
+				REQUIRE(clones.size() == count);
+				for (const Ndk::EntityHandle& clone : clones)
+				{
+					REQUIRE(clone.IsValid());
+					REQUIRE(clone->HasComponent<PrototypeComponent>());
+					REQUIRE(clone->GetComponent<PrototypeComponent>().value == 42);
+					REQUIRE(clone->GetComponent<PrototypeComponent>().GetEntity() == clone);
+				}
+
+				REQUIRE(world.GetComponentPool<PrototypeComponent>().GetSize() == count + 1);
+			}
+		}
+	}
+
+	GIVEN("A world with systems declaring their component accesses")
+	{
+		// Several workers are needed for a missing dependency to show, they are stopped even if a requirement fails
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+		Nz::CallOnExit stopScheduler([] ()
+		{
+			Nz::TaskScheduler::Uninitialize();
+			Nz::TaskScheduler::SetWorkerCount(0);
+		});
+
+		Ndk::World world(false);
+
+		WriterSystem& writer = world.AddSystem<WriterSystem>();
+		ReaderSystem& reader = world.AddSystem<ReaderSystem>();
+		OtherWriterSystem& otherWriter = world.AddSystem<OtherWriterSystem>();
+		UndeclaredSystem& undeclared = world.AddSystem<UndeclaredSystem>();
+
+		THEN("Systems conflict when one writes what the other accesses")
+		{
+			REQUIRE(writer.ConflictsWith(reader));
+			REQUIRE(reader.ConflictsWith(writer));
+			REQUIRE(!writer.ConflictsWith(otherWriter));
+			REQUIRE(!reader.ConflictsWith(otherWriter));
+
+			// Not declaring anything means touching anything
+			REQUIRE(undeclared.ConflictsWith(writer));
+			REQUIRE(undeclared.ConflictsWith(reader));
+			REQUIRE(undeclared.ConflictsWith(otherWriter));
+		}
+
+		WHEN("We update it")
+		{
+			s_writerDone = false;
+			s_readerSawWriterDone = false;
+
+			world.Update(0.f);
+
+			THEN("Declared systems share a stage where conflicting ones still run in order")
+			{
+				REQUIRE(world.GetUpdateStats().stageCount == 2);
+				REQUIRE(s_readerSawWriterDone);
+			}
+
+			AND_WHEN("Parallel updates are disabled")
+			{
+				world.EnableParallelUpdate(false);
+				world.Update(0.f);
+
+				THEN("Every system has a stage of its own")
+				{
+					REQUIRE(world.GetUpdateStats().stageCount == 4);
+				}
+			}
+		}
+	}
+	GIVEN("A world with systems filtering different components")
+	{
+		Ndk::World world(false);
+		PrototypeSystem& prototypeSystem = world.AddSystem<PrototypeSystem>();
+		OtherSystem& otherSystem = world.AddSystem<OtherSystem>();
+
+		Ndk::EntityHandle entity = world.CreateEntity();
+		entity->AddComponent<PrototypeComponent>();
+		world.Update();
+
+		REQUIRE(prototypeSystem.HasEntity(entity));
+		REQUIRE(!otherSystem.HasEntity(entity));
+
+		WHEN("We add a component only one system filters")
+		{
+			entity->AddComponent<OtherComponent>();
+			world.Update();
+
+			THEN("Only this system tests its filter again")
+			{
+				REQUIRE(world.GetUpdateStats().filterEvaluations == 1);
+				REQUIRE(prototypeSystem.HasEntity(entity));
+				REQUIRE(otherSystem.HasEntity(entity));
+			}
+
+			AND_WHEN("We remove the component the other system requires")
+			{
+				entity->RemoveComponent<PrototypeComponent>();
+				world.Update();
+
+				THEN("The entity leaves this system only")
+				{
+					REQUIRE(world.GetUpdateStats().filterEvaluations == 1);
+					REQUIRE(!prototypeSystem.HasEntity(entity));
+					REQUIRE(otherSystem.HasEntity(entity));
+				}
+			}
+
+			AND_WHEN("A system filter changes after the system was added")
+			{
+				prototypeSystem.ExcludeOther();
+				world.Update();
+
+				THEN("Every entity is filtered again")
+				{
+					REQUIRE(!prototypeSystem.HasEntity(entity));
+					REQUIRE(otherSystem.HasEntity(entity));
+				}
+
+				AND_WHEN("We remove the newly excluded component")
+				{
+					entity->RemoveComponent<OtherComponent>();
+					world.Update();
+
+					THEN("The system depending on it takes the entity back")
+					{
+						REQUIRE(world.GetUpdateStats().filterEvaluations == 2);
+						REQUIRE(prototypeSystem.HasEntity(entity));
+						REQUIRE(!otherSystem.HasEntity(entity));
+					}
+				}
+			}
+		}
+
+		WHEN("Nothing changed")
+		{
+			world.Update();
+
+			THEN("No filter is tested")
+			{
+				REQUIRE(world.GetUpdateStats().filterEvaluations == 0);
+			}
+		}
+	}
+}